@@ -307,6 +307,13 @@ win32 {
     contains(CONFIG, "serveronly") {
         message(Restricting build to server-only due to CONFIG+=serveronly.)
         DEFINES += SERVER_ONLY
+    } else:contains(CONFIG, "filesound") {
+        # sound interface without audio hardware for headless load and latency tests
+        message(File Audio Interface Enabled.)
+
+        HEADERS += src/sound/file/sound.h
+        SOURCES += src/sound/file/sound.cpp
+        DEFINES += WITH_FILE_SOUND
     } else {
         message(JACK Audio Interface Enabled.)
 
@@ -391,6 +398,7 @@ HEADERS += src/plugins/audioreverb.h \
     src/protocol.h \
     src/recorder/jamcontroller.h \
     src/threadpool.h \
+    src/roommanager.h \
     src/server.h \
     src/serverlist.h \
     src/serverlogging.h \
@@ -399,6 +407,8 @@ HEADERS += src/plugins/audioreverb.h \
     src/util.h \
     src/recorder/jamrecorder.h \
     src/recorder/creaperproject.h \
+    src/recorder/cmixdownrenderer.h \
+    src/recorder/csessionindex.h \
     src/recorder/cwavestream.h \
     src/signalhandler.h
 
@@ -498,6 +508,7 @@ SOURCES += src/plugins/audioreverb.cpp \
     src/main.cpp \
     src/protocol.cpp \
     src/recorder/jamcontroller.cpp \
+    src/roommanager.cpp \
     src/server.cpp \
     src/serverlist.cpp \
     src/serverlogging.cpp \
@@ -507,6 +518,8 @@ SOURCES += src/plugins/audioreverb.cpp \
     src/util.cpp \
     src/recorder/jamrecorder.cpp \
     src/recorder/creaperproject.cpp \
+    src/recorder/cmixdownrenderer.cpp \
+    src/recorder/csessionindex.cpp \
     src/recorder/cwavestream.cpp
 
 !contains(CONFIG, "serveronly") {
@@ -883,6 +883,9 @@ void CChannelFader::SetChannelInfos ( const CChannelInfo& cChanInfo )
 CAudioMixerBoard::CAudioMixerBoard ( QWidget* parent ) :
     QGroupBox ( parent ),
     pSettings ( nullptr ),
+    eGUIDesign ( GD_STANDARD ),
+    eMeterStyle ( MT_BAR_WIDE ),
+    bMIDICtrlUsed ( false ),
     bDisplayPans ( false ),
     bIsPanSupported ( false ),
     bNoFaderVisible ( true ),
@@ -908,16 +911,21 @@ CAudioMixerBoard::CAudioMixerBoard ( QWidget* parent ) :
     // set title text (default: no server given)
     SetServerName ( "" );
 
-    // create all mixer controls and make them invisible
-    vecpChanFader.Init ( MAX_NUM_CHANNELS );
+    // the mixer controls are only created when a channel ID is used for the first
+    // time (see GetFader()), so that a small room does not pay for the widgets
+    // of all possible channels
+    vecpChanFader.Init ( MAX_NUM_CHANNELS, nullptr );
+    vecFaderRow.Init ( MAX_NUM_CHANNELS, INVALID_INDEX );
+    vecFaderColumn.Init ( MAX_NUM_CHANNELS, INVALID_INDEX );
 
     vecAvgLevels.Init ( MAX_NUM_CHANNELS, 0.0f );
+    vecNewChannelLevels.Init ( MAX_NUM_CHANNELS, INVALID_INDEX );
+    bNewChannelLevels = false;
 
-    for ( size_t i = 0; i < MAX_NUM_CHANNELS; i++ )
-    {
-        vecpChanFader[i] = new CChannelFader ( this );
-        vecpChanFader[i]->Hide();
-    }
+    // the faders which do not fit in the batch of a client list update are
+    // created after the GUI has processed its pending events
+    TimerCreateFaders.setSingleShot ( true );
+    TimerCreateFaders.setInterval ( 0 );
 
     // insert horizontal spacer (at position MAX_NUM_CHANNELS+1 which is index MAX_NUM_CHANNELS)
     pMainLayout->addItem ( new QSpacerItem ( 0, 0, QSizePolicy::Expanding ), 0, MAX_NUM_CHANNELS );
@@ -933,7 +941,7 @@ CAudioMixerBoard::CAudioMixerBoard ( QWidget* parent ) :
     pGroupBoxLayout->addWidget ( pScrollArea );
 
     // Connections -------------------------------------------------------------
-    connectFaderSignalsToMixerBoardSlots<MAX_NUM_CHANNELS>();
+    QObject::connect ( &TimerCreateFaders, &QTimer::timeout, this, &CAudioMixerBoard::OnTimerCreateFaders );
 }
 
 CAudioMixerBoard::~CAudioMixerBoard()
@@ -945,10 +953,17 @@ CAudioMixerBoard::~CAudioMixerBoard()
 }
 
 template<unsigned int slotId>
-inline void CAudioMixerBoard::connectFaderSignalsToMixerBoardSlots()
+inline void CAudioMixerBoard::connectFaderSignalsToMixerBoardSlots ( const size_t iChanID )
 {
     size_t iCurChanID = slotId - 1;
 
+    // the slots are selected at compile time, walk down to the one of the given channel
+    if ( iCurChanID != iChanID )
+    {
+        connectFaderSignalsToMixerBoardSlots<slotId - 1> ( iChanID );
+        return;
+    }
+
     void ( CAudioMixerBoard::*pGainValueChanged ) ( float, bool, bool, bool, double ) = &CAudioMixerBoardSlots<slotId>::OnChGainValueChanged;
 
     void ( CAudioMixerBoard::*pPanValueChanged ) ( float ) = &CAudioMixerBoardSlots<slotId>::OnChPanValueChanged;
@@ -958,14 +973,31 @@ inline void CAudioMixerBoard::connectFaderSignalsToMixerBoardSlots()
     QObject::connect ( vecpChanFader[iCurChanID], &CChannelFader::gainValueChanged, this, pGainValueChanged );
 
     QObject::connect ( vecpChanFader[iCurChanID], &CChannelFader::panValueChanged, this, pPanValueChanged );
-
-    connectFaderSignalsToMixerBoardSlots<slotId - 1>();
 }
 
 template<>
-inline void CAudioMixerBoard::connectFaderSignalsToMixerBoardSlots<0>()
+inline void CAudioMixerBoard::connectFaderSignalsToMixerBoardSlots<0> ( const size_t )
 {}
 
+CChannelFader* CAudioMixerBoard::GetFader ( const size_t iChanID )
+{
+    if ( vecpChanFader[iChanID] == nullptr )
+    {
+        // first use of this channel ID: create the fader with the current
+        // board wide settings and connect it to the slots of its channel
+        vecpChanFader[iChanID] = new CChannelFader ( this );
+        vecpChanFader[iChanID]->Hide();
+        vecpChanFader[iChanID]->SetGUIDesign ( eGUIDesign );
+        vecpChanFader[iChanID]->SetMeterStyle ( eMeterStyle );
+        vecpChanFader[iChanID]->SetDisplayPans ( bDisplayPans && bIsPanSupported );
+        vecpChanFader[iChanID]->SetMIDICtrlUsed ( bMIDICtrlUsed );
+
+        connectFaderSignalsToMixerBoardSlots<MAX_NUM_CHANNELS> ( iChanID );
+    }
+
+    return vecpChanFader[iChanID];
+}
+
 void CAudioMixerBoard::SetServerName ( const QString& strNewServerName )
 {
     // store the current server name
@@ -999,19 +1031,29 @@ void CAudioMixerBoard::SetGUIDesign ( const EGUIDesign eNewDesign )
         pMainLayout->setSpacing ( 6 ); // Qt default spacing value
     }
 
+    eGUIDesign = eNewDesign;
+
     // apply GUI design to child GUI controls
     for ( size_t i = 0; i < MAX_NUM_CHANNELS; i++ )
     {
-        vecpChanFader[i]->SetGUIDesign ( eNewDesign );
+        if ( vecpChanFader[i] != nullptr )
+        {
+            vecpChanFader[i]->SetGUIDesign ( eNewDesign );
+        }
     }
 }
 
 void CAudioMixerBoard::SetMeterStyle ( const EMeterStyle eNewMeterStyle )
 {
+    eMeterStyle = eNewMeterStyle;
+
     // apply GUI design to child GUI controls
     for ( size_t i = 0; i < MAX_NUM_CHANNELS; i++ )
     {
-        vecpChanFader[i]->SetMeterStyle ( eNewMeterStyle );
+        if ( vecpChanFader[i] != nullptr )
+        {
+            vecpChanFader[i]->SetMeterStyle ( eNewMeterStyle );
+        }
     }
 }
 
@@ -1021,7 +1063,10 @@ void CAudioMixerBoard::SetDisplayPans ( const bool eNDP )
 
     for ( size_t i = 0; i < MAX_NUM_CHANNELS; i++ )
     {
-        vecpChanFader[i]->SetDisplayPans ( eNDP && bIsPanSupported );
+        if ( vecpChanFader[i] != nullptr )
+        {
+            vecpChanFader[i]->SetDisplayPans ( eNDP && bIsPanSupported );
+        }
     }
 }
 
@@ -1039,12 +1084,23 @@ void CAudioMixerBoard::HideAll()
     // make all controls invisible
     for ( size_t i = 0; i < MAX_NUM_CHANNELS; i++ )
     {
-        vecpChanFader[i]->SetChannelLevel ( 0 );
-        vecpChanFader[i]->SetDisplayChannelLevel ( false );
-        vecpChanFader[i]->SetDisplayPans ( false );
-        vecpChanFader[i]->Hide();
+        if ( vecpChanFader[i] != nullptr )
+        {
+            vecpChanFader[i]->SetChannelLevel ( 0 );
+            vecpChanFader[i]->SetDisplayChannelLevel ( false );
+            vecpChanFader[i]->SetDisplayPans ( false );
+            vecpChanFader[i]->Hide();
+        }
     }
 
+    // drop the levels which were not yet shown
+    vecNewChannelLevels.Reset ( INVALID_INDEX );
+    bNewChannelLevels = false;
+
+    // drop the faders which were not yet created
+    TimerCreateFaders.stop();
+    vecPendingChanInfo.Init ( 0 );
+
     // initialize flags and other parameters
     bIsPanSupported      = false;
     bNoFaderVisible      = true;
@@ -1087,6 +1143,12 @@ void CAudioMixerBoard::ChangeFaderOrder ( const EChSortType eChSortType )
 
     for ( size_t i = 0; i < MAX_NUM_CHANNELS; i++ )
     {
+        // faders which were never created are not part of the layout
+        if ( vecpChanFader[i] == nullptr )
+        {
+            continue;
+        }
+
         if ( vecpChanFader[i]->GetIsMyOwnFader() )
         {
             iMyFader = static_cast<int> ( i );
@@ -1136,7 +1198,7 @@ void CAudioMixerBoard::ChangeFaderOrder ( const EChSortType eChSortType )
         }
 
         // count the number of visible faders
-        if ( vecpChanFader[i]->IsVisible() )
+        if ( IsFaderVisible ( i ) )
         {
             iNumVisibleFaders++;
         }
@@ -1148,7 +1210,7 @@ void CAudioMixerBoard::ChangeFaderOrder ( const EChSortType eChSortType )
     // move my fader to first position
     if ( pSettings->bOwnFaderFirst )
     {
-        for ( int i = 0; i < MAX_NUM_CHANNELS; i++ )
+        for ( int i = 0; i < PairList.size(); i++ )
         {
             if ( iMyFader == static_cast<int> ( PairList[i].second ) )
             {
@@ -1167,7 +1229,7 @@ void CAudioMixerBoard::ChangeFaderOrder ( const EChSortType eChSortType )
     // the widget from the layout first but it is moved to the new position automatically
     int iVisibleFaderCnt = 0;
 
-    for ( int i = 0; i < MAX_NUM_CHANNELS; i++ )
+    for ( int i = 0; i < PairList.size(); i++ )
     {
         const size_t iCurFaderID = PairList[i].second;
 
@@ -1175,9 +1237,18 @@ void CAudioMixerBoard::ChangeFaderOrder ( const EChSortType eChSortType )
         {
             // channels are added row-first, up to iNumFadersFirstRow, then onto
             // the next row.
-            pMainLayout->addWidget ( vecpChanFader[iCurFaderID]->GetMainWidget(),
-                                     iVisibleFaderCnt / iNumFadersFirstRow,
-                                     iVisibleFaderCnt % iNumFadersFirstRow );
+            const int iRow    = iVisibleFaderCnt / iNumFadersFirstRow;
+            const int iColumn = iVisibleFaderCnt % iNumFadersFirstRow;
+
+            // only move the faders which changed their position, with many clients
+            // a join or leave usually only shifts a part of the faders
+            if ( ( vecFaderRow[iCurFaderID] != iRow ) || ( vecFaderColumn[iCurFaderID] != iColumn ) )
+            {
+                pMainLayout->addWidget ( vecpChanFader[iCurFaderID]->GetMainWidget(), iRow, iColumn );
+
+                vecFaderRow[iCurFaderID]    = iRow;
+                vecFaderColumn[iCurFaderID] = iColumn;
+            }
 
             iVisibleFaderCnt++;
         }
@@ -1214,7 +1285,13 @@ void CAudioMixerBoard::SetRecorderState ( const ERecorderState newRecorderState
 void CAudioMixerBoard::ApplyNewConClientList ( CVector<CChannelInfo>& vecChanInfo )
 {
     // get number of connected clients
-    const size_t iNumConnectedClients = vecChanInfo.size();
+    const size_t iNumConnectedClients  = vecChanInfo.size();
+    int          iNumCreatedFaders     = 0;
+    bool         bFaderCreationPending = false;
+
+    // avoid repainting the mixer for each single fader change, the whole
+    // board is redrawn once after the new list is applied
+    pScrollArea->widget()->setUpdatesEnabled ( false );
 
     Mutex.lock();
     {
@@ -1251,35 +1328,56 @@ void CAudioMixerBoard::ApplyNewConClientList ( CVector<CChannelInfo>& vecChanInf
         {
             if ( iFaderNumber[iChanID] == INVALID_INDEX )
             {
-                // current fader is not used
-                StoreFaderSettings ( vecpChanFader[iChanID] );
+                // current fader is not used (faders which were never created need no update)
+                if ( vecpChanFader[iChanID] != nullptr )
+                {
+                    StoreFaderSettings ( vecpChanFader[iChanID] );
 
-                vecpChanFader[iChanID]->Hide();
+                    vecpChanFader[iChanID]->Hide();
+                }
                 continue;
             }
-            size_t idxVecpChan = static_cast<size_t> ( iFaderNumber[iChanID] );
+
+            // only a batch of faders is created per update, the remaining clients
+            // get their faders on the next update (my own fader is never deferred)
+            if ( ( vecpChanFader[iChanID] == nullptr ) && ( static_cast<int> ( iChanID ) != iMyChannelID ) )
+            {
+                if ( iNumCreatedFaders >= NUM_FADERS_CREATED_PER_BATCH )
+                {
+                    bFaderCreationPending = true;
+                    continue;
+                }
+
+                iNumCreatedFaders++;
+            }
+
+            size_t         idxVecpChan = static_cast<size_t> ( iFaderNumber[iChanID] );
+            CChannelFader* pChanFader  = GetFader ( iChanID );
+            bool           bNewFader   = false;
 
             // current fader is used
-            if ( !vecpChanFader[iChanID]->IsVisible() )
+            if ( !pChanFader->IsVisible() )
             {
+                bNewFader = true;
+
                 // the fader was not in use,
                 // reset everything for new client
-                vecpChanFader[iChanID]->Reset();
+                pChanFader->Reset();
                 vecAvgLevels[iChanID] = 0.0f;
 
                 if ( static_cast<int> ( iChanID ) == iMyChannelID )
                 {
                     // this is my own fader --> set fader property
-                    vecpChanFader[iChanID]->SetIsMyOwnFader();
+                    pChanFader->SetIsMyOwnFader();
                 }
 
                 // keep track of each new client
                 // for "no sorting" channel sort order new clients are added
                 // to the right-hand side of the mixer (#673)
-                vecpChanFader[iChanID]->SetRunningNewClientCnt ( iRunningNewClientCnt++ );
+                pChanFader->SetRunningNewClientCnt ( iRunningNewClientCnt++ );
 
                 // show fader
-                vecpChanFader[iChanID]->Show();
+                pChanFader->Show();
 
                 // Set the default initial fader level. Check first that
                 // this is not the initialization (i.e. previously there
@@ -1292,11 +1390,11 @@ void CAudioMixerBoard::ApplyNewConClientList ( CVector<CChannelInfo>& vecChanInf
                      ( pSettings->iNewClientFaderLevel != 100 ) )
                 {
                     // the value is in percent -> convert range
-                    vecpChanFader[iChanID]->SetFaderLevel ( pSettings->iNewClientFaderLevel / 100.0 * AUD_MIX_FADER_MAX );
+                    pChanFader->SetFaderLevel ( pSettings->iNewClientFaderLevel / 100.0 * AUD_MIX_FADER_MAX );
                 }
             }
 
-            if ( vecpChanFader[iChanID]->GetReceivedName().compare ( vecChanInfo[idxVecpChan].strName ) )
+            if ( pChanFader->GetReceivedName().compare ( vecChanInfo[idxVecpChan].strName ) )
             {
                 // the text has actually changed, search in the list of
                 // stored settings if we have a matching entry
@@ -1313,40 +1411,72 @@ void CAudioMixerBoard::ApplyNewConClientList ( CVector<CChannelInfo>& vecChanInf
                                               bStoredFaderIsMute,
                                               iGroupID ) )
                 {
-                    vecpChanFader[iChanID]->SetFaderLevel ( iStoredFaderLevel, true ); // suppress group update
-                    vecpChanFader[iChanID]->SetPanValue ( iStoredPanValue );
-                    vecpChanFader[iChanID]->SetFaderIsSolo ( bStoredFaderIsSolo );
-                    vecpChanFader[iChanID]->SetFaderIsMute ( bStoredFaderIsMute );
-                    vecpChanFader[iChanID]->SetGroupID ( iGroupID ); // Must be the last to be set in the fader!
+                    pChanFader->SetFaderLevel ( iStoredFaderLevel, true ); // suppress group update
+                    pChanFader->SetPanValue ( iStoredPanValue );
+                    pChanFader->SetFaderIsSolo ( bStoredFaderIsSolo );
+                    pChanFader->SetFaderIsMute ( bStoredFaderIsMute );
+                    pChanFader->SetGroupID ( iGroupID ); // Must be the last to be set in the fader!
                 }
             }
 
-            // set the channel infos
-            vecpChanFader[iChanID]->SetChannelInfos ( vecChanInfo[idxVecpChan] );
+            // set the channel infos, the full list is sent on every change in the
+            // server so only the faders with a changed info have to be updated
+            if ( bNewFader || ( pChanFader->GetReceivedChID() != vecChanInfo[idxVecpChan].iChanID ) ||
+                 ( vecChanInfo[idxVecpChan] != pChanFader->GetReceivedChanInfo() ) )
+            {
+                pChanFader->SetChannelInfos ( vecChanInfo[idxVecpChan] );
+            }
         }
 
         // update the solo states since if any channel was on solo and a new client
         // has just connected, the new channel must be muted
         UpdateSoloStates();
 
-        // update flag for "all faders are invisible"
-        bNoFaderVisible = ( iNumConnectedClients == 0 );
+        // update flag for "all faders are invisible" (not before all faders of
+        // the list are created, so that the faders of the clients which were
+        // already connected do not get the new client fader level)
+        if ( !bFaderCreationPending )
+        {
+            bNoFaderVisible = ( iNumConnectedClients == 0 );
+        }
     }
     Mutex.unlock(); // release mutex
 
+    if ( bFaderCreationPending )
+    {
+        // let the GUI process other events before the next batch of faders is created
+        vecPendingChanInfo = vecChanInfo;
+        TimerCreateFaders.start();
+    }
+    else
+    {
+        TimerCreateFaders.stop();
+        vecPendingChanInfo.Init ( 0 );
+    }
+
     // sort the channels according to the selected sorting type
     ChangeFaderOrder ( eChSortType );
 
+    pScrollArea->widget()->setUpdatesEnabled ( true );
+
     // emit status of connected clients
     emit NumClientsChanged ( static_cast<int> ( iNumConnectedClients ) );
 }
 
+void CAudioMixerBoard::OnTimerCreateFaders()
+{
+    // apply the pending client list again which creates the next batch of faders
+    CVector<CChannelInfo> vecChanInfo = vecPendingChanInfo;
+
+    ApplyNewConClientList ( vecChanInfo );
+}
+
 void CAudioMixerBoard::SetFaderLevel ( const int iChannelIdx, const int iValue )
 {
     // only apply new fader level if channel index is valid and the fader is visible
     if ( ( iChannelIdx >= 0 ) && ( iChannelIdx < MAX_NUM_CHANNELS ) )
     {
-        if ( vecpChanFader[static_cast<size_t> ( iChannelIdx )]->IsVisible() )
+        if ( IsFaderVisible ( static_cast<size_t> ( iChannelIdx ) ) )
         {
             vecpChanFader[static_cast<size_t> ( iChannelIdx )]->SetFaderLevel ( iValue );
         }
@@ -1358,7 +1488,7 @@ void CAudioMixerBoard::SetPanValue ( const int iChannelIdx, const int iValue )
     // only apply new pan value if channel index is valid and the panner is visible
     if ( ( iChannelIdx >= 0 ) && ( iChannelIdx < MAX_NUM_CHANNELS ) && bDisplayPans )
     {
-        if ( vecpChanFader[static_cast<size_t> ( iChannelIdx )]->IsVisible() )
+        if ( IsFaderVisible ( static_cast<size_t> ( iChannelIdx ) ) )
         {
             vecpChanFader[static_cast<size_t> ( iChannelIdx )]->SetPanValue ( iValue );
         }
@@ -1371,7 +1501,7 @@ void CAudioMixerBoard::SetFaderIsSolo ( const int iChannelIdx, const bool bIsSol
     if ( ( iChannelIdx >= 0 ) && ( iChannelIdx < MAX_NUM_CHANNELS ) )
 
     {
-        if ( vecpChanFader[static_cast<size_t> ( iChannelIdx )]->IsVisible() )
+        if ( IsFaderVisible ( static_cast<size_t> ( iChannelIdx ) ) )
         {
             vecpChanFader[static_cast<size_t> ( iChannelIdx )]->SetFaderIsSolo ( bIsSolo );
         }
@@ -1383,7 +1513,7 @@ void CAudioMixerBoard::SetFaderIsMute ( const int iChannelIdx, const bool bIsMut
     // only apply mute if channel index is valid and the fader is visible
     if ( ( iChannelIdx >= 0 ) && ( iChannelIdx < MAX_NUM_CHANNELS ) )
     {
-        if ( vecpChanFader[static_cast<size_t> ( iChannelIdx )]->IsVisible() )
+        if ( IsFaderVisible ( static_cast<size_t> ( iChannelIdx ) ) )
         {
             vecpChanFader[static_cast<size_t> ( iChannelIdx )]->SetFaderIsMute ( bIsMute );
         }
@@ -1397,7 +1527,7 @@ void CAudioMixerBoard::SetAllFaderLevelsToNewClientLevel()
     for ( size_t i = 0; i < MAX_NUM_CHANNELS; i++ )
     {
         // only apply to visible faders and not to my own channel fader
-        if ( vecpChanFader[i]->IsVisible() && ( static_cast<int> ( i ) != iMyChannelID ) )
+        if ( IsFaderVisible ( i ) && ( static_cast<int> ( i ) != iMyChannelID ) )
         {
             // the value is in percent -> convert range, also use the group
             // update flag to make sure the group values are all set to the
@@ -1426,7 +1556,7 @@ void CAudioMixerBoard::AutoAdjustAllFaderLevels()
     for ( size_t i = 0; i < MAX_NUM_CHANNELS; ++i )
     {
         // only apply to visible faders (and not to my own channel fader)
-        if ( vecpChanFader[i]->IsVisible() && ( static_cast<int> ( i ) != iMyChannelID ) )
+        if ( IsFaderVisible ( i ) && ( static_cast<int> ( i ) != iMyChannelID ) )
         {
             // map averaged meter output level to decibels
             // (invert CStereoSignalLevelMeter::CalcLogResultForMeter)
@@ -1516,7 +1646,7 @@ void CAudioMixerBoard::AutoAdjustAllFaderLevels()
     for ( size_t i = 0; i < MAX_NUM_CHANNELS; ++i )
     {
         // only apply to visible faders (and not to my own channel fader)
-        if ( vecpChanFader[i]->IsVisible() && ( static_cast<int> ( i ) != iMyChannelID ) )
+        if ( IsFaderVisible ( i ) && ( static_cast<int> ( i ) != iMyChannelID ) )
         {
             // map averaged meter output level to decibels
             // (invert CStereoSignalLevelMeter::CalcLogResultForMeter)
@@ -1557,13 +1687,18 @@ void CAudioMixerBoard::AutoAdjustAllFaderLevels()
     }
 }
 
-void CAudioMixerBoard::SetMIDICtrlUsed ( const bool bMIDICtrlUsed )
+void CAudioMixerBoard::SetMIDICtrlUsed ( const bool bNMIDICtrlUsed )
 {
     QMutexLocker locker ( &Mutex );
 
+    bMIDICtrlUsed = bNMIDICtrlUsed;
+
     for ( size_t i = 0; i < MAX_NUM_CHANNELS; i++ )
     {
-        vecpChanFader[i]->SetMIDICtrlUsed ( bMIDICtrlUsed );
+        if ( vecpChanFader[i] != nullptr )
+        {
+            vecpChanFader[i]->SetMIDICtrlUsed ( bNMIDICtrlUsed );
+        }
     }
 }
 
@@ -1573,7 +1708,10 @@ void CAudioMixerBoard::StoreAllFaderSettings()
 
     for ( size_t i = 0; i < MAX_NUM_CHANNELS; i++ )
     {
-        StoreFaderSettings ( vecpChanFader[i] );
+        if ( vecpChanFader[i] != nullptr )
+        {
+            StoreFaderSettings ( vecpChanFader[i] );
+        }
     }
 }
 
@@ -1589,12 +1727,12 @@ void CAudioMixerBoard::LoadAllFaderSettings()
 
     for ( size_t i = 0; i < MAX_NUM_CHANNELS; i++ )
     {
-        if ( GetStoredFaderSettings ( vecpChanFader[i]->GetReceivedName(),
-                                      iStoredFaderLevel,
-                                      iStoredPanValue,
-                                      bStoredFaderIsSolo,
-                                      bStoredFaderIsMute,
-                                      iGroupID ) )
+        if ( ( vecpChanFader[i] != nullptr ) && GetStoredFaderSettings ( vecpChanFader[i]->GetReceivedName(),
+                                                                         iStoredFaderLevel,
+                                                                         iStoredPanValue,
+                                                                         bStoredFaderIsSolo,
+                                                                         bStoredFaderIsMute,
+                                                                         iGroupID ) )
         {
             vecpChanFader[i]->SetFaderLevel ( iStoredFaderLevel, true ); // suppress group update
             vecpChanFader[i]->SetPanValue ( iStoredPanValue );
@@ -1610,7 +1748,7 @@ void CAudioMixerBoard::SetRemoteFaderIsMute ( const int iChannelIdx, const bool
     // only apply remote mute state if channel index is valid and the fader is visible
     if ( ( iChannelIdx >= 0 ) && ( iChannelIdx < MAX_NUM_CHANNELS ) )
     {
-        if ( vecpChanFader[static_cast<size_t> ( iChannelIdx )]->IsVisible() )
+        if ( IsFaderVisible ( static_cast<size_t> ( iChannelIdx ) ) )
         {
             vecpChanFader[static_cast<size_t> ( iChannelIdx )]->SetRemoteFaderIsMute ( bIsMute );
         }
@@ -1625,7 +1763,7 @@ void CAudioMixerBoard::UpdateSoloStates()
     for ( size_t i = 0; i < MAX_NUM_CHANNELS; i++ )
     {
         // check if fader is in use and has solo state active
-        if ( vecpChanFader[i]->IsVisible() && vecpChanFader[i]->IsSolo() )
+        if ( IsFaderVisible ( i ) && vecpChanFader[i]->IsSolo() )
         {
             bAnyChannelIsSolo = true;
             continue;
@@ -1635,7 +1773,7 @@ void CAudioMixerBoard::UpdateSoloStates()
     // now update the solo state of all active faders
     for ( size_t i = 0; i < MAX_NUM_CHANNELS; i++ )
     {
-        if ( vecpChanFader[i]->IsVisible() )
+        if ( IsFaderVisible ( i ) )
         {
             vecpChanFader[i]->UpdateSoloState ( bAnyChannelIsSolo );
         }
@@ -1664,7 +1802,7 @@ void CAudioMixerBoard::UpdateGainValue ( const int    iChannelIdx,
         for ( size_t i = 0; i < MAX_NUM_CHANNELS; i++ )
         {
             // update rest of faders selected
-            if ( vecpChanFader[i]->IsVisible() && ( vecpChanFader[i]->GetGroupID() == vecpChanFader[stChannelIdx]->GetGroupID() ) &&
+            if ( IsFaderVisible ( i ) && ( vecpChanFader[i]->GetGroupID() == vecpChanFader[stChannelIdx]->GetGroupID() ) &&
                  ( i != stChannelIdx ) && ( dLevelRatio >= 0 ) )
             {
                 // synchronize faders with moving fader level (it is important
@@ -1761,12 +1899,32 @@ void CAudioMixerBoard::SetChannelLevels ( const CVector<uint16_t>& vecChannelLev
 
     for ( size_t iChId = 0; iChId < MAX_NUM_CHANNELS; iChId++ )
     {
-        if ( vecpChanFader[iChId]->IsVisible() && ( i < iNumChannelLevels ) )
+        if ( IsFaderVisible ( iChId ) && ( i < iNumChannelLevels ) )
         {
             // compute exponential moving average
             vecAvgLevels[iChId] = ( 1.0f - AUTO_FADER_ADJUST_ALPHA ) * vecAvgLevels[iChId] + AUTO_FADER_ADJUST_ALPHA * vecChannelLevel[i];
 
-            vecpChanFader[iChId]->SetChannelLevel ( vecChannelLevel[i++] );
+            // the level meter is updated with the next GUI refresh (see UpdateChannelLevels())
+            vecNewChannelLevels[iChId] = vecChannelLevel[i++];
+            bNewChannelLevels          = true;
+        }
+    }
+}
+
+void CAudioMixerBoard::UpdateChannelLevels()
+{
+    // apply the last received levels to all level meters in one pass, only the
+    // meters which show a different value are repainted
+    if ( !bNewChannelLevels )
+    {
+        return;
+    }
+
+    for ( size_t iChId = 0; iChId < MAX_NUM_CHANNELS; iChId++ )
+    {
+        if ( ( vecNewChannelLevels[iChId] != INVALID_INDEX ) && IsFaderVisible ( iChId ) )
+        {
+            vecpChanFader[iChId]->SetChannelLevel ( static_cast<uint16_t> ( vecNewChannelLevels[iChId] ) );
 
             // show level only if we successfully received levels from the
             // server (if server does not support levels, do not show levels)
@@ -1776,6 +1934,9 @@ void CAudioMixerBoard::SetChannelLevels ( const CVector<uint16_t>& vecChannelLev
             }
         }
     }
+
+    vecNewChannelLevels.Reset ( INVALID_INDEX );
+    bNewChannelLevels = false;
 }
 
 void CAudioMixerBoard::MuteMyChannel() { SetFaderIsMute ( iMyChannelID, true ); }
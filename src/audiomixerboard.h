@@ -38,12 +38,19 @@
 #include <QListWidget>
 #include <QMenu>
 #include <QMutex>
+#include <QTimer>
 #include <QTextBoundaryFinder>
 #include "global.h"
 #include "util.h"
 #include "levelmeter.h"
 #include "settings.h"
 
+/* Definitions ****************************************************************/
+// number of faders which are created at once (if many clients are already
+// connected when joining a server, the faders are created in batches to keep
+// the GUI responsive)
+#define NUM_FADERS_CREATED_PER_BATCH 8
+
 /* Classes ********************************************************************/
 class CChannelFader : public QObject
 {
@@ -70,6 +77,8 @@ public:
     void    SetDisplayPans ( const bool eNDP );
     QFrame* GetMainWidget() { return pFrame; }
 
+    const CChannelInfo& GetReceivedChanInfo() { return cReceivedChanInfo; }
+
     void SetPanValue ( const int iPan );
     void SetFaderIsSolo ( const bool bIsSolo );
     void SetFaderIsMute ( const bool bIsMute );
@@ -218,6 +227,7 @@ public:
     EChSortType GetFaderSorting() { return eChSortType; }
 
     void SetChannelLevels ( const CVector<uint16_t>& vecChannelLevel );
+    void UpdateChannelLevels();
 
     void           SetRecorderState ( const ERecorderState newRecorderState );
     ERecorderState GetRecorderState() { return eRecorderState; };
@@ -229,7 +239,7 @@ public:
 
     void MuteMyChannel();
 
-    void SetMIDICtrlUsed ( const bool bMIDICtrlUsed );
+    void SetMIDICtrlUsed ( const bool bNMIDICtrlUsed );
 
 protected:
     class CMixerBoardScrollArea : public QScrollArea
@@ -249,6 +259,9 @@ protected:
 
     void ChangeFaderOrder ( const EChSortType eChSortType );
 
+    CChannelFader* GetFader ( const size_t iChanID );
+    bool           IsFaderVisible ( const size_t iChanID ) { return ( vecpChanFader[iChanID] != nullptr ) && vecpChanFader[iChanID]->IsVisible(); }
+
     bool GetStoredFaderSettings ( const QString& strName,
                                   int&           iStoredFaderLevel,
                                   int&           iStoredPanValue,
@@ -261,9 +274,14 @@ protected:
     void UpdateTitle();
 
     CClientSettings*        pSettings;
-    CVector<CChannelFader*> vecpChanFader;
+    CVector<CChannelFader*> vecpChanFader; // nullptr if the channel ID was never in use
+    CVector<int>            vecFaderRow;   // current layout position, INVALID_INDEX if not in the layout
+    CVector<int>            vecFaderColumn;
     CMixerBoardScrollArea*  pScrollArea;
     QGridLayout*            pMainLayout;
+    EGUIDesign              eGUIDesign;
+    EMeterStyle             eMeterStyle;
+    bool                    bMIDICtrlUsed;
     bool                    bDisplayPans;
     bool                    bIsPanSupported;
     bool                    bNoFaderVisible;
@@ -275,6 +293,10 @@ protected:
     QMutex                  Mutex;
     EChSortType             eChSortType;
     CVector<float>          vecAvgLevels;
+    CVector<int>            vecNewChannelLevels; // INVALID_INDEX if there is no new level
+    bool                    bNewChannelLevels;
+    QTimer                  TimerCreateFaders;
+    CVector<CChannelInfo>   vecPendingChanInfo; // client list which still has faders to be created
 
     virtual void UpdateGainValue ( const int    iChannelIdx,
                                    const float  fValue,
@@ -286,7 +308,10 @@ protected:
     virtual void UpdatePanValue ( const int iChannelIdx, const float fValue );
 
     template<unsigned int slotId>
-    inline void connectFaderSignalsToMixerBoardSlots();
+    inline void connectFaderSignalsToMixerBoardSlots ( const size_t iChanID );
+
+public slots:
+    void OnTimerCreateFaders();
 
 signals:
     void ChangeChanGain ( int iId, float fGain, bool bIsMyOwnFader );
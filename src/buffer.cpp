@@ -350,6 +350,28 @@ bool CNetBuf::Get ( CVector<uint8_t>& vecbyData, const int iOutSize )
     return bReturn;
 }
 
+bool CNetBuf::GetRedundant ( CVector<uint8_t>& vecbyData )
+{
+    // This is called after Get() failed for a block. If the following block,
+    // which is now at the get position, was received, its redundant copy of the
+    // lost block can be used instead. The following block itself stays in the
+    // buffer. The redundant copy is written to the beginning of the output.
+    if ( !bUseSequenceNumber || ( iRedundantSize == 0 ) || ( veciBlockValid[iBlockGetPos] == 0 ) )
+    {
+        return false;
+    }
+
+    // for simulation buffer no data copying
+    if ( !bIsSimulation )
+    {
+        const CVector<uint8_t>& vecbyBlock = vecvecMemory[iBlockGetPos];
+
+        std::copy ( vecbyBlock.begin() + iBlockSize - iRedundantSize, vecbyBlock.begin() + iBlockSize, vecbyData.begin() );
+    }
+
+    return true;
+}
+
 int CNetBuf::GetAvailSpace() const
 {
     // calculate available space in buffer
@@ -482,6 +504,7 @@ void CNetBufWithStats::Init ( const int iNewBlockSize, const int iNewNumBlocks,
         for ( int i = 0; i < NUM_STAT_SIMULATION_BUFFERS; i++ )
         {
             // init simulation buffers with the correct size
+            SimulationBuffer[i].SetRedundantSize ( iRedundantSize );
             SimulationBuffer[i].Init ( iNewBlockSize, viBufSizesForSim[i], bNUseSequenceNumber );
 
             // init statistics
@@ -528,10 +551,11 @@ bool CNetBufWithStats::Get ( CVector<uint8_t>& vecbyData, const int iOutSize )
     // call base class Get
     const bool bGetOK = CNetBuf::Get ( vecbyData, iOutSize );
 
-    // update statistics calculations
+    // update statistics calculations (a block which can be reconstructed from
+    // its redundant copy is no error so that smaller buffers are chosen)
     for ( int i = 0; i < NUM_STAT_SIMULATION_BUFFERS; i++ )
     {
-        ErrorRateStatistic[i].Update ( !SimulationBuffer[i].Get ( vecbyData, iOutSize ) );
+        ErrorRateStatistic[i].Update ( !SimulationBuffer[i].Get ( vecbyData, iOutSize ) && !SimulationBuffer[i].GetRedundant ( vecbyData ) );
     }
 
     // update auto setting
@@ -24,6 +24,7 @@
 
 #pragma once
 
+#include <atomic>
 #include "util.h"
 #include "global.h"
 
@@ -233,15 +234,25 @@ protected:
 class CNetBuf
 {
 public:
-    CNetBuf ( const bool bNIsSim = false ) : iSequenceNumberAtGetPos ( 0 ), bIsSimulation ( bNIsSim ), bIsInitialized ( false ) {}
+    CNetBuf ( const bool bNIsSim = false ) :
+        iSequenceNumberAtGetPos ( 0 ),
+        iRedundantSize ( 0 ),
+        bIsSimulation ( bNIsSim ),
+        bIsInitialized ( false )
+    {}
 
     void Init ( const int iNewBlockSize, const int iNewNumBlocks, const bool bNUseSequenceNumber, const bool bPreserve = false );
 
     void SetIsSimulation ( const bool bNIsSim ) { bIsSimulation = bNIsSim; }
 
+    // the last bytes of a block may carry a redundant copy of the previous block
+    void SetRedundantSize ( const int iNRedSize ) { iRedundantSize = iNRedSize; }
+
     virtual bool Put ( const CVector<uint8_t>& vecbyData, int iInSize );
     virtual bool Get ( CVector<uint8_t>& vecbyData, const int iOutSize );
 
+    bool GetRedundant ( CVector<uint8_t>& vecbyData );
+
 protected:
     enum EBufState
     {
@@ -261,6 +272,7 @@ protected:
     int                       iBlockPutPos;
     int                       iBlockSize;
     uint8_t                   iSequenceNumberAtGetPos; // uint8_t so that it wraps automatically
+    int                       iRedundantSize;
     EBufState                 eBufState;
     bool                      bUseSequenceNumber;
     bool                      bIsSimulation;
@@ -434,3 +446,143 @@ protected:
     bool           bUseSequenceNumber;
     int            iPutPos, iGetPos;
 };
+
+// Wait-free single producer/single consumer buffer ----------------------------
+// One thread only puts data and one other thread only gets data, both without
+// any lock (e.g., to exchange audio data with the sound card callback which must
+// never wait for another thread). Init() and Reset() must only be called if no
+// other thread accesses the buffer.
+template<class TData>
+class CSpscBuffer
+{
+public:
+    CSpscBuffer() : iMemSize ( 0 ), iPutPos ( 0 ), iGetPos ( 0 ) {}
+
+    void Init ( const int iNewSize )
+    {
+        // one element is always kept free to distinguish a full from an empty buffer
+        iMemSize = iNewSize + 1;
+        vecMemory.Init ( iMemSize );
+
+        Reset();
+    }
+
+    void Reset()
+    {
+        iPutPos.store ( 0 );
+        iGetPos.store ( 0 );
+    }
+
+    int GetAvailData() const
+    {
+        const int iAvData = iPutPos.load ( std::memory_order_acquire ) - iGetPos.load ( std::memory_order_acquire );
+
+        return ( iAvData < 0 ) ? iAvData + iMemSize : iAvData;
+    }
+
+    int GetAvailSpace() const { return iMemSize - 1 - GetAvailData(); }
+
+    bool Put ( const CVector<TData>& vecData, const int iInSize )
+    {
+        const int iCurPutPos = iPutPos.load ( std::memory_order_relaxed );
+        int       iAvSpace   = iGetPos.load ( std::memory_order_acquire ) - iCurPutPos - 1;
+
+        if ( iAvSpace < 0 )
+        {
+            iAvSpace += iMemSize;
+        }
+
+        // check for buffer overrun
+        if ( iInSize > iAvSpace )
+        {
+            return false;
+        }
+
+        // copy the data in up to two blocks because of wrap around
+        const int iFirstBlock = std::min ( iInSize, iMemSize - iCurPutPos );
+
+        std::copy ( vecData.begin(), vecData.begin() + iFirstBlock, vecMemory.begin() + iCurPutPos );
+        std::copy ( vecData.begin() + iFirstBlock, vecData.begin() + iInSize, vecMemory.begin() );
+
+        // publish the new data to the reading thread
+        iPutPos.store ( ( iCurPutPos + iInSize ) % iMemSize, std::memory_order_release );
+
+        return true;
+    }
+
+    bool Get ( CVector<TData>& vecData, const int iOutSize )
+    {
+        const int iCurGetPos = iGetPos.load ( std::memory_order_relaxed );
+        int       iAvData    = iPutPos.load ( std::memory_order_acquire ) - iCurGetPos;
+
+        if ( iAvData < 0 )
+        {
+            iAvData += iMemSize;
+        }
+
+        // check for buffer underrun
+        if ( iOutSize > iAvData )
+        {
+            return false;
+        }
+
+        // copy the data in up to two blocks because of wrap around
+        const int iFirstBlock = std::min ( iOutSize, iMemSize - iCurGetPos );
+
+        std::copy ( vecMemory.begin() + iCurGetPos, vecMemory.begin() + iCurGetPos + iFirstBlock, vecData.begin() );
+        std::copy ( vecMemory.begin(), vecMemory.begin() + ( iOutSize - iFirstBlock ), vecData.begin() + iFirstBlock );
+
+        // release the space to the writing thread
+        iGetPos.store ( ( iCurGetPos + iOutSize ) % iMemSize, std::memory_order_release );
+
+        return true;
+    }
+
+protected:
+    CVector<TData>   vecMemory;
+    int              iMemSize;
+    std::atomic<int> iPutPos;
+    std::atomic<int> iGetPos;
+};
+
+// Wait-free snapshot buffer (triple buffer) ------------------------------------
+// One thread publishes new values of a parameter set, one other thread gets the
+// latest published value, both without any lock (e.g., to hand over settings to
+// the sound card callback). The writer and the reader each own one of the three
+// slots, the third slot holds the latest published value and is swapped with
+// them atomically. The value returned by Get() is not changed by the writer
+// until the next call of Get().
+template<class TData>
+class CSnapshotBuffer
+{
+public:
+    CSnapshotBuffer() : iWriteIdx ( 0 ), iLatestIdx ( 1 ), iReadIdx ( 2 ) {}
+
+    void Publish ( const TData& tNewValue )
+    {
+        Slots[iWriteIdx] = tNewValue;
+
+        // make the written slot the latest one and continue with the old latest slot
+        iWriteIdx = iLatestIdx.exchange ( iWriteIdx | NEW_VALUE_FLAG, std::memory_order_acq_rel ) & SLOT_INDEX_MASK;
+    }
+
+    const TData& Get()
+    {
+        // only swap slots if a new value was published since the last call
+        if ( iLatestIdx.load ( std::memory_order_relaxed ) & NEW_VALUE_FLAG )
+        {
+            iReadIdx = iLatestIdx.exchange ( iReadIdx, std::memory_order_acq_rel ) & SLOT_INDEX_MASK;
+        }
+
+        return Slots[iReadIdx];
+    }
+
+protected:
+    static const int SLOT_INDEX_MASK = 3;
+    static const int NEW_VALUE_FLAG  = 4;
+
+    TData            Slots[3];
+    int              iWriteIdx;
+    std::atomic<int> iLatestIdx;
+    int              iReadIdx;
+};
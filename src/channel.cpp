@@ -26,12 +26,16 @@
 
 // CChannel implementation *****************************************************
 CChannel::CChannel ( const bool bNIsServer ) :
-    vecfGains ( MAX_NUM_CHANNELS, 1.0f ),
-    vecfPannings ( MAX_NUM_CHANNELS, 0.5f ),
     iCurSockBufNumFrames ( INVALID_INDEX ),
     bDoAutoSockBufSize ( true ),
     bUseSequenceNumber ( false ), // this is important since in the client we reset on Channel.SetEnable ( false )
     iSendSequenceNumber ( 0 ),
+    bRedundancyEnabled ( false ),
+    vecbyNetwFrame ( MAX_SIZE_BYTES_NETW_BUF, 0 ),
+    vecbyPrevRedData ( MAX_SIZE_BYTES_NETW_BUF, 0 ),
+    vecbyRecFrame ( MAX_SIZE_BYTES_NETW_BUF, 0 ),
+    bSeparateChannelsEnabled ( false ),
+    bSeparateChannelsNegotiated ( false ),
     iFadeInCnt ( 0 ),
     iFadeInCntMax ( FADE_IN_NUM_FRAMES_DBLE_FRAMESIZE ),
     bIsEnabled ( false ),
@@ -40,8 +44,9 @@ CChannel::CChannel ( const bool bNIsServer ) :
     iAudioFrameSizeSamples ( DOUBLE_SYSTEM_FRAME_SIZE_SAMPLES ),
     SignalLevelMeter ( false, 0.5 ) // server mode with mono out and faster smoothing
 {
-    // reset network transport properties
+    // reset network transport properties and frame loss statistic
     ResetNetworkTransportProperties();
+    ResetLossStatistic();
 
     // initial value for connection time out counter, we calculate the total
     // number of samples here and subtract the number of samples of the block
@@ -102,6 +107,10 @@ CChannel::CChannel ( const bool bNIsServer ) :
     QObject::connect ( &Protocol, &CProtocol::VersionAndOSReceived, this, &CChannel::OnVersionAndOSReceived );
 
     QObject::connect ( &Protocol, &CProtocol::RecorderStateReceived, this, &CChannel::RecorderStateReceived );
+
+    QObject::connect ( &Protocol, &CProtocol::AudioLossRateReceived, this, &CChannel::AudioLossRateReceived );
+
+    QObject::connect ( &Protocol, &CProtocol::NetwTranspFeaturesReceived, this, &CChannel::OnNetwTranspFeaturesReceived );
 }
 
 bool CChannel::ProtocolIsEnabled()
@@ -136,6 +145,12 @@ void CChannel::SetEnable ( const bool bNEnStat )
     // simply set it regardless of the state which does not hurt.
     bUseSequenceNumber = false;
 
+    // the same applies to the redundant frame transmission and the separately
+    // coded audio channels
+    bRedundancyNegotiated       = false;
+    bRedundancyActive           = false;
+    bSeparateChannelsNegotiated = false;
+
     // if channel is not enabled, reset time out count and protocol
     if ( !bNEnStat )
     {
@@ -154,17 +169,40 @@ void CChannel::OnVersionAndOSReceived ( COSUtil::EOpSystemType eOSType, QString
         // does all the initialization and tells the server about the change)
         bUseSequenceNumber = true;
 
-        SetAudioStreamProperties ( eAudioCompressionType, iCeltNumCodedBytes, iNetwFrameSizeFact, iNumAudioChannels );
+        SetAudioStreamProperties ( eAudioCompressionType, iCeltNumCodedBytes, iNetwFrameSizeFact, iNumAudioChannels, bSeparateChannels );
     }
 #endif
 
     emit VersionAndOSReceived ( eOSType, strVersion );
 }
 
+void CChannel::OnNetwTranspFeaturesReceived ( int iFeatures )
+{
+    // the optional flags of the network transport properties are only used if
+    // the server announced them (only the client negotiates, the server follows
+    // the network transport properties)
+    if ( !bIsServer )
+    {
+        bRedundancyNegotiated       = bRedundancyEnabled && ( ( iFeatures & NTF_REDUNDANCY ) != 0 );
+        bSeparateChannelsNegotiated = bSeparateChannelsEnabled && ( ( iFeatures & NTF_SEPARATE_CHANNELS ) != 0 );
+
+        // the server sends the version before the features, so the sequence
+        // number is already activated if the server supports it
+        if ( bUseSequenceNumber )
+        {
+            SetAudioStreamProperties ( eAudioCompressionType, iCeltNumCodedBytes, iNetwFrameSizeFact, iNumAudioChannels, bSeparateChannels );
+        }
+
+        // the client may select another audio coding for the negotiated features
+        emit NetwTranspFeaturesNegotiated();
+    }
+}
+
 void CChannel::SetAudioStreamProperties ( const EAudComprType eNewAudComprType,
                                           const int           iNewCeltNumCodedBytes,
                                           const int           iNewNetwFrameSizeFact,
-                                          const int           iNewNumAudioChannels )
+                                          const int           iNewNumAudioChannels,
+                                          const bool          bNewSeparateChannels )
 {
     /*
         this function is intended for the client (not the server)
@@ -179,10 +217,26 @@ void CChannel::SetAudioStreamProperties ( const EAudComprType eNewAudComprType,
         iCeltNumCodedBytes    = iNewCeltNumCodedBytes;
         iNetwFrameSizeFact    = iNewNetwFrameSizeFact;
 
+        // separately coded audio channels are only possible in stereo mode and need
+        // the sequence number (which is supported by all servers which support them)
+        bSeparateChannels = bUseSequenceNumber && bSeparateChannelsNegotiated && bNewSeparateChannels && ( iNumAudioChannels == 2 );
+
+        // the optional redundant copy of the previous frame is appended to the
+        // coded frame (it needs the sequence number to identify lost frames), it is
+        // not used with separately coded audio channels
+        if ( bUseSequenceNumber && bRedundancyNegotiated && bRedundancyActive && !bSeparateChannels )
+        {
+            iRedNumCodedBytes = std::max ( iCeltNumCodedBytes / REDUNDANT_FRAME_SIZE_DIV, CELT_MINIMUM_NUM_BYTES );
+        }
+        else
+        {
+            iRedNumCodedBytes = 0;
+        }
+
         // add the size of the optional packet counter
         if ( bUseSequenceNumber )
         {
-            iNetwFrameSize = iCeltNumCodedBytes + 1; // per definition 1 byte counter
+            iNetwFrameSize = iCeltNumCodedBytes + iRedNumCodedBytes + 1; // per definition 1 byte counter
         }
         else
         {
@@ -203,14 +257,17 @@ void CChannel::SetAudioStreamProperties ( const EAudComprType eNewAudComprType,
         {
             // init socket buffer
             SockBuf.SetUseDoubleSystemFrameSize ( eAudioCompressionType == CT_OPUS ); // NOTE must be set BEFORE the init()
-            SockBuf.Init ( iCeltNumCodedBytes, iCurSockBufNumFrames, bUseSequenceNumber );
+            SockBuf.SetRedundantSize ( iRedNumCodedBytes );                          // NOTE must be set BEFORE the init()
+            SockBuf.Init ( iCeltNumCodedBytes + iRedNumCodedBytes, iCurSockBufNumFrames, bUseSequenceNumber );
+            ResetLossStatistic();
         }
         MutexSocketBuf.unlock();
 
         MutexConvBuf.lock();
         {
-            // init conversion buffer
+            // init conversion buffer and the redundant copy of the previous frame
             ConvBuf.Init ( iNetwFrameSize * iNetwFrameSizeFact, bUseSequenceNumber );
+            vecbyPrevRedData.Reset ( 0 );
         }
         MutexConvBuf.unlock();
 
@@ -223,6 +280,18 @@ void CChannel::SetAudioStreamProperties ( const EAudComprType eNewAudComprType,
     Protocol.CreateNetwTranspPropsMes ( NetworkTransportProps );
 }
 
+void CChannel::SetRedundancyActive ( const bool bNActive )
+{
+    // switching changes the network frame size on both sides which causes a short
+    // audio dropout, therefore the caller should not switch too often
+    if ( bRedundancyNegotiated && ( bRedundancyActive != bNActive ) )
+    {
+        bRedundancyActive = bNActive;
+
+        SetAudioStreamProperties ( eAudioCompressionType, iCeltNumCodedBytes, iNetwFrameSizeFact, iNumAudioChannels, bSeparateChannels );
+    }
+}
+
 bool CChannel::SetSockBufNumFrames ( const int iNewNumFrames, const bool bPreserve )
 {
     bool ReturnValue           = true;  // init with error
@@ -241,7 +310,7 @@ bool CChannel::SetSockBufNumFrames ( const int iNewNumFrames, const bool bPreser
 
                 // the network block size is a multiple of the minimum network
                 // block size
-                SockBuf.Init ( iCeltNumCodedBytes, iNewNumFrames, bUseSequenceNumber, bPreserve );
+                SockBuf.Init ( iCeltNumCodedBytes + iRedNumCodedBytes, iNewNumFrames, bUseSequenceNumber, bPreserve );
 
                 // store current auto socket buffer size setting in the mutex
                 // region since if we use the current parameter below in the
@@ -277,17 +346,26 @@ void CChannel::SetGain ( const int iChanID, const float fNewGain )
     // set value (make sure channel ID is in range)
     if ( ( iChanID >= 0 ) && ( iChanID < MAX_NUM_CHANNELS ) )
     {
+        const float fOldGain = mapGains.value ( iChanID, 1.0f );
+
         // signal mute change
-        if ( ( vecfGains[iChanID] == 0 ) && ( fNewGain > 0 ) )
+        if ( ( fOldGain == 0 ) && ( fNewGain > 0 ) )
         {
             emit MuteStateHasChanged ( iChanID, false );
         }
-        if ( ( vecfGains[iChanID] > 0 ) && ( fNewGain == 0 ) )
+        if ( ( fOldGain > 0 ) && ( fNewGain == 0 ) )
         {
             emit MuteStateHasChanged ( iChanID, true );
         }
 
-        vecfGains[iChanID] = fNewGain;
+        if ( fNewGain == 1.0f )
+        {
+            mapGains.remove ( iChanID );
+        }
+        else
+        {
+            mapGains.insert ( iChanID, fNewGain );
+        }
     }
 }
 
@@ -298,7 +376,7 @@ float CChannel::GetGain ( const int iChanID )
     // get value (make sure channel ID is in range)
     if ( ( iChanID >= 0 ) && ( iChanID < MAX_NUM_CHANNELS ) )
     {
-        return vecfGains[iChanID];
+        return mapGains.value ( iChanID, 1.0f );
     }
     else
     {
@@ -313,7 +391,14 @@ void CChannel::SetPan ( const int iChanID, const float fNewPan )
     // set value (make sure channel ID is in range)
     if ( ( iChanID >= 0 ) && ( iChanID < MAX_NUM_CHANNELS ) )
     {
-        vecfPannings[iChanID] = fNewPan;
+        if ( fNewPan == 0.5f )
+        {
+            mapPannings.remove ( iChanID );
+        }
+        else
+        {
+            mapPannings.insert ( iChanID, fNewPan );
+        }
     }
 }
 
@@ -324,7 +409,7 @@ float CChannel::GetPan ( const int iChanID )
     // get value (make sure channel ID is in range)
     if ( ( iChanID >= 0 ) && ( iChanID < MAX_NUM_CHANNELS ) )
     {
-        return vecfPannings[iChanID];
+        return mapPannings.value ( iChanID, 0.5f );
     }
     else
     {
@@ -332,6 +417,28 @@ float CChannel::GetPan ( const int iChanID )
     }
 }
 
+void CChannel::ResetGainsPans()
+{
+    QMutexLocker locker ( &Mutex );
+
+    // all other channels back to unity gain and centre pan (note that no mute
+    // state change is signalled, this is used for a new connection only)
+    mapGains.clear();
+    mapPannings.clear();
+}
+
+void CChannel::GetGainsPans ( const CVector<int>& vecChanIDs, const int iNumChans, CVector<float>& vecfGainsOut, CVector<float>& vecfPansOut )
+{
+    // query a whole row of the mix with a single lock
+    QMutexLocker locker ( &Mutex );
+
+    for ( int j = 0; j < iNumChans; j++ )
+    {
+        vecfGainsOut[j] = mapGains.value ( vecChanIDs[j], 1.0f );
+        vecfPansOut[j]  = mapPannings.value ( vecChanIDs[j], 0.5f );
+    }
+}
+
 void CChannel::SetChanInfo ( const CChannelCoreInfo& NChanInf )
 {
     // apply value (if a new channel or different from previous one)
@@ -419,17 +526,33 @@ void CChannel::OnNetTranspPropsReceived ( CNetworkTransportProps NetworkTranspor
             iNumAudioChannels     = static_cast<int> ( NetworkTransportProps.iNumAudioChannels );
             iNetwFrameSizeFact    = NetworkTransportProps.iBlockSizeFact;
             iNetwFrameSize        = static_cast<int> ( NetworkTransportProps.iBaseNetworkPacketSize );
-            bUseSequenceNumber    = ( NetworkTransportProps.eFlags == NF_WITH_COUNTER );
+            bRedundancyNegotiated = ( NetworkTransportProps.eFlags == NF_WITH_COUNTER_AND_REDUNDANCY );
+            bSeparateChannels     = ( NetworkTransportProps.eFlags == NF_WITH_COUNTER_AND_SEPARATE_CHANNELS ) && ( iNumAudioChannels == 2 );
+            bUseSequenceNumber    = ( NetworkTransportProps.eFlags == NF_WITH_COUNTER ) || bRedundancyNegotiated ||
+                                 ( NetworkTransportProps.eFlags == NF_WITH_COUNTER_AND_SEPARATE_CHANNELS );
+            iRedNumCodedBytes     = 0;
 
             if ( bUseSequenceNumber )
             {
                 iCeltNumCodedBytes = iNetwFrameSize - 1; // per definition 1 byte counter
+
+                // the audio coder argument gives the size of the optional redundant
+                // copy of the previous frame which is part of the network frame
+                if ( bRedundancyNegotiated && ( NetworkTransportProps.iAudioCodingArg > 0 ) &&
+                     ( NetworkTransportProps.iAudioCodingArg < iCeltNumCodedBytes ) )
+                {
+                    iRedNumCodedBytes = NetworkTransportProps.iAudioCodingArg;
+
+                    iCeltNumCodedBytes -= iRedNumCodedBytes;
+                }
             }
             else
             {
                 iCeltNumCodedBytes = iNetwFrameSize;
             }
 
+            bRedundancyActive = ( iRedNumCodedBytes > 0 );
+
             // update maximum number of frames for fade in counter (only needed for server)
             // and audio frame size
             if ( eAudioCompressionType == CT_OPUS )
@@ -452,14 +575,17 @@ void CChannel::OnNetTranspPropsReceived ( CNetworkTransportProps NetworkTranspor
                 // update socket buffer (the network block size is a multiple of the
                 // minimum network frame size)
                 SockBuf.SetUseDoubleSystemFrameSize ( eAudioCompressionType == CT_OPUS ); // NOTE must be set BEFORE the init()
-                SockBuf.Init ( iCeltNumCodedBytes, iCurSockBufNumFrames, bUseSequenceNumber );
+                SockBuf.SetRedundantSize ( iRedNumCodedBytes );                          // NOTE must be set BEFORE the init()
+                SockBuf.Init ( iCeltNumCodedBytes + iRedNumCodedBytes, iCurSockBufNumFrames, bUseSequenceNumber );
+                ResetLossStatistic();
             }
             MutexSocketBuf.unlock();
 
             MutexConvBuf.lock();
             {
-                // init conversion buffer
+                // init conversion buffer and the redundant copy of the previous frame
                 ConvBuf.Init ( iNetwFrameSize * iNetwFrameSizeFact, bUseSequenceNumber );
+                vecbyPrevRedData.Reset ( 0 );
             }
             MutexConvBuf.unlock();
         }
@@ -487,7 +613,18 @@ CNetworkTransportProps CChannel::GetNetworkTransportPropsFromCurrentSettings()
 
     if ( bUseSequenceNumber )
     {
-        eFlags = NF_WITH_COUNTER;
+        if ( bSeparateChannels )
+        {
+            eFlags = NF_WITH_COUNTER_AND_SEPARATE_CHANNELS;
+        }
+        else if ( bRedundancyNegotiated )
+        {
+            eFlags = NF_WITH_COUNTER_AND_REDUNDANCY;
+        }
+        else
+        {
+            eFlags = NF_WITH_COUNTER;
+        }
     }
 
     // use current stored settings of the channel to fill the network transport
@@ -498,7 +635,7 @@ CNetworkTransportProps CChannel::GetNetworkTransportPropsFromCurrentSettings()
                                     SYSTEM_SAMPLE_RATE_HZ,
                                     eAudioCompressionType,
                                     eFlags,
-                                    0 );
+                                    iRedNumCodedBytes );
 }
 
 void CChannel::Disconnect()
@@ -601,11 +738,34 @@ EPutDataStat CChannel::PutAudioData ( const CVector<uint8_t>& vecbyData, const i
 EGetDataStat CChannel::GetData ( CVector<uint8_t>& vecbyData, const int iNumBytes )
 {
     EGetDataStat eGetStatus;
+    int          iLossRatePermille = INVALID_INDEX; // no new measurement
 
     MutexSocketBuf.lock();
     {
         // the socket access must be inside a mutex
-        const bool bSockBufState = SockBuf.Get ( vecbyData, iNumBytes );
+        bool bSockBufState;
+        bool bRedundantState = false;
+
+        if ( iRedNumCodedBytes > 0 )
+        {
+            // the received frame carries the redundant copy of the previous frame
+            // after the coded data, if the frame is lost, we use the redundant copy
+            // in the following frame instead (if that one is already received)
+            bSockBufState = SockBuf.Get ( vecbyRecFrame, iNumBytes + iRedNumCodedBytes );
+
+            if ( bSockBufState )
+            {
+                std::copy ( vecbyRecFrame.begin(), vecbyRecFrame.begin() + iNumBytes, vecbyData.begin() );
+            }
+            else
+            {
+                bRedundantState = SockBuf.GetRedundant ( vecbyData );
+            }
+        }
+        else
+        {
+            bSockBufState = SockBuf.Get ( vecbyData, iNumBytes );
+        }
 
         // decrease time-out counter
         if ( iConTimeOut > 0 )
@@ -632,11 +792,40 @@ EGetDataStat CChannel::GetData ( CVector<uint8_t>& vecbyData, const int iNumByte
                     // everything is ok
                     eGetStatus = GS_BUFFER_OK;
                 }
+                else if ( bRedundantState )
+                {
+                    // the frame is lost but the redundant copy is available
+                    eGetStatus = GS_BUFFER_REDUNDANT;
+                }
                 else
                 {
                     // channel is not yet disconnected but no data in buffer
                     eGetStatus = GS_BUFFER_UNDERRUN;
                 }
+
+                // update the frame loss statistic which is reported to the other
+                // side (frames which could be reconstructed count as lost, too)
+                if ( bRedundancyNegotiated )
+                {
+                    bLossStatStarted = bLossStatStarted || bSockBufState;
+
+                    if ( bLossStatStarted )
+                    {
+                        iLossStatNumFrames++;
+
+                        if ( !bSockBufState )
+                        {
+                            iLossStatNumLost++;
+                        }
+
+                        if ( iLossStatNumFrames * iAudioFrameSizeSamples >= AUDIO_LOSS_REPORT_INTERVAL_MS * SYSTEM_SAMPLE_RATE_HZ / 1000 )
+                        {
+                            iLossRatePermille  = 1000 * iLossStatNumLost / iLossStatNumFrames;
+                            iLossStatNumFrames = 0;
+                            iLossStatNumLost   = 0;
+                        }
+                    }
+                }
             }
         }
         else
@@ -657,10 +846,20 @@ EGetDataStat CChannel::GetData ( CVector<uint8_t>& vecbyData, const int iNumByte
         emit Disconnected();
     }
 
+    // we cannot create the protocol message directly since we may be in the
+    // audio thread (see ServerAutoSockBufSizeChange)
+    if ( iLossRatePermille != INVALID_INDEX )
+    {
+        emit AudioLossRateMeasured ( iLossRatePermille );
+    }
+
     return eGetStatus;
 }
 
-void CChannel::PrepAndSendPacket ( CHighPrioSocket* pSocket, const CVector<uint8_t>& vecbyNPacket, const int iNPacketLen )
+void CChannel::PrepAndSendPacket ( CHighPrioSocket*        pSocket,
+                                   const CVector<uint8_t>& vecbyNPacket,
+                                   const int               iNPacketLen,
+                                   const CVector<uint8_t>& vecbyNRedPacket )
 {
     // From v3.8.0 onwards, a server will not send audio to a client until that client has sent channel info.
     // This addresses #1243 but means that clients earlier than v3.3.0 (24 Feb 2013) will no longer be compatible.
@@ -671,6 +870,22 @@ void CChannel::PrepAndSendPacket ( CHighPrioSocket* pSocket, const CVector<uint8
 
     QMutexLocker locker ( &MutexConvBuf );
 
+    if ( iRedNumCodedBytes > 0 )
+    {
+        // append the redundant copy of the previous frame to the coded frame and
+        // keep the redundant copy of the current frame for the next one
+        std::copy ( vecbyNPacket.begin(), vecbyNPacket.begin() + iNPacketLen, vecbyNetwFrame.begin() );
+        std::copy ( vecbyPrevRedData.begin(), vecbyPrevRedData.begin() + iRedNumCodedBytes, vecbyNetwFrame.begin() + iNPacketLen );
+        std::copy ( vecbyNRedPacket.begin(), vecbyNRedPacket.begin() + iRedNumCodedBytes, vecbyPrevRedData.begin() );
+
+        if ( ConvBuf.Put ( vecbyNetwFrame, iNPacketLen + iRedNumCodedBytes, iSendSequenceNumber++ ) )
+        {
+            pSocket->SendPacket ( ConvBuf.GetAll(), GetAddress() );
+        }
+
+        return;
+    }
+
     // use conversion buffer to convert sound card block size in network
     // block size and take care of optional sequence number (note that
     // the sequence number wraps automatically)
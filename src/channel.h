@@ -27,6 +27,7 @@
 #include <QThread>
 #include <QDateTime>
 #include <QFile>
+#include <QHash>
 #if QT_VERSION >= QT_VERSION_CHECK( 5, 6, 0 )
 #    include <QVersionNumber>
 #endif
@@ -46,6 +47,14 @@
 #define FADE_IN_NUM_FRAMES                2250
 #define FADE_IN_NUM_FRAMES_DBLE_FRAMESIZE 1125
 
+// the redundant copy of the previous frame is coded with this fraction of the
+// number of coded bytes of the frame (but at least with the CELT minimum)
+#define REDUNDANT_FRAME_SIZE_DIV 2
+
+// measurement interval of the audio frame loss rate which is reported to the
+// other side if redundant frames are negotiated
+#define AUDIO_LOSS_REPORT_INTERVAL_MS 2000 // ms
+
 enum EPutDataStat
 {
     PS_GEN_ERROR,
@@ -74,7 +83,10 @@ public:
 
     EGetDataStat GetData ( CVector<uint8_t>& vecbyData, const int iNumBytes );
 
-    void PrepAndSendPacket ( CHighPrioSocket* pSocket, const CVector<uint8_t>& vecbyNPacket, const int iNPacketLen );
+    void PrepAndSendPacket ( CHighPrioSocket*        pSocket,
+                             const CVector<uint8_t>& vecbyNPacket,
+                             const int               iNPacketLen,
+                             const CVector<uint8_t>& vecbyNRedPacket );
 
     void ResetTimeOutCounter() { iConTimeOut = iConTimeOutStartVal; }
     bool IsConnected() const { return iConTimeOut > 0; }
@@ -99,6 +111,7 @@ public:
 
     void CreateReqChanInfoMes() { Protocol.CreateReqChanInfoMes(); }
     void CreateVersionAndOSMes() { Protocol.CreateVersionAndOSMes(); }
+    void CreateNetwTranspFeaturesMes() { Protocol.CreateNetwTranspFeaturesMes ( NTF_REDUNDANCY | NTF_SEPARATE_CHANNELS ); }
     void CreateMuteStateHasChangedMes ( const int iChanID, const bool bIsMuted ) { Protocol.CreateMuteStateHasChangedMes ( iChanID, bIsMuted ); }
 
     void  SetGain ( const int iChanID, const float fNewGain );
@@ -108,6 +121,9 @@ public:
     void  SetPan ( const int iChanID, const float fNewPan );
     float GetPan ( const int iChanID );
 
+    void ResetGainsPans();
+    void GetGainsPans ( const CVector<int>& vecChanIDs, const int iNumChans, CVector<float>& vecfGainsOut, CVector<float>& vecfPansOut );
+
     void SetRemoteChanGain ( const int iId, const float fGain ) { Protocol.CreateChanGainMes ( iId, fGain ); }
 
     void SetRemoteChanPan ( const int iId, const float fPan ) { Protocol.CreateChanPanMes ( iId, fPan ); }
@@ -123,7 +139,8 @@ public:
     void SetAudioStreamProperties ( const EAudComprType eNewAudComprType,
                                     const int           iNewNetwFrameSize,
                                     const int           iNewNetwFrameSizeFact,
-                                    const int           iNewNumAudioChannels );
+                                    const int           iNewNumAudioChannels,
+                                    const bool          bNewSeparateChannels );
 
     void SetDoAutoSockBufSize ( const bool bValue ) { bDoAutoSockBufSize = bValue; }
 
@@ -131,6 +148,20 @@ public:
 
     int GetNetwFrameSizeFact() const { return iNetwFrameSizeFact; }
     int GetCeltNumCodedBytes() const { return iCeltNumCodedBytes; }
+    int GetRedNumCodedBytes() const { return iRedNumCodedBytes; }
+
+    // redundant frame transmission (client): the support is negotiated with the
+    // server if enabled, the redundant frames are only sent if set active
+    void SetEnableRedundancy ( const bool bNEnable ) { bRedundancyEnabled = bNEnable; }
+    bool GetRedundancyNegotiated() const { return bRedundancyNegotiated; }
+    void SetRedundancyActive ( const bool bNActive );
+
+    // separately coded audio channels: the client negotiates the support with the
+    // server if enabled and codes the channels separately in stereo mode, the
+    // server shows the second channel as a channel of its own
+    void SetEnableSeparateChannels ( const bool bNEnable ) { bSeparateChannelsEnabled = bNEnable; }
+    bool GetSeparateChannelsNegotiated() const { return bSeparateChannelsNegotiated; }
+    bool GetSeparateChannels() const { return bSeparateChannels; }
 
     void GetBufErrorRates ( CVector<double>& vecErrRates, double& dLimit, double& dMaxUpLimit )
     {
@@ -165,6 +196,14 @@ public:
 
     void CreateRecorderStateMes ( const ERecorderState eRecorderState ) { Protocol.CreateRecorderStateMes ( eRecorderState ); }
 
+    void CreateAudioLossRateMes ( const int iLossRatePermille )
+    {
+        if ( ProtocolIsEnabled() && bRedundancyNegotiated && !bSeparateChannels )
+        {
+            Protocol.CreateAudioLossRateMes ( iLossRatePermille );
+        }
+    }
+
     CNetworkTransportProps GetNetworkTransportPropsFromCurrentSettings();
 
     double UpdateAndGetLevelForMeterdB ( const CVector<short>& vecsAudio, const int iInSize, const bool bIsStereoIn );
@@ -183,6 +222,18 @@ protected:
         iCeltNumCodedBytes    = CELT_MINIMUM_NUM_BYTES;
         iNumAudioChannels     = 1; // mono
         bUseSequenceNumber    = false;
+        bRedundancyNegotiated = false;
+        bRedundancyActive     = false;
+        iRedNumCodedBytes     = 0;
+        bSeparateChannels     = false;
+    }
+
+    void ResetLossStatistic()
+    {
+        // the frames before the first received frame are not counted
+        bLossStatStarted   = false;
+        iLossStatNumFrames = 0;
+        iLossStatNumLost   = 0;
     }
 
     // connection parameters
@@ -191,9 +242,10 @@ protected:
     // channel info
     CChannelCoreInfo ChannelInfo;
 
-    // mixer and effect settings
-    CVector<float> vecfGains;
-    CVector<float> vecfPannings;
+    // mixer and effect settings (sparse: only gains/pans which differ from
+    // unity gain and centre pan are stored)
+    QHash<int, float> mapGains;
+    QHash<int, float> mapPannings;
 
     // network jitter-buffer
     CNetBufWithStats SockBuf;
@@ -202,6 +254,23 @@ protected:
     bool             bUseSequenceNumber;
     uint8_t          iSendSequenceNumber;
 
+    // redundant frame transmission and frame loss statistic
+    bool             bRedundancyEnabled;
+    bool             bRedundancyNegotiated;
+    bool             bRedundancyActive;
+    int              iRedNumCodedBytes;
+    CVector<uint8_t> vecbyNetwFrame;
+    CVector<uint8_t> vecbyPrevRedData;
+    CVector<uint8_t> vecbyRecFrame;
+    bool             bLossStatStarted;
+    int              iLossStatNumFrames;
+    int              iLossStatNumLost;
+
+    // separately coded audio channels
+    bool bSeparateChannelsEnabled;
+    bool bSeparateChannelsNegotiated;
+    bool bSeparateChannels;
+
     // network output conversion buffer
     CConvBuf<uint8_t> ConvBuf;
 
@@ -243,6 +312,7 @@ public slots:
     void OnSplitMessSupported() { Protocol.SetSplitMessageSupported ( true ); }
 
     void OnVersionAndOSReceived ( COSUtil::EOpSystemType eOSType, QString strVersion );
+    void OnNetwTranspFeaturesReceived ( int iFeatures );
 
     void OnParseMessageBody ( CVector<uint8_t> vecbyMesBodyData, int iRecCounter, int iRecID )
     {
@@ -280,6 +350,9 @@ signals:
     void LicenceRequired ( ELicenceType eLicenceType );
     void VersionAndOSReceived ( COSUtil::EOpSystemType eOSType, QString strVersion );
     void RecorderStateReceived ( ERecorderState eRecorderState );
+    void AudioLossRateMeasured ( int iLossRatePermille );
+    void AudioLossRateReceived ( int iLossRatePermille );
+    void NetwTranspFeaturesNegotiated();
     void Disconnected();
 
     void DetectedCLMessage ( CVector<uint8_t> vecbyMesBodyData, int iRecID, CHostAddress RecHostAddr );
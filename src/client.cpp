@@ -23,6 +23,9 @@
 \******************************************************************************/
 
 #include "client.h"
+#if defined( Q_OS_LINUX )
+#    include <pthread.h>
+#endif
 
 /* Implementation *************************************************************/
 CClient::CClient ( const quint16  iPortNumber,
@@ -32,31 +35,50 @@ CClient::CClient ( const quint16  iPortNumber,
                    const bool     bNoAutoJackConnect,
                    const QString& strNClientName,
                    const bool     bNEnableIPv6,
-                   const bool     bNMuteMeInPersonalMix ) :
+                   const bool     bNMuteMeInPersonalMix,
+                   const bool     bNUseNetworkThread,
+                   const bool     bNUseLatencyProbe,
+                   const bool     bNUseRedundancy,
+                   const bool     bNUseSeparateInputs,
+                   const QString& strSoundFileSetup ) :
     ChannelInfo(),
     strClientName ( strNClientName ),
     Channel ( false ), /* we need a client channel -> "false" */
     CurOpusEncoder ( nullptr ),
+    CurOpusEncoderRight ( nullptr ),
+    CurOpusRedEncoder ( nullptr ),
     CurOpusDecoder ( nullptr ),
     eAudioCompressionType ( CT_OPUS ),
     iCeltNumCodedBytes ( OPUS_NUM_BYTES_MONO_LOW_QUALITY ),
     iOPUSFrameSizeSamples ( DOUBLE_SYSTEM_FRAME_SIZE_SAMPLES ),
-    eAudioQuality ( AQ_NORMAL ),
     eAudioChannelConf ( CC_MONO ),
     iNumAudioChannels ( 1 ),
+    bSeparateInputs ( false ),
+    iSepNumCodedBytes ( 0 ),
     bIsInitializationPhase ( true ),
-    bMuteOutStream ( false ),
-    fMuteOutStreamGain ( 1.0f ),
     Socket ( &Channel, iPortNumber, iQosNumber, "", bNEnableIPv6 ),
     Sound ( AudioCallback, this, strMIDISetup, bNoAutoJackConnect, strNClientName ),
-    iAudioInFader ( AUD_FADER_IN_MIDDLE ),
+    AudioParams(),
     bReverbOnLeftChan ( false ),
-    iReverbLevel ( 0 ),
-    iInputBoost ( 1 ),
+    iStreamPropsVersion ( 0 ),
+    iStreamPropsAppliedVersion ( 0 ),
     iSndCrdPrefFrameSizeFactor ( FRAME_SIZE_FACTOR_DEFAULT ),
     iSndCrdFrameSizeFactor ( FRAME_SIZE_FACTOR_DEFAULT ),
     bSndCrdConversionBufferRequired ( false ),
     iSndCardMonoBlockSizeSamConvBuff ( 0 ),
+    bUseNetworkThread ( bNUseNetworkThread ),
+    NetworkThread ( this ),
+    iNetwThreadLeadMinSam ( 0 ),
+    iNetwThreadLeadMeasCnt ( 0 ),
+    iNetwThreadLeadTimeMs ( -1 ),
+    iNetwThreadNumUnderruns ( 0 ),
+    bUseLatencyProbe ( bNUseLatencyProbe ),
+    LatencyProbe(),
+    bUseRedundancy ( bNUseRedundancy ),
+    iUpLossRatePermille ( 0 ),
+    iDownLossRatePermille ( 0 ),
+    iRedundancyOffCnt ( 0 ),
+    bUseSeparateInputs ( bNUseSeparateInputs ),
     bFraSiFactPrefSupported ( false ),
     bFraSiFactDefSupported ( false ),
     bFraSiFactSafeSupported ( false ),
@@ -68,8 +90,19 @@ CClient::CClient ( const quint16  iPortNumber,
     bEnableIPv6 ( bNEnableIPv6 ),
     bMuteMeInPersonalMix ( bNMuteMeInPersonalMix ),
     iServerSockBufNumFrames ( DEF_NET_BUF_SIZE_NUM_BL ),
+    iCurPingTime ( -1 ),
     pSignalHandler ( CSignalHandler::getSingletonP() )
 {
+#ifdef WITH_FILE_SOUND
+    // the sound file setup must be known before the sound interface is initialized
+    Sound.SetFileSetup ( strSoundFileSetup );
+#else
+    Q_UNUSED ( strSoundFileSetup )
+#endif
+
+    // the audio processing starts with the default settings
+    AudioParamsBuffer.Publish ( AudioParams );
+
     int iOpusError;
 
     OpusMode = opus_custom_mode_create ( SYSTEM_SAMPLE_RATE_HZ, DOUBLE_SYSTEM_FRAME_SIZE_SAMPLES, &iOpusError );
@@ -86,25 +119,62 @@ CClient::CClient ( const quint16  iPortNumber,
     Opus64EncoderStereo = opus_custom_encoder_create ( Opus64Mode, 2, &iOpusError ); // stereo encoder OPUS64
     Opus64DecoderStereo = opus_custom_decoder_create ( Opus64Mode, 2, &iOpusError ); // stereo decoder OPUS64
 
+    // init audio encoders for the redundant frames
+    OpusRedEncoderMono     = opus_custom_encoder_create ( OpusMode, 1, &iOpusError );
+    OpusRedEncoderStereo   = opus_custom_encoder_create ( OpusMode, 2, &iOpusError );
+    Opus64RedEncoderMono   = opus_custom_encoder_create ( Opus64Mode, 1, &iOpusError );
+    Opus64RedEncoderStereo = opus_custom_encoder_create ( Opus64Mode, 2, &iOpusError );
+
+    // init audio encoders for the right input of the separately coded inputs
+    OpusEncoderMonoRight   = opus_custom_encoder_create ( OpusMode, 1, &iOpusError );
+    Opus64EncoderMonoRight = opus_custom_encoder_create ( Opus64Mode, 1, &iOpusError );
+
     // we require a constant bit rate
     opus_custom_encoder_ctl ( OpusEncoderMono, OPUS_SET_VBR ( 0 ) );
     opus_custom_encoder_ctl ( OpusEncoderStereo, OPUS_SET_VBR ( 0 ) );
     opus_custom_encoder_ctl ( Opus64EncoderMono, OPUS_SET_VBR ( 0 ) );
     opus_custom_encoder_ctl ( Opus64EncoderStereo, OPUS_SET_VBR ( 0 ) );
+    opus_custom_encoder_ctl ( OpusRedEncoderMono, OPUS_SET_VBR ( 0 ) );
+    opus_custom_encoder_ctl ( OpusRedEncoderStereo, OPUS_SET_VBR ( 0 ) );
+    opus_custom_encoder_ctl ( Opus64RedEncoderMono, OPUS_SET_VBR ( 0 ) );
+    opus_custom_encoder_ctl ( Opus64RedEncoderStereo, OPUS_SET_VBR ( 0 ) );
+    opus_custom_encoder_ctl ( OpusEncoderMonoRight, OPUS_SET_VBR ( 0 ) );
+    opus_custom_encoder_ctl ( Opus64EncoderMonoRight, OPUS_SET_VBR ( 0 ) );
 
     // for 64 samples frame size we have to adjust the PLC behavior to avoid loud artifacts
     opus_custom_encoder_ctl ( Opus64EncoderMono, OPUS_SET_PACKET_LOSS_PERC ( 35 ) );
     opus_custom_encoder_ctl ( Opus64EncoderStereo, OPUS_SET_PACKET_LOSS_PERC ( 35 ) );
+    opus_custom_encoder_ctl ( Opus64EncoderMonoRight, OPUS_SET_PACKET_LOSS_PERC ( 35 ) );
 
     // we want as low delay as possible
     opus_custom_encoder_ctl ( OpusEncoderMono, OPUS_SET_APPLICATION ( OPUS_APPLICATION_RESTRICTED_LOWDELAY ) );
     opus_custom_encoder_ctl ( OpusEncoderStereo, OPUS_SET_APPLICATION ( OPUS_APPLICATION_RESTRICTED_LOWDELAY ) );
     opus_custom_encoder_ctl ( Opus64EncoderMono, OPUS_SET_APPLICATION ( OPUS_APPLICATION_RESTRICTED_LOWDELAY ) );
     opus_custom_encoder_ctl ( Opus64EncoderStereo, OPUS_SET_APPLICATION ( OPUS_APPLICATION_RESTRICTED_LOWDELAY ) );
+    opus_custom_encoder_ctl ( OpusRedEncoderMono, OPUS_SET_APPLICATION ( OPUS_APPLICATION_RESTRICTED_LOWDELAY ) );
+    opus_custom_encoder_ctl ( OpusRedEncoderStereo, OPUS_SET_APPLICATION ( OPUS_APPLICATION_RESTRICTED_LOWDELAY ) );
+    opus_custom_encoder_ctl ( Opus64RedEncoderMono, OPUS_SET_APPLICATION ( OPUS_APPLICATION_RESTRICTED_LOWDELAY ) );
+    opus_custom_encoder_ctl ( Opus64RedEncoderStereo, OPUS_SET_APPLICATION ( OPUS_APPLICATION_RESTRICTED_LOWDELAY ) );
+    opus_custom_encoder_ctl ( OpusEncoderMonoRight, OPUS_SET_APPLICATION ( OPUS_APPLICATION_RESTRICTED_LOWDELAY ) );
+    opus_custom_encoder_ctl ( Opus64EncoderMonoRight, OPUS_SET_APPLICATION ( OPUS_APPLICATION_RESTRICTED_LOWDELAY ) );
+
+    // the redundant frames replace a lost frame, so they must not depend on the
+    // previous frame of the redundant stream which is not decoded by the receiver
+    opus_custom_encoder_ctl ( OpusRedEncoderMono, CELT_SET_PREDICTION_REQUEST, 0 );
+    opus_custom_encoder_ctl ( OpusRedEncoderStereo, CELT_SET_PREDICTION_REQUEST, 0 );
+    opus_custom_encoder_ctl ( Opus64RedEncoderMono, CELT_SET_PREDICTION_REQUEST, 0 );
+    opus_custom_encoder_ctl ( Opus64RedEncoderStereo, CELT_SET_PREDICTION_REQUEST, 0 );
 
     // set encoder low complexity for legacy 128 samples frame size
     opus_custom_encoder_ctl ( OpusEncoderMono, OPUS_SET_COMPLEXITY ( 1 ) );
     opus_custom_encoder_ctl ( OpusEncoderStereo, OPUS_SET_COMPLEXITY ( 1 ) );
+    opus_custom_encoder_ctl ( OpusRedEncoderMono, OPUS_SET_COMPLEXITY ( 1 ) );
+    opus_custom_encoder_ctl ( OpusRedEncoderStereo, OPUS_SET_COMPLEXITY ( 1 ) );
+    opus_custom_encoder_ctl ( OpusEncoderMonoRight, OPUS_SET_COMPLEXITY ( 1 ) );
+
+    // the redundancy support is negotiated with the server on connection
+    Channel.SetEnableRedundancy ( bUseRedundancy );
+    Channel.SetEnableSeparateChannels ( bUseSeparateInputs );
 
     // Connections -------------------------------------------------------------
     // connections for the protocol mechanism
@@ -137,12 +207,23 @@ CClient::CClient ( const quint16  iPortNumber,
 
     QObject::connect ( &Channel, &CChannel::RecorderStateReceived, this, &CClient::RecorderStateReceived );
 
+    QObject::connect ( &Channel, &CChannel::AudioLossRateReceived, this, &CClient::OnAudioLossRateReceived );
+
+    QObject::connect ( &Channel, &CChannel::AudioLossRateMeasured, this, &CClient::OnAudioLossRateMeasured );
+
+    // the separately coded inputs depend on the features negotiated with the server
+    QObject::connect ( &Channel, &CChannel::NetwTranspFeaturesNegotiated, this, &CClient::PrepareAudioCoding );
+
     QObject::connect ( &ConnLessProtocol, &CProtocol::CLMessReadyForSending, this, &CClient::OnSendCLProtMessage );
 
     QObject::connect ( &ConnLessProtocol, &CProtocol::CLServerListReceived, this, &CClient::CLServerListReceived );
 
     QObject::connect ( &ConnLessProtocol, &CProtocol::CLRedServerListReceived, this, &CClient::CLRedServerListReceived );
 
+    QObject::connect ( &ConnLessProtocol, &CProtocol::CLServerListPageReceived, this, &CClient::CLServerListPageReceived );
+
+    QObject::connect ( &ConnLessProtocol, &CProtocol::CLServerListDiffReceived, this, &CClient::CLServerListDiffReceived );
+
     QObject::connect ( &ConnLessProtocol, &CProtocol::CLConnClientsListMesReceived, this, &CClient::CLConnClientsListMesReceived );
 
     QObject::connect ( &ConnLessProtocol, &CProtocol::CLPingReceived, this, &CClient::OnCLPingReceived );
@@ -200,6 +281,8 @@ CClient::~CClient()
         Sound.Stop();
     }
 
+    NetworkThread.Stop();
+
     // free audio encoders and decoders
     opus_custom_encoder_destroy ( OpusEncoderMono );
     opus_custom_decoder_destroy ( OpusDecoderMono );
@@ -209,6 +292,12 @@ CClient::~CClient()
     opus_custom_decoder_destroy ( Opus64DecoderMono );
     opus_custom_encoder_destroy ( Opus64EncoderStereo );
     opus_custom_decoder_destroy ( Opus64DecoderStereo );
+    opus_custom_encoder_destroy ( Opus64RedEncoderMono );
+    opus_custom_encoder_destroy ( Opus64RedEncoderStereo );
+    opus_custom_encoder_destroy ( OpusRedEncoderMono );
+    opus_custom_encoder_destroy ( OpusRedEncoderStereo );
+    opus_custom_encoder_destroy ( Opus64EncoderMonoRight );
+    opus_custom_encoder_destroy ( OpusEncoderMonoRight );
 
     // free audio modes
     opus_custom_mode_destroy ( OpusMode );
@@ -400,6 +489,50 @@ void CClient::OnCLPingReceived ( CHostAddress InetAddr, int iMs )
     }
 }
 
+void CClient::OnAudioLossRateReceived ( int iLossRatePermille )
+{
+    // loss rate of our frames measured by the server
+    iUpLossRatePermille = iLossRatePermille;
+
+    UpdateRedundancy();
+}
+
+void CClient::OnAudioLossRateMeasured ( int iLossRatePermille )
+{
+    // loss rate of the frames of the server measured by us
+    iDownLossRatePermille = iLossRatePermille;
+
+    UpdateRedundancy();
+}
+
+void CClient::UpdateRedundancy()
+{
+    // The redundant frames are used in both directions, so the worse direction
+    // decides. Since switching causes a short dropout, the redundancy is switched
+    // on immediately but only switched off after a longer time with a low loss rate.
+    const int iLossRatePermille = std::max ( iUpLossRatePermille, iDownLossRatePermille );
+
+    if ( iLossRatePermille >= REDUNDANCY_ON_LOSS_PERMILLE )
+    {
+        iRedundancyOffCnt = 0;
+        Channel.SetRedundancyActive ( true );
+    }
+    else if ( iLossRatePermille <= REDUNDANCY_OFF_LOSS_PERMILLE )
+    {
+        iRedundancyOffCnt++;
+
+        if ( iRedundancyOffCnt >= REDUNDANCY_OFF_NUM_REPORTS )
+        {
+            iRedundancyOffCnt = 0;
+            Channel.SetRedundancyActive ( false );
+        }
+    }
+    else
+    {
+        iRedundancyOffCnt = 0;
+    }
+}
+
 void CClient::OnCLPingWithNumClientsReceived ( CHostAddress InetAddr, int iMs, int iNumClients )
 {
     // take care of wrap arounds (if wrapping, do not use result)
@@ -459,7 +592,8 @@ void CClient::SetRemoteChanGain ( const int iId, const float fGain, const bool b
     // if this gain is for my own channel, apply the value for the Mute Myself function
     if ( bIsMyOwnFader )
     {
-        fMuteOutStreamGain = fGain;
+        AudioParams.fMuteOutStreamGain = fGain;
+        AudioParamsBuffer.Publish ( AudioParams );
     }
 
     if ( TimerGainOrPan.isActive() )
@@ -656,46 +790,6 @@ void CClient::SetEnableOPUS64 ( const bool eNEnableOPUS64 )
     }
 }
 
-void CClient::SetAudioQuality ( const EAudioQuality eNAudioQuality )
-{
-    // init with new parameter, if client was running then first
-    // stop it and restart again after new initialization
-    const bool bWasRunning = Sound.IsRunning();
-    if ( bWasRunning )
-    {
-        Sound.Stop();
-    }
-
-    // set new parameter
-    eAudioQuality = eNAudioQuality;
-    Init();
-
-    if ( bWasRunning )
-    {
-        Sound.Start();
-    }
-}
-
-void CClient::SetAudioChannels ( const EAudChanConf eNAudChanConf )
-{
-    // init with new parameter, if client was running then first
-    // stop it and restart again after new initialization
-    const bool bWasRunning = Sound.IsRunning();
-    if ( bWasRunning )
-    {
-        Sound.Stop();
-    }
-
-    // set new parameter
-    eAudioChannelConf = eNAudChanConf;
-    Init();
-
-    if ( bWasRunning )
-    {
-        Sound.Start();
-    }
-}
-
 QString CClient::SetSndCrdDev ( const QString strNewDev )
 {
     // if client was running then first
@@ -974,9 +1068,20 @@ void CClient::Start()
     // initialise client channels
     ClearClientChannels();
 
+    // the redundancy is off on a new connection until its loss rates are reported
+    iUpLossRatePermille   = 0;
+    iDownLossRatePermille = 0;
+    iRedundancyOffCnt     = 0;
+
     // enable channel
     Channel.SetEnable ( true );
 
+    // the network thread must be running before the sound card delivers data
+    if ( bUseNetworkThread )
+    {
+        NetworkThread.Start();
+    }
+
     // start audio interface
     Sound.Start();
 
@@ -991,6 +1096,8 @@ void CClient::Stop()
     // stop audio interface
     Sound.Stop();
 
+    NetworkThread.Stop();
+
     // disable channel
     Channel.SetEnable ( false );
 
@@ -1027,6 +1134,9 @@ void CClient::Stop()
 
 void CClient::Init()
 {
+    // the network thread must not process audio data while the settings change
+    QMutexLocker locker ( &MutexNetworkThread );
+
     // check if possible frame size factors are supported
     const int iFraSizePreffered = SYSTEM_FRAME_SIZE_SAMPLES * FRAME_SIZE_FACTOR_PREFERRED;
     const int iFraSizeDefault   = SYSTEM_FRAME_SIZE_SAMPLES * FRAME_SIZE_FACTOR_DEFAULT;
@@ -1111,142 +1221,296 @@ void CClient::Init()
         }
     }
 
-    // inits for audio coding
+    // calculate stereo (two channels) buffer size
+    iStereoBlockSizeSam = 2 * iMonoBlockSizeSam;
+
+    vecCeltData.Init ( OPUS_MAX_NUM_BYTES );
+    vecRedCeltData.Init ( OPUS_MAX_NUM_BYTES ); // the redundant frame is never larger than the frame
+    vecbyNetwData.Init ( OPUS_MAX_NUM_BYTES );
+    vecfSepEncIn.Init ( 2 * DOUBLE_SYSTEM_FRAME_SIZE_SAMPLES );
+    vecZeros.Init ( iStereoBlockSizeSam, 0 );
+    vecfStereoSndCrdMuteStream.Init ( iStereoBlockSizeSam );
+
+    // the sound card is stopped, so the current settings can be taken over here
+    const CClientAudioParams& Params = AudioParamsBuffer.Get();
+
+    bReverbOnLeftChan = Params.bReverbOnLeftChan;
+
+    PrepareAudioCoding();
+    ApplyAudioCoding ( StreamPropsBuffer.Get() );
+
+    // init reverberation
+    AudioReverb.Init ( eAudioChannelConf, iStereoBlockSizeSam, SYSTEM_SAMPLE_RATE_HZ );
+
+    // the gains start with the current settings
+    InputBoostGain.Init ( iMonoBlockSizeSam, SYSTEM_SAMPLE_RATE_HZ, AUDIO_GAIN_SMOOTHING_TIME_MS );
+    ReverbGain.Init ( iMonoBlockSizeSam, SYSTEM_SAMPLE_RATE_HZ, AUDIO_GAIN_SMOOTHING_TIME_MS );
+    PanGainLeft.Init ( iMonoBlockSizeSam, SYSTEM_SAMPLE_RATE_HZ, AUDIO_GAIN_SMOOTHING_TIME_MS );
+    PanGainRight.Init ( iMonoBlockSizeSam, SYSTEM_SAMPLE_RATE_HZ, AUDIO_GAIN_SMOOTHING_TIME_MS );
+    TransmitGain.Init ( iMonoBlockSizeSam, SYSTEM_SAMPLE_RATE_HZ, AUDIO_GAIN_SMOOTHING_TIME_MS );
+    MuteOutStreamGain.Init ( iMonoBlockSizeSam, SYSTEM_SAMPLE_RATE_HZ, AUDIO_GAIN_SMOOTHING_TIME_MS );
+
+    // init the sound card conversion buffers
+    if ( bSndCrdConversionBufferRequired )
+    {
+        // inits for conversion buffer (the size of the conversion buffer must
+        // be the sum of input/output sizes which is the worst case fill level)
+        const int iSndCardStereoBlockSizeSamConvBuff = 2 * iSndCardMonoBlockSizeSamConvBuff;
+        const int iConBufSize                        = iStereoBlockSizeSam + iSndCardStereoBlockSizeSamConvBuff;
+
+        SndCrdConversionBufferIn.Init ( iConBufSize );
+        SndCrdConversionBufferOut.Init ( iConBufSize );
+        vecDataConvBuf.Init ( iStereoBlockSizeSam );
+
+        // the output conversion buffer must be filled with the inner
+        // block size for initialization (this is the latency which is
+        // introduced by the conversion buffer) to avoid buffer underruns
+        SndCrdConversionBufferOut.Put ( vecZeros, iStereoBlockSizeSam );
+    }
+
+    // init the buffers of the network thread mode
+    if ( bUseNetworkThread )
+    {
+        const int iSndCrdStereoBlockSizeSam = 2 * GetSndCrdActualMonoBlSize();
+        const int iNetwThreadBufSize        = NETW_THREAD_BUFFER_NUM_BLOCKS * std::max ( iSndCrdStereoBlockSizeSam, iStereoBlockSizeSam );
+
+        NetwThreadBufferIn.Init ( iNetwThreadBufSize );
+        NetwThreadBufferOut.Init ( iNetwThreadBufSize );
+        vecNetwThreadData.Init ( iStereoBlockSizeSam );
+
+        // The sound card callback gets the output of the previous block from the
+        // network thread, so the output buffer is filled with one sound card block
+        // for initialization. If the network thread processes other blocks than
+        // the sound card delivers, a second block must be waited for (same as
+        // for the sound card conversion buffer).
+        const int iNetwThreadPrefillSize = iSndCrdStereoBlockSizeSam + ( bSndCrdConversionBufferRequired ? iStereoBlockSizeSam : 0 );
+
+        NetwThreadBufferOut.Put ( CVector<float> ( iNetwThreadPrefillSize, 0.0f ), iNetwThreadPrefillSize );
+
+        iNetwThreadLeadMinSam  = iNetwThreadBufSize;
+        iNetwThreadLeadMeasCnt = 0;
+        iNetwThreadLeadTimeMs  = -1;
+    }
+
+    // reset initialization phase flag and mute flag
+    bIsInitializationPhase = true;
+}
+
+void CClient::PrepareAudioCoding()
+{
+    // Selects the audio coding for the current audio quality and audio channels
+    // and the compression type which is set by Init(). This runs in the thread of
+    // this object, the audio processing takes the selection over at the next block
+    // boundary, therefore the coded data buffers are not resized here. The channel
+    // restarts its network stream with the new frame size which causes a short
+    // dropout of the received audio.
+    CClientStreamProps StreamProps;
+
+    StreamProps.eAudComprType      = eAudioCompressionType;
+    StreamProps.iNetwFrameSizeFact = iSndCrdFrameSizeFactor;
+    StreamProps.eAudioChannelConf  = AudioParams.eAudioChannelConf;
+
+    // the separately coded inputs are used as soon as the server supports them
+    StreamProps.bSeparateChannels = ( AudioParams.eAudioChannelConf == CC_STEREO ) && Channel.GetSeparateChannelsNegotiated();
+
     if ( eAudioCompressionType == CT_OPUS )
     {
-        iOPUSFrameSizeSamples = DOUBLE_SYSTEM_FRAME_SIZE_SAMPLES;
+        StreamProps.iOPUSFrameSizeSamples = DOUBLE_SYSTEM_FRAME_SIZE_SAMPLES;
 
-        if ( eAudioChannelConf == CC_MONO )
+        if ( AudioParams.eAudioChannelConf == CC_MONO )
         {
-            CurOpusEncoder    = OpusEncoderMono;
-            CurOpusDecoder    = OpusDecoderMono;
-            iNumAudioChannels = 1;
+            StreamProps.pOpusEncoder      = OpusEncoderMono;
+            StreamProps.pOpusRedEncoder   = OpusRedEncoderMono;
+            StreamProps.pOpusDecoder      = OpusDecoderMono;
+            StreamProps.iNumAudioChannels = 1;
 
-            switch ( eAudioQuality )
+            switch ( AudioParams.eAudioQuality )
             {
             case AQ_LOW:
-                iCeltNumCodedBytes = OPUS_NUM_BYTES_MONO_LOW_QUALITY_DBLE_FRAMESIZE;
+                StreamProps.iCeltNumCodedBytes = OPUS_NUM_BYTES_MONO_LOW_QUALITY_DBLE_FRAMESIZE;
                 break;
             case AQ_NORMAL:
-                iCeltNumCodedBytes = OPUS_NUM_BYTES_MONO_NORMAL_QUALITY_DBLE_FRAMESIZE;
+                StreamProps.iCeltNumCodedBytes = OPUS_NUM_BYTES_MONO_NORMAL_QUALITY_DBLE_FRAMESIZE;
                 break;
             case AQ_HIGH:
-                iCeltNumCodedBytes = OPUS_NUM_BYTES_MONO_HIGH_QUALITY_DBLE_FRAMESIZE;
+                StreamProps.iCeltNumCodedBytes = OPUS_NUM_BYTES_MONO_HIGH_QUALITY_DBLE_FRAMESIZE;
                 break;
             }
         }
         else
         {
-            CurOpusEncoder    = OpusEncoderStereo;
-            CurOpusDecoder    = OpusDecoderStereo;
-            iNumAudioChannels = 2;
+            StreamProps.pOpusEncoder      = OpusEncoderStereo;
+            StreamProps.pOpusRedEncoder   = OpusRedEncoderStereo;
+            StreamProps.pOpusDecoder      = OpusDecoderStereo;
+            StreamProps.iNumAudioChannels = 2;
 
-            switch ( eAudioQuality )
+            switch ( AudioParams.eAudioQuality )
             {
             case AQ_LOW:
-                iCeltNumCodedBytes = OPUS_NUM_BYTES_STEREO_LOW_QUALITY_DBLE_FRAMESIZE;
+                StreamProps.iCeltNumCodedBytes = OPUS_NUM_BYTES_STEREO_LOW_QUALITY_DBLE_FRAMESIZE;
                 break;
             case AQ_NORMAL:
-                iCeltNumCodedBytes = OPUS_NUM_BYTES_STEREO_NORMAL_QUALITY_DBLE_FRAMESIZE;
+                StreamProps.iCeltNumCodedBytes = OPUS_NUM_BYTES_STEREO_NORMAL_QUALITY_DBLE_FRAMESIZE;
                 break;
             case AQ_HIGH:
-                iCeltNumCodedBytes = OPUS_NUM_BYTES_STEREO_HIGH_QUALITY_DBLE_FRAMESIZE;
+                StreamProps.iCeltNumCodedBytes = OPUS_NUM_BYTES_STEREO_HIGH_QUALITY_DBLE_FRAMESIZE;
                 break;
             }
         }
     }
     else /* CT_OPUS64 */
     {
-        iOPUSFrameSizeSamples = SYSTEM_FRAME_SIZE_SAMPLES;
+        StreamProps.iOPUSFrameSizeSamples = SYSTEM_FRAME_SIZE_SAMPLES;
 
-        if ( eAudioChannelConf == CC_MONO )
+        if ( AudioParams.eAudioChannelConf == CC_MONO )
         {
-            CurOpusEncoder    = Opus64EncoderMono;
-            CurOpusDecoder    = Opus64DecoderMono;
-            iNumAudioChannels = 1;
+            StreamProps.pOpusEncoder      = Opus64EncoderMono;
+            StreamProps.pOpusRedEncoder   = Opus64RedEncoderMono;
+            StreamProps.pOpusDecoder      = Opus64DecoderMono;
+            StreamProps.iNumAudioChannels = 1;
 
-            switch ( eAudioQuality )
+            switch ( AudioParams.eAudioQuality )
             {
             case AQ_LOW:
-                iCeltNumCodedBytes = OPUS_NUM_BYTES_MONO_LOW_QUALITY;
+                StreamProps.iCeltNumCodedBytes = OPUS_NUM_BYTES_MONO_LOW_QUALITY;
                 break;
             case AQ_NORMAL:
-                iCeltNumCodedBytes = OPUS_NUM_BYTES_MONO_NORMAL_QUALITY;
+                StreamProps.iCeltNumCodedBytes = OPUS_NUM_BYTES_MONO_NORMAL_QUALITY;
                 break;
             case AQ_HIGH:
-                iCeltNumCodedBytes = OPUS_NUM_BYTES_MONO_HIGH_QUALITY;
+                StreamProps.iCeltNumCodedBytes = OPUS_NUM_BYTES_MONO_HIGH_QUALITY;
                 break;
             }
         }
         else
         {
-            CurOpusEncoder    = Opus64EncoderStereo;
-            CurOpusDecoder    = Opus64DecoderStereo;
-            iNumAudioChannels = 2;
+            StreamProps.pOpusEncoder      = Opus64EncoderStereo;
+            StreamProps.pOpusRedEncoder   = Opus64RedEncoderStereo;
+            StreamProps.pOpusDecoder      = Opus64DecoderStereo;
+            StreamProps.iNumAudioChannels = 2;
 
-            switch ( eAudioQuality )
+            switch ( AudioParams.eAudioQuality )
             {
             case AQ_LOW:
-                iCeltNumCodedBytes = OPUS_NUM_BYTES_STEREO_LOW_QUALITY;
+                StreamProps.iCeltNumCodedBytes = OPUS_NUM_BYTES_STEREO_LOW_QUALITY;
                 break;
             case AQ_NORMAL:
-                iCeltNumCodedBytes = OPUS_NUM_BYTES_STEREO_NORMAL_QUALITY;
+                StreamProps.iCeltNumCodedBytes = OPUS_NUM_BYTES_STEREO_NORMAL_QUALITY;
                 break;
             case AQ_HIGH:
-                iCeltNumCodedBytes = OPUS_NUM_BYTES_STEREO_HIGH_QUALITY;
+                StreamProps.iCeltNumCodedBytes = OPUS_NUM_BYTES_STEREO_HIGH_QUALITY;
                 break;
             }
         }
     }
 
-    // calculate stereo (two channels) buffer size
-    iStereoBlockSizeSam = 2 * iMonoBlockSizeSam;
+    // with separately coded inputs, the left and right input are coded as two mono
+    // frames with the mono quality one after another in the network frame (the
+    // audio we receive from the server is still coded as stereo)
+    if ( StreamProps.bSeparateChannels )
+    {
+        const bool bIsOpus = ( eAudioCompressionType == CT_OPUS );
 
-    vecCeltData.Init ( iCeltNumCodedBytes );
-    vecZeros.Init ( iStereoBlockSizeSam, 0 );
-    vecsStereoSndCrdMuteStream.Init ( iStereoBlockSizeSam );
+        StreamProps.pOpusEncoder      = bIsOpus ? OpusEncoderMono : Opus64EncoderMono;
+        StreamProps.pOpusEncoderRight = bIsOpus ? OpusEncoderMonoRight : Opus64EncoderMonoRight;
 
-    opus_custom_encoder_ctl ( CurOpusEncoder,
-                              OPUS_SET_BITRATE ( CalcBitRateBitsPerSecFromCodedBytes ( iCeltNumCodedBytes, iOPUSFrameSizeSamples ) ) );
+        switch ( AudioParams.eAudioQuality )
+        {
+        case AQ_LOW:
+            StreamProps.iSepNumCodedBytes = bIsOpus ? OPUS_NUM_BYTES_MONO_LOW_QUALITY_DBLE_FRAMESIZE : OPUS_NUM_BYTES_MONO_LOW_QUALITY;
+            break;
+        case AQ_NORMAL:
+            StreamProps.iSepNumCodedBytes = bIsOpus ? OPUS_NUM_BYTES_MONO_NORMAL_QUALITY_DBLE_FRAMESIZE : OPUS_NUM_BYTES_MONO_NORMAL_QUALITY;
+            break;
+        case AQ_HIGH:
+            StreamProps.iSepNumCodedBytes = bIsOpus ? OPUS_NUM_BYTES_MONO_HIGH_QUALITY_DBLE_FRAMESIZE : OPUS_NUM_BYTES_MONO_HIGH_QUALITY;
+            break;
+        }
 
-    // inits for network and channel
-    vecbyNetwData.Init ( iCeltNumCodedBytes );
+        StreamProps.iCeltNumCodedBytes = 2 * StreamProps.iSepNumCodedBytes;
+        StreamProps.iBitRateBitsPerSec = CalcBitRateBitsPerSecFromCodedBytes ( StreamProps.iSepNumCodedBytes, StreamProps.iOPUSFrameSizeSamples );
+    }
+    else
+    {
+        StreamProps.iBitRateBitsPerSec = CalcBitRateBitsPerSecFromCodedBytes ( StreamProps.iCeltNumCodedBytes, StreamProps.iOPUSFrameSizeSamples );
+    }
 
-    // set the channel network properties
-    Channel.SetAudioStreamProperties ( eAudioCompressionType, iCeltNumCodedBytes, iSndCrdFrameSizeFactor, iNumAudioChannels );
+    StreamProps.iVersion = iStreamPropsAppliedVersion.load ( std::memory_order_relaxed ) + 1;
 
-    // init reverberation
-    AudioReverb.Init ( eAudioChannelConf, iStereoBlockSizeSam, SYSTEM_SAMPLE_RATE_HZ );
+    StreamPropsBuffer.Publish ( StreamProps );
 
-    // init the sound card conversion buffers
-    if ( bSndCrdConversionBufferRequired )
-    {
-        // inits for conversion buffer (the size of the conversion buffer must
-        // be the sum of input/output sizes which is the worst case fill level)
-        const int iSndCardStereoBlockSizeSamConvBuff = 2 * iSndCardMonoBlockSizeSamConvBuff;
-        const int iConBufSize                        = iStereoBlockSizeSam + iSndCardStereoBlockSizeSamConvBuff;
+    // the channel takes over the new properties right away, no audio is sent or
+    // received until the audio processing has taken them over as well
+    Channel.SetAudioStreamProperties ( StreamProps.eAudComprType,
+                                       StreamProps.iCeltNumCodedBytes,
+                                       StreamProps.iNetwFrameSizeFact,
+                                       StreamProps.iNumAudioChannels,
+                                       StreamProps.bSeparateChannels );
 
-        SndCrdConversionBufferIn.Init ( iConBufSize );
-        SndCrdConversionBufferOut.Init ( iConBufSize );
-        vecDataConvBuf.Init ( iStereoBlockSizeSam );
+    iStreamPropsAppliedVersion.store ( StreamProps.iVersion, std::memory_order_release );
+}
 
-        // the output conversion buffer must be filled with the inner
-        // block size for initialization (this is the latency which is
-        // introduced by the conversion buffer) to avoid buffer underruns
-        SndCrdConversionBufferOut.Put ( vecZeros, iStereoBlockSizeSam );
+void CClient::ApplyAudioCoding ( const CClientStreamProps& StreamProps )
+{
+    // takes over the audio coding prepared by PrepareAudioCoding(), this is called
+    // by the audio processing and must therefore neither allocate nor lock
+    CurOpusEncoder        = StreamProps.pOpusEncoder;
+    CurOpusEncoderRight   = StreamProps.pOpusEncoderRight;
+    CurOpusRedEncoder     = StreamProps.pOpusRedEncoder;
+    CurOpusDecoder        = StreamProps.pOpusDecoder;
+    iCeltNumCodedBytes    = StreamProps.iCeltNumCodedBytes;
+    iSepNumCodedBytes     = StreamProps.iSepNumCodedBytes;
+    iOPUSFrameSizeSamples = StreamProps.iOPUSFrameSizeSamples;
+    iNumAudioChannels     = StreamProps.iNumAudioChannels;
+    bSeparateInputs       = StreamProps.bSeparateChannels;
+    iStreamPropsVersion   = StreamProps.iVersion;
+
+    // the bit rate is only stored in the encoder state (the same is done for the
+    // redundant frame encoder on each block)
+    opus_custom_encoder_ctl ( CurOpusEncoder, OPUS_SET_BITRATE ( StreamProps.iBitRateBitsPerSec ) );
+
+    if ( CurOpusEncoderRight != nullptr )
+    {
+        opus_custom_encoder_ctl ( CurOpusEncoderRight, OPUS_SET_BITRATE ( StreamProps.iBitRateBitsPerSec ) );
     }
 
-    // reset initialization phase flag and mute flag
-    bIsInitializationPhase = true;
+    // the reverberation only changes its channel mode (it is initialized by Init())
+    if ( StreamProps.eAudioChannelConf != eAudioChannelConf )
+    {
+        eAudioChannelConf = StreamProps.eAudioChannelConf;
+        AudioReverb.SetAudioChannelConf ( eAudioChannelConf );
+    }
+
+    // a running probe is invalid after a change of the audio properties
+    LatencyProbe.Reset();
+}
+
+void CClient::UpdateAudioGains ( const CClientAudioParams& Params )
+{
+    // calculate pan gain in the range 0 to 1, where 0.5 is the middle position,
+    // for stereo only apply pan attenuation on one channel (same as pan in the
+    // server), for mono implement a cross-fade between channels, for
+    // mono-in/stereo-out use no attenuation in pan center
+    const float fPan   = static_cast<float> ( Params.iAudioInFader ) / AUD_FADER_IN_MAX;
+    const bool  bXFade = ( eAudioChannelConf == CC_MONO );
+
+    InputBoostGain.Update ( static_cast<float> ( Params.iInputBoost ) );
+    ReverbGain.Update ( static_cast<float> ( Params.iReverbLevel ) / AUD_REVERB_MAX / 4 );
+    PanGainLeft.Update ( MathUtils::GetLeftPan ( fPan, bXFade ) );
+    PanGainRight.Update ( MathUtils::GetRightPan ( fPan, bXFade ) );
+
+    // a muted stream is faded out and the local signal is faded in
+    TransmitGain.Update ( Params.bMuteOutStream ? 0.0f : 1.0f );
+    MuteOutStreamGain.Update ( Params.bMuteOutStream ? Params.fMuteOutStreamGain : 0.0f );
 }
 
-void CClient::AudioCallback ( CVector<int16_t>& psData, void* arg )
+void CClient::AudioCallback ( CVector<float>& vecfData, void* arg )
 {
     // get the pointer to the object
     CClient* pMyClientObj = static_cast<CClient*> ( arg );
 
     // process audio data
-    pMyClientObj->ProcessSndCrdAudioData ( psData );
+    pMyClientObj->ProcessSndCrdAudioData ( vecfData );
 
     //### TEST: BEGIN ###//
     // do a soundcard jitter measurement
@@ -1257,13 +1521,17 @@ void CClient::AudioCallback ( CVector<int16_t>& psData, void* arg )
     //### TEST: END ###//
 }
 
-void CClient::ProcessSndCrdAudioData ( CVector<int16_t>& vecsStereoSndCrd )
+void CClient::ProcessSndCrdAudioData ( CVector<float>& vecfStereoSndCrd )
 {
-    // check if a conversion buffer is required or not
-    if ( bSndCrdConversionBufferRequired )
+    // in network thread mode the processing is done in the network thread
+    if ( bUseNetworkThread )
+    {
+        ExchangeNetworkThreadData ( vecfStereoSndCrd );
+    }
+    else if ( bSndCrdConversionBufferRequired )
     {
         // add new sound card block in conversion buffer
-        SndCrdConversionBufferIn.Put ( vecsStereoSndCrd, vecsStereoSndCrd.Size() );
+        SndCrdConversionBufferIn.Put ( vecfStereoSndCrd, vecfStereoSndCrd.Size() );
 
         // process all available blocks of data
         while ( SndCrdConversionBufferIn.GetAvailData() >= iStereoBlockSizeSam )
@@ -1278,75 +1546,202 @@ void CClient::ProcessSndCrdAudioData ( CVector<int16_t>& vecsStereoSndCrd )
         }
 
         // get processed sound card block out of the conversion buffer
-        SndCrdConversionBufferOut.Get ( vecsStereoSndCrd, vecsStereoSndCrd.Size() );
+        SndCrdConversionBufferOut.Get ( vecfStereoSndCrd, vecfStereoSndCrd.Size() );
     }
     else
     {
         // regular case: no conversion buffer required
         // process audio data
-        ProcessAudioDataIntern ( vecsStereoSndCrd );
+        ProcessAudioDataIntern ( vecfStereoSndCrd );
+    }
+}
+
+void CClient::ExchangeNetworkThreadData ( CVector<float>& vecfStereoSndCrd )
+{
+    // called in the sound card callback, nothing in here may block
+    const int iSndCrdStereoBlockSizeSam = vecfStereoSndCrd.Size();
+
+    // hand the new input over to the network thread (if the network thread does
+    // not keep up and the buffer is full, the input block is dropped)
+    NetwThreadBufferIn.Put ( vecfStereoSndCrd, iSndCrdStereoBlockSizeSam );
+    NetworkThread.Wake();
+
+    // get the processed output, if the network thread is late we output silence
+    // which increases the lead time of the network thread by one block
+    if ( !NetwThreadBufferOut.Get ( vecfStereoSndCrd, iSndCrdStereoBlockSizeSam ) )
+    {
+        vecfStereoSndCrd.Reset ( 0 );
+        iNetwThreadNumUnderruns.fetch_add ( 1, std::memory_order_relaxed );
+    }
+
+    // the lead time is the processed output which is left for the next blocks
+    iNetwThreadLeadMinSam = std::min ( iNetwThreadLeadMinSam, NetwThreadBufferOut.GetAvailData() );
+    iNetwThreadLeadMeasCnt += iSndCrdStereoBlockSizeSam / 2;
+
+    if ( iNetwThreadLeadMeasCnt >= SYSTEM_SAMPLE_RATE_HZ * NETW_THREAD_LEAD_MEAS_TIME_MS / 1000 )
+    {
+        iNetwThreadLeadTimeMs.store ( iNetwThreadLeadMinSam / 2 * 1000 / SYSTEM_SAMPLE_RATE_HZ, std::memory_order_relaxed );
+
+        iNetwThreadLeadMinSam  = NetwThreadBufferOut.GetAvailData() + NetwThreadBufferOut.GetAvailSpace();
+        iNetwThreadLeadMeasCnt = 0;
+    }
+}
+
+void CClient::ProcessNetworkThreadData()
+{
+    // called in the network thread
+    QMutexLocker locker ( &MutexNetworkThread );
+
+    // process all complete blocks which the sound card callback has delivered
+    while ( NetwThreadBufferIn.GetAvailData() >= iStereoBlockSizeSam )
+    {
+        NetwThreadBufferIn.Get ( vecNetwThreadData, iStereoBlockSizeSam );
+
+        ProcessAudioDataIntern ( vecNetwThreadData );
+
+        NetwThreadBufferOut.Put ( vecNetwThreadData, iStereoBlockSizeSam );
+    }
+}
+
+void CClient::CNetworkThread::Start()
+{
+    // only start if not already running
+    if ( !bRun )
+    {
+        // drop the wake ups which are left from the last run
+        Semaphore.tryAcquire ( Semaphore.available() );
+        bWakePending = false;
+
+        bRun = true;
+        start ( QThread::TimeCriticalPriority );
+    }
+}
+
+void CClient::CNetworkThread::Stop()
+{
+    if ( bRun )
+    {
+        // leave the wait for new data and wait for the thread to exit
+        bRun = false;
+        Semaphore.release();
+        wait();
     }
 }
 
-void CClient::ProcessAudioDataIntern ( CVector<int16_t>& vecsStereoSndCrd )
+void CClient::CNetworkThread::run()
+{
+#if defined( Q_OS_LINUX )
+    // use real-time scheduling if the user is allowed to (e.g., with an rtprio
+    // limit in /etc/security/limits.conf as it is required by JACK anyway)
+    sched_param SchedParam;
+    SchedParam.sched_priority = NETW_THREAD_RT_PRIORITY;
+
+    if ( pthread_setschedparam ( pthread_self(), SCHED_FIFO, &SchedParam ) != 0 )
+    {
+        qWarning() << "Could not use real-time scheduling for the client network thread";
+    }
+#endif
+
+    while ( bRun )
+    {
+        // wait for new data from the sound card callback (the time out makes
+        // sure the thread does not hang if a wake up gets lost on a reset)
+        if ( Semaphore.tryAcquire ( 1, 100 ) )
+        {
+            // a wake up during the processing releases the semaphore again, the
+            // data of several wake ups is handled by one call
+            bWakePending.store ( false, std::memory_order_release );
+
+            pClient->ProcessNetworkThreadData();
+        }
+    }
+}
+
+void CClient::ProcessAudioDataIntern ( CVector<float>& vecfStereoSndCrd )
 {
     int            i, j, iUnused;
     unsigned char* pCurCodedData;
 
+    // get the current settings (wait-free)
+    const CClientAudioParams& Params = AudioParamsBuffer.Get();
+
+    // a new audio coding is prepared by the thread of this object and taken over
+    // at the block boundary without a restart of the sound card (wait-free)
+    const CClientStreamProps& StreamProps = StreamPropsBuffer.Get();
+
+    if ( StreamProps.iVersion != iStreamPropsVersion )
+    {
+        ApplyAudioCoding ( StreamProps );
+    }
+
+    if ( Params.bReverbOnLeftChan != bReverbOnLeftChan )
+    {
+        bReverbOnLeftChan = Params.bReverbOnLeftChan;
+        AudioReverb.Clear();
+    }
+
+    // the coded audio must match the properties of the channel
+    const bool bStreamPropsApplied = ( iStreamPropsAppliedVersion.load ( std::memory_order_acquire ) == iStreamPropsVersion );
+
+    // the gains follow the settings smoothly to avoid clicks
+    UpdateAudioGains ( Params );
+
     // Transmit signal ---------------------------------------------------------
 
-    if ( iInputBoost != 1 )
+    if ( !InputBoostGain.IsConstant ( 1.0f ) )
     {
         // apply a general gain boost to all audio input:
+        float       fGain     = InputBoostGain.GetStart();
+        const float fGainStep = InputBoostGain.GetStep ( iMonoBlockSizeSam );
+
         for ( i = 0, j = 0; i < iMonoBlockSizeSam; i++, j += 2 )
         {
-            vecsStereoSndCrd[j + 1] = static_cast<int16_t> ( iInputBoost * vecsStereoSndCrd[j + 1] );
-            vecsStereoSndCrd[j]     = static_cast<int16_t> ( iInputBoost * vecsStereoSndCrd[j] );
+            fGain += fGainStep;
+
+            vecfStereoSndCrd[j + 1] *= fGain;
+            vecfStereoSndCrd[j]     *= fGain;
         }
     }
 
     // update stereo signal level meter (not needed in headless mode)
 #ifndef HEADLESS
-    SignalLevelMeter.Update ( vecsStereoSndCrd, iMonoBlockSizeSam, true );
+    SignalLevelMeter.Update ( vecfStereoSndCrd, iMonoBlockSizeSam, true );
 #endif
 
-    // add reverberation effect if activated
-    if ( iReverbLevel != 0 )
+    // add reverberation effect if activated (the reverberation level is only
+    // changed from block to block)
+    if ( !ReverbGain.IsConstant ( 0.0f ) )
     {
-        AudioReverb.Process ( vecsStereoSndCrd, bReverbOnLeftChan, static_cast<float> ( iReverbLevel ) / AUD_REVERB_MAX / 4 );
+        AudioReverb.Process ( vecfStereoSndCrd, bReverbOnLeftChan, ReverbGain.GetEnd() );
     }
 
     // apply pan (audio fader) and mix mono signals
-    if ( !( ( iAudioInFader == AUD_FADER_IN_MIDDLE ) && ( eAudioChannelConf == CC_STEREO ) ) )
+    if ( !( PanGainLeft.IsConstant ( 1.0f ) && PanGainRight.IsConstant ( 1.0f ) && ( eAudioChannelConf == CC_STEREO ) ) )
     {
-        // calculate pan gain in the range 0 to 1, where 0.5 is the middle position
-        const float fPan = static_cast<float> ( iAudioInFader ) / AUD_FADER_IN_MAX;
+        float       fGainL     = PanGainLeft.GetStart();
+        float       fGainR     = PanGainRight.GetStart();
+        const float fGainStepL = PanGainLeft.GetStep ( iMonoBlockSizeSam );
+        const float fGainStepR = PanGainRight.GetStep ( iMonoBlockSizeSam );
 
         if ( eAudioChannelConf == CC_STEREO )
         {
-            // for stereo only apply pan attenuation on one channel (same as pan in the server)
-            const float fGainL = MathUtils::GetLeftPan ( fPan, false );
-            const float fGainR = MathUtils::GetRightPan ( fPan, false );
-
             for ( i = 0, j = 0; i < iMonoBlockSizeSam; i++, j += 2 )
             {
-                // note that the gain is always <= 1, therefore a simple cast is
-                // ok since we never can get an overload
-                vecsStereoSndCrd[j + 1] = static_cast<int16_t> ( fGainR * vecsStereoSndCrd[j + 1] );
-                vecsStereoSndCrd[j]     = static_cast<int16_t> ( fGainL * vecsStereoSndCrd[j] );
+                fGainL += fGainStepL;
+                fGainR += fGainStepR;
+
+                vecfStereoSndCrd[j + 1] *= fGainR;
+                vecfStereoSndCrd[j]     *= fGainL;
             }
         }
         else
         {
-            // for mono implement a cross-fade between channels and mix them, for
-            // mono-in/stereo-out use no attenuation in pan center
-            const float fGainL = MathUtils::GetLeftPan ( fPan, eAudioChannelConf != CC_MONO_IN_STEREO_OUT );
-            const float fGainR = MathUtils::GetRightPan ( fPan, eAudioChannelConf != CC_MONO_IN_STEREO_OUT );
-
             for ( i = 0, j = 0; i < iMonoBlockSizeSam; i++, j += 2 )
             {
-                // note that we need the Float2Short for stereo pan mode
-                vecsStereoSndCrd[i] = Float2Short ( fGainL * vecsStereoSndCrd[j] + fGainR * vecsStereoSndCrd[j + 1] );
+                fGainL += fGainStepL;
+                fGainR += fGainStepR;
+
+                vecfStereoSndCrd[i] = fGainL * vecfStereoSndCrd[j] + fGainR * vecfStereoSndCrd[j + 1];
             }
         }
     }
@@ -1362,49 +1757,118 @@ void CClient::ProcessAudioDataIntern ( CVector<int16_t>& vecsStereoSndCrd )
         // overwrite input values)
         for ( i = iMonoBlockSizeSam - 1, j = iStereoBlockSizeSam - 2; i >= 0; i--, j -= 2 )
         {
-            vecsStereoSndCrd[j] = vecsStereoSndCrd[j + 1] = vecsStereoSndCrd[i];
+            vecfStereoSndCrd[j] = vecfStereoSndCrd[j + 1] = vecfStereoSndCrd[i];
         }
     }
 
+    // in case of mute stream, store local data
+    const bool bMixMuteOutStream = !MuteOutStreamGain.IsConstant ( 0.0f );
+
+    if ( bMixMuteOutStream )
+    {
+        vecfStereoSndCrdMuteStream = vecfStereoSndCrd;
+    }
+
+    // fade the transmitted signal out or in if the stream is muted or unmuted
+    const bool bTransmitMuted = TransmitGain.IsConstant ( 0.0f );
+
+    if ( !bTransmitMuted && !TransmitGain.IsConstant ( 1.0f ) )
+    {
+        float       fGain     = TransmitGain.GetStart();
+        const float fGainStep = TransmitGain.GetStep ( iMonoBlockSizeSam );
+
+        for ( i = 0, j = 0; i < iMonoBlockSizeSam; i++ )
+        {
+            fGain += fGainStep;
+
+            for ( int c = 0; c < iNumAudioChannels; c++, j++ )
+            {
+                vecfStereoSndCrd[j] *= fGain;
+            }
+        }
+    }
+
+    // add the latency probe to the transmitted signal (not if the signal is muted
+    // since we would hear the probe in the local signal)
+    const bool bLatencyProbeActive = bUseLatencyProbe && Channel.IsConnected();
+
+    if ( bLatencyProbeActive && TransmitGain.IsConstant ( 1.0f ) )
+    {
+        LatencyProbe.Inject ( vecfStereoSndCrd, iMonoBlockSizeSam, iNumAudioChannels );
+    }
+
+    // number of bytes of the redundant copy of each frame (zero if not used)
+    const int iRedNumCodedBytes = Channel.GetRedNumCodedBytes();
+
+    if ( ( iRedNumCodedBytes > 0 ) && ( CurOpusRedEncoder != nullptr ) )
+    {
+        opus_custom_encoder_ctl ( CurOpusRedEncoder,
+                                  OPUS_SET_BITRATE ( CalcBitRateBitsPerSecFromCodedBytes ( iRedNumCodedBytes, iOPUSFrameSizeSamples ) ) );
+    }
+
     for ( i = 0, j = 0; i < iSndCrdFrameSizeFactor; i++, j += iNumAudioChannels * iOPUSFrameSizeSamples )
     {
+        const CVector<float>& vecfEncIn = bTransmitMuted ? vecZeros : vecfStereoSndCrd;
+
         // OPUS encoding
-        if ( CurOpusEncoder != nullptr )
+        if ( bSeparateInputs && ( CurOpusEncoderRight != nullptr ) )
         {
-            if ( bMuteOutStream )
+            // split the stereo frame in the left and right input and code them
+            // separately (no redundant copy is sent in this mode)
+            for ( int k = 0; k < iOPUSFrameSizeSamples; k++ )
             {
-                iUnused = opus_custom_encode ( CurOpusEncoder, &vecZeros[j], iOPUSFrameSizeSamples, &vecCeltData[0], iCeltNumCodedBytes );
+                vecfSepEncIn[k]                         = vecfEncIn[j + 2 * k];
+                vecfSepEncIn[iOPUSFrameSizeSamples + k] = vecfEncIn[j + 2 * k + 1];
             }
-            else
+
+            iUnused = opus_custom_encode_float ( CurOpusEncoder, &vecfSepEncIn[0], iOPUSFrameSizeSamples, &vecCeltData[0], iSepNumCodedBytes );
+
+            iUnused = opus_custom_encode_float ( CurOpusEncoderRight,
+                                                 &vecfSepEncIn[iOPUSFrameSizeSamples],
+                                                 iOPUSFrameSizeSamples,
+                                                 &vecCeltData[iSepNumCodedBytes],
+                                                 iSepNumCodedBytes );
+        }
+        else if ( CurOpusEncoder != nullptr )
+        {
+            iUnused = opus_custom_encode_float ( CurOpusEncoder, &vecfEncIn[j], iOPUSFrameSizeSamples, &vecCeltData[0], iCeltNumCodedBytes );
+
+            // the redundant copy is sent with the next packet (for lost packet recovery)
+            if ( ( iRedNumCodedBytes > 0 ) && ( CurOpusRedEncoder != nullptr ) )
             {
-                iUnused = opus_custom_encode ( CurOpusEncoder, &vecsStereoSndCrd[j], iOPUSFrameSizeSamples, &vecCeltData[0], iCeltNumCodedBytes );
+                iUnused = opus_custom_encode_float ( CurOpusRedEncoder, &vecfEncIn[j], iOPUSFrameSizeSamples, &vecRedCeltData[0], iRedNumCodedBytes );
             }
         }
 
         // send coded audio through the network
-        Channel.PrepAndSendPacket ( &Socket, vecCeltData, iCeltNumCodedBytes );
+        if ( bStreamPropsApplied )
+        {
+            Channel.PrepAndSendPacket ( &Socket, vecCeltData, iCeltNumCodedBytes, vecRedCeltData );
+        }
     }
 
     // Receive signal ----------------------------------------------------------
-    // in case of mute stream, store local data
-    if ( bMuteOutStream )
-    {
-        vecsStereoSndCrdMuteStream = vecsStereoSndCrd;
-    }
-
     for ( i = 0, j = 0; i < iSndCrdFrameSizeFactor; i++, j += iNumAudioChannels * iOPUSFrameSizeSamples )
     {
         // receive a new block
-        const bool bReceiveDataOk = ( Channel.GetData ( vecbyNetwData, iCeltNumCodedBytes ) == GS_BUFFER_OK );
+        const EGetDataStat eGetStat          = bStreamPropsApplied ? Channel.GetData ( vecbyNetwData, iCeltNumCodedBytes ) : GS_BUFFER_UNDERRUN;
+        int                iCurNumCodedBytes = iCeltNumCodedBytes;
 
         // get pointer to coded data and manage the flags
-        if ( bReceiveDataOk )
+        if ( eGetStat == GS_BUFFER_OK )
         {
             pCurCodedData = &vecbyNetwData[0];
 
             // on any valid received packet, we clear the initialization phase flag
             bIsInitializationPhase = false;
         }
+        else if ( eGetStat == GS_BUFFER_REDUNDANT )
+        {
+            // the lost packet is replaced by its redundant copy (no audible dropout,
+            // so the buffer OK status flag is not invalidated)
+            pCurCodedData     = &vecbyNetwData[0];
+            iCurNumCodedBytes = Channel.GetRedNumCodedBytes();
+        }
         else
         {
             // for lost packets use null pointer as coded input data
@@ -1417,16 +1881,30 @@ void CClient::ProcessAudioDataIntern ( CVector<int16_t>& vecsStereoSndCrd )
         // OPUS decoding
         if ( CurOpusDecoder != nullptr )
         {
-            iUnused = opus_custom_decode ( CurOpusDecoder, pCurCodedData, iCeltNumCodedBytes, &vecsStereoSndCrd[j], iOPUSFrameSizeSamples );
+            iUnused = opus_custom_decode_float ( CurOpusDecoder, pCurCodedData, iCurNumCodedBytes, &vecfStereoSndCrd[j], iOPUSFrameSizeSamples );
         }
     }
 
+    // search for the latency probe in the mix of the server
+    if ( bLatencyProbeActive )
+    {
+        LatencyProbe.Detect ( vecfStereoSndCrd, iMonoBlockSizeSam, iNumAudioChannels );
+    }
+
     // for muted stream we have to add our local data here
-    if ( bMuteOutStream )
+    if ( bMixMuteOutStream )
     {
-        for ( i = 0; i < iStereoBlockSizeSam; i++ )
+        float       fGain     = MuteOutStreamGain.GetStart();
+        const float fGainStep = MuteOutStreamGain.GetStep ( iMonoBlockSizeSam );
+
+        for ( i = 0, j = 0; i < iMonoBlockSizeSam; i++ )
         {
-            vecsStereoSndCrd[i] = Float2Short ( vecsStereoSndCrd[i] + vecsStereoSndCrdMuteStream[i] * fMuteOutStreamGain );
+            fGain += fGainStep;
+
+            for ( int c = 0; c < iNumAudioChannels; c++, j++ )
+            {
+                vecfStereoSndCrd[j] += vecfStereoSndCrdMuteStream[j] * fGain;
+            }
         }
     }
 
@@ -1440,14 +1918,14 @@ void CClient::ProcessAudioDataIntern ( CVector<int16_t>& vecsStereoSndCrd )
             // overwrite input values)
             for ( i = iMonoBlockSizeSam - 1, j = iStereoBlockSizeSam - 2; i >= 0; i--, j -= 2 )
             {
-                vecsStereoSndCrd[j] = vecsStereoSndCrd[j + 1] = vecsStereoSndCrd[i];
+                vecfStereoSndCrd[j] = vecfStereoSndCrd[j + 1] = vecfStereoSndCrd[i];
             }
         }
     }
     else
     {
         // if not connected, clear data
-        vecsStereoSndCrd.Reset ( 0 );
+        vecfStereoSndCrd.Reset ( 0 );
     }
 
     // update socket buffer size
@@ -1456,17 +1934,8 @@ void CClient::ProcessAudioDataIntern ( CVector<int16_t>& vecsStereoSndCrd )
     Q_UNUSED ( iUnused )
 }
 
-int CClient::EstimatedOverallDelay ( const int iPingTimeMs )
+float CClient::EstimatedSoundCardDelayMs()
 {
-    const float fSystemBlockDurationMs = static_cast<float> ( iOPUSFrameSizeSamples ) / SYSTEM_SAMPLE_RATE_HZ * 1000;
-
-    // If the jitter buffers are set effectively, i.e. they are exactly the
-    // size of the network jitter, then the delay of the buffer is the buffer
-    // length. Since that is usually not the case but the buffers are usually
-    // a bit larger than necessary, we introduce some factor for compensation.
-    // Consider the jitter buffer on the client and on the server side, too.
-    const float fTotalJitterBufferDelayMs = fSystemBlockDurationMs * ( GetSockBufNumFrames() + GetServerSockBufNumFrames() ) * 0.7f;
-
     // consider delay introduced by the sound card conversion buffer by using
     // "GetSndCrdConvBufAdditionalDelayMonoBlSize()"
     float fTotalSoundCardDelayMs = GetSndCrdConvBufAdditionalDelayMonoBlSize() * 1000.0f / SYSTEM_SAMPLE_RATE_HZ;
@@ -1491,6 +1960,37 @@ int CClient::EstimatedOverallDelay ( const int iPingTimeMs )
         fTotalSoundCardDelayMs += fSoundCardInputOutputLatencyMs;
     }
 
+    // in network thread mode the output lags behind by one sound card block plus
+    // the lead time of the network thread
+    if ( bUseNetworkThread )
+    {
+        fTotalSoundCardDelayMs += GetSndCrdActualMonoBlSize() * 1000.0f / SYSTEM_SAMPLE_RATE_HZ + std::max ( GetNetworkThreadLeadTimeMs(), 0 );
+    }
+
+    return fTotalSoundCardDelayMs;
+}
+
+int CClient::EstimatedOverallDelay ( const int iPingTimeMs )
+{
+    const float fSystemBlockDurationMs = static_cast<float> ( iOPUSFrameSizeSamples ) / SYSTEM_SAMPLE_RATE_HZ * 1000;
+    const float fTotalSoundCardDelayMs = EstimatedSoundCardDelayMs();
+
+    // if the latency probe has a valid result, it replaces the estimation of all
+    // delays between the audio encoder input and the audio decoder output
+    const int iMeasuredDelaySam = bUseLatencyProbe ? LatencyProbe.GetDelaySamples() : -1;
+
+    if ( iMeasuredDelaySam >= 0 )
+    {
+        return MathUtils::round ( fTotalSoundCardDelayMs + iMeasuredDelaySam * 1000.0f / SYSTEM_SAMPLE_RATE_HZ );
+    }
+
+    // If the jitter buffers are set effectively, i.e. they are exactly the
+    // size of the network jitter, then the delay of the buffer is the buffer
+    // length. Since that is usually not the case but the buffers are usually
+    // a bit larger than necessary, we introduce some factor for compensation.
+    // Consider the jitter buffer on the client and on the server side, too.
+    const float fTotalJitterBufferDelayMs = fSystemBlockDurationMs * ( GetSockBufNumFrames() + GetServerSockBufNumFrames() ) * 0.7f;
+
     // network packets are of the same size as the audio packets per definition
     // if no sound card conversion buffer is used
     const float fDelayToFillNetworkPacketsMs = GetSystemMonoBlSize() * 1000.0f / SYSTEM_SAMPLE_RATE_HZ;
@@ -1504,6 +2004,35 @@ int CClient::EstimatedOverallDelay ( const int iPingTimeMs )
     return MathUtils::round ( fTotalBufferDelayMs + iPingTimeMs );
 }
 
+CDelayBreakdown CClient::GetDelayBreakdown ( const int iPingTimeMs )
+{
+    const float fSystemBlockDurationMs = static_cast<float> ( iOPUSFrameSizeSamples ) / SYSTEM_SAMPLE_RATE_HZ * 1000;
+    const int   iMeasuredDelaySam      = bUseLatencyProbe ? LatencyProbe.GetDelaySamples() : -1;
+
+    CDelayBreakdown DelayBreakdown;
+
+    DelayBreakdown.iOverallMs      = EstimatedOverallDelay ( std::max ( iPingTimeMs, 0 ) );
+    DelayBreakdown.iPingMs         = iPingTimeMs;
+    DelayBreakdown.iJitterBufferMs = MathUtils::round ( fSystemBlockDurationMs * ( GetSockBufNumFrames() + GetServerSockBufNumFrames() ) );
+    DelayBreakdown.iSoundCardMs    = MathUtils::round ( EstimatedSoundCardDelayMs() );
+
+    if ( iMeasuredDelaySam >= 0 )
+    {
+        DelayBreakdown.iMeasuredMs = MathUtils::round ( iMeasuredDelaySam * 1000.0f / SYSTEM_SAMPLE_RATE_HZ );
+
+        // the rest of the measurement can only be given if the network round trip is known
+        DelayBreakdown.iServerAndCodecMs =
+            ( iPingTimeMs >= 0 ) ? std::max ( DelayBreakdown.iMeasuredMs - iPingTimeMs - DelayBreakdown.iJitterBufferMs, 0 ) : -1;
+    }
+    else
+    {
+        DelayBreakdown.iMeasuredMs       = -1;
+        DelayBreakdown.iServerAndCodecMs = -1;
+    }
+
+    return DelayBreakdown;
+}
+
 // Management of Client Channels and mapping to/from Server Channels
 
 void CClient::ClearClientChannels()
@@ -29,6 +29,9 @@
 #include <QString>
 #include <QDateTime>
 #include <QMutex>
+#include <QSemaphore>
+#include <QThread>
+#include <atomic>
 #ifdef USE_OPUS_SHARED_LIB
 #    include "opus/opus_custom.h"
 #else
@@ -54,7 +57,11 @@
 #            ifdef ANDROID
 #                include "sound/oboe/sound.h"
 #            else
-#                include "sound/jack/sound.h"
+#                ifdef WITH_FILE_SOUND
+#                    include "sound/file/sound.h"
+#                else
+#                    include "sound/jack/sound.h"
+#                endif
 #                ifndef JACK_ON_WINDOWS // these headers are not available in Windows OS
 #                    include <sched.h>
 #                    include <netdb.h>
@@ -74,10 +81,28 @@
 // audio reverberation range
 #define AUD_REVERB_MAX 100
 
+// time constant of the smoothing of the gains if the settings are changed
+#define AUDIO_GAIN_SMOOTHING_TIME_MS 10 // ms
+
 // default delay period between successive gain updates (ms)
 // this will be increased to double the ping time if connected to a distant server
 #define DEFAULT_GAIN_DELAY_PERIOD_MS 50
 
+// network thread mode: size of the buffers between the sound card callback and
+// the network thread in sound card blocks, the real-time priority of the thread
+// (below the usual priority of the audio driver threads) and the time over which
+// the minimum lead time of the network thread is measured
+#define NETW_THREAD_BUFFER_NUM_BLOCKS 8
+#define NETW_THREAD_RT_PRIORITY       50
+#define NETW_THREAD_LEAD_MEAS_TIME_MS 1000 // ms
+
+// redundancy mode: the redundant frames are switched on if the frame loss rate
+// in one of the directions exceeds the on limit and switched off if the loss
+// rate is below the off limit for a number of consecutive reports
+#define REDUNDANCY_ON_LOSS_PERMILLE  5
+#define REDUNDANCY_OFF_LOSS_PERMILLE 1
+#define REDUNDANCY_OFF_NUM_REPORTS   15
+
 // OPUS number of coded bytes per audio packet
 // TODO we have to use new numbers for OPUS to avoid that old CELT packets
 // are used in the OPUS decoder (which gives a bad noise output signal).
@@ -103,8 +128,24 @@
 #define OPUS_NUM_BYTES_STEREO_NORMAL_QUALITY_DBLE_FRAMESIZE 71
 #define OPUS_NUM_BYTES_STEREO_HIGH_QUALITY_DBLE_FRAMESIZE   165
 
+// the coded data buffers have the maximum size so that the audio coding can be
+// changed while the audio is processed
+#define OPUS_MAX_NUM_BYTES OPUS_NUM_BYTES_STEREO_HIGH_QUALITY_DBLE_FRAMESIZE
+
 /* Classes ********************************************************************/
 
+// breakdown of the overall delay per stage in ms, -1 if a stage is not available
+class CDelayBreakdown
+{
+public:
+    int iOverallMs;        // measured round trip plus sound card delay if available, otherwise estimated
+    int iMeasuredMs;       // in-band measurement from the audio encoder input to the decoder output
+    int iPingMs;           // network round trip
+    int iJitterBufferMs;   // nominal size of the client and server jitter buffers
+    int iServerAndCodecMs; // rest of the measurement: packetization, audio codec and server processing
+    int iSoundCardMs;      // reported by the audio interface or estimated
+};
+
 class CClientChannel
 {
 public:
@@ -119,6 +160,73 @@ public:
     // can store here other information about an active channel
 };
 
+// Settings of the audio processing which are changed by the GUI. Each change
+// publishes a complete copy which the audio processing gets without a lock at
+// the beginning of the next block.
+class CClientAudioParams
+{
+public:
+    CClientAudioParams() :
+        eAudioQuality ( AQ_NORMAL ),
+        eAudioChannelConf ( CC_MONO ),
+        iAudioInFader ( AUD_FADER_IN_MIDDLE ),
+        iReverbLevel ( 0 ),
+        bReverbOnLeftChan ( false ),
+        iInputBoost ( 1 ),
+        bMuteOutStream ( false ),
+        fMuteOutStreamGain ( 1.0f )
+    {}
+
+    EAudioQuality eAudioQuality;
+    EAudChanConf  eAudioChannelConf;
+    int           iAudioInFader;
+    int           iReverbLevel;
+    bool          bReverbOnLeftChan;
+    int           iInputBoost;
+    bool          bMuteOutStream;
+    float         fMuteOutStreamGain; // level of the own signal in the local mix if muted
+};
+
+// Audio coding and network properties of the audio stream for the current
+// settings. They are prepared in the thread of the client object, which also
+// applies them to the channel, since the channel locks its mutexes and allocates
+// its buffers. The audio processing takes them over at the next block boundary.
+class CClientStreamProps
+{
+public:
+    CClientStreamProps() :
+        eAudComprType ( CT_NONE ),
+        iCeltNumCodedBytes ( 0 ),
+        iNetwFrameSizeFact ( 0 ),
+        iNumAudioChannels ( 0 ),
+        bSeparateChannels ( false ),
+        eAudioChannelConf ( CC_MONO ),
+        iOPUSFrameSizeSamples ( 0 ),
+        iSepNumCodedBytes ( 0 ),
+        iBitRateBitsPerSec ( 0 ),
+        pOpusEncoder ( nullptr ),
+        pOpusEncoderRight ( nullptr ),
+        pOpusRedEncoder ( nullptr ),
+        pOpusDecoder ( nullptr ),
+        iVersion ( 0 )
+    {}
+
+    EAudComprType      eAudComprType;
+    int                iCeltNumCodedBytes;
+    int                iNetwFrameSizeFact;
+    int                iNumAudioChannels;
+    bool               bSeparateChannels;
+    EAudChanConf       eAudioChannelConf;
+    int                iOPUSFrameSizeSamples;
+    int                iSepNumCodedBytes;
+    int                iBitRateBitsPerSec; // of each encoder
+    OpusCustomEncoder* pOpusEncoder;
+    OpusCustomEncoder* pOpusEncoderRight; // only used for separately coded inputs
+    OpusCustomEncoder* pOpusRedEncoder;
+    OpusCustomDecoder* pOpusDecoder;
+    int                iVersion; // counts the changes of the audio coding
+};
+
 class CClient : public QObject
 {
     Q_OBJECT
@@ -131,7 +239,12 @@ public:
               const bool     bNoAutoJackConnect,
               const QString& strNClientName,
               const bool     bNEnableIPv6,
-              const bool     bNMuteMeInPersonalMix );
+              const bool     bNMuteMeInPersonalMix,
+              const bool     bNUseNetworkThread,
+              const bool     bNUseLatencyProbe,
+              const bool     bNUseRedundancy,
+              const bool     bNUseSeparateInputs,
+              const QString& strSoundFileSetup );
 
     virtual ~CClient();
 
@@ -154,23 +267,43 @@ public:
     EMeterStyle GetMeterStyle() const { return eMeterStyle; }
     void        SetMeterStyle ( const EMeterStyle eNMT ) { eMeterStyle = eNMT; }
 
-    EAudioQuality GetAudioQuality() const { return eAudioQuality; }
-    void          SetAudioQuality ( const EAudioQuality eNAudioQuality );
+    // the audio settings are applied while the audio is processed (without a
+    // restart of the sound card)
+    EAudioQuality GetAudioQuality() const { return AudioParams.eAudioQuality; }
+    void          SetAudioQuality ( const EAudioQuality eNAudioQuality )
+    {
+        AudioParams.eAudioQuality = eNAudioQuality;
+        AudioParamsBuffer.Publish ( AudioParams );
+        PrepareAudioCoding();
+    }
 
-    EAudChanConf GetAudioChannels() const { return eAudioChannelConf; }
-    void         SetAudioChannels ( const EAudChanConf eNAudChanConf );
+    EAudChanConf GetAudioChannels() const { return AudioParams.eAudioChannelConf; }
+    void         SetAudioChannels ( const EAudChanConf eNAudChanConf )
+    {
+        AudioParams.eAudioChannelConf = eNAudChanConf;
+        AudioParamsBuffer.Publish ( AudioParams );
+        PrepareAudioCoding();
+    }
 
-    int  GetAudioInFader() const { return iAudioInFader; }
-    void SetAudioInFader ( const int iNV ) { iAudioInFader = iNV; }
+    int  GetAudioInFader() const { return AudioParams.iAudioInFader; }
+    void SetAudioInFader ( const int iNV )
+    {
+        AudioParams.iAudioInFader = iNV;
+        AudioParamsBuffer.Publish ( AudioParams );
+    }
 
-    int  GetReverbLevel() const { return iReverbLevel; }
-    void SetReverbLevel ( const int iNL ) { iReverbLevel = iNL; }
+    int  GetReverbLevel() const { return AudioParams.iReverbLevel; }
+    void SetReverbLevel ( const int iNL )
+    {
+        AudioParams.iReverbLevel = iNL;
+        AudioParamsBuffer.Publish ( AudioParams );
+    }
 
-    bool IsReverbOnLeftChan() const { return bReverbOnLeftChan; }
+    bool IsReverbOnLeftChan() const { return AudioParams.bReverbOnLeftChan; }
     void SetReverbOnLeftChan ( const bool bIL )
     {
-        bReverbOnLeftChan = bIL;
-        AudioReverb.Clear();
+        AudioParams.bReverbOnLeftChan = bIL;
+        AudioParamsBuffer.Publish ( AudioParams );
     }
 
     void SetDoAutoSockBufSize ( const bool bValue );
@@ -253,14 +386,22 @@ public:
     bool GetFraSiFactDefSupported() { return bFraSiFactDefSupported; }
     bool GetFraSiFactSafeSupported() { return bFraSiFactSafeSupported; }
 
-    void SetMuteOutStream ( const bool bDoMute ) { bMuteOutStream = bDoMute; }
+    void SetMuteOutStream ( const bool bDoMute )
+    {
+        AudioParams.bMuteOutStream = bDoMute;
+        AudioParamsBuffer.Publish ( AudioParams );
+    }
 
     void SetRemoteChanGain ( const int iId, const float fGain, const bool bIsMyOwnFader );
     void SetRemoteChanPan ( const int iId, const float fPan );
     void OnTimerRemoteChanGainOrPan();
     void StartTimerGainOrPan();
 
-    void SetInputBoost ( const int iNewBoost ) { iInputBoost = iNewBoost; }
+    void SetInputBoost ( const int iNewBoost )
+    {
+        AudioParams.iInputBoost = iNewBoost;
+        AudioParamsBuffer.Publish ( AudioParams );
+    }
 
     void SetRemoteInfo() { Channel.SetRemoteInfo ( ChannelInfo ); }
 
@@ -279,8 +420,31 @@ public:
 
     void CreateCLReqServerListMes ( const CHostAddress& InetAddr ) { ConnLessProtocol.CreateCLReqServerListMes ( InetAddr ); }
 
+    void CreateCLReqServerListPageMes ( const CHostAddress& InetAddr, const int iVersion, const int iPage )
+    {
+        ConnLessProtocol.CreateCLReqServerListPageMes ( InetAddr, iVersion, iPage );
+    }
+
+    void CreateCLSubscribeServerListMes ( const CHostAddress& InetAddr, const int iVersion, const int iToken, const bool bSubscribe )
+    {
+        ConnLessProtocol.CreateCLSubscribeServerListMes ( InetAddr, iVersion, iToken, bSubscribe );
+    }
+
     int EstimatedOverallDelay ( const int iPingTimeMs );
 
+    // latency probe mode: the delay is measured in-band by a probe signal which
+    // is detected in our own signal in the mix of the server
+    bool            GetUseLatencyProbe() const { return bUseLatencyProbe; }
+    CDelayBreakdown GetDelayBreakdown ( const int iPingTimeMs );
+    int             GetCurPingTime() const { return iCurPingTime; }
+
+    // network thread mode: minimum time the network thread was ahead of the sound
+    // card in the last measurement period (-1 if not available) and the number of
+    // sound card blocks for which the network thread was too late
+    bool GetUseNetworkThread() const { return bUseNetworkThread; }
+    int  GetNetworkThreadLeadTimeMs() const { return iNetwThreadLeadTimeMs.load ( std::memory_order_relaxed ); }
+    int  GetNetworkThreadNumUnderruns() const { return iNetwThreadNumUnderruns.load ( std::memory_order_relaxed ); }
+
     void GetBufErrorRates ( CVector<double>& vecErrRates, double& dLimit, double& dMaxUpLimit )
     {
         Channel.GetBufErrorRates ( vecErrRates, dLimit, dMaxUpLimit );
@@ -297,11 +461,54 @@ public:
 
 protected:
     // callback function must be static, otherwise it does not work
-    static void AudioCallback ( CVector<short>& psData, void* arg );
+    static void AudioCallback ( CVector<float>& vecfData, void* arg );
+
+    void  Init();
+    void  PrepareAudioCoding();
+    void  ApplyAudioCoding ( const CClientStreamProps& StreamProps );
+    void  UpdateAudioGains ( const CClientAudioParams& Params );
+    void  ProcessSndCrdAudioData ( CVector<float>& vecfStereoSndCrd );
+    void  ProcessAudioDataIntern ( CVector<float>& vecfStereoSndCrd );
+    float EstimatedSoundCardDelayMs();
+    void  ExchangeNetworkThreadData ( CVector<float>& vecfStereoSndCrd );
+    void  ProcessNetworkThreadData();
+    void  UpdateRedundancy();
+
+    // In network thread mode the audio coding and the network transfer is done
+    // in this thread instead of the sound card callback. The callback only
+    // exchanges the audio data with it through wait-free buffers and wakes it up,
+    // so it never waits for the coding or the network.
+    class CNetworkThread : public QThread
+    {
+    public:
+        CNetworkThread ( CClient* pNewClient ) : pClient ( pNewClient ), bRun ( false ), bWakePending ( false )
+        {
+            setObjectName ( "CClientNetworkThread" );
+        }
 
-    void Init();
-    void ProcessSndCrdAudioData ( CVector<short>& vecsStereoSndCrd );
-    void ProcessAudioDataIntern ( CVector<short>& vecsStereoSndCrd );
+        void Start();
+        void Stop();
+
+        // Called in the sound card callback. The release of the semaphore is not
+        // wait-free (it briefly takes the internal lock of the semaphore and may
+        // wake the thread through the OS), therefore it is only done if the thread
+        // is not already woken up.
+        void Wake()
+        {
+            if ( !bWakePending.exchange ( true, std::memory_order_acq_rel ) )
+            {
+                Semaphore.release();
+            }
+        }
+
+    protected:
+        void run() override;
+
+        CClient*          pClient;
+        std::atomic<bool> bRun;
+        std::atomic<bool> bWakePending;
+        QSemaphore        Semaphore;
+    };
 
     int  PreparePingMessage();
     int  EvaluatePingMessage ( const int iMs );
@@ -331,26 +538,35 @@ protected:
     // audio encoder/decoder
     OpusCustomMode*        Opus64Mode;
     OpusCustomEncoder*     Opus64EncoderMono;
+    OpusCustomEncoder*     Opus64EncoderMonoRight; // right input of the separately coded inputs
     OpusCustomDecoder*     Opus64DecoderMono;
     OpusCustomEncoder*     Opus64EncoderStereo;
     OpusCustomDecoder*     Opus64DecoderStereo;
     OpusCustomMode*        OpusMode;
     OpusCustomEncoder*     OpusEncoderMono;
+    OpusCustomEncoder*     OpusEncoderMonoRight;
     OpusCustomDecoder*     OpusDecoderMono;
     OpusCustomEncoder*     OpusEncoderStereo;
     OpusCustomDecoder*     OpusDecoderStereo;
+    OpusCustomEncoder*     Opus64RedEncoderMono; // intra frame encoders for the redundant frames
+    OpusCustomEncoder*     Opus64RedEncoderStereo;
+    OpusCustomEncoder*     OpusRedEncoderMono;
+    OpusCustomEncoder*     OpusRedEncoderStereo;
     OpusCustomEncoder*     CurOpusEncoder;
+    OpusCustomEncoder*     CurOpusEncoderRight;
+    OpusCustomEncoder*     CurOpusRedEncoder;
     OpusCustomDecoder*     CurOpusDecoder;
     EAudComprType          eAudioCompressionType;
     int                    iCeltNumCodedBytes;
     int                    iOPUSFrameSizeSamples;
-    EAudioQuality          eAudioQuality;
-    EAudChanConf           eAudioChannelConf;
+    EAudChanConf           eAudioChannelConf; // currently used by the audio processing
     int                    iNumAudioChannels;
+    bool                   bSeparateInputs; // currently used by the audio coding
+    int                    iSepNumCodedBytes;
     bool                   bIsInitializationPhase;
-    bool                   bMuteOutStream;
-    float                  fMuteOutStreamGain;
     CVector<unsigned char> vecCeltData;
+    CVector<unsigned char> vecRedCeltData;
+    CVector<float>         vecfSepEncIn;
 
     CHighPrioSocket         Socket;
     CSound                  Sound;
@@ -358,22 +574,63 @@ protected:
 
     CVector<uint8_t> vecbyNetwData;
 
-    int          iAudioInFader;
-    bool         bReverbOnLeftChan;
-    int          iReverbLevel;
-    CAudioReverb AudioReverb;
-    int          iInputBoost;
+    // the settings are changed by the thread of the client object only, the audio
+    // processing uses the copy of the snapshot buffer and the smoothed gains
+    CClientAudioParams                  AudioParams;
+    CSnapshotBuffer<CClientAudioParams> AudioParamsBuffer;
+    CSmoothedGain                       InputBoostGain;
+    CSmoothedGain                       ReverbGain;
+    CSmoothedGain                       PanGainLeft;
+    CSmoothedGain                       PanGainRight;
+    CSmoothedGain                       TransmitGain;
+    CSmoothedGain                       MuteOutStreamGain;
+    bool                                bReverbOnLeftChan;
+    CAudioReverb                        AudioReverb;
+
+    // the audio is only sent and received if the channel has taken over the
+    // current properties of the audio coding
+    CSnapshotBuffer<CClientStreamProps> StreamPropsBuffer;
+    int                                 iStreamPropsVersion; // used by the audio coding
+    std::atomic<int>                    iStreamPropsAppliedVersion;
 
     int iSndCrdPrefFrameSizeFactor;
     int iSndCrdFrameSizeFactor;
 
-    bool             bSndCrdConversionBufferRequired;
-    int              iSndCardMonoBlockSizeSamConvBuff;
-    CBuffer<int16_t> SndCrdConversionBufferIn;
-    CBuffer<int16_t> SndCrdConversionBufferOut;
-    CVector<int16_t> vecDataConvBuf;
-    CVector<int16_t> vecsStereoSndCrdMuteStream;
-    CVector<int16_t> vecZeros;
+    // the audio data is processed as normalized float samples from the sound
+    // card callback up to the audio codec
+    bool           bSndCrdConversionBufferRequired;
+    int            iSndCardMonoBlockSizeSamConvBuff;
+    CBuffer<float> SndCrdConversionBufferIn;
+    CBuffer<float> SndCrdConversionBufferOut;
+    CVector<float> vecDataConvBuf;
+    CVector<float> vecfStereoSndCrdMuteStream;
+    CVector<float> vecZeros;
+
+    // network thread mode (the buffers are accessed by the sound card callback
+    // and the network thread, the lead time measurement only by the callback)
+    bool               bUseNetworkThread;
+    CNetworkThread     NetworkThread;
+    QMutex             MutexNetworkThread;
+    CSpscBuffer<float> NetwThreadBufferIn;
+    CSpscBuffer<float> NetwThreadBufferOut;
+    CVector<float>     vecNetwThreadData;
+    int                iNetwThreadLeadMinSam;
+    int                iNetwThreadLeadMeasCnt;
+    std::atomic<int>   iNetwThreadLeadTimeMs;
+    std::atomic<int>   iNetwThreadNumUnderruns;
+
+    // latency probe mode
+    bool          bUseLatencyProbe;
+    CLatencyProbe LatencyProbe;
+
+    // redundancy mode (the loss rates are reported every AUDIO_LOSS_REPORT_INTERVAL_MS)
+    bool bUseRedundancy;
+    int  iUpLossRatePermille;
+    int  iDownLossRatePermille;
+    int  iRedundancyOffCnt;
+
+    // separately coded left and right input in stereo mode
+    bool bUseSeparateInputs;
 
     bool bFraSiFactPrefSupported;
     bool bFraSiFactDefSupported;
@@ -426,6 +683,8 @@ protected slots:
         }
     }
     void OnCLPingReceived ( CHostAddress InetAddr, int iMs );
+    void OnAudioLossRateReceived ( int iLossRatePermille );
+    void OnAudioLossRateMeasured ( int iLossRatePermille );
 
     void OnSendCLProtMessage ( CHostAddress InetAddr, CVector<uint8_t> vecMessage );
 
@@ -456,6 +715,16 @@ signals:
 
     void CLRedServerListReceived ( CHostAddress InetAddr, CVector<CServerInfo> vecServerInfo );
 
+    void CLServerListPageReceived ( CHostAddress InetAddr, int iVersion, int iPage, int iNumPages, CVector<CServerInfo> vecServerInfo );
+
+    void CLServerListDiffReceived ( CHostAddress          InetAddr,
+                                    int                   iBaseVersion,
+                                    int                   iVersion,
+                                    int                   iToken,
+                                    bool                  bResync,
+                                    CVector<CHostAddress> vecRemovedInetAddr,
+                                    CVector<CServerInfo>  vecServerInfo );
+
     void CLConnClientsListMesReceived ( CHostAddress InetAddr, CVector<CChannelInfo> vecChanInfo );
 
     void CLPingTimeWithNumClientsReceived ( CHostAddress InetAddr, int iPingTime, int iNumClients );
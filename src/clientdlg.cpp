@@ -42,6 +42,7 @@ CClientDlg::CClientDlg ( CClient*         pNCliP,
     bEnableIPv6 ( bNEnableIPv6 ),
     eLastRecorderState ( RS_UNDEFINED ), // for SetMixerBoardDeco
     eLastDesign ( GD_ORIGINAL ),         //          "
+    iRefreshCnt ( 0 ),
     ClientSettingsDlg ( pNCliP, pNSetP, parent ),
     ChatDlg ( parent ),
     ConnectDlg ( pNSetP, bNewShowComplRegConnList, parent ),
@@ -197,7 +198,9 @@ CClientDlg::CClientDlg ( CClient*         pNCliP,
                                 "sufficient." ) +
                            "<br>" +
                            tr ( "Overall Delay is calculated from the current Ping Time and the "
-                                "delay introduced by the current buffer settings." );
+                                "delay introduced by the current buffer settings. If the latency "
+                                "probe is enabled, the delay in the audio stream is measured instead "
+                                "and its breakdown is shown in the tool tip." );
 
     lblPing->setWhatsThis ( strConnStats );
     lblPingVal->setWhatsThis ( strConnStats );
@@ -459,9 +462,7 @@ CClientDlg::CClientDlg ( CClient*         pNCliP,
     QObject::connect ( chbLocalMute, &QCheckBox::stateChanged, this, &CClientDlg::OnLocalMuteStateChanged );
 
     // timers
-    QObject::connect ( &TimerSigMet, &QTimer::timeout, this, &CClientDlg::OnTimerSigMet );
-
-    QObject::connect ( &TimerBuffersLED, &QTimer::timeout, this, &CClientDlg::OnTimerBuffersLED );
+    QObject::connect ( &TimerRefresh, &QTimer::timeout, this, &CClientDlg::OnTimerRefresh );
 
     QObject::connect ( &TimerStatus, &QTimer::timeout, this, &CClientDlg::OnTimerStatus );
 
@@ -503,6 +504,10 @@ CClientDlg::CClientDlg ( CClient*         pNCliP,
 
     QObject::connect ( pClient, &CClient::CLRedServerListReceived, this, &CClientDlg::OnCLRedServerListReceived );
 
+    QObject::connect ( pClient, &CClient::CLServerListPageReceived, this, &CClientDlg::OnCLServerListPageReceived );
+
+    QObject::connect ( pClient, &CClient::CLServerListDiffReceived, this, &CClientDlg::OnCLServerListDiffReceived );
+
     QObject::connect ( pClient, &CClient::CLConnClientsListMesReceived, this, &CClientDlg::OnCLConnClientsListMesReceived );
 
     QObject::connect ( pClient, &CClient::CLPingTimeWithNumClientsReceived, this, &CClientDlg::OnCLPingTimeWithNumClientsReceived );
@@ -547,6 +552,10 @@ CClientDlg::CClientDlg ( CClient*         pNCliP,
 
     QObject::connect ( &ConnectDlg, &CConnectDlg::ReqServerListQuery, this, &CClientDlg::OnReqServerListQuery );
 
+    QObject::connect ( &ConnectDlg, &CConnectDlg::ReqServerListPage, this, &CClientDlg::OnReqServerListPage );
+
+    QObject::connect ( &ConnectDlg, &CConnectDlg::SubscribeServerList, this, &CClientDlg::OnSubscribeServerList );
+
     // note that this connection must be a queued connection, otherwise the server list ping
     // times are not accurate and the client list may not be retrieved for all servers listed
     // (it seems the sendto() function needs to be called from different threads to fire the
@@ -1059,7 +1068,25 @@ void CClientDlg::OnLocalMuteStateChanged ( int value )
     }
 }
 
-void CClientDlg::OnTimerSigMet()
+void CClientDlg::OnTimerRefresh()
+{
+    // All periodic updates of the main window while connected are done here in one
+    // pass, so that the GUI thread wakes up only once per refresh interval. The
+    // channel levels of the server are only stored when they are received and are
+    // applied here to the level meters which show a new value.
+    MainMixerBoard->UpdateChannelLevels();
+
+    UpdateInputLevels();
+
+    // the buffer LED shows the state of a longer time interval
+    if ( ++iRefreshCnt >= BUFFER_LED_UPDATE_TIME_MS / LEVELMETER_UPDATE_TIME_MS )
+    {
+        iRefreshCnt = 0;
+        UpdateBuffersLED();
+    }
+}
+
+void CClientDlg::UpdateInputLevels()
 {
     // show current level
     lbrInputLevelL->SetValue ( pClient->GetLevelForMeterdBLeft() );
@@ -1090,7 +1117,7 @@ void CClientDlg::OnTimerSigMet()
     }
 }
 
-void CClientDlg::OnTimerBuffersLED()
+void CClientDlg::UpdateBuffersLED()
 {
     CMultiColorLED::ELightColor eCurStatus;
 
@@ -1147,6 +1174,27 @@ void CClientDlg::OnPingTimeResult ( int iPingTime )
     }
     SetPingTime ( iPingTime, iOverallDelayMs, eOverallDelayLEDColor );
 
+    // show the breakdown of the measured delay
+    if ( pClient->GetUseLatencyProbe() )
+    {
+        const CDelayBreakdown DelayBreakdown = pClient->GetDelayBreakdown ( iPingTime );
+
+        if ( DelayBreakdown.iMeasuredMs >= 0 )
+        {
+            lblDelayVal->setToolTip ( tr ( "Measured audio stream: %1 ms (ping: %2 ms, jitter buffers: %3 ms, "
+                                           "server and audio codec: %4 ms), sound card: %5 ms" )
+                                          .arg ( DelayBreakdown.iMeasuredMs )
+                                          .arg ( DelayBreakdown.iPingMs )
+                                          .arg ( DelayBreakdown.iJitterBufferMs )
+                                          .arg ( DelayBreakdown.iServerAndCodecMs )
+                                          .arg ( DelayBreakdown.iSoundCardMs ) );
+        }
+        else
+        {
+            lblDelayVal->setToolTip ( tr ( "The latency probe was not detected, the delay is estimated." ) );
+        }
+    }
+
     // update delay LED on the main window
     ledDelay->SetLight ( eOverallDelayLEDColor );
 }
@@ -1238,8 +1286,8 @@ void CClientDlg::Connect ( const QString& strSelectedAddress, const QString& str
         MainMixerBoard->SetServerName ( strMixerBoardLabel );
 
         // start timer for level meter bar and ping time measurement
-        TimerSigMet.start ( LEVELMETER_UPDATE_TIME_MS );
-        TimerBuffersLED.start ( BUFFER_LED_UPDATE_TIME_MS );
+        iRefreshCnt = 0;
+        TimerRefresh.start ( LEVELMETER_UPDATE_TIME_MS );
         TimerPing.start ( PING_UPDATE_TIME_MS );
         TimerCheckAudioDeviceOk.start ( CHECK_AUDIO_DEV_OK_TIME_MS ); // is single shot timer
 
@@ -1270,7 +1318,7 @@ void CClientDlg::Disconnect()
     MainMixerBoard->SetServerName ( "" );
 
     // stop timer for level meter bars and reset them
-    TimerSigMet.stop();
+    TimerRefresh.stop();
     lbrInputLevelL->setEnabled ( false );
     lbrInputLevelR->setEnabled ( false );
     lbrInputLevelL->SetValue ( 0 );
@@ -1280,7 +1328,6 @@ void CClientDlg::Disconnect()
     lblConnectToServer->show();
 
     // stop other timers
-    TimerBuffersLED.stop();
     TimerPing.stop();
     TimerCheckAudioDeviceOk.stop();
     TimerDetectFeedback.stop();
@@ -1300,6 +1347,7 @@ void CClientDlg::Disconnect()
     lblPingVal->setText ( "---" );
     lblPingUnit->setText ( "" );
     lblDelayVal->setText ( "---" );
+    lblDelayVal->setToolTip ( "" );
     lblDelayUnit->setText ( "" );
 
     // clear mixer board (remove all faders)
@@ -62,8 +62,8 @@
 
 /* Definitions ****************************************************************/
 // update time for GUI controls
-#define LEVELMETER_UPDATE_TIME_MS  100  // ms
-#define BUFFER_LED_UPDATE_TIME_MS  300  // ms
+#define LEVELMETER_UPDATE_TIME_MS  100  // ms (GUI refresh interval while connected)
+#define BUFFER_LED_UPDATE_TIME_MS  300  // ms (multiple of the GUI refresh interval)
 #define LED_BAR_UPDATE_TIME_MS     1000 // ms
 #define CHECK_AUDIO_DEV_OK_TIME_MS 5000 // ms
 #define DETECT_FEEDBACK_TIME_MS    3000 // ms
@@ -112,8 +112,8 @@ protected:
     bool           bEnableIPv6;
     ERecorderState eLastRecorderState;
     EGUIDesign     eLastDesign;
-    QTimer         TimerSigMet;
-    QTimer         TimerBuffersLED;
+    QTimer         TimerRefresh;
+    int            iRefreshCnt;
     QTimer         TimerStatus;
     QTimer         TimerPing;
     QTimer         TimerCheckAudioDeviceOk;
@@ -123,6 +123,8 @@ protected:
     virtual void dragEnterEvent ( QDragEnterEvent* Event ) { ManageDragNDrop ( Event, true ); }
     virtual void dropEvent ( QDropEvent* Event ) { ManageDragNDrop ( Event, false ); }
     void         UpdateDisplay();
+    void         UpdateInputLevels();
+    void         UpdateBuffersLED();
 
     CClientSettingsDlg ClientSettingsDlg;
     CChatDlg           ChatDlg;
@@ -131,8 +133,7 @@ protected:
 
 public slots:
     void OnConnectDisconBut();
-    void OnTimerSigMet();
-    void OnTimerBuffersLED();
+    void OnTimerRefresh();
     void OnTimerCheckAudioDeviceOk();
     void OnTimerDetectFeedback();
 
@@ -205,6 +206,16 @@ public slots:
 
     void OnReqServerListQuery ( CHostAddress InetAddr ) { pClient->CreateCLReqServerListMes ( InetAddr ); }
 
+    void OnReqServerListPage ( CHostAddress InetAddr, int iVersion, int iPage )
+    {
+        pClient->CreateCLReqServerListPageMes ( InetAddr, iVersion, iPage );
+    }
+
+    void OnSubscribeServerList ( CHostAddress InetAddr, int iVersion, int iToken, bool bSubscribe )
+    {
+        pClient->CreateCLSubscribeServerListMes ( InetAddr, iVersion, iToken, bSubscribe );
+    }
+
     void OnCreateCLServerListPingMes ( CHostAddress InetAddr ) { pClient->CreateCLServerListPingMes ( InetAddr ); }
 
     void OnCreateCLServerListReqVerAndOSMes ( CHostAddress InetAddr ) { pClient->CreateCLServerListReqVerAndOSMes ( InetAddr ); }
@@ -221,6 +232,22 @@ public slots:
         ConnectDlg.SetServerList ( InetAddr, vecServerInfo, true );
     }
 
+    void OnCLServerListPageReceived ( CHostAddress InetAddr, int iVersion, int iPage, int iNumPages, CVector<CServerInfo> vecServerInfo )
+    {
+        ConnectDlg.SetServerListPage ( InetAddr, iVersion, iPage, iNumPages, vecServerInfo );
+    }
+
+    void OnCLServerListDiffReceived ( CHostAddress          InetAddr,
+                                      int                   iBaseVersion,
+                                      int                   iVersion,
+                                      int                   iToken,
+                                      bool                  bResync,
+                                      CVector<CHostAddress> vecRemovedInetAddr,
+                                      CVector<CServerInfo>  vecServerInfo )
+    {
+        ConnectDlg.SetServerListDiff ( InetAddr, iBaseVersion, iVersion, iToken, bResync, vecRemovedInetAddr, vecServerInfo );
+    }
+
     void OnCLConnClientsListMesReceived ( CHostAddress InetAddr, CVector<CChannelInfo> vecChanInfo )
     {
         ConnectDlg.SetConnClientsList ( InetAddr, vecChanInfo );
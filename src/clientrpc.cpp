@@ -193,8 +193,35 @@ CClientRpc::CClientRpc ( CClient* pClient, CRpcServer* pRpcServer, QObject* pare
     /// @brief Returns the client information.
     /// @param {object} params - No parameters (empty object).
     /// @result {boolean} result.connected - Whether the client is connected to the server.
+    /// @result {number} result.networkThreadLeadTimeMs - Minimum lead of the network thread in the last second, -1 if unknown (--netthread).
+    /// @result {number} result.networkThreadUnderruns - Number of sound card blocks the network thread was too late for (--netthread).
+    /// @result {number} result.delayMs - Overall delay, measured if available (--latencyprobe).
+    /// @result {number} result.measuredDelayMs - Measured delay from audio encoder to decoder, -1 if not detected (--latencyprobe).
+    /// @result {number} result.pingMs - Last network round trip time, -1 if unknown (--latencyprobe).
+    /// @result {number} result.jitterBufferDelayMs - Delay of the client and server jitter buffers (--latencyprobe).
+    /// @result {number} result.serverAndCodecDelayMs - Rest of the measured delay, -1 if unknown (--latencyprobe).
+    /// @result {number} result.soundCardDelayMs - Reported or estimated sound card delay (--latencyprobe).
     pRpcServer->HandleMethod ( "jamulusclient/getClientInfo", [=] ( const QJsonObject& params, QJsonObject& response ) {
         QJsonObject result{ { "connected", pClient->IsConnected() } };
+
+        if ( pClient->GetUseNetworkThread() )
+        {
+            result["networkThreadLeadTimeMs"] = pClient->GetNetworkThreadLeadTimeMs();
+            result["networkThreadUnderruns"]  = pClient->GetNetworkThreadNumUnderruns();
+        }
+
+        if ( pClient->GetUseLatencyProbe() )
+        {
+            const CDelayBreakdown DelayBreakdown = pClient->GetDelayBreakdown ( pClient->GetCurPingTime() );
+
+            result["delayMs"]               = DelayBreakdown.iOverallMs;
+            result["measuredDelayMs"]       = DelayBreakdown.iMeasuredMs;
+            result["pingMs"]                = DelayBreakdown.iPingMs;
+            result["jitterBufferDelayMs"]   = DelayBreakdown.iJitterBufferMs;
+            result["serverAndCodecDelayMs"] = DelayBreakdown.iServerAndCodecMs;
+            result["soundCardDelayMs"]      = DelayBreakdown.iSoundCardMs;
+        }
+
         response["result"] = result;
         Q_UNUSED ( params );
     } );
@@ -102,10 +102,19 @@ CConnectDlg::CConnectDlg ( CClientSettings* pNSetP, const bool bNewShowCompleteR
     bShowCompleteRegList ( bNewShowCompleteRegList ),
     bServerListReceived ( false ),
     bReducedServerListReceived ( false ),
+    bPagedServerListReceived ( false ),
+    bServerListTruncated ( false ),
     bServerListItemWasChosen ( false ),
     bListFilterWasActive ( false ),
     bShowAllMusicians ( true ),
-    bEnableIPv6 ( bNEnableIPv6 )
+    bEnableIPv6 ( bNEnableIPv6 ),
+    iServerListPageVersion ( 0 ),
+    iServerListNumPages ( 0 ),
+    iServerListVersion ( -1 ),
+    iServerListToken ( 0 ),
+    bServerListTokenReceived ( false ),
+    iNextPendingServerInfo ( 0 ),
+    bListViewSortPending ( false )
 {
     setupUi ( this );
 
@@ -230,6 +239,15 @@ CConnectDlg::CConnectDlg ( CClientSettings* pNSetP, const bool bNewShowCompleteR
 
     // setup timers
     TimerInitialSort.setSingleShot ( true ); // only once after list request
+    TimerAddServerListItems.setSingleShot ( true );
+    TimerAddServerListItems.setInterval ( 0 );
+    TimerUpdateListView.setSingleShot ( true );
+    TimerUpdateListView.setInterval ( LIST_VIEW_UPDATE_TIME_SERVER_LIST_MS );
+
+    TimerRenewSubscription.setInterval ( SERVLIST_SUBSCRIPTION_RENEW_TIME_MS );
+
+    // time base of the ping scheduler
+    PingClock.start();
 
 #if defined( ANDROID ) || defined( Q_OS_IOS )
     // for the Android and iOS version maximize the window
@@ -266,6 +284,12 @@ CConnectDlg::CConnectDlg ( CClientSettings* pNSetP, const bool bNewShowCompleteR
     QObject::connect ( &TimerPing, &QTimer::timeout, this, &CConnectDlg::OnTimerPing );
 
     QObject::connect ( &TimerReRequestServList, &QTimer::timeout, this, &CConnectDlg::OnTimerReRequestServList );
+
+    QObject::connect ( &TimerAddServerListItems, &QTimer::timeout, this, &CConnectDlg::OnTimerAddServerListItems );
+
+    QObject::connect ( &TimerUpdateListView, &QTimer::timeout, this, &CConnectDlg::OnTimerUpdateListView );
+
+    QObject::connect ( &TimerRenewSubscription, &QTimer::timeout, this, &CConnectDlg::OnTimerRenewSubscription );
 }
 
 void CConnectDlg::showEvent ( QShowEvent* )
@@ -289,18 +313,26 @@ void CConnectDlg::showEvent ( QShowEvent* )
 
 void CConnectDlg::RequestServerList()
 {
+    // the changes of the current list are not needed anymore
+    CancelServerListSubscription();
+
     // reset flags
     bServerListReceived        = false;
     bReducedServerListReceived = false;
+    bPagedServerListReceived   = false;
+    bServerListTruncated       = false;
     bServerListItemWasChosen   = false;
     bListFilterWasActive       = false;
+    bServerListTokenReceived   = false;
+    iServerListNumPages        = 0;
+    mapServerListPages.clear();
 
     // clear current address and name
     strSelectedAddress    = "";
     strSelectedServerName = "";
 
     // clear server list view
-    lvwServers->clear();
+    ClearServerList();
 
     // update list combo box (disable events to avoid a signal)
     cbxDirectory->blockSignals ( true );
@@ -340,9 +372,14 @@ void CConnectDlg::RequestServerList()
 
 void CConnectDlg::hideEvent ( QHideEvent* )
 {
+    // if window is closed, the list is not updated anymore
+    CancelServerListSubscription();
+
     // if window is closed, stop timers
     TimerPing.stop();
     TimerReRequestServList.stop();
+    TimerAddServerListItems.stop();
+    TimerUpdateListView.stop();
 }
 
 void CConnectDlg::OnDirectoryChanged ( int iTypeIdx )
@@ -366,14 +403,25 @@ void CConnectDlg::OnDirectoryChanged ( int iTypeIdx )
 
 void CConnectDlg::OnTimerReRequestServList()
 {
-    // if the server list is not yet received, retransmit the request for the
-    // server list
-    if ( !bServerListReceived )
+    // if a paged server list is not yet complete, re-request the missing pages,
+    // otherwise if the server list is not yet received, retransmit the request
+    // for the server list
+    if ( ( iServerListNumPages > 0 ) && !bPagedServerListReceived )
+    {
+        RequestMissingServerListPages();
+    }
+    else if ( !bServerListReceived )
     {
         // note that this is a connection less message which may get lost
         // and therefore it makes sense to re-transmit it
         emit ReqServerListQuery ( haDirectoryAddress );
     }
+    else if ( bServerListTruncated && !bPagedServerListReceived )
+    {
+        // the first page of the truncated list got lost, it tells the number of
+        // pages (the directory answers with the page of its current list)
+        emit ReqServerListPage ( haDirectoryAddress, iServerListPageVersion, 0 );
+    }
 }
 
 void CConnectDlg::SetServerList ( const CHostAddress& InetAddr, const CVector<CServerInfo>& vecServerInfo, const bool bIsReducedServerList )
@@ -405,136 +453,408 @@ void CConnectDlg::SetServerList ( const CHostAddress& InetAddr, const CVector<CS
     else
     {
         // set flag and disable timer for resend server list request if full list
-        // was received (i.e. not the reduced list)
-        bServerListReceived = true;
-        TimerReRequestServList.stop();
+        // was received (i.e. not the reduced list), a list of the maximum legacy
+        // length is the beginning of a paged list and the timer keeps requesting
+        // the pages until the paged list is complete
+        bServerListReceived  = true;
+        bServerListTruncated = ( vecServerInfo.Size() == MAX_NUM_SERVERS_IN_LEGACY_SERVER_LIST );
+
+        if ( ( iServerListNumPages == 0 ) && !bServerListTruncated )
+        {
+            TimerReRequestServList.stop();
+        }
+    }
+
+    ShowServerList ( InetAddr, vecServerInfo );
+}
+
+void CConnectDlg::SetServerListPage ( const CHostAddress&         InetAddr,
+                                      const int                   iVersion,
+                                      const int                   iPage,
+                                      const int                   iNumPages,
+                                      const CVector<CServerInfo>& vecServerInfo )
+{
+    // we only accept pages from the directory we have sent the request to and
+    // only until the complete list is assembled
+    if ( bPagedServerListReceived || ( InetAddr.InetAddr != haDirectoryAddress.InetAddr ) )
+    {
+        return;
+    }
+
+    // the first page or a page of a changed list (re)starts the assembly, pages
+    // of different versions of the list must not be combined
+    if ( ( iServerListNumPages == 0 ) || ( iVersion != iServerListPageVersion ) || ( iNumPages != iServerListNumPages ) )
+    {
+        iServerListPageVersion = iVersion;
+        iServerListNumPages    = iNumPages;
+        mapServerListPages.clear();
+        mapServerListPages.insert ( iPage, vecServerInfo );
+
+        RequestMissingServerListPages();
+
+        // the timer re-requests pages which got lost
+        TimerReRequestServList.start ( SERV_LIST_REQ_UPDATE_TIME_MS );
     }
+    else
+    {
+        mapServerListPages.insert ( iPage, vecServerInfo );
+    }
+
+    if ( mapServerListPages.size() < iServerListNumPages )
+    {
+        return;
+    }
+
+    // the list is complete, it replaces any (truncated) server list received
+    // before and no further server list is accepted
+    bPagedServerListReceived = true;
+    bServerListReceived      = true;
+    TimerReRequestServList.stop();
+
+    CVector<CServerInfo> vecCompleteServerInfo;
+
+    foreach ( const CVector<CServerInfo>& vecPageServerInfo, mapServerListPages )
+    {
+        vecCompleteServerInfo.insert ( vecCompleteServerInfo.end(), vecPageServerInfo.begin(), vecPageServerInfo.end() );
+    }
+
+    mapServerListPages.clear();
+
+    ShowServerList ( InetAddr, vecCompleteServerInfo );
 
+    // the list is kept up to date by the changes the directory sends
+    iServerListVersion = iServerListPageVersion;
+    RenewServerListSubscription();
+}
+
+void CConnectDlg::SetServerListDiff ( const CHostAddress&          InetAddr,
+                                      const int                    iBaseVersion,
+                                      const int                    iVersion,
+                                      const int                    iToken,
+                                      const bool                   bResync,
+                                      const CVector<CHostAddress>& vecRemovedInetAddr,
+                                      const CVector<CServerInfo>&  vecServerInfo )
+{
+    if ( InetAddr.InetAddr != haDirectoryAddress.InetAddr )
+    {
+        return;
+    }
+
+    // every diff carries the token we need to subscribe, it may arrive after the
+    // paged server list is complete
+    const bool bTokenIsNew = !bServerListTokenReceived;
+
+    iServerListToken         = iToken;
+    bServerListTokenReceived = true;
+
+    if ( bTokenIsNew && ( iServerListVersion >= 0 ) )
+    {
+        RenewServerListSubscription();
+    }
+
+    // we only accept changes of the server list we have received from the directory
+    if ( !bServerListReceived )
+    {
+        return;
+    }
+
+    // a diff without changes tells the version of a server list which was not paged
+    // (the version of a paged list is taken from its pages)
+    if ( iServerListVersion < 0 )
+    {
+        if ( !bResync && ( iBaseVersion == iVersion ) && ( iServerListNumPages == 0 ) && !bServerListTruncated )
+        {
+            iServerListVersion = iVersion;
+            RenewServerListSubscription();
+        }
+        return;
+    }
+
+    // the changes are not available anymore, so we need the complete list again
+    if ( bResync )
+    {
+        RequestServerList();
+        return;
+    }
+
+    // if a diff got lost (or the list view items are still being created), the renewed
+    // subscription tells the directory which changes we need
+    if ( ( iBaseVersion != iServerListVersion ) || ( vecPendingServerInfo.Size() > 0 ) )
+    {
+        if ( iVersion != iServerListVersion )
+        {
+            RenewServerListSubscription();
+        }
+        return;
+    }
+
+    // the removed entries are applied first, a changed entry replaces the old one
+    for ( int iIdx = 0; iIdx < vecRemovedInetAddr.Size(); iIdx++ )
+    {
+        RemoveServerListItem ( vecRemovedInetAddr[iIdx].toString() );
+    }
+
+    for ( int iIdx = 0; iIdx < vecServerInfo.Size(); iIdx++ )
+    {
+        RemoveServerListItem ( vecServerInfo[iIdx].HostAddr.toString() );
+        AddServerListItem ( vecServerInfo[iIdx].HostAddr, vecServerInfo[iIdx], lvwServers->topLevelItemCount() );
+    }
+
+    iServerListVersion = iVersion;
+
+    // the new items have to pass the list filter
+    if ( !TimerUpdateListView.isActive() )
+    {
+        TimerUpdateListView.start();
+    }
+}
+
+void CConnectDlg::RenewServerListSubscription()
+{
+    // subscribe (again) to the changes of the server list, this also tells the
+    // directory the version we have (note that this message may get lost)
+    if ( iServerListVersion >= 0 )
+    {
+        if ( bServerListTokenReceived )
+        {
+            emit SubscribeServerList ( haDirectoryAddress, iServerListVersion, iServerListToken, true );
+        }
+        else
+        {
+            // the directory sends the token with the first page of the list
+            emit ReqServerListPage ( haDirectoryAddress, iServerListVersion, 0 );
+        }
+
+        TimerRenewSubscription.start();
+    }
+}
+
+void CConnectDlg::CancelServerListSubscription()
+{
+    if ( ( iServerListVersion >= 0 ) && bServerListTokenReceived )
+    {
+        emit SubscribeServerList ( haDirectoryAddress, iServerListVersion, iServerListToken, false );
+    }
+
+    iServerListVersion = -1;
+    TimerRenewSubscription.stop();
+}
+
+void CConnectDlg::RequestMissingServerListPages()
+{
+    for ( int iPage = 0; iPage < iServerListNumPages; iPage++ )
+    {
+        if ( !mapServerListPages.contains ( iPage ) )
+        {
+            // note that this is a connection less message which may get lost
+            emit ReqServerListPage ( haDirectoryAddress, iServerListPageVersion, iPage );
+        }
+    }
+}
+
+void CConnectDlg::ShowServerList ( const CHostAddress& InetAddr, const CVector<CServerInfo>& vecServerInfo )
+{
     // first clear list
+    ClearServerList();
+
+    // the list view items are created in batches so that long lists do not
+    // block the GUI, the first batch is added immediately
+    haPendingServerListAddr = InetAddr;
+    vecPendingServerInfo    = vecServerInfo;
+    iNextPendingServerInfo  = 0;
+
+    OnTimerAddServerListItems();
+
+    // immediately issue the ping measurements and start the ping scheduler
+    // since the server list is (being) filled now
+    OnTimerPing();
+    TimerPing.start ( PING_SLOT_TIME_SERVER_LIST_MS );
+}
+
+void CConnectDlg::ClearServerList()
+{
     lvwServers->clear();
+    mapListViewItems.clear();
+    mapPingQueueHighPrio.clear();
+    mapPingQueueLowPrio.clear();
+    mapClientsChangeTime.clear();
+    vecPendingServerInfo.Init ( 0 );
+    iNextPendingServerInfo = 0;
+    TimerAddServerListItems.stop();
+}
 
-    // add list item for each server in the server list
-    const int iServerInfoLen = vecServerInfo.Size();
+void CConnectDlg::OnTimerAddServerListItems()
+{
+    const CHostAddress&         InetAddr       = haPendingServerListAddr;
+    const CVector<CServerInfo>& vecServerInfo  = vecPendingServerInfo;
+    const int                   iServerInfoLen = std::min ( vecServerInfo.Size(), iNextPendingServerInfo + NUM_SERVER_LIST_ITEMS_PER_BATCH );
 
-    for ( int iIdx = 0; iIdx < iServerInfoLen; iIdx++ )
+    // add list item for each server of this batch
+    for ( int iIdx = iNextPendingServerInfo; iIdx < iServerInfoLen; iIdx++ )
     {
         // get the host address, note that for the very first entry which is
         // the directory server, we have to use the receive host address
         // instead
-        CHostAddress CurHostAddress;
-
         if ( iIdx > 0 )
         {
-            CurHostAddress = vecServerInfo[iIdx].HostAddr;
+            AddServerListItem ( vecServerInfo[iIdx].HostAddr, vecServerInfo[iIdx], iIdx );
         }
         else
         {
             // substitute the receive host address for directory server
-            CurHostAddress = InetAddr;
+            AddServerListItem ( InetAddr, vecServerInfo[iIdx], iIdx );
         }
+    }
 
-        // create new list view item
-        CMappedTreeWidgetItem* pNewListViewItem = new CMappedTreeWidgetItem ( lvwServers );
+    iNextPendingServerInfo = iServerInfoLen;
 
-        // make the entry invisible (will be set to visible on successful ping
-        // result) if the complete list of registered servers shall not be shown
-        if ( !bShowCompleteRegList )
-        {
-            pNewListViewItem->setHidden ( true );
-        }
+    if ( iNextPendingServerInfo < vecServerInfo.Size() )
+    {
+        // let the GUI process other events before the next batch
+        TimerAddServerListItems.start();
+    }
+    else
+    {
+        vecPendingServerInfo.Init ( 0 );
+        iNextPendingServerInfo = 0;
+    }
+}
+
+void CConnectDlg::AddServerListItem ( const CHostAddress& CurHostAddress, const CServerInfo& ServerInfo, const int iIdx )
+{
+    // create new list view item
+    CMappedTreeWidgetItem* pNewListViewItem = new CMappedTreeWidgetItem ( lvwServers );
+
+    // make the entry invisible (will be set to visible on successful ping
+    // result) if the complete list of registered servers shall not be shown
+    if ( !bShowCompleteRegList )
+    {
+        pNewListViewItem->setHidden ( true );
+    }
 
-        // server name (if empty, show host address instead)
-        if ( !vecServerInfo[iIdx].strName.isEmpty() )
+    // server name (if empty, show host address instead)
+    if ( !ServerInfo.strName.isEmpty() )
+    {
+        pNewListViewItem->setText ( LVC_NAME, ServerInfo.strName );
+    }
+    else
+    {
+        // IP address and port (use IP number without last byte)
+        // Definition: If the port number is the default port number, we do
+        // not show it.
+        if ( ServerInfo.HostAddr.iPort == DEFAULT_PORT_NUMBER )
         {
-            pNewListViewItem->setText ( LVC_NAME, vecServerInfo[iIdx].strName );
+            // only show IP number, no port number
+            pNewListViewItem->setText ( LVC_NAME, CurHostAddress.toString ( CHostAddress::SM_IP_NO_LAST_BYTE ) );
         }
         else
         {
-            // IP address and port (use IP number without last byte)
-            // Definition: If the port number is the default port number, we do
-            // not show it.
-            if ( vecServerInfo[iIdx].HostAddr.iPort == DEFAULT_PORT_NUMBER )
-            {
-                // only show IP number, no port number
-                pNewListViewItem->setText ( LVC_NAME, CurHostAddress.toString ( CHostAddress::SM_IP_NO_LAST_BYTE ) );
-            }
-            else
-            {
-                // show IP number and port
-                pNewListViewItem->setText ( LVC_NAME, CurHostAddress.toString ( CHostAddress::SM_IP_NO_LAST_BYTE_PORT ) );
-            }
+            // show IP number and port
+            pNewListViewItem->setText ( LVC_NAME, CurHostAddress.toString ( CHostAddress::SM_IP_NO_LAST_BYTE_PORT ) );
         }
+    }
 
-        // in case of all servers shown, add the registration number at the beginning
-        if ( bShowCompleteRegList )
-        {
-            pNewListViewItem->setText ( LVC_NAME, QString ( "%1: " ).arg ( 1 + iIdx, 3 ) + pNewListViewItem->text ( LVC_NAME ) );
-        }
+    // in case of all servers shown, add the registration number at the beginning
+    if ( bShowCompleteRegList )
+    {
+        pNewListViewItem->setText ( LVC_NAME, QString ( "%1: " ).arg ( 1 + iIdx, 3 ) + pNewListViewItem->text ( LVC_NAME ) );
+    }
 
-        // show server name in bold font if it is a permanent server
-        QFont CurServerNameFont = pNewListViewItem->font ( LVC_NAME );
-        CurServerNameFont.setBold ( vecServerInfo[iIdx].bPermanentOnline );
-        pNewListViewItem->setFont ( LVC_NAME, CurServerNameFont );
+    // show server name in bold font if it is a permanent server
+    QFont CurServerNameFont = pNewListViewItem->font ( LVC_NAME );
+    CurServerNameFont.setBold ( ServerInfo.bPermanentOnline );
+    pNewListViewItem->setFont ( LVC_NAME, CurServerNameFont );
 
-        // the ping time shall be shown in bold font
-        QFont CurPingTimeFont = pNewListViewItem->font ( LVC_PING );
-        CurPingTimeFont.setBold ( true );
-        pNewListViewItem->setFont ( LVC_PING, CurPingTimeFont );
+    // the ping time shall be shown in bold font
+    QFont CurPingTimeFont = pNewListViewItem->font ( LVC_PING );
+    CurPingTimeFont.setBold ( true );
+    pNewListViewItem->setFont ( LVC_PING, CurPingTimeFont );
 
-        // server location (city and country)
-        QString strLocation = vecServerInfo[iIdx].strCity;
+    // server location (city and country)
+    QString strLocation = ServerInfo.strCity;
 
-        if ( ( !strLocation.isEmpty() ) && ( vecServerInfo[iIdx].eCountry != QLocale::AnyCountry ) )
-        {
-            strLocation += ", ";
-        }
+    if ( ( !strLocation.isEmpty() ) && ( ServerInfo.eCountry != QLocale::AnyCountry ) )
+    {
+        strLocation += ", ";
+    }
 
-        if ( vecServerInfo[iIdx].eCountry != QLocale::AnyCountry )
-        {
-            QString strCountryToString = QLocale::countryToString ( vecServerInfo[iIdx].eCountry );
+    if ( ServerInfo.eCountry != QLocale::AnyCountry )
+    {
+        QString strCountryToString = QLocale::countryToString ( ServerInfo.eCountry );
 
-            // Qt countryToString does not use spaces in between country name
-            // parts but they use upper case letters which we can detect and
-            // insert spaces as a post processing
+        // Qt countryToString does not use spaces in between country name
+        // parts but they use upper case letters which we can detect and
+        // insert spaces as a post processing
 #if QT_VERSION >= QT_VERSION_CHECK( 5, 0, 0 )
-            if ( !strCountryToString.contains ( " " ) )
+        if ( !strCountryToString.contains ( " " ) )
+        {
+            QRegularExpressionMatchIterator reMatchIt = QRegularExpression ( "[A-Z][^A-Z]*" ).globalMatch ( strCountryToString );
+            QStringList                     slNames;
+            while ( reMatchIt.hasNext() )
             {
-                QRegularExpressionMatchIterator reMatchIt = QRegularExpression ( "[A-Z][^A-Z]*" ).globalMatch ( strCountryToString );
-                QStringList                     slNames;
-                while ( reMatchIt.hasNext() )
-                {
-                    slNames << reMatchIt.next().capturedTexts();
-                }
-                strCountryToString = slNames.join ( " " );
+                slNames << reMatchIt.next().capturedTexts();
             }
+            strCountryToString = slNames.join ( " " );
+        }
 #endif
 
-            strLocation += strCountryToString;
-        }
+        strLocation += strCountryToString;
+    }
+
+    pNewListViewItem->setText ( LVC_LOCATION, strLocation );
+
+    // init the minimum ping time with a large number (note that this number
+    // must fit in an integer type)
+    pNewListViewItem->setText ( LVC_PING_MIN_HIDDEN, "99999999" );
+
+    // store the maximum number of clients
+    pNewListViewItem->setText ( LVC_CLIENTS_MAX_HIDDEN, QString().setNum ( ServerInfo.iMaxNumClients ) );
+
+    // store host address
+    const QString strCurHostAddress = CurHostAddress.toString();
+    pNewListViewItem->setData ( LVC_NAME, Qt::UserRole, strCurHostAddress );
+
+    // index the item by its address and ping it as soon as possible (if a server
+    // is listed more than once, the first item gets the results as before)
+    if ( !mapListViewItems.contains ( strCurHostAddress ) )
+    {
+        mapListViewItems.insert ( strCurHostAddress, pNewListViewItem );
+        mapPingQueueHighPrio.insert ( PingClock.elapsed(), strCurHostAddress );
+    }
 
-        pNewListViewItem->setText ( LVC_LOCATION, strLocation );
+    // per default expand the list item (if not "show all servers")
+    if ( bShowAllMusicians )
+    {
+        lvwServers->expandItem ( pNewListViewItem );
+    }
+}
+
+void CConnectDlg::RemoveServerListItem ( const QString& strHostAddress )
+{
+    // deleting the item also removes it from the list view
+    delete mapListViewItems.take ( strHostAddress );
 
-        // init the minimum ping time with a large number (note that this number
-        // must fit in an integer type)
-        pNewListViewItem->setText ( LVC_PING_MIN_HIDDEN, "99999999" );
+    mapClientsChangeTime.remove ( strHostAddress );
 
-        // store the maximum number of clients
-        pNewListViewItem->setText ( LVC_CLIENTS_MAX_HIDDEN, QString().setNum ( vecServerInfo[iIdx].iMaxNumClients ) );
+    // the server must not stay in the ping queues, it is queued again if it is added again
+    QMultiMap<qint64, QString>* pPingQueues[] = { &mapPingQueueHighPrio, &mapPingQueueLowPrio };
 
-        // store host address
-        pNewListViewItem->setData ( LVC_NAME, Qt::UserRole, CurHostAddress.toString() );
+    for ( QMultiMap<qint64, QString>* pQueue : pPingQueues )
+    {
+        QMultiMap<qint64, QString>::iterator it = pQueue->begin();
 
-        // per default expand the list item (if not "show all servers")
-        if ( bShowAllMusicians )
+        while ( it != pQueue->end() )
         {
-            lvwServers->expandItem ( pNewListViewItem );
+            if ( it.value() == strHostAddress )
+            {
+                it = pQueue->erase ( it );
+            }
+            else
+            {
+                ++it;
+            }
         }
     }
-
-    // immediately issue the ping measurements and start the ping timer since
-    // the server list is filled now
-    OnTimerPing();
-    TimerPing.start ( PING_UPDATE_TIME_SERVER_LIST_MS );
 }
 
 void CConnectDlg::SetConnClientsList ( const CHostAddress& InetAddr, const CVector<CChannelInfo>& vecChanInfo )
@@ -841,42 +1161,75 @@ void CConnectDlg::OnDeleteServerAddrClicked()
 
 void CConnectDlg::OnTimerPing()
 {
-    // send ping messages to the servers in the list
-    const int iServerListLen = lvwServers->topLevelItemCount();
+    // The ping time messages for all servers should not be sent all in a very
+    // short time since it showed that this leads to errors in the ping time
+    // measurement (#49). We therefore spread the pings over short time slots,
+    // with just enough pings per slot to ping every server once per update time.
+    const int iNumServers        = static_cast<int> ( mapListViewItems.size() );
+    const int iNumSlotsPerUpdate = PING_UPDATE_TIME_SERVER_LIST_MS / PING_SLOT_TIME_SERVER_LIST_MS;
+    const int iNumPingsPerSlot   = std::max ( PING_MIN_NUM_PER_SLOT_SERVER_LIST, ( iNumServers + iNumSlotsPerUpdate - 1 ) / iNumSlotsPerUpdate );
 
-    for ( int iIdx = 0; iIdx < iServerListLen; iIdx++ )
+    const qint64 iNow     = PingClock.elapsed();
+    int          iNumSent = 0;
+
+    // servers which are due are taken from the high priority queue first
+    while ( iNumSent < iNumPingsPerSlot )
     {
-        QTreeWidgetItem* pCurListViewItem = lvwServers->topLevelItem ( iIdx );
+        QMultiMap<qint64, QString>* pQueue = nullptr;
+
+        if ( !mapPingQueueHighPrio.isEmpty() && ( mapPingQueueHighPrio.firstKey() <= iNow ) )
+        {
+            pQueue = &mapPingQueueHighPrio;
+        }
+        else if ( !mapPingQueueLowPrio.isEmpty() && ( mapPingQueueLowPrio.firstKey() <= iNow ) )
+        {
+            pQueue = &mapPingQueueLowPrio;
+        }
+        else
+        {
+            break; // no server is due
+        }
 
-        // we need to ask for the server version only if we have not received it
-        const bool bNeedVersion = pCurListViewItem->text ( LVC_VERSION ).isEmpty();
+        const QString    strServerAddress = pQueue->take ( pQueue->firstKey() );
+        QTreeWidgetItem* pCurListViewItem = mapListViewItems.value ( strServerAddress, nullptr );
 
         CHostAddress haServerAddress;
 
         // try to parse host address string which is stored as user data
         // in the server list item GUI control element
-        if ( NetworkUtil().ParseNetworkAddress ( pCurListViewItem->data ( LVC_NAME, Qt::UserRole ).toString(), haServerAddress, bEnableIPv6 ) )
+        if ( pCurListViewItem && NetworkUtil().ParseNetworkAddress ( strServerAddress, haServerAddress, bEnableIPv6 ) )
         {
-            // if address is valid, send ping message using a new thread
-#if QT_VERSION >= QT_VERSION_CHECK( 6, 0, 0 )
-            QFuture<void> f = QtConcurrent::run ( &CConnectDlg::EmitCLServerListPingMes, this, haServerAddress, bNeedVersion );
-            Q_UNUSED ( f );
-#else
-            QtConcurrent::run ( this, &CConnectDlg::EmitCLServerListPingMes, haServerAddress, bNeedVersion );
-#endif
+            // we need to ask for the server version only if we have not received it
+            EmitCLServerListPingMes ( haServerAddress, pCurListViewItem->text ( LVC_VERSION ).isEmpty() );
+            iNumSent++;
+
+            // Servers which did not answer yet, which are visible in the list or
+            // which had a change of the connected clients recently are pinged at the
+            // normal rate, all others less often.
+            const bool bIsHighPrio = pCurListViewItem->text ( LVC_PING ).isEmpty() || IsListViewItemVisible ( pCurListViewItem ) ||
+                                     ( iNow - mapClientsChangeTime.value ( strServerAddress, -PING_RECENT_CHANGE_TIME_SERVER_LIST_MS ) <
+                                       PING_RECENT_CHANGE_TIME_SERVER_LIST_MS );
+
+            if ( bIsHighPrio )
+            {
+                mapPingQueueHighPrio.insert ( iNow + PING_UPDATE_TIME_SERVER_LIST_MS, strServerAddress );
+            }
+            else
+            {
+                mapPingQueueLowPrio.insert ( iNow + PING_INTERVAL_FACTOR_HIDDEN_SERVER * PING_UPDATE_TIME_SERVER_LIST_MS, strServerAddress );
+            }
         }
     }
 }
 
-void CConnectDlg::EmitCLServerListPingMes ( const CHostAddress& haServerAddress, const bool bNeedVersion )
+bool CConnectDlg::IsListViewItemVisible ( QTreeWidgetItem* pItem )
 {
-    // The ping time messages for all servers should not be sent all in a very
-    // short time since it showed that this leads to errors in the ping time
-    // measurement (#49). We therefore introduce a short delay for each server
-    // (since we are doing this in a separate thread for each server, we do not
-    // block the GUI).
-    QThread::msleep ( 11 );
+    // the item is shown and (at least partly) scrolled into the view
+    return !pItem->isHidden() && lvwServers->viewport()->rect().intersects ( lvwServers->visualItemRect ( pItem ) );
+}
 
+void CConnectDlg::EmitCLServerListPingMes ( const CHostAddress& haServerAddress, const bool bNeedVersion )
+{
     // first request the server version if we have not already received it
     if ( bNeedVersion )
     {
@@ -953,6 +1306,9 @@ void CConnectDlg::SetPingTimeAndNumClientsResult ( const CHostAddress& InetAddr,
             pCurListViewItem->setText ( LVC_PING, QString ( "%1 ms" ).arg ( iMinPingTime, 4, 10, QLatin1Char ( ' ' ) ) );
         }
 
+        // remember when the number of clients changed to ping this server more often
+        const QString strOldClients = pCurListViewItem->text ( LVC_CLIENTS );
+
         // update number of clients text
         if ( pCurListViewItem->text ( LVC_CLIENTS_MAX_HIDDEN ).toInt() == 0 )
         {
@@ -968,6 +1324,11 @@ void CConnectDlg::SetPingTimeAndNumClientsResult ( const CHostAddress& InetAddr,
             pCurListViewItem->setText ( LVC_CLIENTS, QString().setNum ( iNumClients ) + "/" + pCurListViewItem->text ( LVC_CLIENTS_MAX_HIDDEN ) );
         }
 
+        if ( !bIsFirstPing && ( pCurListViewItem->text ( LVC_CLIENTS ) != strOldClients ) )
+        {
+            mapClientsChangeTime.insert ( InetAddr.toString(), PingClock.elapsed() );
+        }
+
         // check if the number of child list items matches the number of
         // connected clients, if not then request the client names
         if ( iNumClients != pCurListViewItem->childCount() )
@@ -981,19 +1342,34 @@ void CConnectDlg::SetPingTimeAndNumClientsResult ( const CHostAddress& InetAddr,
             pCurListViewItem->setHidden ( false );
         }
 
-        // Update sorting. Note that the sorting must be the last action for the
-        // current item since the topLevelItem(iIdx) is then no longer valid.
-        // To avoid that the list is sorted shortly before a double click (which
-        // could lead to connecting an incorrect server) the sorting is disabled
-        // as long as the mouse is over the list (but it is not disabled for the
-        // initial timer of about 2s, see TimerInitialSort) (#293).
-        if ( bDoSorting && !bShowCompleteRegList &&
-             ( TimerInitialSort.isActive() || !lvwServers->underMouse() ) ) // do not sort if "show all servers"
+        // the sorting is updated together with the other list view updates
+        if ( bDoSorting )
         {
-            lvwServers->sortByColumn ( LVC_PING_MIN_HIDDEN, Qt::AscendingOrder );
+            bListViewSortPending = true;
         }
     }
 
+    // the ping results of many servers arrive in a short time, the updates which
+    // concern the complete list are therefore done once for all of them
+    if ( !TimerUpdateListView.isActive() )
+    {
+        TimerUpdateListView.start();
+    }
+}
+
+void CConnectDlg::OnTimerUpdateListView()
+{
+    // Update sorting. To avoid that the list is sorted shortly before a double
+    // click (which could lead to connecting an incorrect server) the sorting is
+    // disabled as long as the mouse is over the list (but it is not disabled for
+    // the initial timer of about 2s, see TimerInitialSort) (#293).
+    if ( bListViewSortPending && !bShowCompleteRegList &&
+         ( TimerInitialSort.isActive() || !lvwServers->underMouse() ) ) // do not sort if "show all servers"
+    {
+        lvwServers->sortByColumn ( LVC_PING_MIN_HIDDEN, Qt::AscendingOrder );
+        bListViewSortPending = false;
+    }
+
     // if no server item has children, do not show decoration
     bool      bAnyListItemHasChilds = false;
     const int iServerListLen        = lvwServers->topLevelItemCount();
@@ -1004,6 +1380,7 @@ void CConnectDlg::SetPingTimeAndNumClientsResult ( const CHostAddress& InetAddr,
         if ( lvwServers->topLevelItem ( iIdx )->childCount() > 0 )
         {
             bAnyListItemHasChilds = true;
+            break;
         }
     }
 
@@ -1033,19 +1410,8 @@ void CConnectDlg::SetServerVersionResult ( const CHostAddress& InetAddr, const Q
 
 CMappedTreeWidgetItem* CConnectDlg::FindListViewItem ( const CHostAddress& InetAddr )
 {
-    const int iServerListLen = lvwServers->topLevelItemCount();
-
-    for ( int iIdx = 0; iIdx < iServerListLen; iIdx++ )
-    {
-        // compare the received address with the user data string of the
-        // host address by a string compare
-        if ( !lvwServers->topLevelItem ( iIdx )->data ( LVC_NAME, Qt::UserRole ).toString().compare ( InetAddr.toString() ) )
-        {
-            return static_cast<CMappedTreeWidgetItem*> ( lvwServers->topLevelItem ( iIdx ) );
-        }
-    }
-
-    return nullptr;
+    // the items are indexed by the user data string of the host address
+    return mapListViewItems.value ( InetAddr.toString(), nullptr );
 }
 
 CMappedTreeWidgetItem* CConnectDlg::GetParentListViewItem ( QTreeWidgetItem* pItem )
@@ -30,7 +30,10 @@
 #include <QWhatsThis>
 #include <QTimer>
 #include <QLocale>
-#include <QtConcurrent>
+#include <QMap>
+#include <QMultiMap>
+#include <QHash>
+#include <QElapsedTimer>
 #include <QRegularExpression>
 #include "global.h"
 #include "util.h"
@@ -43,6 +46,23 @@
 // transmitted until it is received
 #define SERV_LIST_REQ_UPDATE_TIME_MS 2000 // ms
 
+// the pings of the server list are spread over short time slots, at least the
+// given number of servers is pinged per slot
+#define PING_SLOT_TIME_SERVER_LIST_MS     11 // ms
+#define PING_MIN_NUM_PER_SLOT_SERVER_LIST 4
+
+// servers which are not visible in the list and had no recent change of the
+// connected clients are pinged less often by this factor
+#define PING_INTERVAL_FACTOR_HIDDEN_SERVER     4
+#define PING_RECENT_CHANGE_TIME_SERVER_LIST_MS 10000 // ms
+
+// number of server list items which are created at once (long lists are
+// created in batches to keep the GUI responsive)
+#define NUM_SERVER_LIST_ITEMS_PER_BATCH 100
+
+// the sorting and filtering of the list view is updated at most once per interval
+#define LIST_VIEW_UPDATE_TIME_SERVER_LIST_MS 100 // ms
+
 /* Classes ********************************************************************/
 
 // Subclass of QTreeWidgetItem that allows LVC_VERSION to sort by the UserRole data value
@@ -69,6 +89,20 @@ public:
 
     void SetServerList ( const CHostAddress& InetAddr, const CVector<CServerInfo>& vecServerInfo, const bool bIsReducedServerList = false );
 
+    void SetServerListPage ( const CHostAddress&         InetAddr,
+                             const int                   iVersion,
+                             const int                   iPage,
+                             const int                   iNumPages,
+                             const CVector<CServerInfo>& vecServerInfo );
+
+    void SetServerListDiff ( const CHostAddress&          InetAddr,
+                             const int                    iBaseVersion,
+                             const int                    iVersion,
+                             const int                    iToken,
+                             const bool                   bResync,
+                             const CVector<CHostAddress>& vecRemovedInetAddr,
+                             const CVector<CServerInfo>&  vecServerInfo );
+
     void SetConnClientsList ( const CHostAddress& InetAddr, const CVector<CChannelInfo>& vecChanInfo );
 
     void SetPingTimeAndNumClientsResult ( const CHostAddress& InetAddr, const int iPingTime, const int iNumClients );
@@ -102,6 +136,14 @@ protected:
     void                   UpdateListFilter();
     void                   ShowAllMusicians ( const bool bState );
     void                   RequestServerList();
+    void                   RequestMissingServerListPages();
+    void                   ShowServerList ( const CHostAddress& InetAddr, const CVector<CServerInfo>& vecServerInfo );
+    void                   ClearServerList();
+    void                   AddServerListItem ( const CHostAddress& CurHostAddress, const CServerInfo& ServerInfo, const int iIdx );
+    void                   RemoveServerListItem ( const QString& strHostAddress );
+    void                   RenewServerListSubscription();
+    void                   CancelServerListSubscription();
+    bool                   IsListViewItemVisible ( QTreeWidgetItem* pItem );
     void                   EmitCLServerListPingMes ( const CHostAddress& haServerAddress, const bool bNeedVersion );
     void                   UpdateDirectoryComboBox();
 
@@ -110,17 +152,50 @@ protected:
     QTimer       TimerPing;
     QTimer       TimerReRequestServList;
     QTimer       TimerInitialSort;
+    QTimer       TimerAddServerListItems;
+    QTimer       TimerUpdateListView;
+    QTimer       TimerRenewSubscription;
     CHostAddress haDirectoryAddress;
     QString      strSelectedAddress;
     QString      strSelectedServerName;
     bool         bShowCompleteRegList;
     bool         bServerListReceived;
     bool         bReducedServerListReceived;
+    bool         bPagedServerListReceived;
+    bool         bServerListTruncated;
     bool         bServerListItemWasChosen;
     bool         bListFilterWasActive;
     bool         bShowAllMusicians;
     bool         bEnableIPv6;
 
+    // pages of a server list which is too long for a single server list message
+    int                             iServerListPageVersion;
+    int                             iServerListNumPages; // zero if no paged server list is being received
+    QMap<int, CVector<CServerInfo>> mapServerListPages;
+
+    // version of the shown server list if we get its changes from the directory,
+    // negative if the version is not known
+    int iServerListVersion;
+
+    // the directory only accepts a subscription with the token it has sent to us
+    int  iServerListToken;
+    bool bServerListTokenReceived;
+
+    // server list items which are not yet created in the list view
+    CHostAddress         haPendingServerListAddr;
+    CVector<CServerInfo> vecPendingServerInfo;
+    int                  iNextPendingServerInfo;
+
+    // list view items indexed by the host address string, the ping scheduler
+    // queues (keyed by the due time of the ping) and the time of the last
+    // change of the connected clients
+    QHash<QString, CMappedTreeWidgetItem*> mapListViewItems;
+    QMultiMap<qint64, QString>             mapPingQueueHighPrio;
+    QMultiMap<qint64, QString>             mapPingQueueLowPrio;
+    QHash<QString, qint64>                 mapClientsChangeTime;
+    QElapsedTimer                          PingClock;
+    bool                                   bListViewSortPending;
+
 public slots:
     void OnServerListItemDoubleClicked ( QTreeWidgetItem* Item, int );
     void OnServerAddrEditTextChanged ( const QString& );
@@ -132,9 +207,14 @@ public slots:
     void OnDeleteServerAddrClicked();
     void OnTimerPing();
     void OnTimerReRequestServList();
+    void OnTimerAddServerListItems();
+    void OnTimerUpdateListView();
+    void OnTimerRenewSubscription() { RenewServerListSubscription(); }
 
 signals:
     void ReqServerListQuery ( CHostAddress InetAddr );
+    void ReqServerListPage ( CHostAddress InetAddr, int iVersion, int iPage );
+    void SubscribeServerList ( CHostAddress InetAddr, int iVersion, int iToken, bool bSubscribe );
     void CreateCLServerListPingMes ( CHostAddress InetAddr );
     void CreateCLServerListReqVerAndOSMes ( CHostAddress InetAddr );
     void CreateCLServerListReqConnClientsListMes ( CHostAddress InetAddr );
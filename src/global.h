@@ -147,6 +147,11 @@ LED bar:      lbr
 // gets in trouble if the value is too low)
 #define CELT_MINIMUM_NUM_BYTES 10
 
+// CELT encoder request which is not part of the public OPUS custom API: with
+// the value 0 only intra frames are coded (no inter frame prediction and no
+// prefilter), so that a frame can be decoded without its predecessor
+#define CELT_SET_PREDICTION_REQUEST 10002
+
 // Maximum block size for network input buffer. It is defined by the longest
 // protocol message which is PROTMESSID_CLM_SERVER_LIST: Worst case:
 // (2+2+1+2+2)+200*(4+2+2+1+1+2+20+2+32+2+20)=17609
@@ -205,17 +210,23 @@ LED bar:      lbr
 #define RED_BOUND_LED_BAR    7
 #define YELLOW_BOUND_LED_BAR 5
 
-// maximum number of connected clients at the server (must not be larger than 256)
-#define MAX_NUM_CHANNELS 150 // max number channels for server
+// maximum number of connected clients at the server (the channel IDs are sent as
+// one byte and the IDs above the maximum are used as INVALID_CHANNEL_ID and
+// NOT_ADMITTED_CHANNEL_ID, so this must not be larger than 253)
+#define MAX_NUM_CHANNELS 250 // max number channels for server
 
 // actual number of used channels in the server
 // this parameter can safely be changed from 1 to MAX_NUM_CHANNELS
 // without any other changes in the code
 #define DEFAULT_USED_NUM_CHANNELS 10 // default used number channels for server
 
-// Maximum number of servers registered in the server list. If you want to
-// change this parameter, you most probably have to adjust MAX_SIZE_BYTES_NETW_BUF.
-#define MAX_NUM_SERVERS_IN_SERVER_LIST 150 // reduced to 150 because we now have genre-based server lists
+// Maximum number of servers registered in the server list. Only the first
+// MAX_NUM_SERVERS_IN_LEGACY_SERVER_LIST servers are sent in the (reduced) server
+// list messages which must fit into MAX_SIZE_BYTES_NETW_BUF, the complete list is
+// delivered in pages of at most MAX_SIZE_BYTES_SERVER_LIST_PAGE bytes of entries.
+#define MAX_NUM_SERVERS_IN_SERVER_LIST        5000
+#define MAX_NUM_SERVERS_IN_LEGACY_SERVER_LIST 150
+#define MAX_SIZE_BYTES_SERVER_LIST_PAGE       1200 // bytes (fits one UDP datagram without fragmentation)
 
 // defines the time interval at which the ping time is updated in the GUI
 #define PING_UPDATE_TIME_MS 500 // ms
@@ -239,6 +250,32 @@ LED bar:      lbr
 // time between server registration refreshes
 #define SERVLIST_REGIST_INTERV_MINUTES 15 // minutes
 
+// time window in which the directory collects the NAT hole punch requests for
+// the registered servers before sending them
+#define SERVLIST_HOLE_PUNCH_INTERVAL_MS 20 // ms
+
+// maximum number of hole punch messages the directory sends per time window
+#define SERVLIST_HOLE_PUNCH_MAX_MES_PER_INTERVAL 100
+
+// maximum number of targets in one hole punch message with multiple targets
+#define MAX_NUM_TARGETS_SEND_EMPTY_MES_MULTI 100
+
+// number of records in the journal of the persistent server list after which
+// the server list file is rewritten and the journal is emptied
+#define SERVLIST_JOURNAL_MAX_RECORDS 1000
+
+// clients which show the server list can subscribe to its changes, the directory
+// sends the changes of the server list to the subscribers once per interval, a
+// subscription expires if the client does not renew it in time
+#define SERVLIST_SUBSCRIPTION_PUSH_INTERVAL_MS 1000  // ms
+#define SERVLIST_SUBSCRIPTION_RENEW_TIME_MS    20000 // ms
+#define SERVLIST_SUBSCRIPTION_TIME_OUT_MS      60000 // ms
+#define SERVLIST_MAX_NUM_SUBSCRIBERS           2000
+
+// maximum number of changes of the server list the directory keeps for the
+// subscribers, older subscribers have to request the complete list again
+#define SERVLIST_MAX_NUM_CHANGES 2000
+
 // defines the minimum time a server must run to be a permanent server
 #define SERVLIST_TIME_PERMSERV_MINUTES 2880 // minutes, 2880 = 60 min * 24 h * 2 d
 
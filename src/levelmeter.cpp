@@ -28,7 +28,7 @@
 #include "levelmeter.h"
 
 /* Implementation *************************************************************/
-CLevelMeter::CLevelMeter ( QWidget* parent ) : QWidget ( parent ), eLevelMeterType ( MT_BAR_WIDE )
+CLevelMeter::CLevelMeter ( QWidget* parent ) : QWidget ( parent ), eLevelMeterType ( MT_BAR_WIDE ), iCurValue ( INVALID_INDEX )
 {
     // initialize LED meter
     QWidget*     pLEDMeter  = new QWidget();
@@ -94,6 +94,7 @@ CLevelMeter::~CLevelMeter()
 void CLevelMeter::SetLevelMeterType ( const ELevelMeterType eNType )
 {
     eLevelMeterType = eNType;
+    iCurValue       = INVALID_INDEX; // the next value is shown in any case
 
     switch ( eNType )
     {
@@ -181,6 +182,18 @@ void CLevelMeter::SetBarMeterStyleAndClipStatus ( const ELevelMeterType eNType,
 
 void CLevelMeter::SetValue ( const double dValue )
 {
+    // many meters are updated in one GUI refresh, so the widgets are only touched
+    // if the shown value changes (a clipped value is always processed since it
+    // restarts the clip indicator timer)
+    const int iNewValue = static_cast<int> ( std::ceil ( 100 * dValue ) );
+
+    if ( ( iNewValue == iCurValue ) && ( dValue <= NUM_STEPS_LED_BAR ) )
+    {
+        return;
+    }
+
+    iCurValue = iNewValue;
+
     switch ( eLevelMeterType )
     {
     case MT_LED_STRIPE:
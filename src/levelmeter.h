@@ -108,6 +108,7 @@ protected:
 
     CMinimumStackedLayout* pMinStackedLayout;
     ELevelMeterType        eLevelMeterType;
+    int                    iCurValue; // shown value in 1/100 LED steps (INVALID_INDEX forces an update)
     CVector<cLED*>         vecpLEDs;
     QProgressBar*          pBarMeter;
 
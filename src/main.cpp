@@ -35,6 +35,8 @@
 #    endif
 #endif
 #include "settings.h"
+#include "recorder/cmixdownrenderer.h"
+#include "roommanager.h"
 #ifndef SERVER_ONLY
 #    include "testbench.h"
 #endif
@@ -87,10 +89,16 @@ int main ( int argc, char** argv )
     bool         bDisconnectAllClientsOnQuit = false;
     bool         bUseDoubleSystemFrameSize   = true; // default is 128 samples frame size
     bool         bUseMultithreading          = false;
+    bool         bMultiRoom                  = false;
     bool         bShowAnalyzerConsole        = false;
     bool         bMuteStream                 = false;
     bool         bMuteMeInPersonalMix        = false;
+    bool         bUseNetworkThread           = false;
+    bool         bUseLatencyProbe            = false;
+    bool         bUseRedundancy              = false;
+    bool         bUseSeparateInputs          = false;
     bool         bDisableRecording           = false;
+    bool         bMixdownStems               = false;
     bool         bDelayPan                   = false;
     bool         bNoAutoJackConnect          = false;
     bool         bUseTranslation             = true;
@@ -108,6 +116,7 @@ int main ( int argc, char** argv )
     QString      strHTMLStatusFileName       = "";
     QString      strLoggingFileName          = "";
     QString      strRecordingDirName         = "";
+    QString      strMixdownSessionDirName    = "";
     QString      strDirectoryAddress         = "";
     QString      strServerListFileName       = "";
     QString      strServerInfo               = "";
@@ -117,6 +126,7 @@ int main ( int argc, char** argv )
     QString      strWelcomeMessage           = "";
     QString      strClientName               = "";
     QString      strJsonRpcSecretFileName    = "";
+    QString      strSoundFileSetup           = "";
 
 #if defined( HEADLESS ) || defined( SERVER_ONLY )
     Q_UNUSED ( bStartMinimized )
@@ -127,6 +137,11 @@ int main ( int argc, char** argv )
 #endif
 #if defined( SERVER_ONLY )
     Q_UNUSED ( bMuteMeInPersonalMix )
+    Q_UNUSED ( bUseNetworkThread )
+    Q_UNUSED ( bUseLatencyProbe )
+    Q_UNUSED ( bUseRedundancy )
+    Q_UNUSED ( bUseSeparateInputs )
+    Q_UNUSED ( strSoundFileSetup )
     Q_UNUSED ( bNoAutoJackConnect )
     Q_UNUSED ( bCustomPortNumberGiven )
 #endif
@@ -410,6 +425,34 @@ int main ( int argc, char** argv )
             continue;
         }
 
+        // Offline mixdown of a recorded session -------------------------------
+        if ( GetStringArgument ( argc,
+                                 argv,
+                                 i,
+                                 "--mixdown", // no short form
+                                 "--mixdown",
+                                 strArgument ) )
+        {
+            strMixdownSessionDirName = strArgument;
+            qInfo() << qUtf8Printable ( QString ( "- render mixdown of session: %1" ).arg ( strMixdownSessionDirName ) );
+            CommandLineOptions << "--mixdown";
+            ServerOnlyOptions << "--mixdown";
+            continue;
+        }
+
+        // Render stems with the mixdown ---------------------------------------
+        if ( GetFlagArgument ( argv,
+                               i,
+                               "--mixdownstems", // no short form
+                               "--mixdownstems" ) )
+        {
+            bMixdownStems = true;
+            qInfo() << "- render one stem per track with the mixdown";
+            CommandLineOptions << "--mixdownstems";
+            ServerOnlyOptions << "--mixdownstems";
+            continue;
+        }
+
         // Server mode flag ----------------------------------------------------
         if ( GetFlagArgument ( argv, i, "-s", "--server" ) )
         {
@@ -445,6 +488,19 @@ int main ( int argc, char** argv )
             continue;
         }
 
+        // Multi-room mode -----------------------------------------------------
+        if ( GetFlagArgument ( argv,
+                               i,
+                               "--multiroom", // no short form
+                               "--multiroom" ) )
+        {
+            bMultiRoom = true;
+            qInfo() << "- multi-room mode";
+            CommandLineOptions << "--multiroom";
+            ServerOnlyOptions << "--multiroom";
+            continue;
+        }
+
         // Maximum number of channels ------------------------------------------
         if ( GetNumericArgument ( argc, argv, i, "-u", "--numchannels", 1, MAX_NUM_CHANNELS, rDbleArgument ) )
         {
@@ -520,6 +576,73 @@ int main ( int argc, char** argv )
             continue;
         }
 
+        // Audio coding and network transfer in a separate thread --------------
+        if ( GetFlagArgument ( argv,
+                               i,
+                               "--netthread", // no short form
+                               "--netthread" ) )
+        {
+            bUseNetworkThread = true;
+            qInfo() << "- audio coding and network transfer in a separate real-time thread";
+            CommandLineOptions << "--netthread";
+            ClientOnlyOptions << "--netthread";
+            continue;
+        }
+
+        // In-band latency measurement ------------------------------------------
+        if ( GetFlagArgument ( argv,
+                               i,
+                               "--latencyprobe", // no short form
+                               "--latencyprobe" ) )
+        {
+            bUseLatencyProbe = true;
+            qInfo() << "- measure the latency with a probe signal in the audio stream";
+            CommandLineOptions << "--latencyprobe";
+            ClientOnlyOptions << "--latencyprobe";
+            continue;
+        }
+
+        // Redundant frames on packet loss --------------------------------------
+        if ( GetFlagArgument ( argv,
+                               i,
+                               "--redundancy", // no short form
+                               "--redundancy" ) )
+        {
+            bUseRedundancy = true;
+            qInfo() << "- send redundant audio frames if packets are lost";
+            CommandLineOptions << "--redundancy";
+            ClientOnlyOptions << "--redundancy";
+            continue;
+        }
+
+        // Separate input channels ---------------------------------------------
+        if ( GetFlagArgument ( argv,
+                               i,
+                               "--separateinputs", // no short form
+                               "--separateinputs" ) )
+        {
+            bUseSeparateInputs = true;
+            qInfo() << "- send the left and right input as separate channels in stereo mode";
+            CommandLineOptions << "--separateinputs";
+            ClientOnlyOptions << "--separateinputs";
+            continue;
+        }
+
+        // Sound file setup (only used with the file sound interface) ----------
+        if ( GetStringArgument ( argc,
+                                 argv,
+                                 i,
+                                 "--soundfile", // no short form
+                                 "--soundfile",
+                                 strArgument ) )
+        {
+            strSoundFileSetup = strArgument;
+            qInfo() << qUtf8Printable ( QString ( "- sound file setup: %1" ).arg ( strSoundFileSetup ) );
+            CommandLineOptions << "--soundfile";
+            ClientOnlyOptions << "--soundfile";
+            continue;
+        }
+
         // Client Name ---------------------------------------------------------
         if ( GetStringArgument ( argc,
                                  argv,
@@ -811,6 +934,27 @@ int main ( int argc, char** argv )
 #endif
     }
 
+    // Offline mixdown ---------------------------------------------------------
+    // rendering a recorded session does not need a running server, so do it
+    // before any application object is created and exit afterwards
+    if ( !strMixdownSessionDirName.isEmpty() )
+    {
+        try
+        {
+            recorder::CMixdownRenderer::SessionDirToMixdown ( strMixdownSessionDirName,
+                                                              bUseDoubleSystemFrameSize ? DOUBLE_SYSTEM_FRAME_SIZE_SAMPLES
+                                                                                        : SYSTEM_FRAME_SIZE_SAMPLES,
+                                                              bMixdownStems );
+        }
+        catch ( const CGenErr& generr )
+        {
+            qCritical() << qUtf8Printable ( QString ( "%1: %2" ).arg ( APP_NAME ).arg ( generr.GetErrorText() ) );
+            exit ( 1 );
+        }
+
+        exit ( 0 );
+    }
+
     // Application/GUI setup ---------------------------------------------------
     // Application object
 #ifdef HEADLESS
@@ -868,6 +1012,8 @@ int main ( int argc, char** argv )
     //### TEST: BEGIN ###//
     // activate the following line to activate the test bench,
     // CTestbench Testbench ( "127.0.0.1", DEFAULT_PORT_NUMBER );
+    // activate the following line to run the reverberation benchmark,
+    // CAudioReverbBenchmark::Run();
     //### TEST: END ###//
 #endif
 
@@ -929,7 +1075,12 @@ int main ( int argc, char** argv )
                              bNoAutoJackConnect,
                              strClientName,
                              bEnableIPv6,
-                             bMuteMeInPersonalMix );
+                             bMuteMeInPersonalMix,
+                             bUseNetworkThread,
+                             bUseLatencyProbe,
+                             bUseRedundancy,
+                             bUseSeparateInputs,
+                             strSoundFileSetup );
 
             // load settings from init-file (command line options override)
             CClientSettings Settings ( &Client, strIniFileName );
@@ -997,16 +1148,30 @@ int main ( int argc, char** argv )
                              strRecordingDirName,
                              bDisconnectAllClientsOnQuit,
                              bUseDoubleSystemFrameSize,
-                             bUseMultithreading,
+                             bUseMultithreading && !bMultiRoom, // in multi-room mode the room manager owns the thread pool
                              bDisableRecording,
                              bDelayPan,
                              bEnableIPv6,
                              eLicenceType );
 
+            // in multi-room mode the server becomes the first room of the room manager
+            std::unique_ptr<CRoomManager> pRoomManager;
+            if ( bMultiRoom )
+            {
+                pRoomManager.reset ( new CRoomManager ( &Server,
+                                                        iPortNumber,
+                                                        strServerBindIP,
+                                                        iQosNumber,
+                                                        bUseDoubleSystemFrameSize,
+                                                        bUseMultithreading,
+                                                        bDelayPan,
+                                                        bEnableIPv6 ) );
+            }
+
 #ifndef NO_JSON_RPC
             if ( pRpcServer )
             {
-                new CServerRpc ( &Server, pRpcServer, pRpcServer );
+                new CServerRpc ( &Server, pRoomManager.get(), pRpcServer, pRpcServer );
             }
 
 #endif
@@ -1123,10 +1288,15 @@ QString UsageArguments ( char** argv )
            "  -P, --delaypan          start with delay panning enabled\n"
            "  -R, --recording         set server recording directory; server will record when a session is active by default\n"
            "      --norecord          set server not to record by default when recording is configured\n"
+           "      --mixdown           render a stereo mixdown of a recorded session directory and exit\n"
+           "                          (use -F for sessions recorded in 64 samples frame size mode)\n"
+           "      --mixdownstems      with --mixdown, also render one stereo stem per track\n"
            "  -s, --server            start Server\n"
            "      --serverbindip      IP address the Server will bind to (rather than all)\n"
            "  -T, --multithreading    use multithreading to make better use of\n"
            "                          multi-core CPUs and support more Clients\n"
+           "      --multiroom         host additional rooms (created via JSON-RPC) in this\n"
+           "                          process, sharing one timer and thread pool\n"
            "  -u, --numchannels       maximum number of channels\n"
            "  -w, --welcomemessage    welcome message to display on connect\n"
            "                          (string or filename, HTML supported)\n"
@@ -1137,6 +1307,16 @@ QString UsageArguments ( char** argv )
            "  -j, --nojackconnect     disable auto JACK connections\n"
            "  -M, --mutestream        prevent others on a server from hearing what I play\n"
            "      --mutemyown         prevent me from hearing what I play in the server mix (headless only)\n"
+           "      --netthread         do the audio coding and network transfer in a separate\n"
+           "                          real-time thread instead of the sound card callback\n"
+           "      --latencyprobe      measure the latency with a short probe signal which is\n"
+           "                          added to the audio stream every few seconds\n"
+           "      --redundancy        send a redundant copy of each audio frame with the next\n"
+           "                          one if packets are lost (requires server support)\n"
+           "      --separateinputs    in stereo mode send the left and right input as two\n"
+           "                          separate channels (requires server support)\n"
+           "      --soundfile         sound file setup \"in=<source>;out=<sink>;frames=<n>\"\n"
+           "                          (only for builds with CONFIG+=filesound)\n"
            "      --clientname        client name (window title and JACK client name)\n"
            "      --ctrlmidich        configure MIDI controller\n"
            "\n"
@@ -54,13 +54,26 @@ void CAudioReverb::Init ( const EAudChanConf eNAudioChannelConf, const int iNSte
     for ( int i = 0; i < 4; i++ )
     {
         combDelays[i].Init ( lengths[i] );
-        combFilters[i].setPole ( 0.2f );
     }
 
+    // calculate the comb filter coefficients based on the pole value
+    const float fCombPole = 0.2f;
+    combFilterA           = -fCombPole;
+    combFilterB           = 1.0f - fCombPole;
+
+    // the output delays were implemented by writing before reading which gives
+    // a delay of one sample less than the delay length
     setT60 ( fT60, iSampleRate );
-    outLeftDelay.Init ( lengths[7] );
-    outRightDelay.Init ( lengths[8] );
+    outLeftDelay.Init ( lengths[7] - 1 );
+    outRightDelay.Init ( lengths[8] - 1 );
     allpassCoefficient = 0.7f;
+
+    // allocate the intermediate block signals here to avoid memory allocation
+    // in the audio processing
+    vecfBlockIn.Init ( iStereoBlockSizeSam / 2 );
+    vecfBlockOutLeft.Init ( iStereoBlockSizeSam / 2 );
+    vecfBlockOutRight.Init ( iStereoBlockSizeSam / 2 );
+
     Clear();
 }
 
@@ -93,22 +106,32 @@ bool CAudioReverb::isPrime ( const int number )
     }
 }
 
+void CAudioReverb::SetAudioChannelConf ( const EAudChanConf eNAudioChannelConf )
+{
+    // the delay lines do not depend on the audio channels, so this allocates no
+    // memory and can be used in the audio processing
+    eAudioChannelConf = eNAudioChannelConf;
+
+    Clear();
+}
+
 void CAudioReverb::Clear()
 {
     // reset and clear all internal state
-    allpassDelays[0].Reset ( 0 );
-    allpassDelays[1].Reset ( 0 );
-    allpassDelays[2].Reset ( 0 );
-    combDelays[0].Reset ( 0 );
-    combDelays[1].Reset ( 0 );
-    combDelays[2].Reset ( 0 );
-    combDelays[3].Reset ( 0 );
-    combFilters[0].Reset();
-    combFilters[1].Reset();
-    combFilters[2].Reset();
-    combFilters[3].Reset();
-    outRightDelay.Reset ( 0 );
-    outLeftDelay.Reset ( 0 );
+    allpassDelays[0].Clear();
+    allpassDelays[1].Clear();
+    allpassDelays[2].Clear();
+    combDelays[0].Clear();
+    combDelays[1].Clear();
+    combDelays[2].Clear();
+    combDelays[3].Clear();
+    outRightDelay.Clear();
+    outLeftDelay.Clear();
+
+    for ( int i = 0; i < 4; i++ )
+    {
+        combFilterState[i] = 0;
+    }
 }
 
 void CAudioReverb::setT60 ( const float fT60, const int iSampleRate )
@@ -120,88 +143,177 @@ void CAudioReverb::setT60 ( const float fT60, const int iSampleRate )
     }
 }
 
-void CAudioReverb::COnePole::setPole ( const float fPole )
+void CAudioReverb::ProcessAllpass ( CDelayLine& Delay, float* pfInOut, const int iNumSamples )
 {
-    // calculate IIR filter coefficients based on the pole value
-    fA = -fPole;
-    fB = 1.0f - fPole;
+    const CFloat4 Coefficient = Broadcast ( allpassCoefficient );
+
+    // the delay line is at least as long as a span, so the samples of a span do
+    // not depend on each other and four of them are processed at once
+    for ( int iPos = 0; iPos < iNumSamples; )
+    {
+        const int iSpan    = Delay.GetSpan ( iNumSamples - iPos );
+        float*    pfDelay  = Delay.GetSpanMemory();
+        float*    pfSpanIO = &pfInOut[iPos];
+        int       i        = 0;
+
+        for ( ; i + 4 <= iSpan; i += 4 )
+        {
+            const CFloat4 Delayed = Load ( &pfDelay[i] );
+            const CFloat4 New     = Coefficient * Delayed + Load ( &pfSpanIO[i] );
+
+            Store ( &pfDelay[i], New );
+            Store ( &pfSpanIO[i], Delayed - Coefficient * New );
+        }
+
+        for ( ; i < iSpan; i++ )
+        {
+            const float fDelayed = pfDelay[i];
+            const float fNew     = allpassCoefficient * fDelayed + pfSpanIO[i];
+
+            pfDelay[i]  = fNew;
+            pfSpanIO[i] = fDelayed - allpassCoefficient * fNew;
+        }
+
+        Delay.Advance ( iSpan );
+        iPos += iSpan;
+    }
 }
 
-float CAudioReverb::COnePole::Calc ( const float fIn )
+void CAudioReverb::ProcessCombs ( const float* pfIn, float* pfOut, const int iNumSamples )
 {
-    // calculate IIR filter
-    fLastSample = fB * fIn - fA * fLastSample;
+    // the one-pole filters make each comb recursive from sample to sample,
+    // therefore the four combs are computed in parallel as the vector lanes
+    const CFloat4 Gain  = { combCoefficient[0], combCoefficient[1], combCoefficient[2], combCoefficient[3] };
+    const CFloat4 FiltA = Broadcast ( combFilterA );
+    const CFloat4 FiltB = Broadcast ( combFilterB );
+    CFloat4       State = { combFilterState[0], combFilterState[1], combFilterState[2], combFilterState[3] };
+    float*        pfDelay[4];
+
+    for ( int iPos = 0; iPos < iNumSamples; )
+    {
+        // the span ends where the first of the four delay lines wraps
+        int iSpan = iNumSamples - iPos;
+
+        for ( int c = 0; c < 4; c++ )
+        {
+            iSpan      = combDelays[c].GetSpan ( iSpan );
+            pfDelay[c] = combDelays[c].GetSpanMemory();
+        }
 
-    return fLastSample;
+        for ( int i = 0; i < iSpan; i++ )
+        {
+            const CFloat4 Delayed = { pfDelay[0][i], pfDelay[1][i], pfDelay[2][i], pfDelay[3][i] };
+
+            State = FiltB * ( Gain * Delayed ) - FiltA * State;
+
+            const CFloat4 Comb = Broadcast ( pfIn[iPos + i] ) + State;
+
+            pfDelay[0][i] = Comb[0];
+            pfDelay[1][i] = Comb[1];
+            pfDelay[2][i] = Comb[2];
+            pfDelay[3][i] = Comb[3];
+
+            pfOut[iPos + i] = Comb[0] + Comb[1] + Comb[2] + Comb[3];
+        }
+
+        for ( int c = 0; c < 4; c++ )
+        {
+            combDelays[c].Advance ( iSpan );
+        }
+
+        iPos += iSpan;
+    }
+
+    for ( int c = 0; c < 4; c++ )
+    {
+        combFilterState[c] = State[c];
+    }
+}
+
+void CAudioReverb::ProcessDelay ( CDelayLine& Delay, float* pfInOut, const int iNumSamples )
+{
+    for ( int iPos = 0; iPos < iNumSamples; )
+    {
+        const int iSpan    = Delay.GetSpan ( iNumSamples - iPos );
+        float*    pfDelay  = Delay.GetSpanMemory();
+        float*    pfSpanIO = &pfInOut[iPos];
+        int       i        = 0;
+
+        for ( ; i + 4 <= iSpan; i += 4 )
+        {
+            const CFloat4 Delayed = Load ( &pfDelay[i] );
+
+            Store ( &pfDelay[i], Load ( &pfSpanIO[i] ) );
+            Store ( &pfSpanIO[i], Delayed );
+        }
+
+        for ( ; i < iSpan; i++ )
+        {
+            const float fDelayed = pfDelay[i];
+
+            pfDelay[i]  = pfSpanIO[i];
+            pfSpanIO[i] = fDelayed;
+        }
+
+        Delay.Advance ( iSpan );
+        iPos += iSpan;
+    }
 }
 
-void CAudioReverb::Process ( CVector<int16_t>& vecsStereoInOut, const bool bReverbOnLeftChan, const float fAttenuation )
+void CAudioReverb::Process ( CVector<float>& vecfStereoInOut, const bool bReverbOnLeftChan, const float fAttenuation )
 {
-    float fMixedInput, temp, temp0, temp1, temp2;
+    const int iNumSamples = iStereoBlockSizeSam / 2;
 
-    for ( int i = 0; i < iStereoBlockSizeSam; i += 2 )
+    // we sum up the stereo input channels (in case mono input is used, a zero
+    // shall be input for the right channel)
+    if ( eAudioChannelConf == CC_STEREO )
     {
-        // we sum up the stereo input channels (in case mono input is used, a zero
-        // shall be input for the right channel)
-        if ( eAudioChannelConf == CC_STEREO )
+        for ( int i = 0; i < iNumSamples; i++ )
         {
-            fMixedInput = 0.5f * ( vecsStereoInOut[i] + vecsStereoInOut[i + 1] );
+            vecfBlockIn[i] = 0.5f * ( vecfStereoInOut[2 * i] + vecfStereoInOut[2 * i + 1] );
         }
-        else
+    }
+    else
+    {
+        const int iInChan = bReverbOnLeftChan ? 0 : 1;
+
+        for ( int i = 0; i < iNumSamples; i++ )
         {
-            if ( bReverbOnLeftChan )
-            {
-                fMixedInput = vecsStereoInOut[i];
-            }
-            else
-            {
-                fMixedInput = vecsStereoInOut[i + 1];
-            }
+            vecfBlockIn[i] = vecfStereoInOut[2 * i + iInChan];
         }
+    }
 
-        temp  = allpassDelays[0].Get();
-        temp0 = allpassCoefficient * temp;
-        temp0 += fMixedInput;
-        allpassDelays[0].Add ( temp0 );
-        temp0 = -( allpassCoefficient * temp0 ) + temp;
-
-        temp  = allpassDelays[1].Get();
-        temp1 = allpassCoefficient * temp;
-        temp1 += temp0;
-        allpassDelays[1].Add ( temp1 );
-        temp1 = -( allpassCoefficient * temp1 ) + temp;
-
-        temp  = allpassDelays[2].Get();
-        temp2 = allpassCoefficient * temp;
-        temp2 += temp1;
-        allpassDelays[2].Add ( temp2 );
-        temp2 = -( allpassCoefficient * temp2 ) + temp;
-
-        const float temp3 = temp2 + combFilters[0].Calc ( combCoefficient[0] * combDelays[0].Get() );
-        const float temp4 = temp2 + combFilters[1].Calc ( combCoefficient[1] * combDelays[1].Get() );
-        const float temp5 = temp2 + combFilters[2].Calc ( combCoefficient[2] * combDelays[2].Get() );
-        const float temp6 = temp2 + combFilters[3].Calc ( combCoefficient[3] * combDelays[3].Get() );
-
-        combDelays[0].Add ( temp3 );
-        combDelays[1].Add ( temp4 );
-        combDelays[2].Add ( temp5 );
-        combDelays[3].Add ( temp6 );
-
-        const float filtout = temp3 + temp4 + temp5 + temp6;
-
-        outLeftDelay.Add ( filtout );
-        outRightDelay.Add ( filtout );
-
-        // inplace apply the attenuated reverb signal (for stereo always apply
-        // reverberation effect on both channels)
-        if ( ( eAudioChannelConf == CC_STEREO ) || bReverbOnLeftChan )
+    // three series allpass units, four parallel combs and the two decorrelation
+    // delay lines at the output
+    ProcessAllpass ( allpassDelays[0], &vecfBlockIn[0], iNumSamples );
+    ProcessAllpass ( allpassDelays[1], &vecfBlockIn[0], iNumSamples );
+    ProcessAllpass ( allpassDelays[2], &vecfBlockIn[0], iNumSamples );
+
+    ProcessCombs ( &vecfBlockIn[0], &vecfBlockOutLeft[0], iNumSamples );
+
+    std::copy ( vecfBlockOutLeft.begin(), vecfBlockOutLeft.begin() + iNumSamples, vecfBlockOutRight.begin() );
+
+    ProcessDelay ( outLeftDelay, &vecfBlockOutLeft[0], iNumSamples );
+    ProcessDelay ( outRightDelay, &vecfBlockOutRight[0], iNumSamples );
+
+    // inplace apply the attenuated reverb signal (for stereo always apply
+    // reverberation effect on both channels)
+    const float fDryGain = 1.0f - fAttenuation;
+    const float fWetGain = 0.5f * fAttenuation;
+
+    if ( ( eAudioChannelConf == CC_STEREO ) || bReverbOnLeftChan )
+    {
+        for ( int i = 0; i < iNumSamples; i++ )
         {
-            vecsStereoInOut[i] = Float2Short ( ( 1.0f - fAttenuation ) * vecsStereoInOut[i] + 0.5f * fAttenuation * outLeftDelay.Get() );
+            vecfStereoInOut[2 * i] = fDryGain * vecfStereoInOut[2 * i] + fWetGain * vecfBlockOutLeft[i];
         }
+    }
 
-        if ( ( eAudioChannelConf == CC_STEREO ) || !bReverbOnLeftChan )
+    if ( ( eAudioChannelConf == CC_STEREO ) || !bReverbOnLeftChan )
+    {
+        for ( int i = 0; i < iNumSamples; i++ )
         {
-            vecsStereoInOut[i + 1] = Float2Short ( ( 1.0f - fAttenuation ) * vecsStereoInOut[i + 1] + 0.5f * fAttenuation * outRightDelay.Get() );
+            vecfStereoInOut[2 * i + 1] = fDryGain * vecfStereoInOut[2 * i + 1] + fWetGain * vecfBlockOutRight[i];
         }
     }
-}
\ No newline at end of file
+}
@@ -15,6 +15,8 @@
 */
 
 #pragma once
+#include <algorithm>
+#include <cstring>
 #include "util.h"
 
 class CAudioReverb
@@ -24,34 +26,108 @@ public:
 
     void Init ( const EAudChanConf eNAudioChannelConf, const int iNStereoBlockSizeSam, const int iSampleRate, const float fT60 = 1.1f );
 
+    void SetAudioChannelConf ( const EAudChanConf eNAudioChannelConf );
     void Clear();
-    void Process ( CVector<int16_t>& vecsStereoInOut, const bool bReverbOnLeftChan, const float fAttenuation );
+    void Process ( CVector<float>& vecfStereoInOut, const bool bReverbOnLeftChan, const float fAttenuation );
 
 protected:
-    void setT60 ( const float fT60, const int iSampleRate );
-    bool isPrime ( const int number );
-
-    class COnePole
+    // The reverberation is processed block-wise: each stage processes the whole
+    // block over contiguous spans of its delay line (a span ends where the delay
+    // line index wraps), so that the inner loops have no wrap branches and can be
+    // vectorized by the compiler.
+    class CDelayLine
     {
     public:
-        COnePole() : fA ( 0 ), fB ( 0 ) { Reset(); }
-        void  setPole ( const float fPole );
-        float Calc ( const float fIn );
-        void  Reset() { fLastSample = 0; }
+        CDelayLine() : iIdx ( 0 ) {}
+
+        void Init ( const int iNewSize )
+        {
+            vecfMemory.Init ( iNewSize );
+            iIdx = 0;
+        }
+
+        void Clear()
+        {
+            vecfMemory.Reset ( 0 );
+            iIdx = 0;
+        }
+
+        int Size() const { return vecfMemory.Size(); }
+
+        // number of samples (at most iMaxNumSamples) until the index wraps and
+        // the memory at the index (the oldest sample, it is replaced by the new one)
+        int    GetSpan ( const int iMaxNumSamples ) const { return std::min ( iMaxNumSamples, vecfMemory.Size() - iIdx ); }
+        float* GetSpanMemory() { return &vecfMemory[iIdx]; }
+
+        void Advance ( const int iNumSamples )
+        {
+            iIdx += iNumSamples;
+
+            if ( iIdx == vecfMemory.Size() )
+            {
+                iIdx = 0;
+            }
+        }
 
     protected:
-        float fA;
-        float fB;
-        float fLastSample;
+        CVector<float> vecfMemory;
+        int            iIdx;
+    };
+
+    // Four float values which are processed as the lanes of one SIMD vector. With
+    // GCC and Clang the vector extension is used (SSE on x86, NEON on ARM), other
+    // compilers use the scalar fallback.
+#if defined( __GNUC__ )
+    typedef float CFloat4 __attribute__ ( ( vector_size ( 16 ) ) );
+#else
+    struct CFloat4
+    {
+        float fLane[4];
+
+        float&       operator[] ( const int i ) { return fLane[i]; }
+        const float& operator[] ( const int i ) const { return fLane[i]; }
+
+        friend CFloat4 operator+ ( const CFloat4& a, const CFloat4& b ) { return { a[0] + b[0], a[1] + b[1], a[2] + b[2], a[3] + b[3] }; }
+        friend CFloat4 operator- ( const CFloat4& a, const CFloat4& b ) { return { a[0] - b[0], a[1] - b[1], a[2] - b[2], a[3] - b[3] }; }
+        friend CFloat4 operator* ( const CFloat4& a, const CFloat4& b ) { return { a[0] * b[0], a[1] * b[1], a[2] * b[2], a[3] * b[3] }; }
     };
+#endif
+
+    static CFloat4 Broadcast ( const float fValue ) { return CFloat4 { fValue, fValue, fValue, fValue }; }
+
+    static CFloat4 Load ( const float* pfData )
+    {
+        CFloat4 Value;
+        memcpy ( &Value, pfData, sizeof ( CFloat4 ) ); // no alignment required
+        return Value;
+    }
+
+    static void Store ( float* pfData, const CFloat4& Value ) { memcpy ( pfData, &Value, sizeof ( CFloat4 ) ); }
+
+    void setT60 ( const float fT60, const int iSampleRate );
+    bool isPrime ( const int number );
+
+    void ProcessAllpass ( CDelayLine& Delay, float* pfInOut, const int iNumSamples );
+    void ProcessCombs ( const float* pfIn, float* pfOut, const int iNumSamples );
+    void ProcessDelay ( CDelayLine& Delay, float* pfInOut, const int iNumSamples );
 
     EAudChanConf eAudioChannelConf;
     int          iStereoBlockSizeSam;
-    CFIFO<float> allpassDelays[3];
-    CFIFO<float> combDelays[4];
-    COnePole     combFilters[4];
-    CFIFO<float> outLeftDelay;
-    CFIFO<float> outRightDelay;
+    CDelayLine   allpassDelays[3];
+    CDelayLine   combDelays[4];
+    CDelayLine   outLeftDelay;
+    CDelayLine   outRightDelay;
     float        allpassCoefficient;
     float        combCoefficient[4];
+
+    // one-pole lowpass filters in the comb feedback paths (the four combs are
+    // processed as the lanes of one vector, all filters use the same pole)
+    float combFilterA;
+    float combFilterB;
+    float combFilterState[4];
+
+    // intermediate signals of a block (mono)
+    CVector<float> vecfBlockIn;
+    CVector<float> vecfBlockOutLeft;
+    CVector<float> vecfBlockOutRight;
 };
@@ -196,8 +196,21 @@ MESSAGES (with connection)
     - "flags":           flags indicating network properties:
                           - 0: none
                           - 1: WITH_COUNTER (a packet counter is added to the audio packet)
+                          - 2: WITH_COUNTER_AND_REDUNDANCY (like WITH_COUNTER, the audio
+                               frames may carry a redundant copy of the previous frame,
+                               see "audiocod arg", and PROTMESSID_AUDIO_LOSS_RATE is used)
+                          - 3: WITH_COUNTER_AND_SEPARATE_CHANNELS (like WITH_COUNTER, the
+                               audio channels in the frames of the client are coded
+                               separately as mono frames of equal size which follow each
+                               other, the server shows each of them as its own channel;
+                               the frames of the server are coded as usual)
     - "audiocod arg":    argument for the audio coder, if not used this value
                          shall be set to 0
+                         for WITH_COUNTER_AND_REDUNDANCY: number of bytes of the
+                         redundant copy of the previous frame which is appended to
+                         each coded frame (before the counter), 0 if no redundant
+                         copy is transmitted, the "base netw size" includes these
+                         bytes
 
 
 - PROTMESSID_REQ_NETW_TRANSPORT_PROPS: Request properties for network transport
@@ -246,6 +259,34 @@ MESSAGES (with connection)
     - tbc
 
 
+- PROTMESSID_AUDIO_LOSS_RATE: Loss rate of the received audio frames
+
+    +------------------------------+
+    | 2 bytes loss rate (per mill) |
+    +------------------------------+
+
+    - only sent if WITH_COUNTER_AND_REDUNDANCY is used, reports the frames which
+      were lost or too late (regardless if they could be reconstructed) in
+      the last measurement interval so that the sender can adapt the redundancy
+
+
+- PROTMESSID_NETW_TRANSP_FEATURES: Optional network transport features
+                                   supported by the server
+
+    +------------------------+
+    | 2 bytes feature flags  |
+    +------------------------+
+
+    - "feature flags":
+      Bits of ENetwTranspFeatures:
+      bit 0 - understands WITH_COUNTER_AND_REDUNDANCY
+      bit 1 - understands WITH_COUNTER_AND_SEPARATE_CHANNELS
+
+    - the server sends this message on a new connection, a client only uses
+      the flags of PROTMESSID_NETW_TRANSPORT_PROPS which the server announced
+      (old clients ignore the message)
+
+
 CONNECTION LESS MESSAGES
 ------------------------
 
@@ -352,6 +393,85 @@ CONNECTION LESS MESSAGES
 
     note: does not have any data -> n = 0
 
+    note: a directory with more servers than fit into one server list message
+          only lists the first servers in PROTMESSID_CLM_RED_SERVER_LIST and
+          PROTMESSID_CLM_SERVER_LIST and additionally sends the first page of
+          the complete list as PROTMESSID_CLM_SERVER_LIST_PAGE
+
+
+- PROTMESSID_CLM_SERVER_LIST_PAGE: One page of the complete server list
+
+    +----------------------+---------------------+-------------------------+ ...
+    | 4 bytes list version | 2 bytes page index  | 2 bytes number of pages | ...
+    +----------------------+---------------------+-------------------------+ ...
+        ... ------------------------------------------------+
+        ...  entries as in PROTMESSID_CLM_SERVER_LIST        |
+        ... ------------------------------------------------+
+
+    - "list version" changes whenever the server list of the directory changes,
+      pages of different versions must not be combined
+    - the entries of all pages in the order of the page index form the
+      server list, the first entry of the first page is the directory
+
+
+- PROTMESSID_CLM_REQ_SERVER_LIST_PAGE: Request one page of the server list
+
+    +----------------------+--------------------+
+    | 4 bytes list version | 2 bytes page index |
+    +----------------------+--------------------+
+
+    note: if the requested version is not available anymore, the directory
+          answers with the page of the current version
+
+
+- PROTMESSID_CLM_SUBSCRIBE_SERVER_LIST: Subscribe to the changes of the server
+                                        list
+
+    +----------------------+---------------+-----------------------+
+    | 4 bytes list version | 4 bytes token | 1 byte subscribe flag |
+    +----------------------+---------------+-----------------------+
+
+    - "list version" is the version of the server list the client currently
+      shows, the directory sends the changes since this version
+    - "token" is the token of the last PROTMESSID_CLM_SERVER_LIST_DIFF the
+      client has received, the directory ignores the message if the token does
+      not match the address it is received from
+    - "subscribe flag" is 1 to subscribe (or renew the subscription) and 0 to
+      unsubscribe, a subscription which is not renewed expires
+
+
+- PROTMESSID_CLM_SERVER_LIST_DIFF: Changes of the server list
+
+    +----------------------+----------------------+---------------+ ...
+    | 4 bytes base version | 4 bytes list version | 4 bytes token | ...
+    +----------------------+----------------------+---------------+ ...
+        ... -------------+ ...
+        ...  1 byte flag | ...
+        ... -------------+ ...
+        ... ------------------------------+ ...
+        ...  2 bytes number n of removed  | ...
+        ... ------------------------------+ ...
+        ... ---------------------------------------------+ ...
+        ...  n times: 4 bytes IP address, 2 bytes port   | ...
+        ... ---------------------------------------------+ ...
+        ... ------------------------------------------------------------+
+        ...  added or changed entries as in PROTMESSID_CLM_SERVER_LIST   |
+        ... ------------------------------------------------------------+
+
+    - applying the changes to the server list of version "base version"
+      results in the server list of version "list version", the removed
+      entries are applied first, an added or changed entry replaces the entry
+      with the same address
+    - "flag" is 1 if the changes are not available, the client then has to
+      request the complete server list again (no removed or changed entries
+      are sent in this case)
+    - "token" is generated by the directory for the address the message is sent
+      to, it must be echoed in PROTMESSID_CLM_SUBSCRIBE_SERVER_LIST so that only
+      the owner of an address can subscribe it to the changes
+    - the directory sends this message with equal base and list version and
+      without changes after the server list and after the first page of a
+      paged server list as the version of that list and for the token
+
 
 - PROTMESSID_CLM_SEND_EMPTY_MESSAGE: Send "empty message" message
 
@@ -360,6 +480,23 @@ CONNECTION LESS MESSAGES
     +--------------------+--------------+
 
 
+- PROTMESSID_CLM_SEND_EMPTY_MES_MULTI: Send "empty message" message to several
+                                       targets
+
+    for each target append following data:
+
+    +--------------------+--------------+
+    | 4 bytes IP address | 2 bytes port |
+    +--------------------+--------------+
+
+    note: the directory only sends this message to servers which announced
+          SF_SEND_EMPTY_MES_MULTI in PROTMESSID_CLM_SERVER_FEATURES, all
+          other servers get one PROTMESSID_CLM_SEND_EMPTY_MESSAGE per target
+
+    note: a server only acts on this message if it was sent by the directory
+          the server is registered with
+
+
 - PROTMESSID_CLM_DISCONNECTION: Disconnect message
 
     note: does not have any data -> n = 0
@@ -432,6 +569,23 @@ CONNECTION LESS MESSAGES
           five times for one registration request at 500ms intervals.
           Beyond this, it should "ping" every 15 minutes
           (standard re-registration timeout).
+
+
+- PROTMESSID_CLM_SERVER_FEATURES: Optional features supported by a registered
+                                  server
+
+    +------------------------+
+    | 2 bytes feature flags  |
+    +------------------------+
+
+    - "feature flags":
+      Bits of EServerFeatures:
+      bit 0 - understands PROTMESSID_CLM_SEND_EMPTY_MES_MULTI
+
+    Note: the server sends this message to the directory after each
+          successful registration, the directory only applies it to the
+          list entry with the address of the sender. Directories which
+          do not know the message ignore it.
 */
 
 #include "protocol.h"
@@ -824,6 +978,14 @@ void CProtocol::ParseMessageBody ( const CVector<uint8_t>& vecbyMesBodyData, con
                 case PROTMESSID_RECORDER_STATE:
                     EvaluateRecorderStateMes ( vecbyMesBodyDataRef );
                     break;
+
+                case PROTMESSID_AUDIO_LOSS_RATE:
+                    EvaluateAudioLossRateMes ( vecbyMesBodyDataRef );
+                    break;
+
+                case PROTMESSID_NETW_TRANSP_FEATURES:
+                    EvaluateNetwTranspFeaturesMes ( vecbyMesBodyDataRef );
+                    break;
                 }
             }
 
@@ -873,10 +1035,30 @@ void CProtocol::ParseConnectionLessMessageBody ( const CVector<uint8_t>& vecbyMe
         EvaluateCLReqServerListMes ( InetAddr );
         break;
 
+    case PROTMESSID_CLM_SERVER_LIST_PAGE:
+        EvaluateCLServerListPageMes ( InetAddr, vecbyMesBodyData );
+        break;
+
+    case PROTMESSID_CLM_REQ_SERVER_LIST_PAGE:
+        EvaluateCLReqServerListPageMes ( InetAddr, vecbyMesBodyData );
+        break;
+
+    case PROTMESSID_CLM_SUBSCRIBE_SERVER_LIST:
+        EvaluateCLSubscribeServerListMes ( InetAddr, vecbyMesBodyData );
+        break;
+
+    case PROTMESSID_CLM_SERVER_LIST_DIFF:
+        EvaluateCLServerListDiffMes ( InetAddr, vecbyMesBodyData );
+        break;
+
     case PROTMESSID_CLM_SEND_EMPTY_MESSAGE:
         EvaluateCLSendEmptyMesMes ( vecbyMesBodyData );
         break;
 
+    case PROTMESSID_CLM_SEND_EMPTY_MES_MULTI:
+        EvaluateCLSendEmptyMesMultiMes ( InetAddr, vecbyMesBodyData );
+        break;
+
     case PROTMESSID_CLM_REGISTER_SERVER:
         EvaluateCLRegisterServerMes ( InetAddr, vecbyMesBodyData );
         break;
@@ -916,6 +1098,10 @@ void CProtocol::ParseConnectionLessMessageBody ( const CVector<uint8_t>& vecbyMe
     case PROTMESSID_CLM_REGISTER_SERVER_RESP:
         EvaluateCLRegisterServerResp ( InetAddr, vecbyMesBodyData );
         break;
+
+    case PROTMESSID_CLM_SERVER_FEATURES:
+        EvaluateCLServerFeaturesMes ( InetAddr, vecbyMesBodyData );
+        break;
     }
 }
 
@@ -1664,6 +1850,71 @@ bool CProtocol::EvaluateRecorderStateMes ( const CVector<uint8_t>& vecData )
     return false; // no error
 }
 
+void CProtocol::CreateAudioLossRateMes ( const int iLossRatePermille )
+{
+    CVector<uint8_t> vecData ( 2 ); // 2 bytes of data
+    int              iPos = 0;      // init position pointer
+
+    // build data vector
+    PutValOnStream ( vecData, iPos, static_cast<uint32_t> ( iLossRatePermille ), 2 );
+
+    CreateAndSendMessage ( PROTMESSID_AUDIO_LOSS_RATE, vecData );
+}
+
+bool CProtocol::EvaluateAudioLossRateMes ( const CVector<uint8_t>& vecData )
+{
+    int iPos = 0; // init position pointer
+
+    // check size
+    if ( vecData.Size() != 2 )
+    {
+        return true; // return error code
+    }
+
+    // extract loss rate
+    const int iData = static_cast<int> ( GetValFromStream ( vecData, iPos, 2 ) );
+
+    if ( iData > 1000 )
+    {
+        return true; // return error code
+    }
+
+    // invoke message action
+    emit AudioLossRateReceived ( iData );
+
+    return false; // no error
+}
+
+void CProtocol::CreateNetwTranspFeaturesMes ( const int iFeatures )
+{
+    CVector<uint8_t> vecData ( 2 ); // 2 bytes of data
+    int              iPos = 0;      // init position pointer
+
+    // build data vector
+    PutValOnStream ( vecData, iPos, static_cast<uint32_t> ( iFeatures ), 2 );
+
+    CreateAndSendMessage ( PROTMESSID_NETW_TRANSP_FEATURES, vecData );
+}
+
+bool CProtocol::EvaluateNetwTranspFeaturesMes ( const CVector<uint8_t>& vecData )
+{
+    int iPos = 0; // init position pointer
+
+    // check size (later versions may append further data)
+    if ( vecData.Size() < 2 )
+    {
+        return true; // return error code
+    }
+
+    // extract feature flags, unknown bits are ignored by the receiver
+    const int iData = static_cast<int> ( GetValFromStream ( vecData, iPos, 2 ) );
+
+    // invoke message action
+    emit NetwTranspFeaturesReceived ( iData );
+
+    return false; // no error
+}
+
 // Connection less messages ----------------------------------------------------
 void CProtocol::CreateCLPingMes ( const CHostAddress& InetAddr, const int iMs )
 {
@@ -1732,6 +1983,36 @@ bool CProtocol::EvaluateCLPingWithNumClientsMes ( const CHostAddress& InetAddr,
     return false; // no error
 }
 
+bool CProtocol::GenCLPingAnswerMes ( CVector<uint8_t>&       vecMessage,
+                                     const int               iRecID,
+                                     const CVector<uint8_t>& vecbyMesBodyData,
+                                     const int               iNumClients )
+{
+    if ( ( iRecID == PROTMESSID_CLM_PING_MS ) && ( vecbyMesBodyData.Size() == 4 ) )
+    {
+        // the transmit time is sent back unchanged
+        GenMessageFrame ( vecMessage, 0, PROTMESSID_CLM_PING_MS, vecbyMesBodyData );
+
+        return false; // no error
+    }
+
+    if ( ( iRecID == PROTMESSID_CLM_PING_MS_WITHNUMCLIENTS ) && ( vecbyMesBodyData.Size() == 5 ) )
+    {
+        // the transmit time (4 bytes) is sent back unchanged, followed by the
+        // current number of connected clients (1 byte)
+        CVector<uint8_t> vecData ( vecbyMesBodyData );
+        int              iPos = 4; // position of the number of clients
+
+        PutValOnStream ( vecData, iPos, static_cast<uint32_t> ( iNumClients ), 1 );
+
+        GenMessageFrame ( vecMessage, 0, PROTMESSID_CLM_PING_MS_WITHNUMCLIENTS, vecData );
+
+        return false; // no error
+    }
+
+    return true; // return error code
+}
+
 void CProtocol::CreateCLServerFullMes ( const CHostAddress& InetAddr )
 {
     CreateAndImmSendConLessMessage ( PROTMESSID_CLM_SERVER_FULL, CVector<uint8_t> ( 0 ), InetAddr );
@@ -2006,6 +2287,16 @@ bool CProtocol::EvaluateCLUnregisterServerMes ( const CHostAddress& InetAddr )
 }
 
 void CProtocol::CreateCLServerListMes ( const CHostAddress& InetAddr, const CVector<CServerInfo> vecServerInfo )
+{
+    CVector<uint8_t> vecMessage;
+
+    GenCLServerListMes ( vecMessage, vecServerInfo );
+
+    // immediately send message
+    emit CLMessReadyForSending ( InetAddr, vecMessage );
+}
+
+void CProtocol::GenCLServerListMes ( CVector<uint8_t>& vecMessage, const CVector<CServerInfo>& vecServerInfo )
 {
     const int iNumServers = vecServerInfo.Size();
 
@@ -2015,127 +2306,316 @@ void CProtocol::CreateCLServerListMes ( const CHostAddress& InetAddr, const CVec
 
     for ( int i = 0; i < iNumServers; i++ )
     {
-        // convert server list strings to utf-8
-        const QByteArray strUTF8Name  = vecServerInfo[i].strName.toUtf8();
-        const QByteArray strUTF8Empty = QString ( "" ).toUtf8();
-        const QByteArray strUTF8City  = vecServerInfo[i].strCity.toUtf8();
+        PutServerListEntryOnStream ( vecData, iPos, vecServerInfo[i] );
+    }
 
-        // size of current list entry
-        const int iCurListEntrLen = 4 +                      // IP address
-                                    2 +                      // port number
-                                    2 +                      // country
-                                    1 +                      // maximum number of connected clients
-                                    1 +                      // is permanent flag
-                                    2 + strUTF8Name.size() + // name utf-8 str. size / str.
-                                    2 +                      // empty string
-                                    2 + strUTF8City.size();  // city utf-8 str. size / str.
+    // build complete message (counter per definition=0 for connection less
+    // messages)
+    GenMessageFrame ( vecMessage, 0, PROTMESSID_CLM_SERVER_LIST, vecData );
+}
 
-        // make space for new data
-        vecData.Enlarge ( iCurListEntrLen );
+bool CProtocol::EvaluateCLServerListMes ( const CHostAddress& InetAddr, const CVector<uint8_t>& vecData )
+{
+    int                  iPos = 0; // init position pointer
+    CVector<CServerInfo> vecServerInfo ( 0 );
 
-        // IP address (4 bytes)
-        // note the Server List manager has put the internal details in HostAddr where required
-        PutValOnStream ( vecData, iPos, static_cast<uint32_t> ( vecServerInfo[i].HostAddr.InetAddr.toIPv4Address() ), 4 );
+    if ( GetServerListEntriesFromStream ( vecData, iPos, vecServerInfo ) )
+    {
+        return true; // return error code
+    }
 
-        // port number (2 bytes)
-        // note the Server List manager has put the internal details in HostAddr where required
-        PutValOnStream ( vecData, iPos, static_cast<uint32_t> ( vecServerInfo[i].HostAddr.iPort ), 2 );
+    // invoke message action
+    emit CLServerListReceived ( InetAddr, vecServerInfo );
 
-        // country (2 bytes)
-        PutCountryOnStream ( vecData, iPos, vecServerInfo[i].eCountry );
+    return false; // no error
+}
 
-        // maximum number of connected clients (1 byte)
-        PutValOnStream ( vecData, iPos, static_cast<uint32_t> ( vecServerInfo[i].iMaxNumClients ), 1 );
+void CProtocol::GenCLServerListPageMes ( CVector<CVector<uint8_t>>& vecPageMes, const CVector<CServerInfo>& vecServerInfo, const int iVersion )
+{
+    const int iNumServers = vecServerInfo.Size();
 
-        // "is permanent" flag (1 byte)
-        PutValOnStream ( vecData, iPos, static_cast<uint32_t> ( vecServerInfo[i].bPermanentOnline ), 1 );
+    // encode all entries first to know where the pages have to be split
+    CVector<uint8_t> vecEntries ( 0 );
+    CVector<int>     vecPageStart ( 0 );
+    int              iPos = 0; // init position pointer
 
-        // name
-        PutStringUTF8OnStream ( vecData, iPos, strUTF8Name );
+    vecPageStart.Add ( 0 );
 
-        // empty string
-        PutStringUTF8OnStream ( vecData, iPos, strUTF8Empty );
+    for ( int i = 0; i < iNumServers; i++ )
+    {
+        const int iEntryStart = iPos;
 
-        // city
-        PutStringUTF8OnStream ( vecData, iPos, strUTF8City );
+        PutServerListEntryOnStream ( vecEntries, iPos, vecServerInfo[i] );
+
+        // start a new page if the entry does not fit into the current one
+        if ( ( iPos - vecPageStart[vecPageStart.Size() - 1] > MAX_SIZE_BYTES_SERVER_LIST_PAGE ) &&
+             ( iEntryStart > vecPageStart[vecPageStart.Size() - 1] ) )
+        {
+            vecPageStart.Add ( iEntryStart );
+        }
     }
 
-    CreateAndImmSendConLessMessage ( PROTMESSID_CLM_SERVER_LIST, vecData, InetAddr );
+    const int iNumPages = vecPageStart.Size();
+
+    vecPageMes.Init ( iNumPages );
+
+    for ( int iPage = 0; iPage < iNumPages; iPage++ )
+    {
+        const int iPageStart = vecPageStart[iPage];
+        const int iPageEnd   = ( iPage + 1 < iNumPages ) ? vecPageStart[iPage + 1] : iPos;
+
+        CVector<uint8_t> vecData ( 8 + iPageEnd - iPageStart );
+        int              iPagePos = 0;
+
+        // list version (4 bytes)
+        PutValOnStream ( vecData, iPagePos, static_cast<uint32_t> ( iVersion ), 4 );
+
+        // page index (2 bytes)
+        PutValOnStream ( vecData, iPagePos, static_cast<uint32_t> ( iPage ), 2 );
+
+        // number of pages (2 bytes)
+        PutValOnStream ( vecData, iPagePos, static_cast<uint32_t> ( iNumPages ), 2 );
+
+        // the server list entries of this page
+        std::copy ( vecEntries.begin() + iPageStart, vecEntries.begin() + iPageEnd, vecData.begin() + iPagePos );
+
+        // build complete message (counter per definition=0 for connection less
+        // messages)
+        GenMessageFrame ( vecPageMes[iPage], 0, PROTMESSID_CLM_SERVER_LIST_PAGE, vecData );
+    }
 }
 
-bool CProtocol::EvaluateCLServerListMes ( const CHostAddress& InetAddr, const CVector<uint8_t>& vecData )
+bool CProtocol::EvaluateCLServerListPageMes ( const CHostAddress& InetAddr, const CVector<uint8_t>& vecData )
 {
-    int                  iPos     = 0; // init position pointer
-    const int            iDataLen = vecData.Size();
+    int                  iPos = 0; // init position pointer
     CVector<CServerInfo> vecServerInfo ( 0 );
 
-    while ( iPos < iDataLen )
+    // check size (version, page index and number of pages)
+    if ( vecData.Size() < 8 )
     {
-        // check size (the next 10 bytes)
-        if ( ( iDataLen - iPos ) < 10 )
-        {
-            return true; // return error code
-        }
+        return true; // return error code
+    }
 
+    // list version (4 bytes)
+    const int iVersion = static_cast<int> ( GetValFromStream ( vecData, iPos, 4 ) );
+
+    // page index (2 bytes)
+    const int iPage = static_cast<int> ( GetValFromStream ( vecData, iPos, 2 ) );
+
+    // number of pages (2 bytes)
+    const int iNumPages = static_cast<int> ( GetValFromStream ( vecData, iPos, 2 ) );
+
+    if ( iPage >= iNumPages )
+    {
+        return true; // return error code
+    }
+
+    if ( GetServerListEntriesFromStream ( vecData, iPos, vecServerInfo ) )
+    {
+        return true; // return error code
+    }
+
+    // invoke message action
+    emit CLServerListPageReceived ( InetAddr, iVersion, iPage, iNumPages, vecServerInfo );
+
+    return false; // no error
+}
+
+void CProtocol::CreateCLReqServerListPageMes ( const CHostAddress& InetAddr, const int iVersion, const int iPage )
+{
+    CVector<uint8_t> vecData ( 6 ); // 6 bytes of data
+    int              iPos = 0;      // init position pointer
+
+    // build data vector
+    // list version (4 bytes)
+    PutValOnStream ( vecData, iPos, static_cast<uint32_t> ( iVersion ), 4 );
+
+    // page index (2 bytes)
+    PutValOnStream ( vecData, iPos, static_cast<uint32_t> ( iPage ), 2 );
+
+    CreateAndImmSendConLessMessage ( PROTMESSID_CLM_REQ_SERVER_LIST_PAGE, vecData, InetAddr );
+}
+
+bool CProtocol::EvaluateCLReqServerListPageMes ( const CHostAddress& InetAddr, const CVector<uint8_t>& vecData )
+{
+    int iPos = 0; // init position pointer
+
+    // check size
+    if ( vecData.Size() != 6 )
+    {
+        return true; // return error code
+    }
+
+    // list version (4 bytes)
+    const int iVersion = static_cast<int> ( GetValFromStream ( vecData, iPos, 4 ) );
+
+    // page index (2 bytes)
+    const int iPage = static_cast<int> ( GetValFromStream ( vecData, iPos, 2 ) );
+
+    // invoke message action
+    emit CLReqServerListPage ( InetAddr, iVersion, iPage );
+
+    return false; // no error
+}
+
+void CProtocol::CreateCLSubscribeServerListMes ( const CHostAddress& InetAddr, const int iVersion, const int iToken, const bool bSubscribe )
+{
+    CVector<uint8_t> vecData ( 9 ); // 9 bytes of data
+    int              iPos = 0;      // init position pointer
+
+    // build data vector
+    // list version (4 bytes)
+    PutValOnStream ( vecData, iPos, static_cast<uint32_t> ( iVersion ), 4 );
+
+    // token (4 bytes)
+    PutValOnStream ( vecData, iPos, static_cast<uint32_t> ( iToken ), 4 );
+
+    // subscribe flag (1 byte)
+    PutValOnStream ( vecData, iPos, static_cast<uint32_t> ( bSubscribe ), 1 );
+
+    CreateAndImmSendConLessMessage ( PROTMESSID_CLM_SUBSCRIBE_SERVER_LIST, vecData, InetAddr );
+}
+
+bool CProtocol::EvaluateCLSubscribeServerListMes ( const CHostAddress& InetAddr, const CVector<uint8_t>& vecData )
+{
+    int iPos = 0; // init position pointer
+
+    // check size
+    if ( vecData.Size() != 9 )
+    {
+        return true; // return error code
+    }
+
+    // list version (4 bytes)
+    const int iVersion = static_cast<int> ( GetValFromStream ( vecData, iPos, 4 ) );
+
+    // token (4 bytes)
+    const int iToken = static_cast<int> ( GetValFromStream ( vecData, iPos, 4 ) );
+
+    // subscribe flag (1 byte)
+    const bool bSubscribe = static_cast<bool> ( GetValFromStream ( vecData, iPos, 1 ) );
+
+    // invoke message action
+    emit CLSubscribeServerList ( InetAddr, iVersion, iToken, bSubscribe );
+
+    return false; // no error
+}
+
+void CProtocol::GenCLServerListDiffMes ( CVector<uint8_t>&            vecMessage,
+                                         const int                    iBaseVersion,
+                                         const int                    iVersion,
+                                         const int                    iToken,
+                                         const bool                   bResync,
+                                         const CVector<CHostAddress>& vecRemovedInetAddr,
+                                         const CVector<CServerInfo>&  vecServerInfo )
+{
+    const int iNumRemoved = vecRemovedInetAddr.Size();
+    const int iNumServers = vecServerInfo.Size();
+
+    // build data vector (the entries are appended by enlarging the vector)
+    CVector<uint8_t> vecData ( 15 + 6 * iNumRemoved );
+    int              iPos = 0; // init position pointer
+
+    // base version (4 bytes)
+    PutValOnStream ( vecData, iPos, static_cast<uint32_t> ( iBaseVersion ), 4 );
+
+    // list version (4 bytes)
+    PutValOnStream ( vecData, iPos, static_cast<uint32_t> ( iVersion ), 4 );
+
+    // token (4 bytes)
+    PutValOnStream ( vecData, iPos, static_cast<uint32_t> ( iToken ), 4 );
+
+    // flag (1 byte)
+    PutValOnStream ( vecData, iPos, static_cast<uint32_t> ( bResync ), 1 );
+
+    // number of removed servers (2 bytes)
+    PutValOnStream ( vecData, iPos, static_cast<uint32_t> ( iNumRemoved ), 2 );
+
+    for ( int i = 0; i < iNumRemoved; i++ )
+    {
         // IP address (4 bytes)
-        const quint32 iIpAddr = static_cast<quint32> ( GetValFromStream ( vecData, iPos, 4 ) );
+        PutValOnStream ( vecData, iPos, static_cast<uint32_t> ( vecRemovedInetAddr[i].InetAddr.toIPv4Address() ), 4 );
 
         // port number (2 bytes)
-        const quint16 iPort = static_cast<quint16> ( GetValFromStream ( vecData, iPos, 2 ) );
+        PutValOnStream ( vecData, iPos, static_cast<uint32_t> ( vecRemovedInetAddr[i].iPort ), 2 );
+    }
 
-        // country (2 bytes)
-        const QLocale::Country eCountry = GetCountryFromStream ( vecData, iPos );
+    for ( int i = 0; i < iNumServers; i++ )
+    {
+        PutServerListEntryOnStream ( vecData, iPos, vecServerInfo[i] );
+    }
 
-        // maximum number of connected clients (1 byte)
-        const int iMaxNumClients = static_cast<int> ( GetValFromStream ( vecData, iPos, 1 ) );
+    // build complete message (counter per definition=0 for connection less
+    // messages)
+    GenMessageFrame ( vecMessage, 0, PROTMESSID_CLM_SERVER_LIST_DIFF, vecData );
+}
 
-        // "is permanent" flag (1 byte)
-        const bool bPermanentOnline = static_cast<bool> ( GetValFromStream ( vecData, iPos, 1 ) );
+bool CProtocol::EvaluateCLServerListDiffMes ( const CHostAddress& InetAddr, const CVector<uint8_t>& vecData )
+{
+    int                   iPos = 0; // init position pointer
+    CVector<CHostAddress> vecRemovedInetAddr ( 0 );
+    CVector<CServerInfo>  vecServerInfo ( 0 );
 
-        // server name
-        QString strName;
-        if ( GetStringFromStream ( vecData, iPos, MAX_LEN_SERVER_NAME, strName ) )
-        {
-            return true; // return error code
-        }
+    // check size (versions, token, flag and number of removed servers)
+    if ( vecData.Size() < 15 )
+    {
+        return true; // return error code
+    }
 
-        // empty
-        QString strEmpty;
-        if ( GetStringFromStream ( vecData, iPos, MAX_LEN_IP_ADDRESS, strEmpty ) )
-        {
-            return true; // return error code
-        }
+    // base version (4 bytes)
+    const int iBaseVersion = static_cast<int> ( GetValFromStream ( vecData, iPos, 4 ) );
 
-        // server city
-        QString strCity;
-        if ( GetStringFromStream ( vecData, iPos, MAX_LEN_SERVER_CITY, strCity ) )
-        {
-            return true; // return error code
-        }
+    // list version (4 bytes)
+    const int iVersion = static_cast<int> ( GetValFromStream ( vecData, iPos, 4 ) );
 
-        // add server information to vector
-        vecServerInfo.Add ( CServerInfo ( CHostAddress ( QHostAddress ( iIpAddr ), iPort ),
-                                          CHostAddress ( QHostAddress ( iIpAddr ), iPort ),
-                                          strName,
-                                          eCountry,
-                                          strCity,
-                                          iMaxNumClients,
-                                          bPermanentOnline ) );
+    // token (4 bytes)
+    const int iToken = static_cast<int> ( GetValFromStream ( vecData, iPos, 4 ) );
+
+    // flag (1 byte)
+    const bool bResync = static_cast<bool> ( GetValFromStream ( vecData, iPos, 1 ) );
+
+    // number of removed servers (2 bytes)
+    const int iNumRemoved = static_cast<int> ( GetValFromStream ( vecData, iPos, 2 ) );
+
+    // check size (removed servers)
+    if ( vecData.Size() - iPos < 6 * iNumRemoved )
+    {
+        return true; // return error code
     }
 
-    // check size: all data is read, the position must now be at the end
-    if ( iPos != iDataLen )
+    for ( int i = 0; i < iNumRemoved; i++ )
+    {
+        // IP address (4 bytes)
+        const quint32 iIpAddr = static_cast<quint32> ( GetValFromStream ( vecData, iPos, 4 ) );
+
+        // port number (2 bytes)
+        const quint16 iPort = static_cast<quint16> ( GetValFromStream ( vecData, iPos, 2 ) );
+
+        vecRemovedInetAddr.Add ( CHostAddress ( QHostAddress ( iIpAddr ), iPort ) );
+    }
+
+    if ( GetServerListEntriesFromStream ( vecData, iPos, vecServerInfo ) )
     {
         return true; // return error code
     }
 
     // invoke message action
-    emit CLServerListReceived ( InetAddr, vecServerInfo );
+    emit CLServerListDiffReceived ( InetAddr, iBaseVersion, iVersion, iToken, bResync, vecRemovedInetAddr, vecServerInfo );
 
     return false; // no error
 }
 
 void CProtocol::CreateCLRedServerListMes ( const CHostAddress& InetAddr, const CVector<CServerInfo> vecServerInfo )
+{
+    CVector<uint8_t> vecMessage;
+
+    GenCLRedServerListMes ( vecMessage, vecServerInfo );
+
+    // immediately send message
+    emit CLMessReadyForSending ( InetAddr, vecMessage );
+}
+
+void CProtocol::GenCLRedServerListMes ( CVector<uint8_t>& vecMessage, const CVector<CServerInfo>& vecServerInfo )
 {
     const int iNumServers = vecServerInfo.Size();
 
@@ -2168,7 +2648,16 @@ void CProtocol::CreateCLRedServerListMes ( const CHostAddress& InetAddr, const C
         PutStringUTF8OnStream ( vecData, iPos, strUTF8Name, 1 );
     }
 
-    CreateAndImmSendConLessMessage ( PROTMESSID_CLM_RED_SERVER_LIST, vecData, InetAddr );
+    // build complete message (counter per definition=0 for connection less
+    // messages)
+    GenMessageFrame ( vecMessage, 0, PROTMESSID_CLM_RED_SERVER_LIST, vecData );
+}
+
+void CProtocol::SendCLPreparedMes ( const CHostAddress& InetAddr, const CVector<uint8_t>& vecMessage )
+{
+    // the message was built completely beforehand (e.g., by GenCLServerListMes),
+    // so it can be sent as it is
+    emit CLMessReadyForSending ( InetAddr, vecMessage );
 }
 
 bool CProtocol::EvaluateCLRedServerListMes ( const CHostAddress& InetAddr, const CVector<uint8_t>& vecData )
@@ -2271,6 +2760,57 @@ bool CProtocol::EvaluateCLSendEmptyMesMes ( const CVector<uint8_t>& vecData )
     return false; // no error
 }
 
+void CProtocol::CreateCLSendEmptyMesMultiMes ( const CHostAddress& InetAddr, const CVector<CHostAddress>& vecTargetInetAddr )
+{
+    const int iNumTargets = vecTargetInetAddr.Size();
+    int       iPos        = 0; // init position pointer
+
+    // build data vector (6 bytes per target)
+    CVector<uint8_t> vecData ( 6 * iNumTargets );
+
+    for ( int i = 0; i < iNumTargets; i++ )
+    {
+        // IP address (4 bytes)
+        PutValOnStream ( vecData, iPos, static_cast<uint32_t> ( vecTargetInetAddr[i].InetAddr.toIPv4Address() ), 4 );
+
+        // port number (2 bytes)
+        PutValOnStream ( vecData, iPos, static_cast<uint32_t> ( vecTargetInetAddr[i].iPort ), 2 );
+    }
+
+    CreateAndImmSendConLessMessage ( PROTMESSID_CLM_SEND_EMPTY_MES_MULTI, vecData, InetAddr );
+}
+
+bool CProtocol::EvaluateCLSendEmptyMesMultiMes ( const CHostAddress& InetAddr, const CVector<uint8_t>& vecData )
+{
+    int       iPos        = 0; // init position pointer
+    const int iNumTargets = vecData.Size() / 6;
+
+    // check size
+    if ( ( vecData.Size() % 6 ) != 0 || ( iNumTargets > MAX_NUM_TARGETS_SEND_EMPTY_MES_MULTI ) )
+    {
+        return true; // return error code
+    }
+
+    CVector<CHostAddress> vecTargetInetAddr ( iNumTargets );
+
+    for ( int i = 0; i < iNumTargets; i++ )
+    {
+        // IP address (4 bytes)
+        const quint32 iIpAddr = static_cast<quint32> ( GetValFromStream ( vecData, iPos, 4 ) );
+
+        // port number (2 bytes)
+        const quint16 iPort = static_cast<quint16> ( GetValFromStream ( vecData, iPos, 2 ) );
+
+        vecTargetInetAddr[i] = CHostAddress ( QHostAddress ( iIpAddr ), iPort );
+    }
+
+    // invoke message action (the receiver has to check the sender since the
+    // message makes us send one datagram per target)
+    emit CLSendEmptyMesMulti ( InetAddr, vecTargetInetAddr );
+
+    return false; // no error
+}
+
 void CProtocol::CreateCLEmptyMes ( const CHostAddress& InetAddr )
 {
     // special message: for this message there exist no Evaluate
@@ -2364,6 +2904,16 @@ bool CProtocol::EvaluateCLReqVersionAndOSMes ( const CHostAddress& InetAddr )
 }
 
 void CProtocol::CreateCLConnClientsListMes ( const CHostAddress& InetAddr, const CVector<CChannelInfo>& vecChanInfo )
+{
+    CVector<uint8_t> vecMessage;
+
+    GenCLConnClientsListMes ( vecMessage, vecChanInfo );
+
+    // immediately send message
+    emit CLMessReadyForSending ( InetAddr, vecMessage );
+}
+
+void CProtocol::GenCLConnClientsListMes ( CVector<uint8_t>& vecMessage, const CVector<CChannelInfo>& vecChanInfo )
 {
     const int iNumClients = vecChanInfo.Size();
 
@@ -2411,7 +2961,9 @@ void CProtocol::CreateCLConnClientsListMes ( const CHostAddress& InetAddr, const
         PutStringUTF8OnStream ( vecData, iPos, strUTF8City );
     }
 
-    CreateAndImmSendConLessMessage ( PROTMESSID_CLM_CONN_CLIENTS_LIST, vecData, InetAddr );
+    // build complete message (counter per definition=0 for connection less
+    // messages)
+    GenMessageFrame ( vecMessage, 0, PROTMESSID_CLM_CONN_CLIENTS_LIST, vecData );
 }
 
 bool CProtocol::EvaluateCLConnClientsListMes ( const CHostAddress& InetAddr, const CVector<uint8_t>& vecData )
@@ -2579,6 +3131,35 @@ bool CProtocol::EvaluateCLRegisterServerResp ( const CHostAddress& InetAddr, con
     return false; // no error
 }
 
+void CProtocol::CreateCLServerFeaturesMes ( const CHostAddress& InetAddr, const int iFeatures )
+{
+    int              iPos = 0; // init position pointer
+    CVector<uint8_t> vecData ( 2 );
+
+    PutValOnStream ( vecData, iPos, static_cast<uint32_t> ( iFeatures ), 2 );
+
+    CreateAndImmSendConLessMessage ( PROTMESSID_CLM_SERVER_FEATURES, vecData, InetAddr );
+}
+
+bool CProtocol::EvaluateCLServerFeaturesMes ( const CHostAddress& InetAddr, const CVector<uint8_t>& vecData )
+{
+    int iPos = 0; // init position pointer
+
+    // check size (later versions may append further data)
+    if ( vecData.Size() < 2 )
+    {
+        return true; // return error code
+    }
+
+    // feature flags (2 bytes), unknown bits are ignored by the receiver
+    const int iFeatures = static_cast<int> ( GetValFromStream ( vecData, iPos, 2 ) );
+
+    // invoke message action
+    emit CLServerFeaturesReceived ( InetAddr, iFeatures );
+
+    return false; // no error
+}
+
 /******************************************************************************\
 * Message generation and parsing                                               *
 \******************************************************************************/
@@ -2889,3 +3470,117 @@ void CProtocol::PutCountryOnStream ( CVector<uint8_t>& vecIn, int& iPos, QLocale
     unsigned short iCountryCode = CLocale::QtCountryToWireFormatCountryCode ( eCountry );
     PutValOnStream ( vecIn, iPos, iCountryCode, 2 );
 }
+
+void CProtocol::PutServerListEntryOnStream ( CVector<uint8_t>& vecIn, int& iPos, const CServerInfo& ServerInfo )
+{
+    // convert server list strings to utf-8
+    const QByteArray strUTF8Name  = ServerInfo.strName.toUtf8();
+    const QByteArray strUTF8Empty = QString ( "" ).toUtf8();
+    const QByteArray strUTF8City  = ServerInfo.strCity.toUtf8();
+
+    // size of current list entry
+    const int iCurListEntrLen = 4 +                      // IP address
+                                2 +                      // port number
+                                2 +                      // country
+                                1 +                      // maximum number of connected clients
+                                1 +                      // is permanent flag
+                                2 + strUTF8Name.size() + // name utf-8 str. size / str.
+                                2 +                      // empty string
+                                2 + strUTF8City.size();  // city utf-8 str. size / str.
+
+    // make space for new data
+    vecIn.Enlarge ( iCurListEntrLen );
+
+    // IP address (4 bytes)
+    // note the Server List manager has put the internal details in HostAddr where required
+    PutValOnStream ( vecIn, iPos, static_cast<uint32_t> ( ServerInfo.HostAddr.InetAddr.toIPv4Address() ), 4 );
+
+    // port number (2 bytes)
+    // note the Server List manager has put the internal details in HostAddr where required
+    PutValOnStream ( vecIn, iPos, static_cast<uint32_t> ( ServerInfo.HostAddr.iPort ), 2 );
+
+    // country (2 bytes)
+    PutCountryOnStream ( vecIn, iPos, ServerInfo.eCountry );
+
+    // maximum number of connected clients (1 byte)
+    PutValOnStream ( vecIn, iPos, static_cast<uint32_t> ( ServerInfo.iMaxNumClients ), 1 );
+
+    // "is permanent" flag (1 byte)
+    PutValOnStream ( vecIn, iPos, static_cast<uint32_t> ( ServerInfo.bPermanentOnline ), 1 );
+
+    // name
+    PutStringUTF8OnStream ( vecIn, iPos, strUTF8Name );
+
+    // empty string
+    PutStringUTF8OnStream ( vecIn, iPos, strUTF8Empty );
+
+    // city
+    PutStringUTF8OnStream ( vecIn, iPos, strUTF8City );
+}
+
+bool CProtocol::GetServerListEntriesFromStream ( const CVector<uint8_t>& vecIn, int& iPos, CVector<CServerInfo>& vecServerInfo )
+{
+    const int iDataLen = vecIn.Size();
+
+    while ( iPos < iDataLen )
+    {
+        // check size (the next 10 bytes)
+        if ( ( iDataLen - iPos ) < 10 )
+        {
+            return true; // return error code
+        }
+
+        // IP address (4 bytes)
+        const quint32 iIpAddr = static_cast<quint32> ( GetValFromStream ( vecIn, iPos, 4 ) );
+
+        // port number (2 bytes)
+        const quint16 iPort = static_cast<quint16> ( GetValFromStream ( vecIn, iPos, 2 ) );
+
+        // country (2 bytes)
+        const QLocale::Country eCountry = GetCountryFromStream ( vecIn, iPos );
+
+        // maximum number of connected clients (1 byte)
+        const int iMaxNumClients = static_cast<int> ( GetValFromStream ( vecIn, iPos, 1 ) );
+
+        // "is permanent" flag (1 byte)
+        const bool bPermanentOnline = static_cast<bool> ( GetValFromStream ( vecIn, iPos, 1 ) );
+
+        // server name
+        QString strName;
+        if ( GetStringFromStream ( vecIn, iPos, MAX_LEN_SERVER_NAME, strName ) )
+        {
+            return true; // return error code
+        }
+
+        // empty
+        QString strEmpty;
+        if ( GetStringFromStream ( vecIn, iPos, MAX_LEN_IP_ADDRESS, strEmpty ) )
+        {
+            return true; // return error code
+        }
+
+        // server city
+        QString strCity;
+        if ( GetStringFromStream ( vecIn, iPos, MAX_LEN_SERVER_CITY, strCity ) )
+        {
+            return true; // return error code
+        }
+
+        // add server information to vector
+        vecServerInfo.Add ( CServerInfo ( CHostAddress ( QHostAddress ( iIpAddr ), iPort ),
+                                          CHostAddress ( QHostAddress ( iIpAddr ), iPort ),
+                                          strName,
+                                          eCountry,
+                                          strCity,
+                                          iMaxNumClients,
+                                          bPermanentOnline ) );
+    }
+
+    // check size: all data is read, the position must now be at the end
+    if ( iPos != iDataLen )
+    {
+        return true; // return error code
+    }
+
+    return false; // no error
+}
@@ -62,6 +62,8 @@
 #define PROTMESSID_RECORDER_STATE           33 // contains the state of the jam recorder (ERecorderState)
 #define PROTMESSID_REQ_SPLIT_MESS_SUPPORT   34 // request support for split messages
 #define PROTMESSID_SPLIT_MESS_SUPPORTED     35 // split messages are supported
+#define PROTMESSID_AUDIO_LOSS_RATE          36 // loss rate of the received audio frames
+#define PROTMESSID_NETW_TRANSP_FEATURES     37 // optional network transport features supported by the server
 
 // message IDs of connection less messages (CLM)
 // DEFINITION -> start at 1000, end at 1999, see IsConnectionLessMessageID
@@ -83,6 +85,12 @@
 #define PROTMESSID_CLM_REGISTER_SERVER_RESP   1016 // status of server registration request
 #define PROTMESSID_CLM_REGISTER_SERVER_EX     1017 // register server with extended information
 #define PROTMESSID_CLM_RED_SERVER_LIST        1018 // reduced server list
+#define PROTMESSID_CLM_SERVER_LIST_PAGE       1019 // one page of the server list
+#define PROTMESSID_CLM_REQ_SERVER_LIST_PAGE   1020 // request one page of the server list
+#define PROTMESSID_CLM_SEND_EMPTY_MES_MULTI   1021 // empty messages shall be send to several targets
+#define PROTMESSID_CLM_SUBSCRIBE_SERVER_LIST  1022 // subscribe to the changes of the server list
+#define PROTMESSID_CLM_SERVER_LIST_DIFF       1023 // changes of the server list
+#define PROTMESSID_CLM_SERVER_FEATURES        1024 // optional features supported by a registered server
 
 // special IDs
 #define PROTMESSID_SPECIAL_SPLIT_MESSAGE 2001 // a container for split messages
@@ -134,6 +142,8 @@ public:
 
     void CreateVersionAndOSMes();
     void CreateRecorderStateMes ( const ERecorderState eRecorderState );
+    void CreateAudioLossRateMes ( const int iLossRatePermille );
+    void CreateNetwTranspFeaturesMes ( const int iFeatures );
 
     void CreateCLPingMes ( const CHostAddress& InetAddr, const int iMs );
     void CreateCLPingWithNumClientsMes ( const CHostAddress& InetAddr, const int iMs, const int iNumClients );
@@ -143,16 +153,32 @@ public:
     void CreateCLUnregisterServerMes ( const CHostAddress& InetAddr );
     void CreateCLServerListMes ( const CHostAddress& InetAddr, const CVector<CServerInfo> vecServerInfo );
     void CreateCLRedServerListMes ( const CHostAddress& InetAddr, const CVector<CServerInfo> vecServerInfo );
+    void GenCLServerListMes ( CVector<uint8_t>& vecMessage, const CVector<CServerInfo>& vecServerInfo );
+    void GenCLRedServerListMes ( CVector<uint8_t>& vecMessage, const CVector<CServerInfo>& vecServerInfo );
+    void GenCLServerListPageMes ( CVector<CVector<uint8_t>>& vecPageMes, const CVector<CServerInfo>& vecServerInfo, const int iVersion );
+    void SendCLPreparedMes ( const CHostAddress& InetAddr, const CVector<uint8_t>& vecMessage );
+    void CreateCLReqServerListPageMes ( const CHostAddress& InetAddr, const int iVersion, const int iPage );
+    void CreateCLSubscribeServerListMes ( const CHostAddress& InetAddr, const int iVersion, const int iToken, const bool bSubscribe );
+    void GenCLServerListDiffMes ( CVector<uint8_t>&            vecMessage,
+                                  const int                    iBaseVersion,
+                                  const int                    iVersion,
+                                  const int                    iToken,
+                                  const bool                   bResync,
+                                  const CVector<CHostAddress>& vecRemovedInetAddr,
+                                  const CVector<CServerInfo>&  vecServerInfo );
     void CreateCLReqServerListMes ( const CHostAddress& InetAddr );
     void CreateCLSendEmptyMesMes ( const CHostAddress& InetAddr, const CHostAddress& TargetInetAddr );
+    void CreateCLSendEmptyMesMultiMes ( const CHostAddress& InetAddr, const CVector<CHostAddress>& vecTargetInetAddr );
     void CreateCLEmptyMes ( const CHostAddress& InetAddr );
     void CreateCLDisconnection ( const CHostAddress& InetAddr );
     void CreateCLVersionAndOSMes ( const CHostAddress& InetAddr );
     void CreateCLReqVersionAndOSMes ( const CHostAddress& InetAddr );
     void CreateCLConnClientsListMes ( const CHostAddress& InetAddr, const CVector<CChannelInfo>& vecChanInfo );
+    void GenCLConnClientsListMes ( CVector<uint8_t>& vecMessage, const CVector<CChannelInfo>& vecChanInfo );
     void CreateCLReqConnClientsListMes ( const CHostAddress& InetAddr );
     void CreateCLChannelLevelListMes ( const CHostAddress& InetAddr, const CVector<uint16_t>& vecLevelList, const int iNumClients );
     void CreateCLRegisterServerResp ( const CHostAddress& InetAddr, const ESvrRegResult eResult );
+    void CreateCLServerFeaturesMes ( const CHostAddress& InetAddr, const int iFeatures );
 
     static bool ParseMessageFrame ( const CVector<uint8_t>& vecbyData,
                                     const int               iNumBytesIn,
@@ -166,6 +192,13 @@ public:
 
     static bool IsConnectionLessMessageID ( const int iID ) { return ( iID >= 1000 ) && ( iID < 2000 ); }
 
+    // generates the answer to a PROTMESSID_CLM_PING_MS or PROTMESSID_CLM_PING_MS_WITHNUMCLIENTS
+    // message, so that the server can answer pings without parsing them in the protocol object
+    static bool GenCLPingAnswerMes ( CVector<uint8_t>&       vecMessage,
+                                     const int               iRecID,
+                                     const CVector<uint8_t>& vecbyMesBodyData,
+                                     const int               iNumClients );
+
     // this function is public because we need it in the test bench
     void CreateAndImmSendAcknMess ( const int& iID, const int& iCnt );
 
@@ -200,7 +233,7 @@ protected:
 
     void EnqueueMessage ( CVector<uint8_t>& vecMessage, const int iCnt, const int iID );
 
-    void GenMessageFrame ( CVector<uint8_t>& vecOut, const int iCnt, const int iID, const CVector<uint8_t>& vecData );
+    static void GenMessageFrame ( CVector<uint8_t>& vecOut, const int iCnt, const int iID, const CVector<uint8_t>& vecData );
 
     void GenSplitMessageContainer ( CVector<uint8_t>&       vecOut,
                                     const int               iID,
@@ -218,7 +251,7 @@ protected:
                                       int&                    iSplitCnt,
                                       int&                    iCurPartSize );
 
-    void PutValOnStream ( CVector<uint8_t>& vecIn, int& iPos, const uint32_t iVal, const int iNumOfBytes );
+    static void PutValOnStream ( CVector<uint8_t>& vecIn, int& iPos, const uint32_t iVal, const int iNumOfBytes );
 
     void PutStringUTF8OnStream ( CVector<uint8_t>& vecIn,
                                  int&              iPos,
@@ -227,6 +260,10 @@ protected:
 
     void PutCountryOnStream ( CVector<uint8_t>& vecIn, int& iPos, QLocale::Country eCountry );
 
+    void PutServerListEntryOnStream ( CVector<uint8_t>& vecIn, int& iPos, const CServerInfo& ServerInfo );
+
+    bool GetServerListEntriesFromStream ( const CVector<uint8_t>& vecIn, int& iPos, CVector<CServerInfo>& vecServerInfo );
+
     static uint32_t GetValFromStream ( const CVector<uint8_t>& vecIn, int& iPos, const int iNumOfBytes );
 
     bool GetStringFromStream ( const CVector<uint8_t>& vecIn,
@@ -261,6 +298,8 @@ protected:
     bool EvaluateLicenceRequiredMes ( const CVector<uint8_t>& vecData );
     bool EvaluateVersionAndOSMes ( const CVector<uint8_t>& vecData );
     bool EvaluateRecorderStateMes ( const CVector<uint8_t>& vecData );
+    bool EvaluateAudioLossRateMes ( const CVector<uint8_t>& vecData );
+    bool EvaluateNetwTranspFeaturesMes ( const CVector<uint8_t>& vecData );
 
     bool EvaluateCLPingMes ( const CHostAddress& InetAddr, const CVector<uint8_t>& vecData );
     bool EvaluateCLPingWithNumClientsMes ( const CHostAddress& InetAddr, const CVector<uint8_t>& vecData );
@@ -271,7 +310,12 @@ protected:
     bool EvaluateCLServerListMes ( const CHostAddress& InetAddr, const CVector<uint8_t>& vecData );
     bool EvaluateCLRedServerListMes ( const CHostAddress& InetAddr, const CVector<uint8_t>& vecData );
     bool EvaluateCLReqServerListMes ( const CHostAddress& InetAddr );
+    bool EvaluateCLServerListPageMes ( const CHostAddress& InetAddr, const CVector<uint8_t>& vecData );
+    bool EvaluateCLReqServerListPageMes ( const CHostAddress& InetAddr, const CVector<uint8_t>& vecData );
+    bool EvaluateCLSubscribeServerListMes ( const CHostAddress& InetAddr, const CVector<uint8_t>& vecData );
+    bool EvaluateCLServerListDiffMes ( const CHostAddress& InetAddr, const CVector<uint8_t>& vecData );
     bool EvaluateCLSendEmptyMesMes ( const CVector<uint8_t>& vecData );
+    bool EvaluateCLSendEmptyMesMultiMes ( const CHostAddress& InetAddr, const CVector<uint8_t>& vecData );
     bool EvaluateCLDisconnectionMes ( const CHostAddress& InetAddr );
     bool EvaluateCLVersionAndOSMes ( const CHostAddress& InetAddr, const CVector<uint8_t>& vecData );
     bool EvaluateCLReqVersionAndOSMes ( const CHostAddress& InetAddr );
@@ -279,6 +323,7 @@ protected:
     bool EvaluateCLReqConnClientsListMes ( const CHostAddress& InetAddr );
     bool EvaluateCLChannelLevelListMes ( const CHostAddress& InetAddr, const CVector<uint8_t>& vecData );
     bool EvaluateCLRegisterServerResp ( const CHostAddress& InetAddr, const CVector<uint8_t>& vecData );
+    bool EvaluateCLServerFeaturesMes ( const CHostAddress& InetAddr, const CVector<uint8_t>& vecData );
 
     int iOldRecID;
     int iOldRecCnt;
@@ -324,6 +369,8 @@ signals:
     void LicenceRequired ( ELicenceType eLicenceType );
     void VersionAndOSReceived ( COSUtil::EOpSystemType eOSType, QString strVersion );
     void RecorderStateReceived ( ERecorderState eRecorderState );
+    void AudioLossRateReceived ( int iLossRatePermille );
+    void NetwTranspFeaturesReceived ( int iFeatures );
 
     void CLPingReceived ( CHostAddress InetAddr, int iMs );
     void CLPingWithNumClientsReceived ( CHostAddress InetAddr, int iMs, int iNumClients );
@@ -337,7 +384,18 @@ signals:
     void CLServerListReceived ( CHostAddress InetAddr, CVector<CServerInfo> vecServerInfo );
     void CLRedServerListReceived ( CHostAddress InetAddr, CVector<CServerInfo> vecServerInfo );
     void CLReqServerList ( CHostAddress InetAddr );
+    void CLServerListPageReceived ( CHostAddress InetAddr, int iVersion, int iPage, int iNumPages, CVector<CServerInfo> vecServerInfo );
+    void CLReqServerListPage ( CHostAddress InetAddr, int iVersion, int iPage );
+    void CLSubscribeServerList ( CHostAddress InetAddr, int iVersion, int iToken, bool bSubscribe );
+    void CLServerListDiffReceived ( CHostAddress          InetAddr,
+                                    int                   iBaseVersion,
+                                    int                   iVersion,
+                                    int                   iToken,
+                                    bool                  bResync,
+                                    CVector<CHostAddress> vecRemovedInetAddr,
+                                    CVector<CServerInfo>  vecServerInfo );
     void CLSendEmptyMes ( CHostAddress TargetInetAddr );
+    void CLSendEmptyMesMulti ( CHostAddress InetAddr, CVector<CHostAddress> vecTargetInetAddr );
     void CLDisconnection ( CHostAddress InetAddr );
     void CLVersionAndOSReceived ( CHostAddress InetAddr, COSUtil::EOpSystemType eOSType, QString strVersion );
     void CLReqVersionAndOS ( CHostAddress InetAddr );
@@ -345,4 +403,5 @@ signals:
     void CLReqConnClientsList ( CHostAddress InetAddr );
     void CLChannelLevelListReceived ( CHostAddress InetAddr, CVector<uint16_t> vecLevelList );
     void CLRegisterServerResp ( CHostAddress InetAddr, ESvrRegResult eStatus );
+    void CLServerFeaturesReceived ( CHostAddress InetAddr, int iFeatures );
 };
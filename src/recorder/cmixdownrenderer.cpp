@@ -0,0 +1,329 @@
+/******************************************************************************\
+ * Copyright (c) 2020-2025
+ *
+ * Author(s):
+ *  pljones
+ *
+ ******************************************************************************
+ *
+ * This program is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation; either version 2 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ *
+\******************************************************************************/
+
+#include <QElapsedTimer>
+#include <QThread>
+#include <QtEndian>
+
+#include "../threadpool.h"
+
+#include "jamrecorder.h"
+#include "cmixdownrenderer.h"
+
+using namespace recorder;
+
+/* ********************************************************************************************************
+ * CMixdownRenderer
+ * ********************************************************************************************************/
+
+/**
+ * @brief CMixdownRenderer::CMixdownRenderer Prepare an offline mixdown of a recorded session
+ * @param strSessionDirName the session directory containing the client WAV files
+ * @param iServerFrameSizeSamples the server frame size used when recording the session
+ * @param bRenderStems if true, a stereo stem is written for each track as well
+ *
+ * The track layout is read using CJamSession::TracksFromSessionDir, so each item is placed by its startFrame
+ * exactly as in the generated Reaper project.  Output is written to the "mixdown" subdirectory of the session.
+ */
+CMixdownRenderer::CMixdownRenderer ( const QString& strSessionDirName, const int iServerFrameSizeSamples, const bool bRenderStems ) :
+    sessionDir ( QDir ( strSessionDirName ) ),
+    outputDir ( QDir ( sessionDir.absoluteFilePath ( "mixdown" ) ) ),
+    iServerFrameSizeSamples ( iServerFrameSizeSamples ),
+    bRenderStems ( bRenderStems ),
+    tracks ( CJamSession::TracksFromSessionDir ( strSessionDirName, iServerFrameSizeSamples ) ),
+    iNumFrames ( 0 )
+{
+    // the session length is given by the end of the last item
+    foreach ( auto trackName, tracks.keys() )
+    {
+        foreach ( auto item, tracks.value ( trackName ) )
+        {
+            iNumFrames = std::max ( iNumFrames, item.startFrame + item.frameCount );
+        }
+    }
+
+    strMixdownFileName = outputDir.absoluteFilePath ( sessionDir.dirName().append ( ".wav" ) );
+}
+
+/**
+ * @brief CMixdownRenderer::SetTrackGainPan Override the default unity gain / centre pan of a track
+ */
+void CMixdownRenderer::SetTrackGainPan ( const QString& strTrackName, const float fGain, const float fPan )
+{
+    mapGainPan.insert ( strTrackName, SGainPan ( fGain, fPan ) );
+}
+
+/**
+ * @brief CMixdownRenderer::Render Mix the session down to stereo
+ * @return the mixdown file name
+ *
+ * The session timeline is cut into slices of MIXDOWN_CHUNK_SECONDS which are rendered in parallel on a
+ * CThreadPool.  Each slice only reads the part of each client file it needs and writes its result directly
+ * to its position in the (pre-sized) output file(s), so memory use does not depend on the session length.
+ */
+QString CMixdownRenderer::Render()
+{
+    if ( iNumFrames == 0 )
+    {
+        throw CGenErr ( sessionDir.absolutePath() + " contains no recorded tracks." );
+    }
+
+    if ( !outputDir.exists() && !QDir().mkpath ( outputDir.absolutePath() ) )
+    {
+        throw CGenErr ( outputDir.absolutePath() + " does not exist and could not be created" );
+    }
+
+    CreateOutputFile ( strMixdownFileName );
+
+    if ( bRenderStems )
+    {
+        foreach ( auto trackName, tracks.keys() )
+        {
+            CreateOutputFile ( StemFileName ( trackName ) );
+        }
+    }
+
+    QElapsedTimer ElapsedTimer;
+    ElapsedTimer.start();
+
+    {
+        const int    iNumThreads  = std::max ( 1, QThread::idealThreadCount() );
+        const qint64 iChunkFrames = std::max ( 1, MIXDOWN_CHUNK_SECONDS * SYSTEM_SAMPLE_RATE_HZ / iServerFrameSizeSamples );
+
+        CThreadPool                ThreadPool ( static_cast<size_t> ( iNumThreads ) );
+        CVector<std::future<void>> Futures;
+
+        Futures.reserve ( static_cast<size_t> ( iNumFrames / iChunkFrames + 1 ) );
+
+        for ( qint64 iStartFrame = 0; iStartFrame < iNumFrames; iStartFrame += iChunkFrames )
+        {
+            const qint64 iStopFrame = std::min ( iStartFrame + iChunkFrames, iNumFrames );
+
+            Futures.push_back ( ThreadPool.enqueue ( CMixdownRenderer::RenderChunkBlock, this, iStartFrame, iStopFrame ) );
+        }
+
+        // make sure all slices are written before the files are used
+        for ( auto& future : Futures )
+        {
+            future.wait();
+        }
+    }
+
+    if ( !strError.isEmpty() )
+    {
+        throw CGenErr ( strError );
+    }
+
+    const double dSessionSeconds = static_cast<double> ( iNumFrames * iServerFrameSizeSamples ) / SYSTEM_SAMPLE_RATE_HZ;
+    const double dElapsedSeconds = std::max ( ElapsedTimer.elapsed(), static_cast<qint64> ( 1 ) ) / 1000.0;
+
+    qInfo() << qUtf8Printable ( QString ( "Mixdown of %1 s rendered in %2 s (%3 x real-time)" )
+                                    .arg ( dSessionSeconds, 0, 'f', 1 )
+                                    .arg ( dElapsedSeconds, 0, 'f', 1 )
+                                    .arg ( dSessionSeconds / dElapsedSeconds, 0, 'f', 0 ) );
+
+    return strMixdownFileName;
+}
+
+/**
+ * @brief CMixdownRenderer::SessionDirToMixdown Replica of CJamRecorder::SessionDirToReaper but rendering audio
+ * @param strSessionDirName Where the session wave files are
+ * @param iServerFrameSizeSamples What the server frame size was for the session
+ * @param bRenderStems Also write a stem per track
+ */
+void CMixdownRenderer::SessionDirToMixdown ( const QString& strSessionDirName, const int iServerFrameSizeSamples, const bool bRenderStems )
+{
+    const QFileInfo fiSessionDir ( QDir::cleanPath ( strSessionDirName ) );
+    if ( !fiSessionDir.exists() || !fiSessionDir.isDir() )
+    {
+        throw CGenErr ( fiSessionDir.absoluteFilePath() + " does not exist or is not a directory.  Aborting." );
+    }
+
+    CMixdownRenderer Renderer ( fiSessionDir.absoluteFilePath(), iServerFrameSizeSamples, bRenderStems );
+
+    qDebug() << "Session mixdown:" << Renderer.Render();
+}
+
+// This is a static method used as a callback, and does not inherit a "this" pointer,
+// so it is necessary for the renderer instance to be passed as a parameter.
+void CMixdownRenderer::RenderChunkBlock ( CMixdownRenderer* pRenderer, const qint64 iStartFrame, const qint64 iStopFrame )
+{
+    pRenderer->RenderChunk ( iStartFrame, iStopFrame );
+}
+
+/**
+ * @brief CMixdownRenderer::CreateOutputFile Create a stereo WAV file big enough for the whole session
+ * @param strFileName the file to create (any existing file is overwritten)
+ *
+ * The file is pre-sized so that the worker threads can write their slices at any position.
+ */
+void CMixdownRenderer::CreateOutputFile ( const QString& strFileName )
+{
+    QFile outf ( strFileName );
+    if ( !outf.open ( QFile::OpenMode ( QIODevice::OpenModeFlag::ReadWrite | QIODevice::OpenModeFlag::Truncate ) ) )
+    {
+        throw CGenErr ( "Could not write to WAV file " + strFileName );
+    }
+
+    CWaveStream out ( &outf, 2 );
+
+    const qint64 iFileSize = CWaveStream::headerSize + iNumFrames * iServerFrameSizeSamples * 2 /* stereo */ * sizeof ( int16_t );
+
+    if ( !outf.resize ( iFileSize ) || !outf.seek ( iFileSize ) )
+    {
+        throw CGenErr ( "Could not allocate WAV file " + strFileName );
+    }
+
+    // update the RIFF and data chunk sizes for the final length
+    out.finalise();
+}
+
+/**
+ * @brief CMixdownRenderer::RenderChunk Mix all track items overlapping the given frame range
+ * @param iStartFrame first server frame of the slice
+ * @param iStopFrame first server frame after the slice
+ *
+ * The gain and pan math is the same as the stereo target path of CServer::MixEncodeTransmitData.
+ */
+void CMixdownRenderer::RenderChunk ( const qint64 iStartFrame, const qint64 iStopFrame )
+{
+    const int iNumSamples = static_cast<int> ( ( iStopFrame - iStartFrame ) * iServerFrameSizeSamples );
+
+    CVector<float> vecfMix ( 2 /* stereo */ * iNumSamples, 0.0f );
+    CVector<float> vecfStem;
+
+    foreach ( auto trackName, tracks.keys() )
+    {
+        const SGainPan gainPan = mapGainPan.value ( trackName, SGainPan() );
+
+        // calculate combined gain/pan for each stereo channel where we define
+        // the panning that center equals full gain for both channels
+        const float fGainL = MathUtils::GetLeftPan ( gainPan.fPan, false ) * gainPan.fGain;
+        const float fGainR = MathUtils::GetRightPan ( gainPan.fPan, false ) * gainPan.fGain;
+
+        if ( bRenderStems )
+        {
+            vecfStem.Init ( 2 /* stereo */ * iNumSamples, 0.0f );
+        }
+
+        CVector<float>& vecfTarget = bRenderStems ? vecfStem : vecfMix;
+
+        foreach ( auto item, tracks.value ( trackName ) )
+        {
+            // only the part of the item which overlaps this slice is of interest
+            const qint64 iItemStartFrame = std::max ( iStartFrame, item.startFrame );
+            const qint64 iItemStopFrame  = std::min ( iStopFrame, item.startFrame + item.frameCount );
+
+            if ( iItemStartFrame >= iItemStopFrame )
+            {
+                continue;
+            }
+
+            const int iNumAudChan = item.numAudioChannels;
+            QFile     inf ( item.fileName );
+
+            if ( !inf.open ( QIODevice::ReadOnly ) ||
+                 !inf.seek ( CWaveStream::headerSize +
+                             ( iItemStartFrame - item.startFrame ) * iServerFrameSizeSamples * iNumAudChan * sizeof ( int16_t ) ) )
+            {
+                QMutexLocker locker ( &MutexError );
+                strError = "Could not read WAV file " + item.fileName;
+                return;
+            }
+
+            const QByteArray data = inf.read ( ( iItemStopFrame - iItemStartFrame ) * iServerFrameSizeSamples * iNumAudChan * sizeof ( int16_t ) );
+            const uchar*     pData = reinterpret_cast<const uchar*> ( data.constData() );
+
+            // a client file may be truncated if the server did not shut down cleanly
+            const int iNumItemSamples = data.size() / static_cast<int> ( iNumAudChan * sizeof ( int16_t ) );
+            const int iOffset         = static_cast<int> ( ( iItemStartFrame - iStartFrame ) * iServerFrameSizeSamples );
+
+            if ( iNumAudChan == 1 )
+            {
+                // mono: copy same mono data in both out stereo audio channels
+                for ( int i = 0, k = 2 * iOffset; i < iNumItemSamples; i++, k += 2 )
+                {
+                    const float fSample = qFromLittleEndian<qint16> ( pData + i * sizeof ( int16_t ) );
+
+                    vecfTarget[k] += fSample * fGainL;
+                    vecfTarget[k + 1] += fSample * fGainR;
+                }
+            }
+            else
+            {
+                // stereo
+                for ( int i = 0, k = 2 * iOffset; i < 2 * iNumItemSamples; i += 2, k += 2 )
+                {
+                    vecfTarget[k] += qFromLittleEndian<qint16> ( pData + i * sizeof ( int16_t ) ) * fGainL;
+                    vecfTarget[k + 1] += qFromLittleEndian<qint16> ( pData + ( i + 1 ) * sizeof ( int16_t ) ) * fGainR;
+                }
+            }
+        }
+
+        if ( bRenderStems )
+        {
+            WriteChunk ( StemFileName ( trackName ), iStartFrame, vecfStem );
+
+            for ( int i = 0; i < vecfMix.Size(); i++ )
+            {
+                vecfMix[i] += vecfStem[i];
+            }
+        }
+    }
+
+    WriteChunk ( strMixdownFileName, iStartFrame, vecfMix );
+}
+
+/**
+ * @brief CMixdownRenderer::WriteChunk Write a rendered slice to its position in an output file
+ * @param strFileName the output file (created by CreateOutputFile)
+ * @param iStartFrame first server frame of the slice
+ * @param vecfMix interleaved stereo samples
+ */
+void CMixdownRenderer::WriteChunk ( const QString& strFileName, const qint64 iStartFrame, const CVector<float>& vecfMix )
+{
+    QByteArray data ( vecfMix.Size() * static_cast<int> ( sizeof ( int16_t ) ), 0 );
+    uchar*     pData = reinterpret_cast<uchar*> ( data.data() );
+
+    // convert from float to short with clipping
+    for ( int i = 0; i < vecfMix.Size(); i++ )
+    {
+        qToLittleEndian<qint16> ( Float2Short ( vecfMix[i] ), pData + i * sizeof ( int16_t ) );
+    }
+
+    // each worker uses its own file handle so slices can be written concurrently
+    QFile        outf ( strFileName );
+    const qint64 iPos = CWaveStream::headerSize + iStartFrame * iServerFrameSizeSamples * 2 /* stereo */ * sizeof ( int16_t );
+
+    if ( !outf.open ( QIODevice::ReadWrite ) || !outf.seek ( iPos ) || ( outf.write ( data ) != data.size() ) )
+    {
+        QMutexLocker locker ( &MutexError );
+        strError = "Could not write to WAV file " + strFileName;
+    }
+}
+
+QString CMixdownRenderer::StemFileName ( const QString& strTrackName ) const
+{
+    return outputDir.absoluteFilePath ( sessionDir.dirName() + "-" + strTrackName + ".wav" );
+}
@@ -0,0 +1,99 @@
+/******************************************************************************\
+ * Copyright (c) 2020-2025
+ *
+ * Author(s):
+ *  pljones
+ *
+ ******************************************************************************
+ *
+ * This program is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation; either version 2 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ *
+\******************************************************************************/
+
+#pragma once
+
+#include <QDir>
+#include <QFile>
+#include <QMap>
+#include <QMutex>
+
+#include "../util.h"
+
+#include "cwavestream.h"
+
+namespace recorder
+{
+
+// length of the timeline slice rendered by one worker (in seconds)
+#define MIXDOWN_CHUNK_SECONDS 5
+
+class CMixdownRenderer
+{
+public:
+    CMixdownRenderer ( const QString& strSessionDirName, const int iServerFrameSizeSamples, const bool bRenderStems = false );
+
+    /**
+     * @brief SetTrackGainPan Override the default unity gain / centre pan of a track
+     * @param strTrackName the track name as returned by CJamSession::TracksFromSessionDir
+     * @param fGain linear gain
+     * @param fPan pan, 0 is left, 0.5 is centre, 1 is right
+     */
+    void SetTrackGainPan ( const QString& strTrackName, const float fGain, const float fPan );
+
+    /**
+     * @brief Render Mix all tracks of the session down to a stereo WAV file (and optionally one stereo stem per track)
+     * @return the mixdown file name
+     */
+    QString Render();
+
+    /**
+     * @brief SessionDirToMixdown Render the session in the given directory using all available cores
+     * @param strSessionDirName Where the session wave files are
+     * @param serverFrameSizeSamples What the server frame size was for the session
+     * @param bRenderStems Also write a stem per track
+     */
+    static void SessionDirToMixdown ( const QString& strSessionDirName, const int iServerFrameSizeSamples, const bool bRenderStems );
+
+private:
+    struct SGainPan
+    {
+        SGainPan ( const float fNGain = 1.0f, const float fNPan = 0.5f ) : fGain ( fNGain ), fPan ( fNPan ) {}
+
+        float fGain;
+        float fPan;
+    };
+
+    static void RenderChunkBlock ( CMixdownRenderer* pRenderer, const qint64 iStartFrame, const qint64 iStopFrame );
+
+    void    CreateOutputFile ( const QString& strFileName );
+    void    RenderChunk ( const qint64 iStartFrame, const qint64 iStopFrame );
+    void    WriteChunk ( const QString& strFileName, const qint64 iStartFrame, const CVector<float>& vecfMix );
+    QString StemFileName ( const QString& strTrackName ) const;
+
+    const QDir sessionDir;
+    const QDir outputDir;
+    const int  iServerFrameSizeSamples;
+    const bool bRenderStems;
+
+    const QMap<QString, QList<STrackItem>> tracks;
+    QMap<QString, SGainPan>                mapGainPan;
+    qint64                                 iNumFrames;
+    QString                                strMixdownFileName;
+
+    QMutex  MutexError;
+    QString strError;
+};
+
+} // namespace recorder
@@ -0,0 +1,275 @@
+/******************************************************************************\
+ * Copyright (c) 2020-2025
+ *
+ * Author(s):
+ *  pljones
+ *
+ ******************************************************************************
+ *
+ * This program is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation; either version 2 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ *
+\******************************************************************************/
+
+#include "csessionindex.h"
+
+#include <QFileInfo>
+#include <QHash>
+#include <QtEndian>
+
+#include "../util.h"
+
+using namespace recorder;
+
+const char* CSessionIndex::fileName = "session.jidx";
+
+/* ********************************************************************************************************
+ * CSessionIndex
+ *
+ * Header (16 bytes):
+ *   0  uint32 magic "JMSI"
+ *   4  uint32 version
+ *   8  uint32 server frame size in samples
+ *  12  uint32 record header size in bytes
+ *
+ * Record (record header size plus the length of the names):
+ *   0  uint8  event (EV_CONNECT / EV_DISCONNECT)
+ *   1  uint8  number of audio channels
+ *   2  uint16 channel id
+ *   4  int64  start frame
+ *  12  int64  frame count (0 for EV_CONNECT)
+ *  20  uint16 length n of the track name in bytes
+ *  22  uint16 length m of the file name in bytes
+ *  24  track name, UTF-8 (n bytes)
+ *  .. file name relative to the session directory, UTF-8 (m bytes)
+ * ********************************************************************************************************/
+
+/**
+ * @brief CSessionIndex::CSessionIndex
+ * @param sessionDir the session directory the index is written to
+ * @param iServerFrameSizeSamples the server frame size used for the session
+ *
+ * The index file is only created on the first append, so that the session directory can be created after construction.
+ */
+CSessionIndex::CSessionIndex ( const QDir& sessionDir, const int iServerFrameSizeSamples ) :
+    sessionDir ( sessionDir ),
+    iServerFrameSizeSamples ( iServerFrameSizeSamples ),
+    indexFile ( sessionDir.absoluteFilePath ( fileName ) )
+{}
+
+CSessionIndex::~CSessionIndex()
+{
+    if ( indexFile.isOpen() )
+    {
+        indexFile.close();
+    }
+}
+
+/**
+ * @brief CSessionIndex::AppendConnect Record the start of a new client file
+ * @param iChID the channel id of the client
+ * @param trackName the client name at connection time
+ * @param trackItem the new file
+ */
+void CSessionIndex::AppendConnect ( const int iChID, const QString& trackName, const STrackItem& trackItem )
+{
+    Append ( EV_CONNECT, iChID, trackName, trackItem );
+}
+
+/**
+ * @brief CSessionIndex::AppendDisconnect Record the end of a client file
+ * @param iChID the channel id of the client
+ * @param trackName the (latest) client name
+ * @param trackItem the completed file
+ */
+void CSessionIndex::AppendDisconnect ( const int iChID, const QString& trackName, const STrackItem& trackItem )
+{
+    Append ( EV_DISCONNECT, iChID, trackName, trackItem );
+}
+
+void CSessionIndex::Append ( const EEvent eEvent, const int iChID, const QString& trackName, const STrackItem& trackItem )
+{
+    if ( !indexFile.isOpen() )
+    {
+        if ( !indexFile.open ( QFile::WriteOnly | QFile::Append ) )
+        {
+            throw CGenErr ( "Could not write to session index " + indexFile.fileName() );
+        }
+
+        if ( indexFile.size() == 0 )
+        {
+            uchar header[headerSize];
+            qToLittleEndian<quint32> ( magic, header );
+            qToLittleEndian<quint32> ( version, header + 4 );
+            qToLittleEndian<quint32> ( static_cast<quint32> ( iServerFrameSizeSamples ), header + 8 );
+            qToLittleEndian<quint32> ( static_cast<quint32> ( recordHeaderSize ), header + 12 );
+            indexFile.write ( reinterpret_cast<const char*> ( header ), headerSize );
+        }
+    }
+
+    // the names are stored completely (the client name is limited by the server and
+    // the file name by the file system, so both fit the 16 bit lengths)
+    const QByteArray baTrackName = trackName.toUtf8();
+    const QByteArray baFileName  = QFileInfo ( trackItem.fileName ).fileName().toUtf8();
+
+    uchar recordHeader[recordHeaderSize];
+
+    recordHeader[0] = eEvent;
+    recordHeader[1] = static_cast<uchar> ( trackItem.numAudioChannels );
+    qToLittleEndian<quint16> ( static_cast<quint16> ( iChID ), recordHeader + 2 );
+    qToLittleEndian<qint64> ( trackItem.startFrame, recordHeader + 4 );
+    qToLittleEndian<qint64> ( trackItem.frameCount, recordHeader + 12 );
+    qToLittleEndian<quint16> ( static_cast<quint16> ( baTrackName.size() ), recordHeader + 20 );
+    qToLittleEndian<quint16> ( static_cast<quint16> ( baFileName.size() ), recordHeader + 22 );
+
+    // the record is written at once, so a reader sees it completely or only a part at the end of the file
+    indexFile.write ( QByteArray ( reinterpret_cast<const char*> ( recordHeader ), recordHeaderSize ) + baTrackName + baFileName );
+
+    // make the record visible to readers of the index straight away
+    indexFile.flush();
+}
+
+/**
+ * @brief CSessionIndex::ReadItems Rebuild the track items of a session from its index
+ * @param sessionDirName the session directory
+ * @param items receives one item per client file, in order of connection
+ * @param iServerFrameSizeSamples receives the server frame size used for the session
+ * @return false if there is no (valid) index, in which case items is left empty
+ *
+ * Items without a disconnect record are still being recorded (or the server stopped unexpectedly);
+ * their length is taken from the size of their file.
+ */
+bool CSessionIndex::ReadItems ( const QString& sessionDirName, QList<SSessionIndexItem>& items, int& iServerFrameSizeSamples )
+{
+    items.clear();
+
+    const QDir sessionDir ( sessionDirName );
+    QFile      file ( sessionDir.absoluteFilePath ( fileName ) );
+
+    if ( !file.open ( QFile::ReadOnly ) || file.size() < headerSize )
+    {
+        return false;
+    }
+
+    // the size is read once, so records appended concurrently are not seen (or only partly, see below)
+    const qint64 iFileSize = file.size();
+    uchar*       pData     = file.map ( 0, iFileSize );
+
+    if ( pData == nullptr )
+    {
+        return false;
+    }
+
+    const int iRecordHeaderSize = static_cast<int> ( qFromLittleEndian<quint32> ( pData + 12 ) );
+
+    if ( qFromLittleEndian<quint32> ( pData ) != magic || qFromLittleEndian<quint32> ( pData + 4 ) != version ||
+         iRecordHeaderSize != recordHeaderSize )
+    {
+        file.unmap ( pData );
+        return false;
+    }
+
+    iServerFrameSizeSamples = static_cast<int> ( qFromLittleEndian<quint32> ( pData + 8 ) );
+
+    QHash<int, int> mapOpenItems; // channel id to index into items
+    qint64          iPos = headerSize;
+
+    // a record which is only partly written (at the end of the file) is ignored
+    while ( iPos + recordHeaderSize <= iFileSize )
+    {
+        const uchar* pRecord         = pData + iPos;
+        const int    iTrackNameBytes = qFromLittleEndian<quint16> ( pRecord + 20 );
+        const int    iFileNameBytes  = qFromLittleEndian<quint16> ( pRecord + 22 );
+
+        if ( iPos + recordHeaderSize + iTrackNameBytes + iFileNameBytes > iFileSize )
+        {
+            break;
+        }
+
+        iPos += recordHeaderSize + iTrackNameBytes + iFileNameBytes;
+
+        const char*   pNames           = reinterpret_cast<const char*> ( pRecord + recordHeaderSize );
+        const int     iChID            = qFromLittleEndian<quint16> ( pRecord + 2 );
+        const int     numAudioChannels = pRecord[1];
+        const qint64  startFrame       = qFromLittleEndian<qint64> ( pRecord + 4 );
+        const qint64  frameCount       = qFromLittleEndian<qint64> ( pRecord + 12 );
+        const QString trackName        = QString::fromUtf8 ( pNames, iTrackNameBytes );
+        const QString entryName        = QString::fromUtf8 ( pNames + iTrackNameBytes, iFileNameBytes );
+
+        const STrackItem trackItem ( numAudioChannels, startFrame, frameCount, sessionDir.absoluteFilePath ( entryName ) );
+
+        switch ( pRecord[0] )
+        {
+        case EV_CONNECT:
+            mapOpenItems.insert ( iChID, items.size() );
+            items.append ( SSessionIndexItem ( trackName, trackItem, true ) );
+            break;
+
+        case EV_DISCONNECT:
+            if ( mapOpenItems.contains ( iChID ) )
+            {
+                // the disconnect carries the latest name and the final length
+                items[mapOpenItems.take ( iChID )] = SSessionIndexItem ( trackName, trackItem, false );
+            }
+            else
+            {
+                items.append ( SSessionIndexItem ( trackName, trackItem, false ) );
+            }
+            break;
+
+        default:
+            break;
+        }
+    }
+
+    file.unmap ( pData );
+
+    foreach ( const int iItem, mapOpenItems )
+    {
+        STrackItem&     trackItem = items[iItem].trackItem;
+        const QFileInfo fiEntry ( trackItem.fileName );
+
+        if ( fiEntry.exists() && trackItem.numAudioChannels > 0 && iServerFrameSizeSamples > 0 )
+        {
+            trackItem.frameCount = ( fiEntry.size() - CWaveStream::headerSize ) / static_cast<qint64> ( sizeof ( int16_t ) ) /
+                                   trackItem.numAudioChannels / iServerFrameSizeSamples;
+        }
+    }
+
+    return true;
+}
+
+/**
+ * @brief CSessionIndex::ReadTracks Rebuild the track item map of a session from its index
+ * @param sessionDirName the session directory
+ * @param tracks receives a map of (latest) client name to connection items
+ * @return false if there is no (valid) index
+ */
+bool CSessionIndex::ReadTracks ( const QString& sessionDirName, QMap<QString, QList<STrackItem>>& tracks )
+{
+    QList<SSessionIndexItem> items;
+    int                      iServerFrameSizeSamples;
+
+    if ( !ReadItems ( sessionDirName, items, iServerFrameSizeSamples ) )
+    {
+        return false;
+    }
+
+    foreach ( const SSessionIndexItem& item, items )
+    {
+        tracks[item.trackName].append ( item.trackItem );
+    }
+
+    return true;
+}
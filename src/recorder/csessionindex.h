@@ -0,0 +1,90 @@
+/******************************************************************************\
+ * Copyright (c) 2020-2025
+ *
+ * Author(s):
+ *  pljones
+ *
+ ******************************************************************************
+ *
+ * This program is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation; either version 2 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ *
+\******************************************************************************/
+
+#pragma once
+
+#include <QDir>
+#include <QFile>
+#include <QList>
+#include <QMap>
+
+#include "cwavestream.h"
+
+namespace recorder
+{
+
+struct SSessionIndexItem
+{
+    SSessionIndexItem ( const QString& trackName, const STrackItem& trackItem, const bool open ) :
+        trackName ( trackName ),
+        trackItem ( trackItem ),
+        open ( open )
+    {}
+
+    QString    trackName;
+    STrackItem trackItem;
+    bool       open; // no disconnect recorded (yet)
+};
+
+/**
+ * @brief The CSessionIndex class Compact binary index of the client files of a recording session
+ *
+ * The index consists of a small header followed by little endian records with length prefixed names, one appended
+ * on every client connect and one on every disconnect.  Readers memory-map the file and rebuild the track items in a single pass,
+ * so neither the session directory has to be scanned nor the file names parsed.
+ */
+class CSessionIndex
+{
+public:
+    CSessionIndex ( const QDir& sessionDir, const int iServerFrameSizeSamples );
+    ~CSessionIndex();
+
+    void AppendConnect ( const int iChID, const QString& trackName, const STrackItem& trackItem );
+    void AppendDisconnect ( const int iChID, const QString& trackName, const STrackItem& trackItem );
+
+    static bool ReadItems ( const QString& sessionDirName, QList<SSessionIndexItem>& items, int& iServerFrameSizeSamples );
+    static bool ReadTracks ( const QString& sessionDirName, QMap<QString, QList<STrackItem>>& tracks );
+
+    static const char* fileName;
+
+private:
+    enum EEvent : uint8_t
+    {
+        EV_CONNECT    = 1,
+        EV_DISCONNECT = 2
+    };
+
+    void Append ( const EEvent eEvent, const int iChID, const QString& trackName, const STrackItem& trackItem );
+
+    static const uint32_t magic            = 0x49534d4a; // "JMSI"
+    static const uint32_t version          = 2;
+    static const int      headerSize       = 16; // magic, version, frame size, record header size
+    static const int      recordHeaderSize = 24; // fixed part of a record, followed by the names
+
+    const QDir sessionDir;
+    const int  iServerFrameSizeSamples;
+    QFile      indexFile;
+};
+
+} // namespace recorder
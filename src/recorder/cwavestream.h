@@ -98,6 +98,9 @@ public:
 
     void finalise();
 
+    // size of the RIFF, fmt and data sub-chunk headers preceding the samples
+    static const int64_t headerSize = 44;
+
 private:
     void waveStreamHeaders();
 
@@ -31,6 +31,7 @@ CJamController::CJamController ( CServer* pNServer ) :
     bRecorderInitialised ( false ),
     bEnableRecording ( false ),
     strRecordingDir ( "" ),
+    strRecordingSessionDir ( "" ),
     pthJamRecorder ( nullptr ),
     pJamRecorder ( nullptr )
 {}
@@ -143,12 +144,18 @@ void CJamController::SetRecordingDir ( QString newRecordingDir, int iServerFrame
         qRegisterMetaType<CVector<int16_t>> ( "CVector<int16_t>" );
         QObject::connect ( this, &CJamController::AudioFrame, pJamRecorder, &CJamRecorder::OnFrame );
 
+        QObject::connect ( this, &CJamController::ListenerAudioFrame, pJamRecorder, &CJamRecorder::OnListenerFrame );
+
+        QObject::connect ( this, &CJamController::ListenerMixRecordingChanged, pJamRecorder, &CJamRecorder::OnListenerMixRecordingChanged );
+
         // from the recorder to the server
         QObject::connect ( pJamRecorder, &CJamRecorder::RecordingSessionStarted, this, &CJamController::RecordingSessionStarted );
 
         // from the recorder to the controller
         QObject::connect ( pJamRecorder, &CJamRecorder::RecordingFailed, this, &CJamController::OnRecordingFailed );
 
+        QObject::connect ( pJamRecorder, &CJamRecorder::RecordingSessionStarted, this, &CJamController::OnRecordingSessionStarted );
+
         pthJamRecorder->start ( QThread::NormalPriority );
     }
     else
@@ -173,6 +180,12 @@ void CJamController::OnRecordingFailed ( QString error )
     pServer->SetEnableRecording ( false );
 }
 
+void CJamController::OnRecordingSessionStarted ( QString sessionDir )
+{
+    // remembered so that the session index can be read without asking the recorder thread
+    strRecordingSessionDir = sessionDir;
+}
+
 ERecorderState CJamController::GetRecorderState()
 {
     // return recorder state
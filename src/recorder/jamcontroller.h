@@ -43,17 +43,20 @@ public:
     void           RequestNewRecording();
     void           SetEnableRecording ( bool bNewEnableRecording, bool isRunning );
     QString        GetRecordingDir() { return strRecordingDir; }
+    QString        GetRecordingSessionDir() { return strRecordingSessionDir; }
     void           SetRecordingDir ( QString newRecordingDir, int iServerFrameSizeSamples, bool bDisableRecording );
     ERecorderState GetRecorderState();
 
 private:
     void OnRecordingFailed ( QString error );
+    void OnRecordingSessionStarted ( QString sessionDir );
 
     CServer* pServer;
 
     bool     bRecorderInitialised;
     bool     bEnableRecording;
     QString  strRecordingDir;
+    QString  strRecordingSessionDir;
     QThread* pthJamRecorder;
 
     CJamRecorder* pJamRecorder;
@@ -71,6 +74,12 @@ signals:
                       const CHostAddress     RecHostAddr,
                       const int              iNumAudChan,
                       const CVector<int16_t> vecsData );
+    void ListenerAudioFrame ( const int              iChID,
+                              const QString          stChName,
+                              const CHostAddress     RecHostAddr,
+                              const int              iNumAudChan,
+                              const CVector<int16_t> vecsData );
+    void ListenerMixRecordingChanged ( int iChID, bool bEnable );
 };
 
 } // namespace recorder
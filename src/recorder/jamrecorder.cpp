@@ -150,11 +150,14 @@ QString CJamClient::TranslateChars ( const QString& input ) const
  *
  * Each session is stored into its own subdirectory of the recording base directory.
  */
-CJamSession::CJamSession ( QDir recordBaseDir ) :
+CJamSession::CJamSession ( QDir recordBaseDir, const int iServerFrameSizeSamples ) :
     sessionDir ( QDir ( recordBaseDir.absoluteFilePath ( "Jam-" + QDateTime().currentDateTimeUtc().toString ( "yyyyMMdd-HHmmsszzz" ) ) ) ),
+    listenerDir ( QDir ( sessionDir.absoluteFilePath ( "listeners" ) ) ),
+    sessionIndex ( sessionDir, iServerFrameSizeSamples ),
     currentFrame ( 0 ),
     chIdDisconnected ( -1 ),
     vecptrJamClients ( MAX_NUM_CHANNELS ),
+    vecptrListenerJamClients ( MAX_NUM_CHANNELS ),
     jamClientConnections()
 {
     QFileInfo fi ( sessionDir.absolutePath() );
@@ -175,6 +178,7 @@ CJamSession::CJamSession ( QDir recordBaseDir ) :
 
     // Explicitly set all the pointers to "empty"
     vecptrJamClients.fill ( nullptr );
+    vecptrListenerJamClients.fill ( nullptr );
 }
 
 /**
@@ -199,6 +203,14 @@ CJamSession::~CJamSession()
  */
 void CJamSession::DisconnectClient ( int iChID )
 {
+    // the mix this client heard ends with the client
+    DisconnectListener ( iChID );
+
+    if ( vecptrJamClients[iChID] == nullptr )
+    {
+        return;
+    }
+
     vecptrJamClients[iChID]->Disconnect();
 
     jamClientConnections.append ( new CJamClientConnection ( vecptrJamClients[iChID]->NumAudioChannels(),
@@ -207,11 +219,52 @@ void CJamSession::DisconnectClient ( int iChID )
                                                              vecptrJamClients[iChID]->ClientName(),
                                                              vecptrJamClients[iChID]->FileName() ) );
 
+    sessionIndex.AppendDisconnect ( iChID,
+                                    vecptrJamClients[iChID]->ClientName(),
+                                    STrackItem ( vecptrJamClients[iChID]->NumAudioChannels(),
+                                                 vecptrJamClients[iChID]->StartFrame(),
+                                                 vecptrJamClients[iChID]->FrameCount(),
+                                                 vecptrJamClients[iChID]->FileName() ) );
+
     delete vecptrJamClients[iChID];
     vecptrJamClients[iChID] = nullptr;
     chIdDisconnected        = iChID;
 }
 
+/**
+ * @brief CJamSession::NewClient Start a new file for a client and record it in the session index
+ * @param iChID the channel id of the client
+ * @param name the client name
+ * @param address the client IP and port number
+ * @param numAudioChannels the client number of audio channels
+ */
+void CJamSession::NewClient ( const int iChID, const QString name, const CHostAddress address, const int numAudioChannels )
+{
+    vecptrJamClients[iChID] = new CJamClient ( currentFrame, numAudioChannels, name, address, sessionDir );
+
+    sessionIndex.AppendConnect ( iChID,
+                                 vecptrJamClients[iChID]->ClientName(),
+                                 STrackItem ( numAudioChannels, currentFrame, 0, vecptrJamClients[iChID]->FileName() ) );
+}
+
+/**
+ * @brief CJamSession::DisconnectListener Close the listener mix file of a client, if any
+ * @param iChID the channel id of the client
+ *
+ * Listener mixes are not part of the session tracks (they are a copy of what is already recorded),
+ * so they are not added to jamClientConnections.
+ */
+void CJamSession::DisconnectListener ( int iChID )
+{
+    if ( vecptrListenerJamClients[iChID] != nullptr )
+    {
+        vecptrListenerJamClients[iChID]->Disconnect();
+
+        delete vecptrListenerJamClients[iChID];
+        vecptrListenerJamClients[iChID] = nullptr;
+    }
+}
+
 /**
  * @brief CJamSession::Frame Process a frame emitted for a client by the server
  * @param iChID the client channel id
@@ -242,7 +295,7 @@ void CJamSession::Frame ( const int              iChID,
     if ( vecptrJamClients[iChID] == nullptr )
     {
         // then we have not seen this client this session
-        vecptrJamClients[iChID] = new CJamClient ( currentFrame, numAudioChannels, name, address, sessionDir );
+        NewClient ( iChID, name, address, numAudioChannels );
     }
     else if ( numAudioChannels != vecptrJamClients[iChID]->NumAudioChannels() ||
               address.InetAddr != vecptrJamClients[iChID]->ClientAddress().InetAddr ||
@@ -255,7 +308,7 @@ void CJamSession::Frame ( const int              iChID,
         }
         else
         {
-            vecptrJamClients[iChID] = new CJamClient ( currentFrame, numAudioChannels, name, address, sessionDir );
+            NewClient ( iChID, name, address, numAudioChannels );
         }
     }
 
@@ -274,6 +327,50 @@ void CJamSession::Frame ( const int              iChID,
     }
 }
 
+/**
+ * @brief CJamSession::ListenerFrame Process a frame of the mix the server sent to a client
+ * @param iChID the client channel id
+ * @param name the client name
+ * @param address the client IP and port number
+ * @param numAudioChannels the number of audio channels of the mix
+ * @param data the frame data
+ *
+ * Listener mixes are written to the "listeners" subdirectory of the session, so that neither the
+ * Reaper project nor a mixdown pick them up.  The session frame counter is only advanced by Frame().
+ */
+void CJamSession::ListenerFrame ( const int              iChID,
+                                  const QString          name,
+                                  const CHostAddress     address,
+                                  const int              numAudioChannels,
+                                  const CVector<int16_t> data,
+                                  int                    iServerFrameSizeSamples )
+{
+    if ( vecptrListenerJamClients[iChID] != nullptr &&
+         ( numAudioChannels != vecptrListenerJamClients[iChID]->NumAudioChannels() ||
+           address.InetAddr != vecptrListenerJamClients[iChID]->ClientAddress().InetAddr ||
+           address.iPort != vecptrListenerJamClients[iChID]->ClientAddress().iPort ) )
+    {
+        DisconnectListener ( iChID );
+    }
+
+    if ( vecptrListenerJamClients[iChID] == nullptr )
+    {
+        if ( numAudioChannels == 0 )
+        {
+            return;
+        }
+
+        if ( !listenerDir.exists() && !QDir().mkpath ( listenerDir.absolutePath() ) )
+        {
+            throw CGenErr ( listenerDir.absolutePath() + " does not exist and could not be created" );
+        }
+
+        vecptrListenerJamClients[iChID] = new CJamClient ( currentFrame, numAudioChannels, name, address, listenerDir );
+    }
+
+    vecptrListenerJamClients[iChID]->Frame ( name, data, iServerFrameSizeSamples );
+}
+
 /**
  * @brief CJamSession::End Clean up any "hanging" clients when the server thinks they all left
  */
@@ -286,6 +383,8 @@ void CJamSession::End()
             DisconnectClient ( iChID );
             vecptrJamClients[iChID] = nullptr;
         }
+
+        DisconnectListener ( iChID );
     }
 }
 
@@ -316,19 +415,31 @@ QMap<QString, QList<STrackItem>> CJamSession::Tracks()
 }
 
 /**
- * @brief CJamSession::TracksFromSessionDir Replica of CJamSession::Tracks but using the directory contents to construct the track item map
+ * @brief CJamSession::TracksFromSessionDir Replica of CJamSession::Tracks but using the session index or directory contents to construct the track item map
  * @param sessionDirName the directory name to scan
  * @return a map of (latest) client name to connection items
+ *
+ * The directory is only scanned for sessions recorded without a session index.
  */
 QMap<QString, QList<STrackItem>> CJamSession::TracksFromSessionDir ( const QString& sessionDirName, int iServerFrameSizeSamples )
 {
     QMap<QString, QList<STrackItem>> tracks;
 
+    if ( CSessionIndex::ReadTracks ( sessionDirName, tracks ) )
+    {
+        return tracks;
+    }
+
     const QDir sessionDir ( sessionDirName );
-    foreach ( auto entry, sessionDir.entryList ( { "*.pcm" } ) )
+    foreach ( auto entry, sessionDir.entryList ( { "*.wav" }, QDir::Files ) )
     {
+        auto split = entry.split ( "." )[0].split ( "-" );
+        if ( split.size() < 4 )
+        {
+            // not a file written by CJamClient
+            continue;
+        }
 
-        auto    split       = entry.split ( "." )[0].split ( "-" );
         QString name        = split[0];
         QString hostPort    = split[1];
         QString frame       = split[2];
@@ -342,7 +453,8 @@ QMap<QString, QList<STrackItem>> CJamSession::TracksFromSessionDir ( const QStri
         }
 
         QFileInfo fiEntry ( sessionDir.absoluteFilePath ( entry ) );
-        qint64    length = fiEntry.size() / numChannels.toInt() / iServerFrameSizeSamples;
+        qint64    length = ( fiEntry.size() - CWaveStream::headerSize ) / static_cast<qint64> ( sizeof ( int16_t ) ) / numChannels.toInt() /
+                        iServerFrameSizeSamples;
 
         STrackItem track ( numChannels.toInt(), frame.toLongLong(), length, sessionDir.absoluteFilePath ( entry ) );
 
@@ -404,7 +516,7 @@ void CJamRecorder::Start()
         QMutexLocker mutexLocker ( &ChIdMutex );
         try
         {
-            currentSession = new CJamSession ( recordBaseDir );
+            currentSession = new CJamSession ( recordBaseDir, iServerFrameSizeSamples );
             isRecording    = true;
         }
         catch ( const CGenErr& err )
@@ -503,11 +615,12 @@ void CJamRecorder::AudacityLofFromCurrentSession()
         QFile outf ( audacityLofFileName );
         if ( outf.open ( QFile::WriteOnly ) )
         {
-            QTextStream sOut ( &outf );
+            QTextStream                            sOut ( &outf );
+            const QMap<QString, QList<STrackItem>> tracks = currentSession->Tracks();
 
-            foreach ( auto trackName, currentSession->Tracks().keys() )
+            foreach ( auto trackName, tracks.keys() )
             {
-                foreach ( auto item, currentSession->Tracks()[trackName] )
+                foreach ( auto item, tracks[trackName] )
                 {
                     QFileInfo fi ( item.fileName );
                     sOut << "file " << '"' << fi.fileName() << '"';
@@ -568,6 +681,10 @@ void CJamRecorder::SessionDirToReaper ( QString& strSessionDirName, int serverFr
 void CJamRecorder::OnDisconnected ( int iChID )
 {
     QMutexLocker mutexLocker ( &ChIdMutex );
+
+    // the server sends the listener mix of a new client of this channel only after it was enabled
+    vecbListenerEnabled[iChID] = true;
+
     if ( !isRecording )
     {
         qWarning() << "CJamRecorder::OnDisconnected: channel" << iChID << "disconnected but not recording";
@@ -615,3 +732,47 @@ void CJamRecorder::OnFrame ( const int              iChID,
         currentSession->Frame ( iChID, name, address, numAudioChannels, data, iServerFrameSizeSamples );
     }
 }
+
+/**
+ * @brief CJamRecorder::OnListenerFrame Handle a frame of the mix sent to a client selected for listener mix recording
+ * @param iChID the client channel id
+ * @param name the client name
+ * @param address the client IP and port number
+ * @param numAudioChannels the number of audio channels of the mix
+ * @param data the frame data
+ *
+ * Unlike OnFrame, this does not start a recording: the session is driven by the client inputs.
+ */
+void CJamRecorder::OnListenerFrame ( const int              iChID,
+                                     const QString          name,
+                                     const CHostAddress     address,
+                                     const int              numAudioChannels,
+                                     const CVector<int16_t> data )
+{
+    QMutexLocker mutexLocker ( &ChIdMutex );
+    if ( !vecbListenerEnabled[iChID] || !isRecording || currentSession == nullptr )
+    {
+        // late frames of a disabled listener mix are dropped
+        return;
+    }
+
+    currentSession->ListenerFrame ( iChID, name, address, numAudioChannels, data, iServerFrameSizeSamples );
+}
+
+/**
+ * @brief CJamRecorder::OnListenerMixRecordingChanged Handle the start or end of listener mix recording for a client
+ * @param iChID the client channel id
+ * @param bEnable whether the listener mix of the client is recorded
+ */
+void CJamRecorder::OnListenerMixRecordingChanged ( int iChID, bool bEnable )
+{
+    QMutexLocker mutexLocker ( &ChIdMutex );
+    vecbListenerEnabled[iChID] = bEnable;
+
+    if ( bEnable || currentSession == nullptr )
+    {
+        return;
+    }
+
+    currentSession->DisconnectListener ( iChID );
+}
@@ -33,6 +33,7 @@
 #include "../channel.h"
 
 #include "creaperproject.h"
+#include "csessionindex.h"
 #include "cwavestream.h"
 
 namespace recorder
@@ -113,7 +114,7 @@ class CJamSession : public QObject
     Q_OBJECT
 
 public:
-    CJamSession ( QDir recordBaseDir );
+    CJamSession ( QDir recordBaseDir, const int iServerFrameSizeSamples );
 
     virtual ~CJamSession();
 
@@ -124,6 +125,13 @@ public:
                  const CVector<int16_t> data,
                  int                    iServerFrameSizeSamples );
 
+    void ListenerFrame ( const int              iChID,
+                         const QString          name,
+                         const CHostAddress     address,
+                         const int              numAudioChannels,
+                         const CVector<int16_t> data,
+                         int                    iServerFrameSizeSamples );
+
     void End();
 
     QVector<CJamClient*> Clients() { return vecptrJamClients; }
@@ -136,16 +144,24 @@ public:
 
     void DisconnectClient ( int iChID );
 
+    void DisconnectListener ( int iChID );
+
     static QMap<QString, QList<STrackItem>> TracksFromSessionDir ( const QString& name, int iServerFrameSizeSamples );
 
 private:
     CJamSession();
 
+    void NewClient ( const int iChID, const QString name, const CHostAddress address, const int numAudioChannels );
+
     const QDir sessionDir;
+    const QDir listenerDir;
+
+    CSessionIndex sessionIndex;
 
     qint64                       currentFrame;
     int                          chIdDisconnected;
     QVector<CJamClient*>         vecptrJamClients;
+    QVector<CJamClient*>         vecptrListenerJamClients;
     QList<CJamClientConnection*> jamClientConnections;
 };
 
@@ -158,7 +174,8 @@ public:
         recordBaseDir ( strRecordingBaseDir ),
         iServerFrameSizeSamples ( iServerFrameSizeSamples ),
         isRecording ( false ),
-        currentSession ( nullptr )
+        currentSession ( nullptr ),
+        vecbListenerEnabled ( MAX_NUM_CHANNELS, true )
     {}
 
     /**
@@ -185,6 +202,10 @@ private:
     CJamSession* currentSession;
     QMutex       ChIdMutex;
 
+    // the server only sends listener frames of enabled clients, but frames which
+    // were mixed before a disable may arrive after it (they must not reopen the file)
+    QVector<bool> vecbListenerEnabled;
+
 signals:
     void RecordingSessionStarted ( QString sessionDir );
     void RecordingFailed ( QString error );
@@ -215,6 +236,22 @@ public slots:
      * @brief Handle a frame of data to process
      */
     void OnFrame ( const int iChID, const QString name, const CHostAddress address, const int numAudioChannels, const CVector<int16_t> data );
+
+    /**
+     * @brief Handle a frame of the mix sent to a client selected for listener mix recording
+     */
+    void OnListenerFrame ( const int              iChID,
+                           const QString          name,
+                           const CHostAddress     address,
+                           const int              numAudioChannels,
+                           const CVector<int16_t> data );
+
+    /**
+     * @brief Handle the start or end of listener mix recording for a client
+     * @param iChID channel number of client
+     * @param bEnable whether the listener mix of the client is recorded
+     */
+    void OnListenerMixRecordingChanged ( int iChID, bool bEnable );
 };
 
 } // namespace recorder
@@ -0,0 +1,232 @@
+/******************************************************************************\
+ * Copyright (c) 2004-2025
+ *
+ * Author(s):
+ *  Volker Fischer
+ *
+ ******************************************************************************
+ *
+ * This program is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation; either version 2 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ *
+\******************************************************************************/
+
+#include "roommanager.h"
+
+/* Implementation *************************************************************/
+CRoomManager::CRoomManager ( CServer*       pNMainServer,
+                             const quint16  iNMainPortNumber,
+                             const QString& strNServerBindIP,
+                             const quint16  iNQosNumber,
+                             const bool     bNUseDoubleSystemFrameSize,
+                             const bool     bNUseMultithreading,
+                             const bool     bNDelayPan,
+                             const bool     bNEnableIPv6 ) :
+    pMainServer ( pNMainServer ),
+    strServerBindIP ( strNServerBindIP ),
+    iQosNumber ( iNQosNumber ),
+    bUseDoubleSystemFrameSize ( bNUseDoubleSystemFrameSize ),
+    bDelayPan ( bNDelayPan ),
+    bEnableIPv6 ( bNEnableIPv6 ),
+    iNextRoomID ( MAIN_ROOM_ID + 1 ),
+    HighPrecisionTimer ( bNUseDoubleSystemFrameSize ),
+    iMaxNumThreads ( 1 )
+{
+    // setup the shared CThreadPool if multithreading is active and possible
+    // (the rooms themselves are run without their own thread pool)
+    if ( bNUseMultithreading )
+    {
+        const int iAvailableCores = QThread::idealThreadCount();
+
+        if ( iAvailableCores == 1 )
+        {
+            qDebug() << "found only one core, disabling multithreading for all rooms";
+        }
+        else
+        {
+            iMaxNumThreads = iAvailableCores;
+            qDebug() << "multithreading enabled for all rooms, setting thread count to" << iMaxNumThreads;
+
+            pThreadPool = std::unique_ptr<CThreadPool> ( new CThreadPool{ static_cast<size_t> ( iMaxNumThreads ) } );
+        }
+    }
+
+    // the server given on the command line is the first room
+    AddRoom ( MAIN_ROOM_ID, pMainServer, iNMainPortNumber );
+
+    QObject::connect ( &HighPrecisionTimer, &CHighPrecisionTimer::timeout, this, &CRoomManager::OnTimer );
+}
+
+CRoomManager::~CRoomManager()
+{
+    HighPrecisionTimer.Stop();
+
+    // the main server is owned by the caller, all other rooms by us
+    foreach ( const int iRoomID, mapRooms.keys() )
+    {
+        if ( iRoomID != MAIN_ROOM_ID )
+        {
+            delete mapRooms[iRoomID];
+        }
+    }
+}
+
+void CRoomManager::AddRoom ( const int iRoomID, CServer* pRoom, const quint16 iPortNumber )
+{
+    pRoom->SetRoomMode();
+
+    mapRooms.insert ( iRoomID, pRoom );
+    mapRoomPorts.insert ( iRoomID, iPortNumber );
+
+    // allocate worst case memory here to avoid allocating memory in the time-critical frame pass
+    vecRoomNumClients.Init ( mapRooms.size() );
+    Futures.reserve ( mapRooms.size() * iMaxNumThreads );
+
+    QObject::connect ( pRoom, &CServer::Started, this, &CRoomManager::OnRoomStarted );
+
+    QObject::connect ( pRoom, &CServer::Stopped, this, &CRoomManager::OnRoomStopped );
+}
+
+int CRoomManager::CreateRoom ( const quint16 iPortNumber, const int iMaxNumChan, const QString& strName, const QString& strWelcomeMessage )
+{
+    // the protocol has no notion of rooms, the clients select a room by its port
+    if ( mapRoomPorts.values().contains ( iPortNumber ) )
+    {
+        throw CGenErr ( QString ( "Port %1 is already used by another room." ).arg ( iPortNumber ) );
+    }
+
+    // a room shares the frame size and network settings of the main server, it has no
+    // logging, status file, directory registration or recording (the CServer
+    // constructor throws if the socket cannot be bound)
+    CServer* pRoom = new CServer ( iMaxNumChan,
+                                   "", // logging file name
+                                   strServerBindIP,
+                                   iPortNumber,
+                                   iQosNumber,
+                                   "", // HTML status file name
+                                   "", // directory address
+                                   "", // server list file name
+                                   "", // server info
+                                   "", // server list filter
+                                   "", // server public IP
+                                   strWelcomeMessage,
+                                   "",   // recording directory
+                                   true, // disconnect all clients when the room is destroyed
+                                   bUseDoubleSystemFrameSize,
+                                   false, // the shared thread pool is used
+                                   true,  // disable recording
+                                   bDelayPan,
+                                   bEnableIPv6,
+                                   LT_NO_LICENCE );
+
+    pRoom->SetServerName ( strName );
+
+    const int iRoomID = iNextRoomID++;
+    AddRoom ( iRoomID, pRoom, iPortNumber );
+
+    qInfo() << qUtf8Printable ( QString ( "- room %1 created on port %2" ).arg ( iRoomID ).arg ( iPortNumber ) );
+
+    return iRoomID;
+}
+
+bool CRoomManager::DestroyRoom ( const int iRoomID )
+{
+    // the main server lives as long as the process
+    if ( iRoomID == MAIN_ROOM_ID || !mapRooms.contains ( iRoomID ) )
+    {
+        return false;
+    }
+
+    CServer* pRoom = mapRooms.take ( iRoomID );
+    mapRoomPorts.remove ( iRoomID );
+    vecRoomNumClients.Init ( mapRooms.size() );
+
+    // tell the clients and stop the room (note that the frame pass runs in this
+    // thread, so the room cannot be in the middle of a frame here)
+    pRoom->OnAboutToQuit();
+    delete pRoom;
+
+    qInfo() << qUtf8Printable ( QString ( "- room %1 destroyed" ).arg ( iRoomID ) );
+
+    return true;
+}
+
+void CRoomManager::OnRoomStarted()
+{
+    // the first active room starts the shared frame clock
+    if ( !HighPrecisionTimer.isActive() )
+    {
+        HighPrecisionTimer.Start();
+    }
+}
+
+void CRoomManager::OnRoomStopped()
+{
+    // stop the shared frame clock when the last room becomes idle
+    foreach ( CServer* pRoom, mapRooms )
+    {
+        if ( pRoom->IsRunning() )
+        {
+            return;
+        }
+    }
+
+    HighPrecisionTimer.Stop();
+}
+
+void CRoomManager::OnTimer()
+{
+    // without multithreading all blocks are processed directly in this thread
+    CThreadPool*                        pPool = pThreadPool.get();
+    QMap<int, CServer*>::const_iterator it;
+    int                                 iRoom;
+
+    // Decode the audio of all running rooms in one pass over the shared thread
+    // pool (idle rooms are marked with -1 and skipped in all phases).
+    for ( it = mapRooms.constBegin(), iRoom = 0; it != mapRooms.constEnd(); ++it, iRoom++ )
+    {
+        if ( it.value()->IsRunning() )
+        {
+            vecRoomNumClients[iRoom] = it.value()->BeginFrame();
+            it.value()->ScheduleDecodeBlocks ( vecRoomNumClients[iRoom], pPool, iMaxNumThreads, Futures );
+        }
+        else
+        {
+            vecRoomNumClients[iRoom] = -1;
+        }
+    }
+
+    CServer::WaitForBlocks ( Futures );
+
+    // mix, encode and transmit for all running rooms in one pass
+    for ( it = mapRooms.constBegin(), iRoom = 0; it != mapRooms.constEnd(); ++it, iRoom++ )
+    {
+        if ( vecRoomNumClients[iRoom] >= 0 )
+        {
+            it.value()->EndDecode ( vecRoomNumClients[iRoom] );
+            it.value()->ScheduleMixEncodeBlocks ( vecRoomNumClients[iRoom], pPool, iMaxNumThreads, Futures );
+        }
+    }
+
+    CServer::WaitForBlocks ( Futures );
+
+    for ( it = mapRooms.constBegin(), iRoom = 0; it != mapRooms.constEnd(); ++it, iRoom++ )
+    {
+        if ( vecRoomNumClients[iRoom] >= 0 )
+        {
+            // note that this stops idle rooms (and possibly the shared timer)
+            it.value()->EndFrame ( vecRoomNumClients[iRoom] );
+        }
+    }
+}
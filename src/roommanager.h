@@ -0,0 +1,94 @@
+/******************************************************************************\
+ * Copyright (c) 2004-2025
+ *
+ * Author(s):
+ *  Volker Fischer
+ *
+ ******************************************************************************
+ *
+ * This program is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation; either version 2 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ *
+\******************************************************************************/
+
+#pragma once
+
+#include <QObject>
+#include <QMap>
+#include "global.h"
+#include "util.h"
+#include "server.h"
+#include "threadpool.h"
+
+/* Definitions ****************************************************************/
+// room ID of the server given on the command line
+#define MAIN_ROOM_ID 0
+
+/* Classes ********************************************************************/
+// The room manager hosts several independent servers ("rooms") in one process.
+// Each room keeps its own socket (the protocol has no notion of rooms, so a room
+// is identified by its port), but all rooms are clocked by a single timer and
+// their decoding and mixing is scheduled on one shared thread pool in one pass
+// per frame.
+class CRoomManager : public QObject
+{
+    Q_OBJECT
+
+public:
+    CRoomManager ( CServer*       pNMainServer,
+                   const quint16  iNMainPortNumber,
+                   const QString& strNServerBindIP,
+                   const quint16  iNQosNumber,
+                   const bool     bNUseDoubleSystemFrameSize,
+                   const bool     bNUseMultithreading,
+                   const bool     bNDelayPan,
+                   const bool     bNEnableIPv6 );
+
+    virtual ~CRoomManager();
+
+    int  CreateRoom ( const quint16 iPortNumber, const int iMaxNumChan, const QString& strName, const QString& strWelcomeMessage );
+    bool DestroyRoom ( const int iRoomID );
+
+    QList<int> GetRoomIDs() const { return mapRooms.keys(); }
+    CServer*   GetRoom ( const int iRoomID ) const { return mapRooms.value ( iRoomID, nullptr ); }
+    quint16    GetRoomPort ( const int iRoomID ) const { return mapRoomPorts.value ( iRoomID, 0 ); }
+
+protected:
+    void AddRoom ( const int iRoomID, CServer* pRoom, const quint16 iPortNumber );
+
+    CServer*      pMainServer;
+    const QString strServerBindIP;
+    const quint16 iQosNumber;
+    const bool    bUseDoubleSystemFrameSize;
+    const bool    bDelayPan;
+    const bool    bEnableIPv6;
+
+    QMap<int, CServer*> mapRooms;
+    QMap<int, quint16>  mapRoomPorts;
+    int                 iNextRoomID;
+
+    // number of connected clients of each room in the current frame pass
+    CVector<int> vecRoomNumClients;
+
+    // shared frame clock and worker threads
+    CHighPrecisionTimer          HighPrecisionTimer;
+    int                          iMaxNumThreads;
+    std::unique_ptr<CThreadPool> pThreadPool;
+    CVector<std::future<void>>   Futures;
+
+public slots:
+    void OnTimer();
+    void OnRoomStarted();
+    void OnRoomStopped();
+};
@@ -47,14 +47,22 @@ CServer::CServer ( const int          iNewMaxNumChan,
                    const ELicenceType eNLicenceType ) :
     bUseDoubleSystemFrameSize ( bNUseDoubleSystemFrameSize ),
     bUseMultithreading ( bNUseMultithreading ),
+    iMaxNumThreads ( 1 ),
+    vecChannels ( new CChannel[iNewMaxNumChan] ),
     iMaxNumChannels ( iNewMaxNumChan ),
     iCurNumChannels ( 0 ),
+    iNumRightInputChannels ( 0 ),
+    bFreeChanCodecsRequested ( false ),
+    iChanListVersion ( 0 ),
+    iConnClientsListMesVersion ( -1 ),
     Socket ( this, iPortNumber, iQosNumber, strServerBindIP, bNEnableIPv6 ),
     Logging(),
     iFrameCount ( 0 ),
     bWriteStatusHTMLFile ( false ),
     strServerHTMLFileListName ( strHTMLStatusFileName ),
     HighPrecisionTimer ( bNUseDoubleSystemFrameSize ),
+    bRoomMode ( false ),
+    bRoomIsRunning ( false ),
     ServerListManager ( iPortNumber,
                         strDirectoryAddress,
                         strServerListFileName,
@@ -66,6 +74,7 @@ CServer::CServer ( const int          iNewMaxNumChan,
                         &ConnLessProtocol ),
     JamController ( this ),
     bDisableRecording ( bDisableRecording ),
+    vecbListenerMixRecording ( new std::atomic<bool>[iNewMaxNumChan] ),
     bAutoRunMinimized ( false ),
     bDelayPan ( bNDelayPan ),
     bEnableIPv6 ( bNEnableIPv6 ),
@@ -73,55 +82,27 @@ CServer::CServer ( const int          iNewMaxNumChan,
     bDisconnectAllClientsOnQuit ( bNDisconnectAllClientsOnQuit ),
     pSignalHandler ( CSignalHandler::getSingletonP() )
 {
-    int iOpusError;
     int i;
 
-    // create OPUS encoder/decoder for each channel (must be done before
-    // enabling the channels), create a mono and stereo encoder/decoder
-    // for each channel
-    for ( i = 0; i < iMaxNumChannels; i++ )
-    {
-        // init OPUS -----------------------------------------------------------
-        OpusMode[i] = opus_custom_mode_create ( SYSTEM_SAMPLE_RATE_HZ, DOUBLE_SYSTEM_FRAME_SIZE_SAMPLES, &iOpusError );
-
-        Opus64Mode[i] = opus_custom_mode_create ( SYSTEM_SAMPLE_RATE_HZ, SYSTEM_FRAME_SIZE_SAMPLES, &iOpusError );
-
-        // init audio encoders and decoders
-        OpusEncoderMono[i]     = opus_custom_encoder_create ( OpusMode[i], 1, &iOpusError );   // mono encoder legacy
-        OpusDecoderMono[i]     = opus_custom_decoder_create ( OpusMode[i], 1, &iOpusError );   // mono decoder legacy
-        OpusEncoderStereo[i]   = opus_custom_encoder_create ( OpusMode[i], 2, &iOpusError );   // stereo encoder legacy
-        OpusDecoderStereo[i]   = opus_custom_decoder_create ( OpusMode[i], 2, &iOpusError );   // stereo decoder legacy
-        Opus64EncoderMono[i]   = opus_custom_encoder_create ( Opus64Mode[i], 1, &iOpusError ); // mono encoder OPUS64
-        Opus64DecoderMono[i]   = opus_custom_decoder_create ( Opus64Mode[i], 1, &iOpusError ); // mono decoder OPUS64
-        Opus64EncoderStereo[i] = opus_custom_encoder_create ( Opus64Mode[i], 2, &iOpusError ); // stereo encoder OPUS64
-        Opus64DecoderStereo[i] = opus_custom_decoder_create ( Opus64Mode[i], 2, &iOpusError ); // stereo decoder OPUS64
-
-        // we require a constant bit rate
-        opus_custom_encoder_ctl ( OpusEncoderMono[i], OPUS_SET_VBR ( 0 ) );
-        opus_custom_encoder_ctl ( OpusEncoderStereo[i], OPUS_SET_VBR ( 0 ) );
-        opus_custom_encoder_ctl ( Opus64EncoderMono[i], OPUS_SET_VBR ( 0 ) );
-        opus_custom_encoder_ctl ( Opus64EncoderStereo[i], OPUS_SET_VBR ( 0 ) );
-
-        // for 64 samples frame size we have to adjust the PLC behavior to avoid loud artifacts
-        opus_custom_encoder_ctl ( Opus64EncoderMono[i], OPUS_SET_PACKET_LOSS_PERC ( 35 ) );
-        opus_custom_encoder_ctl ( Opus64EncoderStereo[i], OPUS_SET_PACKET_LOSS_PERC ( 35 ) );
-
-        // we want as low delay as possible
-        opus_custom_encoder_ctl ( OpusEncoderMono[i], OPUS_SET_APPLICATION ( OPUS_APPLICATION_RESTRICTED_LOWDELAY ) );
-        opus_custom_encoder_ctl ( OpusEncoderStereo[i], OPUS_SET_APPLICATION ( OPUS_APPLICATION_RESTRICTED_LOWDELAY ) );
-        opus_custom_encoder_ctl ( Opus64EncoderMono[i], OPUS_SET_APPLICATION ( OPUS_APPLICATION_RESTRICTED_LOWDELAY ) );
-        opus_custom_encoder_ctl ( Opus64EncoderStereo[i], OPUS_SET_APPLICATION ( OPUS_APPLICATION_RESTRICTED_LOWDELAY ) );
-
-        // set encoder low complexity for legacy 128 samples frame size
-        opus_custom_encoder_ctl ( OpusEncoderMono[i], OPUS_SET_COMPLEXITY ( 1 ) );
-        opus_custom_encoder_ctl ( OpusEncoderStereo[i], OPUS_SET_COMPLEXITY ( 1 ) );
-
-        // init double-to-normal frame size conversion buffers -----------------
-        // use worst case memory initialization to avoid allocating memory in
-        // the time-critical thread
-        DoubleFrameSizeConvBufIn[i].Init ( 2 /* stereo */ * DOUBLE_SYSTEM_FRAME_SIZE_SAMPLES /* worst case buffer size */ );
-        DoubleFrameSizeConvBufOut[i].Init ( 2 /* stereo */ * DOUBLE_SYSTEM_FRAME_SIZE_SAMPLES /* worst case buffer size */ );
-    }
+    // the audio codecs and conversion buffers of a channel are created shortly
+    // before the channel is used (see PrepareFreeChannels()), so that a server with
+    // a large capacity starts quickly and only uses the memory of the channels in use
+    OpusMode.Init ( iMaxNumChannels, nullptr );
+    Opus64Mode.Init ( iMaxNumChannels, nullptr );
+    OpusEncoderMono.Init ( iMaxNumChannels, nullptr );
+    OpusDecoderMono.Init ( iMaxNumChannels, nullptr );
+    OpusEncoderStereo.Init ( iMaxNumChannels, nullptr );
+    OpusDecoderStereo.Init ( iMaxNumChannels, nullptr );
+    Opus64EncoderMono.Init ( iMaxNumChannels, nullptr );
+    Opus64DecoderMono.Init ( iMaxNumChannels, nullptr );
+    Opus64EncoderStereo.Init ( iMaxNumChannels, nullptr );
+    Opus64DecoderStereo.Init ( iMaxNumChannels, nullptr );
+    Opus64RedEncoderMono.Init ( iMaxNumChannels, nullptr );
+    Opus64RedEncoderStereo.Init ( iMaxNumChannels, nullptr );
+    OpusRedEncoderMono.Init ( iMaxNumChannels, nullptr );
+    OpusRedEncoderStereo.Init ( iMaxNumChannels, nullptr );
+    DoubleFrameSizeConvBufIn.Init ( iMaxNumChannels );
+    DoubleFrameSizeConvBufOut.Init ( iMaxNumChannels );
 
     // define colors for chat window identifiers
     vstrChatColors.Init ( 6 );
@@ -149,24 +130,37 @@ CServer::CServer ( const int          iNewMaxNumChan,
 
     // allocate worst case memory for the temporary vectors
     vecChanIDsCurConChan.Init ( iMaxNumChannels );
-    vecvecfGains.Init ( iMaxNumChannels );
-    vecvecfPannings.Init ( iMaxNumChannels );
+    vecRightInputChanID.Init ( iMaxNumChannels, INVALID_CHANNEL_ID );
+    vecRightInputOwnerID.Init ( iMaxNumChannels, INVALID_CHANNEL_ID );
     vecvecsData.Init ( iMaxNumChannels );
     vecvecsData2.Init ( iMaxNumChannels );
     vecvecsSendData.Init ( iMaxNumChannels );
     vecvecfIntermediateProcBuf.Init ( iMaxNumChannels );
     vecvecbyCodedData.Init ( iMaxNumChannels );
+    vecvecbyRedCodedData.Init ( iMaxNumChannels );
     vecNumAudioChannels.Init ( iMaxNumChannels );
+    vecNumMixAudioChannels.Init ( iMaxNumChannels );
+    vecRightInputChanCnt.Init ( iMaxNumChannels, INVALID_INDEX );
     vecNumFrameSizeConvBlocks.Init ( iMaxNumChannels );
     vecUseDoubleSysFraSizeConvBuf.Init ( iMaxNumChannels );
     vecAudioComprType.Init ( iMaxNumChannels );
 
-    for ( i = 0; i < iMaxNumChannels; i++ )
+    // the gains and pans of a mix are only needed while it is mixed, so there is
+    // one row for each block of channels which is mixed concurrently (see
+    // ScheduleBlocks()) instead of one row for each channel
+    const int iNumMixRows = std::max ( 1, QThread::idealThreadCount() );
+
+    vecvecfGains.Init ( iNumMixRows );
+    vecvecfPannings.Init ( iNumMixRows );
+
+    for ( i = 0; i < iNumMixRows; i++ )
     {
-        // init vectors storing information of all channels
         vecvecfGains[i].Init ( iMaxNumChannels );
         vecvecfPannings[i].Init ( iMaxNumChannels );
+    }
 
+    for ( i = 0; i < iMaxNumChannels; i++ )
+    {
         // we always use stereo audio buffers (which is the worst case)
         vecvecsData[i].Init ( 2 /* stereo */ * DOUBLE_SYSTEM_FRAME_SIZE_SAMPLES /* worst case buffer size */ );
         vecvecsData2[i].Init ( 2 /* stereo */ * DOUBLE_SYSTEM_FRAME_SIZE_SAMPLES /* worst case buffer size */ );
@@ -180,6 +174,7 @@ CServer::CServer ( const int          iNewMaxNumChan,
 
         // allocate worst case memory for the coded data
         vecvecbyCodedData[i].Init ( MAX_SIZE_BYTES_NETW_BUF );
+        vecvecbyRedCodedData[i].Init ( MAX_SIZE_BYTES_NETW_BUF );
     }
 
     // allocate worst case memory for the channel levels
@@ -221,10 +216,15 @@ CServer::CServer ( const int          iNewMaxNumChan,
 
     // enable all channels (for the server all channel must be enabled the
     // entire life time of the software)
+    vecChannelOrder.Init ( iMaxNumChannels );
+
     for ( i = 0; i < iMaxNumChannels; i++ )
     {
         vecChannels[i].SetEnable ( true );
         vecChannelOrder[i] = i;
+
+        // listener mix recording is opt-in per connected client
+        vecbListenerMixRecording[i] = false;
     }
 
     int iAvailableCores = QThread::idealThreadCount();
@@ -252,34 +252,58 @@ CServer::CServer ( const int          iNewMaxNumChan,
     // connect timer timeout signal
     QObject::connect ( &HighPrecisionTimer, &CHighPrecisionTimer::timeout, this, &CServer::OnTimer );
 
-    QObject::connect ( &ConnLessProtocol, &CProtocol::CLMessReadyForSending, this, &CServer::OnSendCLProtMessage );
+    // the connection less messages are parsed in the connection less worker thread (see
+    // OnProtocolCLMessageReceived()) and the slots are called directly in that thread,
+    // the slots which access the channels set the server mutex themselves (note that
+    // pings are answered by the socket directly)
+    QObject::connect ( &ConnLessProtocol, &CProtocol::CLMessReadyForSending, this, &CServer::OnSendCLProtMessage, Qt::DirectConnection );
+
+    QObject::connect ( &ConnLessProtocol, &CProtocol::CLRegisterServerReceived, this, &CServer::OnCLRegisterServerReceived, Qt::DirectConnection );
+
+    QObject::connect ( &ConnLessProtocol,
+                       &CProtocol::CLRegisterServerExReceived,
+                       this,
+                       &CServer::OnCLRegisterServerExReceived,
+                       Qt::DirectConnection );
 
-    QObject::connect ( &ConnLessProtocol, &CProtocol::CLPingReceived, this, &CServer::OnCLPingReceived );
+    QObject::connect ( &ConnLessProtocol,
+                       &CProtocol::CLUnregisterServerReceived,
+                       this,
+                       &CServer::OnCLUnregisterServerReceived,
+                       Qt::DirectConnection );
 
-    QObject::connect ( &ConnLessProtocol, &CProtocol::CLPingWithNumClientsReceived, this, &CServer::OnCLPingWithNumClientsReceived );
+    QObject::connect ( &ConnLessProtocol, &CProtocol::CLReqServerList, this, &CServer::OnCLReqServerList, Qt::DirectConnection );
 
-    QObject::connect ( &ConnLessProtocol, &CProtocol::CLRegisterServerReceived, this, &CServer::OnCLRegisterServerReceived );
+    QObject::connect ( &ConnLessProtocol, &CProtocol::CLReqServerListPage, this, &CServer::OnCLReqServerListPage, Qt::DirectConnection );
 
-    QObject::connect ( &ConnLessProtocol, &CProtocol::CLRegisterServerExReceived, this, &CServer::OnCLRegisterServerExReceived );
+    QObject::connect ( &ConnLessProtocol, &CProtocol::CLSubscribeServerList, this, &CServer::OnCLSubscribeServerList, Qt::DirectConnection );
 
-    QObject::connect ( &ConnLessProtocol, &CProtocol::CLUnregisterServerReceived, this, &CServer::OnCLUnregisterServerReceived );
+    QObject::connect ( &ConnLessProtocol, &CProtocol::CLRegisterServerResp, this, &CServer::OnCLRegisterServerResp, Qt::DirectConnection );
 
-    QObject::connect ( &ConnLessProtocol, &CProtocol::CLReqServerList, this, &CServer::OnCLReqServerList );
+    QObject::connect ( &ConnLessProtocol, &CProtocol::CLServerFeaturesReceived, this, &CServer::OnCLServerFeaturesReceived, Qt::DirectConnection );
 
-    QObject::connect ( &ConnLessProtocol, &CProtocol::CLRegisterServerResp, this, &CServer::OnCLRegisterServerResp );
+    QObject::connect ( &ConnLessProtocol, &CProtocol::CLSendEmptyMes, this, &CServer::OnCLSendEmptyMes, Qt::DirectConnection );
 
-    QObject::connect ( &ConnLessProtocol, &CProtocol::CLSendEmptyMes, this, &CServer::OnCLSendEmptyMes );
+    QObject::connect ( &ConnLessProtocol, &CProtocol::CLSendEmptyMesMulti, this, &CServer::OnCLSendEmptyMesMulti, Qt::DirectConnection );
 
-    QObject::connect ( &ConnLessProtocol, &CProtocol::CLDisconnection, this, &CServer::OnCLDisconnection );
+    QObject::connect ( &ConnLessProtocol, &CProtocol::CLDisconnection, this, &CServer::OnCLDisconnection, Qt::DirectConnection );
 
-    QObject::connect ( &ConnLessProtocol, &CProtocol::CLReqVersionAndOS, this, &CServer::OnCLReqVersionAndOS );
+    QObject::connect ( &ConnLessProtocol, &CProtocol::CLReqVersionAndOS, this, &CServer::OnCLReqVersionAndOS, Qt::DirectConnection );
 
-    QObject::connect ( &ConnLessProtocol, &CProtocol::CLVersionAndOSReceived, this, &CServer::CLVersionAndOSReceived );
+    QObject::connect ( &ConnLessProtocol, &CProtocol::CLVersionAndOSReceived, this, &CServer::CLVersionAndOSReceived, Qt::DirectConnection );
 
-    QObject::connect ( &ConnLessProtocol, &CProtocol::CLReqConnClientsList, this, &CServer::OnCLReqConnClientsList );
+    QObject::connect ( &ConnLessProtocol, &CProtocol::CLReqConnClientsList, this, &CServer::OnCLReqConnClientsList, Qt::DirectConnection );
+
+    QObject::connect ( &TimerConnClientsListReq, &QTimer::timeout, this, &CServer::OnTimerConnClientsListReq, Qt::DirectConnection );
 
     QObject::connect ( &ServerListManager, &CServerListManager::SvrRegStatusChanged, this, &CServer::SvrRegStatusChanged );
 
+    QObject::connect ( &ServerListManager,
+                       &CServerListManager::RegisteredDirectoryChanged,
+                       this,
+                       &CServer::OnRegisteredDirectoryChanged,
+                       Qt::DirectConnection );
+
     QObject::connect ( &JamController, &recorder::CJamController::RestartRecorder, this, &CServer::RestartRecorder );
 
     QObject::connect ( &JamController, &recorder::CJamController::StopRecorder, this, &CServer::StopRecorder );
@@ -295,63 +319,99 @@ CServer::CServer ( const int          iNewMaxNumChan,
     qRegisterMetaType<CVector<int16_t>> ( "CVector<int16_t>" );
     QObject::connect ( this, &CServer::AudioFrame, &JamController, &recorder::CJamController::AudioFrame );
 
+    QObject::connect ( this, &CServer::ListenerAudioFrame, &JamController, &recorder::CJamController::ListenerAudioFrame );
+
+    QObject::connect ( this, &CServer::ListenerMixRecordingChanged, &JamController, &recorder::CJamController::ListenerMixRecordingChanged );
+
     QObject::connect ( QCoreApplication::instance(), &QCoreApplication::aboutToQuit, this, &CServer::OnAboutToQuit );
 
     QObject::connect ( pSignalHandler, &CSignalHandler::HandledSignal, this, &CServer::OnHandledSignal );
 
-    connectChannelSignalsToServerSlots<MAX_NUM_CHANNELS>();
+    for ( i = 0; i < iMaxNumChannels; i++ )
+    {
+        ConnectChannelSignals ( i );
+    }
+
+    // the connection less worker thread must be running before the socket is started
+    ConnLessWorkerThread.setObjectName ( "ConnLessWorker" );
+    ConnLessProtocol.moveToThread ( &ConnLessWorkerThread );
+    ServerListManager.MoveToThread ( &ConnLessWorkerThread );
+    TimerConnClientsListReq.setSingleShot ( true );
+    TimerConnClientsListReq.moveToThread ( &ConnLessWorkerThread );
+    ConnLessWorkerThread.start();
+
+    // create the audio codecs of the first channels
+    RequestFreeChannelCodecs();
 
     // start the socket (it is important to start the socket after all
     // initializations and connections)
     Socket.Start();
 }
 
-template<unsigned int slotId>
-inline void CServer::connectChannelSignalsToServerSlots()
+void CServer::ConnectChannelSignals ( const int iChID )
 {
-    int iCurChanID = slotId - 1;
-
-    void ( CServer::*pOnSendProtMessCh ) ( CVector<uint8_t> ) = &CServerSlots<slotId>::OnSendProtMessCh;
-
-    void ( CServer::*pOnReqConnClientsListCh )() = &CServerSlots<slotId>::OnReqConnClientsListCh;
-
-    void ( CServer::*pOnChatTextReceivedCh ) ( QString ) = &CServerSlots<slotId>::OnChatTextReceivedCh;
-
-    void ( CServer::*pOnMuteStateHasChangedCh ) ( int, bool ) = &CServerSlots<slotId>::OnMuteStateHasChangedCh;
-
-    void ( CServer::*pOnServerAutoSockBufSizeChangeCh ) ( int ) = &CServerSlots<slotId>::OnServerAutoSockBufSizeChangeCh;
+    CChannel* pChannel = &vecChannels[iChID];
 
     // send message
-    QObject::connect ( &vecChannels[iCurChanID], &CChannel::MessReadyForSending, this, pOnSendProtMessCh );
+    QObject::connect ( pChannel, &CChannel::MessReadyForSending, this, [this, iChID] ( CVector<uint8_t> mess ) { SendProtMessage ( iChID, mess ); } );
 
     // request connected clients list
-    QObject::connect ( &vecChannels[iCurChanID], &CChannel::ReqConnClientsList, this, pOnReqConnClientsListCh );
+    QObject::connect ( pChannel, &CChannel::ReqConnClientsList, this, [this, iChID]() { CreateAndSendChanListForThisChan ( iChID ); } );
 
-    // channel info has changed
-    QObject::connect ( &vecChannels[iCurChanID], &CChannel::ChanInfoHasChanged, this, &CServer::CreateAndSendChanListForAllConChannels );
+    // channel info has changed (the right input channel of separately coded inputs
+    // shows the info of its client)
+    QObject::connect ( pChannel, &CChannel::ChanInfoHasChanged, this, [this, iChID]() {
+        UpdateRightInputChanInfo ( iChID );
+        CreateAndSendChanListForAllConChannels();
+    } );
 
     // chat text received
-    QObject::connect ( &vecChannels[iCurChanID], &CChannel::ChatTextReceived, this, pOnChatTextReceivedCh );
+    QObject::connect ( pChannel, &CChannel::ChatTextReceived, this, [this, iChID] ( QString strChatText ) {
+        CreateAndSendChatTextForAllConChannels ( iChID, strChatText );
+    } );
 
     // other mute state has changed
-    QObject::connect ( &vecChannels[iCurChanID], &CChannel::MuteStateHasChanged, this, pOnMuteStateHasChangedCh );
+    QObject::connect ( pChannel, &CChannel::MuteStateHasChanged, this, [this, iChID] ( int iChanID, bool bIsMuted ) {
+        CreateOtherMuteStateChanged ( iChID, iChanID, bIsMuted );
+    } );
 
     // auto socket buffer size change
-    QObject::connect ( &vecChannels[iCurChanID], &CChannel::ServerAutoSockBufSizeChange, this, pOnServerAutoSockBufSizeChangeCh );
-
-    connectChannelSignalsToServerSlots<slotId - 1>();
+    QObject::connect ( pChannel, &CChannel::ServerAutoSockBufSizeChange, this, [this, iChID] ( int iNNumFra ) {
+        CreateAndSendJitBufMessage ( iChID, iNNumFra );
+    } );
+
+    // audio frame loss rate measured (reported to the client for adapting the redundancy)
+    QObject::connect ( pChannel, &CChannel::AudioLossRateMeasured, this, [this, iChID] ( int iLossRatePermille ) {
+        vecChannels[iChID].CreateAudioLossRateMes ( iLossRatePermille );
+    } );
 }
 
-template<>
-inline void CServer::connectChannelSignalsToServerSlots<0>()
-{}
-
 void CServer::CreateAndSendJitBufMessage ( const int iCurChanID, const int iNNumFra ) { vecChannels[iCurChanID].CreateJitBufMes ( iNNumFra ); }
 
 CServer::~CServer()
 {
+    // move the connection less objects back to our thread and stop their thread
+    QMetaObject::invokeMethod (
+        &ConnLessProtocol,
+        [this]() {
+            TimerConnClientsListReq.stop();
+            TimerConnClientsListReq.moveToThread ( thread() );
+            ConnLessProtocol.moveToThread ( thread() );
+            ServerListManager.MoveToThread ( thread() );
+        },
+        Qt::BlockingQueuedConnection );
+
+    ConnLessWorkerThread.quit();
+    ConnLessWorkerThread.wait();
+
     for ( int i = 0; i < iMaxNumChannels; i++ )
     {
+        // the codecs of channels which were never used have not been created
+        if ( OpusMode[i] == nullptr )
+        {
+            continue;
+        }
+
         // free audio encoders and decoders
         opus_custom_encoder_destroy ( OpusEncoderMono[i] );
         opus_custom_decoder_destroy ( OpusDecoderMono[i] );
@@ -361,6 +421,10 @@ CServer::~CServer()
         opus_custom_decoder_destroy ( Opus64DecoderMono[i] );
         opus_custom_encoder_destroy ( Opus64EncoderStereo[i] );
         opus_custom_decoder_destroy ( Opus64DecoderStereo[i] );
+        opus_custom_encoder_destroy ( Opus64RedEncoderMono[i] );
+        opus_custom_encoder_destroy ( Opus64RedEncoderStereo[i] );
+        opus_custom_encoder_destroy ( OpusRedEncoderMono[i] );
+        opus_custom_encoder_destroy ( OpusRedEncoderStereo[i] );
 
         // free audio modes
         opus_custom_mode_destroy ( OpusMode[i] );
@@ -379,6 +443,9 @@ void CServer::OnNewConnection ( int iChID, int iTotChans, CHostAddress RecHostAd
 {
     QMutexLocker locker ( &Mutex );
 
+    // the cached connected clients list message is outdated now
+    iChanListVersion++;
+
     // inform the client about its own ID at the server (note that this
     // must be the first message to be sent for a new connection)
     vecChannels[iChID].CreateClientIDMes ( iChID );
@@ -442,6 +509,9 @@ void CServer::OnNewConnection ( int iChID, int iTotChans, CHostAddress RecHostAd
     // send version info (for, e.g., feature activation in the client)
     vecChannels[iChID].CreateVersionAndOSMes();
 
+    // announce the optional network transport features (must be sent after the version)
+    vecChannels[iChID].CreateNetwTranspFeaturesMes();
+
     // send recording state message on connection
     vecChannels[iChID].CreateRecorderStateMes ( JamController.GetRecorderState() );
 
@@ -468,8 +538,52 @@ void CServer::OnSendCLProtMessage ( CHostAddress InetAddr, CVector<uint8_t> vecM
     Socket.SendPacket ( vecMessage, InetAddr );
 }
 
+void CServer::OnCLReqConnClientsList ( CHostAddress InetAddr )
+{
+    // called in the connection less worker thread, the request is answered
+    // together with all other requests which arrive in a short time
+    setConnClientsListReqAddr.insert ( InetAddr );
+
+    if ( !TimerConnClientsListReq.isActive() )
+    {
+        TimerConnClientsListReq.start ( CONN_CLIENTS_LIST_COALESCE_TIME_MS );
+    }
+}
+
+void CServer::OnTimerConnClientsListReq()
+{
+    // called in the connection less worker thread
+    // only create the message again if the channel list has changed (the
+    // version is read before the list so that a change in between is not lost)
+    const int iCurChanListVersion = iChanListVersion.load();
+
+    if ( iCurChanListVersion != iConnClientsListMesVersion )
+    {
+        CVector<CChannelInfo> vecChanInfo;
+
+        // the lock is only needed for reading the channels
+        {
+            QMutexLocker locker ( &Mutex );
+            vecChanInfo = CreateChannelList();
+        }
+
+        ConnLessProtocol.GenCLConnClientsListMes ( vecConnClientsListMes, vecChanInfo );
+        iConnClientsListMesVersion = iCurChanListVersion;
+    }
+
+    for ( const CHostAddress& InetAddr : setConnClientsListReqAddr )
+    {
+        ConnLessProtocol.SendCLPreparedMes ( InetAddr, vecConnClientsListMes );
+    }
+
+    setConnClientsListReqAddr.clear();
+}
+
 void CServer::OnCLDisconnection ( CHostAddress InetAddr )
 {
+    // called in the connection less worker thread
+    QMutexLocker locker ( &Mutex );
+
     // check if the given address is actually a client which is connected to
     // this server, if yes, disconnect it
     const int iCurChanID = FindChannel ( InetAddr );
@@ -540,8 +654,15 @@ void CServer::Start()
     // only start if not already running
     if ( !IsRunning() )
     {
-        // start timer
-        HighPrecisionTimer.Start();
+        // start timer (in room mode the room manager starts its timer on the Started signal)
+        if ( bRoomMode )
+        {
+            bRoomIsRunning = true;
+        }
+        else
+        {
+            HighPrecisionTimer.Start();
+        }
 
         // emit start signal
         emit Started();
@@ -557,7 +678,14 @@ void CServer::Stop()
     if ( IsRunning() )
     {
         // stop timer
-        HighPrecisionTimer.Stop();
+        if ( bRoomMode )
+        {
+            bRoomIsRunning = false;
+        }
+        else
+        {
+            HighPrecisionTimer.Stop();
+        }
 
         // logging (add "server stopped" logging entry)
         Logging.AddServerStopped();
@@ -567,6 +695,14 @@ void CServer::Stop()
     }
 }
 
+void CServer::SetRoomMode()
+{
+    // the frames of a room are clocked by the room manager, so our own timer must not run
+    Stop();
+
+    bRoomMode = true;
+}
+
 void CServer::OnTimer()
 {
     //### TEST: BEGIN ###//
@@ -574,79 +710,96 @@ void CServer::OnTimer()
     // static CTimingMeas JitterMeas ( 1000, "test2.dat" ); JitterMeas.Measure();
     //### TEST: END ###//
 
+    // without multithreading all blocks are processed directly in this thread
+    CThreadPool* pPool = bUseMultithreading ? pThreadPool.get() : nullptr;
+
     // Get data from all connected clients -------------------------------------
-    // some inits
-    int  iNumClients          = 0; // init connected client counter
-    bool bUseMT               = false;
-    int  iNumBlocks           = 0;     // init number of blocks for multithreading
-    int  iMTBlockSize         = 0;     // init block size for multithreading
-    bChannelIsNowDisconnected = false; // note that the flag must be a member function since QtConcurrent::run can only take 5 params
+    const int iNumClients = BeginFrame();
 
-    {
-        // Make put and get calls thread safe.
-        QMutexLocker locker ( &Mutex );
+    ScheduleDecodeBlocks ( iNumClients, pPool, iMaxNumThreads, Futures );
+    WaitForBlocks ( Futures );
 
-        // first, get number and IDs of connected channels
-        for ( int i = 0; i < iMaxNumChannels; i++ )
-        {
-            if ( vecChannels[i].IsConnected() )
-            {
-                // add ID and increment counter (note that the vector length is
-                // according to the worst case scenario, if the number of
-                // connected clients is less, only a subset of elements of this
-                // vector are actually used and the others are dummy elements)
-                vecChanIDsCurConChan[iNumClients] = i;
-                iNumClients++;
-            }
-        }
+    EndDecode ( iNumClients );
 
-        // use multithreading for any non-zero number of clients
-        // (overhead is low and it is worth doing for all numbers)
-        bUseMT = bUseMultithreading && iNumClients > 0;
+    // Process data ------------------------------------------------------------
+    ScheduleMixEncodeBlocks ( iNumClients, pPool, iMaxNumThreads, Futures );
+    WaitForBlocks ( Futures );
+
+    EndFrame ( iNumClients );
+}
+
+// The frame processing is split in phases so that the room manager can run each
+// phase for all rooms in one pass over the shared thread pool. The phases must be
+// called in order: BeginFrame, ScheduleDecodeBlocks, (wait), EndDecode,
+// ScheduleMixEncodeBlocks, (wait), EndFrame.
+int CServer::BeginFrame()
+{
+    int iNumClients = 0; // init connected client counter
+
+    bChannelIsNowDisconnected = false; // note that the flag must be a member function since QtConcurrent::run can only take 5 params
+
+    // Make put and get calls thread safe (the mutex is released in EndDecode()
+    // after all channels are decoded).
+    Mutex.lock();
+
+    // add or remove the right input channels of separately coded inputs
+    UpdateRightInputChannels();
 
-        // prepare and decode connected channels
-        if ( !bUseMT )
+    // first, get number and IDs of connected channels (including the right input
+    // channels which are mixed like a connected channel)
+    for ( int i = 0; i < iMaxNumChannels; i++ )
+    {
+        if ( vecChannels[i].IsConnected() || IsRightInputChannel ( i ) )
         {
-            // run the OPUS decoder for all data blocks
-            DecodeReceiveDataBlocks ( this, 0, iNumClients - 1, iNumClients );
+            // add ID and increment counter (note that the vector length is
+            // according to the worst case scenario, if the number of
+            // connected clients is less, only a subset of elements of this
+            // vector are actually used and the others are dummy elements)
+            vecChanIDsCurConChan[iNumClients] = i;
+            iNumClients++;
         }
-        else
-        {
-            // spread work equally among available threads
-            iNumBlocks   = std::min ( iNumClients, iMaxNumThreads );
-            iMTBlockSize = ( iNumClients - 1 ) / iNumBlocks + 1;
+    }
 
-            // processing with multithreading
-            for ( int iBlockCnt = 0; iBlockCnt < iNumBlocks; iBlockCnt++ )
-            {
-                // The work for OPUS decoding is distributed over all available processor cores.
-                // By using the future synchronizer we make sure that all
-                // threads are done when we leave the timer callback function.
-                const int iStartChanCnt = iBlockCnt * iMTBlockSize;
-                const int iStopChanCnt  = std::min ( ( iBlockCnt + 1 ) * iMTBlockSize - 1, iNumClients - 1 );
+    // the client channel needs the index of its right input channel for decoding
+    for ( int iChanCnt = 0; iChanCnt < iNumClients; iChanCnt++ )
+    {
+        vecRightInputChanCnt[iChanCnt] = INVALID_INDEX;
 
-                Futures.push_back ( pThreadPool->enqueue ( CServer::DecodeReceiveDataBlocks, this, iStartChanCnt, iStopChanCnt, iNumClients ) );
-            }
+        const int iRightChanID = vecRightInputChanID[vecChanIDsCurConChan[iChanCnt]];
 
-            // make sure all concurrent run threads have finished when we leave this function
-            for ( auto& future : Futures )
+        if ( iRightChanID != INVALID_CHANNEL_ID )
+        {
+            for ( int j = 0; j < iNumClients; j++ )
             {
-                future.wait();
+                if ( vecChanIDsCurConChan[j] == iRightChanID )
+                {
+                    vecRightInputChanCnt[iChanCnt] = j;
+                    break;
+                }
             }
-            Futures.clear();
         }
+    }
 
-        // a channel is now disconnected, take action on it
-        if ( bChannelIsNowDisconnected )
-        {
-            // update channel list for all currently connected clients
-            CreateAndSendChanListForAllConChannels();
-        }
+    return iNumClients;
+}
+
+void CServer::ScheduleDecodeBlocks ( const int iNumClients, CThreadPool* pPool, const int iNumThreads, CVector<std::future<void>>& vecFutures )
+{
+    // run the OPUS decoder for all data blocks
+    ScheduleBlocks ( CServer::DecodeReceiveDataBlocks, iNumClients, pPool, iNumThreads, vecFutures );
+}
+
+void CServer::EndDecode ( const int iNumClients )
+{
+    // a channel is now disconnected, take action on it
+    if ( bChannelIsNowDisconnected )
+    {
+        // update channel list for all currently connected clients
+        CreateAndSendChanListForAllConChannels();
     }
 
-    // Process data ------------------------------------------------------------
-    // Check if at least one client is connected. If not, stop server until
-    // one client is connected.
+    Mutex.unlock();
+
     if ( iNumClients > 0 )
     {
         // calculate levels for all connected clients
@@ -657,57 +810,49 @@ void CServer::OnTimer()
             // get actual ID of current channel
             const int iCurChanID = vecChanIDsCurConChan[iChanCnt];
 
-            // update socket buffer size
-            vecChannels[iCurChanID].UpdateSocketBufferSize();
+            // a right input channel has no network connection of its own
+            const bool bIsRightInput = IsRightInputChannel ( iCurChanID );
 
-            // send channel levels if they are ready
-            if ( bSendChannelLevels )
+            if ( !bIsRightInput )
             {
-                ConnLessProtocol.CreateCLChannelLevelListMes ( vecChannels[iCurChanID].GetAddress(), vecChannelLevels, iNumClients );
+                // update socket buffer size
+                vecChannels[iCurChanID].UpdateSocketBufferSize();
+
+                // send channel levels if they are ready
+                if ( bSendChannelLevels )
+                {
+                    ConnLessProtocol.CreateCLChannelLevelListMes ( vecChannels[iCurChanID].GetAddress(), vecChannelLevels, iNumClients );
+                }
             }
 
             // export the audio data for recording purpose
             if ( JamController.GetRecordingEnabled() )
             {
+                const int iAddrChanID = bIsRightInput ? vecRightInputOwnerID[iCurChanID] : iCurChanID;
+
                 emit AudioFrame ( iCurChanID,
                                   vecChannels[iCurChanID].GetName(),
-                                  vecChannels[iCurChanID].GetAddress(),
+                                  vecChannels[iAddrChanID].GetAddress(),
                                   vecNumAudioChannels[iChanCnt],
                                   vecvecsData[iChanCnt] );
             }
-
-            // processing without multithreading
-            if ( !bUseMT )
-            {
-                // generate a separate mix for each channel, OPUS encode the
-                // audio data and transmit the network packet
-                MixEncodeTransmitData ( iChanCnt, iNumClients );
-            }
         }
+    }
+}
 
-        // processing with multithreading
-        if ( bUseMT )
-        {
-            for ( int iBlockCnt = 0; iBlockCnt < iNumBlocks; iBlockCnt++ )
-            {
-                // Generate a separate mix for each channel, OPUS encode the
-                // audio data and transmit the network packet. The work is
-                // distributed over all available processor cores.
-                // By using the future synchronizer we make sure that all
-                // threads are done when we leave the timer callback function.
-                const int iStartChanCnt = iBlockCnt * iMTBlockSize;
-                const int iStopChanCnt  = std::min ( ( iBlockCnt + 1 ) * iMTBlockSize - 1, iNumClients - 1 );
-
-                Futures.push_back ( pThreadPool->enqueue ( CServer::MixEncodeTransmitDataBlocks, this, iStartChanCnt, iStopChanCnt, iNumClients ) );
-            }
+void CServer::ScheduleMixEncodeBlocks ( const int iNumClients, CThreadPool* pPool, const int iNumThreads, CVector<std::future<void>>& vecFutures )
+{
+    // generate a separate mix for each channel, OPUS encode the
+    // audio data and transmit the network packet
+    ScheduleBlocks ( CServer::MixEncodeTransmitDataBlocks, iNumClients, pPool, iNumThreads, vecFutures );
+}
 
-            // make sure all concurrent run threads have finished when we leave this function
-            for ( auto& fFuture : Futures )
-            {
-                fFuture.wait();
-            }
-            Futures.clear();
-        }
+void CServer::EndFrame ( const int iNumClients )
+{
+    // Check if at least one client is connected. If not, stop server until
+    // one client is connected.
+    if ( iNumClients > 0 )
+    {
         if ( bDelayPan )
         {
             for ( int i = 0; i < iNumClients; i++ )
@@ -727,10 +872,62 @@ void CServer::OnTimer()
     }
 }
 
+void CServer::ScheduleBlocks ( void ( *pBlockFunc ) ( CServer*, const int, const int, const int, const int ),
+                               const int                   iNumClients,
+                               CThreadPool*                pPool,
+                               const int                   iNumThreads,
+                               CVector<std::future<void>>& vecFutures )
+{
+    if ( iNumClients == 0 )
+    {
+        return;
+    }
+
+    if ( pPool == nullptr )
+    {
+        // processing without multithreading
+        pBlockFunc ( this, 0, 0, iNumClients - 1, iNumClients );
+        return;
+    }
+
+    // spread work equally among available threads (use multithreading for any
+    // non-zero number of clients, overhead is low and it is worth doing for all numbers,
+    // each block needs its own mix row)
+    const int iNumBlocks   = std::min ( std::min ( iNumClients, iNumThreads ), vecvecfGains.Size() );
+    const int iMTBlockSize = ( iNumClients - 1 ) / iNumBlocks + 1;
+
+    for ( int iBlockCnt = 0; iBlockCnt < iNumBlocks; iBlockCnt++ )
+    {
+        // The work is distributed over all available processor cores.
+        // By using the future synchronizer (see WaitForBlocks()) we make sure that all
+        // threads are done when we leave the timer callback function.
+        const int iStartChanCnt = iBlockCnt * iMTBlockSize;
+        const int iStopChanCnt  = std::min ( ( iBlockCnt + 1 ) * iMTBlockSize - 1, iNumClients - 1 );
+
+        vecFutures.push_back ( pPool->enqueue ( pBlockFunc, this, iBlockCnt, iStartChanCnt, iStopChanCnt, iNumClients ) );
+    }
+}
+
+void CServer::WaitForBlocks ( CVector<std::future<void>>& vecFutures )
+{
+    // make sure all concurrent run threads have finished
+    for ( auto& future : vecFutures )
+    {
+        future.wait();
+    }
+    vecFutures.clear();
+}
+
 // This is a static method used as a callback, and does not inherit a "this" pointer,
 // so it is necessary for the server instance to be passed as a parameter.
-void CServer::DecodeReceiveDataBlocks ( CServer* pServer, const int iStartChanCnt, const int iStopChanCnt, const int iNumClients )
+void CServer::DecodeReceiveDataBlocks ( CServer*  pServer,
+                                        const int iBlockCnt,
+                                        const int iStartChanCnt,
+                                        const int iStopChanCnt,
+                                        const int iNumClients )
 {
+    Q_UNUSED ( iBlockCnt )
+
     // loop over all channels in the current block, needed for multithreading support
     for ( int iChanCnt = iStartChanCnt; iChanCnt <= iStopChanCnt; iChanCnt++ )
     {
@@ -740,12 +937,17 @@ void CServer::DecodeReceiveDataBlocks ( CServer* pServer, const int iStartChanCn
 
 // This is a static method used as a callback, and does not inherit a "this" pointer,
 // so it is necessary for the server instance to be passed as a parameter.
-void CServer::MixEncodeTransmitDataBlocks ( CServer* pServer, const int iStartChanCnt, const int iStopChanCnt, const int iNumClients )
+void CServer::MixEncodeTransmitDataBlocks ( CServer*  pServer,
+                                            const int iBlockCnt,
+                                            const int iStartChanCnt,
+                                            const int iStopChanCnt,
+                                            const int iNumClients )
 {
     // loop over all channels in the current block, needed for multithreading support
+    // (the channels of a block are mixed one after another using the mix row of the block)
     for ( int iChanCnt = iStartChanCnt; iChanCnt <= iStopChanCnt; iChanCnt++ )
     {
-        pServer->MixEncodeTransmitData ( iChanCnt, iNumClients );
+        pServer->MixEncodeTransmitData ( iChanCnt, iNumClients, iBlockCnt );
     }
 }
 
@@ -759,9 +961,31 @@ void CServer::DecodeReceiveData ( const int iChanCnt, const int iNumClients )
     // get actual ID of current channel
     const int iCurChanID = vecChanIDsCurConChan[iChanCnt];
 
+    // the right input channel is decoded together with its client channel, only
+    // the properties of the mono audio data are stored here
+    if ( IsRightInputChannel ( iCurChanID ) )
+    {
+        const int iOwnerChanID = vecRightInputOwnerID[iCurChanID];
+
+        vecNumAudioChannels[iChanCnt]           = 1;
+        vecNumMixAudioChannels[iChanCnt]        = 1;
+        vecAudioComprType[iChanCnt]             = vecChannels[iOwnerChanID].GetAudioCompressionType();
+        vecUseDoubleSysFraSizeConvBuf[iChanCnt] = ( !bUseDoubleSystemFrameSize && ( vecAudioComprType[iChanCnt] == CT_OPUS ) );
+        vecNumFrameSizeConvBlocks[iChanCnt]     = ( bUseDoubleSystemFrameSize && ( vecAudioComprType[iChanCnt] == CT_OPUS64 ) ) ? 2 : 1;
+        return;
+    }
+
+    // with separately coded inputs, the client channel gets the left input and the
+    // right input goes to the right input channel (if one could be allocated) but
+    // the mix for the client is still stereo
+    const bool bSeparateInputs = vecChannels[iCurChanID].GetSeparateChannels();
+    const int  iRightChanCnt   = vecRightInputChanCnt[iChanCnt];
+    const int  iRightChanID    = ( iRightChanCnt != INVALID_INDEX ) ? vecChanIDsCurConChan[iRightChanCnt] : INVALID_CHANNEL_ID;
+
     // get and store number of audio channels and compression type
-    vecNumAudioChannels[iChanCnt] = vecChannels[iCurChanID].GetNumAudioChannels();
-    vecAudioComprType[iChanCnt]   = vecChannels[iCurChanID].GetAudioCompressionType();
+    vecNumMixAudioChannels[iChanCnt] = vecChannels[iCurChanID].GetNumAudioChannels();
+    vecNumAudioChannels[iChanCnt]    = bSeparateInputs ? 1 : vecNumMixAudioChannels[iChanCnt];
+    vecAudioComprType[iChanCnt]      = vecChannels[iCurChanID].GetAudioCompressionType();
 
     // get info about required frame size conversion properties
     vecUseDoubleSysFraSizeConvBuf[iChanCnt] = ( !bUseDoubleSystemFrameSize && ( vecAudioComprType[iChanCnt] == CT_OPUS ) );
@@ -779,7 +1003,12 @@ void CServer::DecodeReceiveData ( const int iChanCnt, const int iNumClients )
     if ( vecUseDoubleSysFraSizeConvBuf[iChanCnt] )
     {
         DoubleFrameSizeConvBufIn[iCurChanID].SetBufferSize ( DOUBLE_SYSTEM_FRAME_SIZE_SAMPLES * vecNumAudioChannels[iChanCnt] );
-        DoubleFrameSizeConvBufOut[iCurChanID].SetBufferSize ( DOUBLE_SYSTEM_FRAME_SIZE_SAMPLES * vecNumAudioChannels[iChanCnt] );
+        DoubleFrameSizeConvBufOut[iCurChanID].SetBufferSize ( DOUBLE_SYSTEM_FRAME_SIZE_SAMPLES * vecNumMixAudioChannels[iChanCnt] );
+
+        if ( iRightChanID != INVALID_CHANNEL_ID )
+        {
+            DoubleFrameSizeConvBufIn[iRightChanID].SetBufferSize ( DOUBLE_SYSTEM_FRAME_SIZE_SAMPLES );
+        }
     }
 
     // select the opus decoder and raw audio frame length
@@ -814,29 +1043,6 @@ void CServer::DecodeReceiveData ( const int iChanCnt, const int iNumClients )
         CurOpusDecoder = nullptr;
     }
 
-    // get gains of all connected channels
-    for ( int j = 0; j < iNumClients; j++ )
-    {
-        // The second index of "vecvecdGains" does not represent
-        // the channel ID! Therefore we have to use
-        // "vecChanIDsCurConChan" to query the IDs of the currently
-        // connected channels
-        vecvecfGains[iChanCnt][j] = vecChannels[iCurChanID].GetGain ( vecChanIDsCurConChan[j] );
-
-        // consider audio fade-in
-        vecvecfGains[iChanCnt][j] *= vecChannels[vecChanIDsCurConChan[j]].GetFadeInGain();
-
-        // use the fade in of the current channel for all other connected clients
-        // as well to avoid the client volumes are at 100% when joining a server (#628)
-        if ( j != iChanCnt )
-        {
-            vecvecfGains[iChanCnt][j] *= vecChannels[iCurChanID].GetFadeInGain();
-        }
-
-        // panning
-        vecvecfPannings[iChanCnt][j] = vecChannels[iCurChanID].GetPan ( vecChanIDsCurConChan[j] );
-    }
-
     // If the server frame size is smaller than the received OPUS frame size, we need a conversion
     // buffer which stores the large buffer.
     // Note that we have a shortcut here. If the conversion buffer is not needed, the boolean flag
@@ -865,6 +1071,12 @@ void CServer::DecodeReceiveData ( const int iChanCnt, const int iNumClients )
 
                 FreeChannel ( iCurChanID ); // note that the channel is now not in use
 
+                // the right input channel is removed with the next frame
+                if ( iRightChanCnt != INVALID_INDEX )
+                {
+                    vecvecsData[iRightChanCnt].Reset ( 0 );
+                }
+
                 // note that no mutex is needed for this shared resource since it is not a
                 // read-modify-write operation but an atomic write and also each thread can
                 // only set it to true and never to false
@@ -875,10 +1087,18 @@ void CServer::DecodeReceiveData ( const int iChanCnt, const int iNumClients )
             }
 
             // get pointer to coded data
+            int iCurNumCodedBytes = iCeltNumCodedBytes;
+
             if ( eGetStat == GS_BUFFER_OK )
             {
                 pCurCodedData = &vecvecbyCodedData[iChanCnt][0];
             }
+            else if ( eGetStat == GS_BUFFER_REDUNDANT )
+            {
+                // the lost packet is replaced by its redundant copy
+                pCurCodedData     = &vecvecbyCodedData[iChanCnt][0];
+                iCurNumCodedBytes = vecChannels[iCurChanID].GetRedNumCodedBytes();
+            }
             else
             {
                 // for lost packets use null pointer as coded input data
@@ -886,13 +1106,41 @@ void CServer::DecodeReceiveData ( const int iChanCnt, const int iNumClients )
             }
 
             // OPUS decode received data stream
-            if ( CurOpusDecoder != nullptr )
+            if ( bSeparateInputs )
+            {
+                // the network frame holds the left and right input as two mono frames
+                // of equal size, the right one is dropped if there is no channel for it
+                const int iSepNumCodedBytes = iCurNumCodedBytes / 2;
+                const int iOffset           = iB * SYSTEM_FRAME_SIZE_SAMPLES;
+
+                if ( CurOpusDecoder != nullptr )
+                {
+                    iUnused = opus_custom_decode ( CurOpusDecoder,
+                                                   pCurCodedData,
+                                                   iSepNumCodedBytes,
+                                                   &vecvecsData[iChanCnt][iOffset],
+                                                   iClientFrameSizeSamples );
+                }
+
+                if ( iRightChanID != INVALID_CHANNEL_ID )
+                {
+                    OpusCustomDecoder* RightOpusDecoder =
+                        ( vecAudioComprType[iChanCnt] == CT_OPUS ) ? OpusDecoderMono[iRightChanID] : Opus64DecoderMono[iRightChanID];
+
+                    iUnused = opus_custom_decode ( RightOpusDecoder,
+                                                   pCurCodedData == nullptr ? nullptr : pCurCodedData + iSepNumCodedBytes,
+                                                   iSepNumCodedBytes,
+                                                   &vecvecsData[iRightChanCnt][iOffset],
+                                                   iClientFrameSizeSamples );
+                }
+            }
+            else if ( CurOpusDecoder != nullptr )
             {
                 const int iOffset = iB * SYSTEM_FRAME_SIZE_SAMPLES * vecNumAudioChannels[iChanCnt];
 
                 iUnused = opus_custom_decode ( CurOpusDecoder,
                                                pCurCodedData,
-                                               iCeltNumCodedBytes,
+                                               iCurNumCodedBytes,
                                                &vecvecsData[iChanCnt][iOffset],
                                                iClientFrameSizeSamples );
             }
@@ -904,34 +1152,71 @@ void CServer::DecodeReceiveData ( const int iChanCnt, const int iNumClients )
         {
             DoubleFrameSizeConvBufIn[iCurChanID].PutAll ( vecvecsData[iChanCnt] );
             DoubleFrameSizeConvBufIn[iCurChanID].Get ( vecvecsData[iChanCnt], SYSTEM_FRAME_SIZE_SAMPLES * vecNumAudioChannels[iChanCnt] );
+
+            if ( iRightChanID != INVALID_CHANNEL_ID )
+            {
+                DoubleFrameSizeConvBufIn[iRightChanID].PutAll ( vecvecsData[iRightChanCnt] );
+                DoubleFrameSizeConvBufIn[iRightChanID].Get ( vecvecsData[iRightChanCnt], SYSTEM_FRAME_SIZE_SAMPLES );
+            }
         }
     }
+    else if ( iRightChanID != INVALID_CHANNEL_ID )
+    {
+        // the second half of the large frame of the right input is read in lockstep
+        DoubleFrameSizeConvBufIn[iRightChanID].Get ( vecvecsData[iRightChanCnt], SYSTEM_FRAME_SIZE_SAMPLES );
+    }
 
     Q_UNUSED ( iUnused )
 }
 
 /// @brief Mix all audio data from all clients together, encode and transmit
-void CServer::MixEncodeTransmitData ( const int iChanCnt, const int iNumClients )
+void CServer::MixEncodeTransmitData ( const int iChanCnt, const int iNumClients, const int iMixRow )
 {
     int               i, j, k, iUnused;
     CVector<float>&   vecfIntermProcBuf = vecvecfIntermediateProcBuf[iChanCnt]; // use reference for faster access
     CVector<int16_t>& vecsSendData      = vecvecsSendData[iChanCnt];            // use reference for faster access
+    CVector<float>&   vecfGains         = vecvecfGains[iMixRow];                // use reference for faster access
+    CVector<float>&   vecfPannings      = vecvecfPannings[iMixRow];             // use reference for faster access
 
     // get actual ID of current channel
     const int iCurChanID = vecChanIDsCurConChan[iChanCnt];
 
+    // a right input channel has no listener, it is only mixed for the other channels
+    if ( IsRightInputChannel ( iCurChanID ) )
+    {
+        return;
+    }
+
+    // get gains and pans of all connected channels (the index of the mix row does
+    // not represent the channel ID! Therefore "vecChanIDsCurConChan" is used to
+    // query the IDs of the currently connected channels)
+    vecChannels[iCurChanID].GetGainsPans ( vecChanIDsCurConChan, iNumClients, vecfGains, vecfPannings );
+
+    for ( j = 0; j < iNumClients; j++ )
+    {
+        // consider audio fade-in
+        vecfGains[j] *= GetFadeInGain ( vecChanIDsCurConChan[j] );
+
+        // use the fade in of the current channel for all other connected clients
+        // as well to avoid the client volumes are at 100% when joining a server (#628)
+        if ( j != iChanCnt )
+        {
+            vecfGains[j] *= GetFadeInGain ( iCurChanID );
+        }
+    }
+
     // init intermediate processing vector with zeros since we mix all channels on that vector
     vecfIntermProcBuf.Reset ( 0 );
 
     // distinguish between stereo and mono mode
-    if ( vecNumAudioChannels[iChanCnt] == 1 )
+    if ( vecNumMixAudioChannels[iChanCnt] == 1 )
     {
         // Mono target channel -------------------------------------------------
         for ( j = 0; j < iNumClients; j++ )
         {
             // get a reference to the audio data and gain of the current client
             const CVector<int16_t>& vecsData = vecvecsData[j];
-            const float             fGain    = vecvecfGains[iChanCnt][j];
+            const float             fGain    = vecfGains[j];
 
             // if channel gain is 1, avoid multiplication for speed optimization
             if ( fGain == 1.0f )
@@ -995,8 +1280,8 @@ void CServer::MixEncodeTransmitData ( const int iChanCnt, const int iNumClients
             const CVector<int16_t>& vecsData  = vecvecsData[j];
             const CVector<int16_t>& vecsData2 = vecvecsData2[j];
 
-            const float fGain = vecvecfGains[iChanCnt][j];
-            const float fPan  = bDelayPan ? 0.5f : vecvecfPannings[iChanCnt][j];
+            const float fGain = vecfGains[j];
+            const float fPan  = bDelayPan ? 0.5f : vecfPannings[j];
 
             // calculate combined gain/pan for each stereo channel where we define
             // the panning that center equals full gain for both channels
@@ -1005,7 +1290,7 @@ void CServer::MixEncodeTransmitData ( const int iChanCnt, const int iNumClients
 
             if ( bDelayPan )
             {
-                iPanDel  = lround ( (float) ( 2 * maxPanDelay - 2 ) * ( vecvecfPannings[iChanCnt][j] - 0.5f ) );
+                iPanDel  = lround ( (float) ( 2 * maxPanDelay - 2 ) * ( vecfPannings[j] - 0.5f ) );
                 iPanDelL = ( iPanDel > 0 ) ? iPanDel : 0;
                 iPanDelR = ( iPanDel < 0 ) ? -iPanDel : 0;
             }
@@ -1106,37 +1391,54 @@ void CServer::MixEncodeTransmitData ( const int iChanCnt, const int iNumClients
         }
     }
 
+    // export the mix of selected clients for recording purpose (this must be done before
+    // the frame size conversion buffer may replace the content of the send vector)
+    if ( vecbListenerMixRecording[iCurChanID] && JamController.GetRecordingEnabled() && vecChannels[iCurChanID].IsConnected() )
+    {
+        emit ListenerAudioFrame ( iCurChanID,
+                                  vecChannels[iCurChanID].GetName(),
+                                  vecChannels[iCurChanID].GetAddress(),
+                                  vecNumMixAudioChannels[iChanCnt],
+                                  vecsSendData );
+    }
+
     int                iClientFrameSizeSamples = 0; // initialize to avoid a compiler warning
     OpusCustomEncoder* pCurOpusEncoder         = nullptr;
+    OpusCustomEncoder* pCurOpusRedEncoder      = nullptr;
 
-    // get current number of CELT coded bytes
+    // get current number of CELT coded bytes and of the optional redundant frame
     const int iCeltNumCodedBytes = vecChannels[iCurChanID].GetCeltNumCodedBytes();
+    const int iRedNumCodedBytes  = vecChannels[iCurChanID].GetRedNumCodedBytes();
 
     // select the opus encoder and raw audio frame length
     if ( vecAudioComprType[iChanCnt] == CT_OPUS )
     {
         iClientFrameSizeSamples = DOUBLE_SYSTEM_FRAME_SIZE_SAMPLES;
 
-        if ( vecNumAudioChannels[iChanCnt] == 1 )
+        if ( vecNumMixAudioChannels[iChanCnt] == 1 )
         {
-            pCurOpusEncoder = OpusEncoderMono[iCurChanID];
+            pCurOpusEncoder    = OpusEncoderMono[iCurChanID];
+            pCurOpusRedEncoder = OpusRedEncoderMono[iCurChanID];
         }
         else
         {
-            pCurOpusEncoder = OpusEncoderStereo[iCurChanID];
+            pCurOpusEncoder    = OpusEncoderStereo[iCurChanID];
+            pCurOpusRedEncoder = OpusRedEncoderStereo[iCurChanID];
         }
     }
     else if ( vecAudioComprType[iChanCnt] == CT_OPUS64 )
     {
         iClientFrameSizeSamples = SYSTEM_FRAME_SIZE_SAMPLES;
 
-        if ( vecNumAudioChannels[iChanCnt] == 1 )
+        if ( vecNumMixAudioChannels[iChanCnt] == 1 )
         {
-            pCurOpusEncoder = Opus64EncoderMono[iCurChanID];
+            pCurOpusEncoder    = Opus64EncoderMono[iCurChanID];
+            pCurOpusRedEncoder = Opus64RedEncoderMono[iCurChanID];
         }
         else
         {
-            pCurOpusEncoder = Opus64EncoderStereo[iCurChanID];
+            pCurOpusEncoder    = Opus64EncoderStereo[iCurChanID];
+            pCurOpusRedEncoder = Opus64RedEncoderStereo[iCurChanID];
         }
     }
 
@@ -1146,12 +1448,12 @@ void CServer::MixEncodeTransmitData ( const int iChanCnt, const int iNumClients
     // is false and the Get() function is not called at all. Therefore if the buffer is not needed
     // we do not spend any time in the function but go directly inside the if condition.
     if ( ( vecUseDoubleSysFraSizeConvBuf[iChanCnt] == 0 ) ||
-         DoubleFrameSizeConvBufOut[iCurChanID].Put ( vecsSendData, SYSTEM_FRAME_SIZE_SAMPLES * vecNumAudioChannels[iChanCnt] ) )
+         DoubleFrameSizeConvBufOut[iCurChanID].Put ( vecsSendData, SYSTEM_FRAME_SIZE_SAMPLES * vecNumMixAudioChannels[iChanCnt] ) )
     {
         if ( vecUseDoubleSysFraSizeConvBuf[iChanCnt] != 0 )
         {
             // get the large frame from the conversion buffer
-            DoubleFrameSizeConvBufOut[iCurChanID].GetAll ( vecsSendData, DOUBLE_SYSTEM_FRAME_SIZE_SAMPLES * vecNumAudioChannels[iChanCnt] );
+            DoubleFrameSizeConvBufOut[iCurChanID].GetAll ( vecsSendData, DOUBLE_SYSTEM_FRAME_SIZE_SAMPLES * vecNumMixAudioChannels[iChanCnt] );
         }
 
         // OPUS encoding
@@ -1162,11 +1464,17 @@ void CServer::MixEncodeTransmitData ( const int iChanCnt, const int iNumClients
             // optimization it would be better to set it only if the network frame size is changed
             opus_custom_encoder_ctl ( pCurOpusEncoder,
                                       OPUS_SET_BITRATE ( CalcBitRateBitsPerSecFromCodedBytes ( iCeltNumCodedBytes, iClientFrameSizeSamples ) ) );
+
+            if ( iRedNumCodedBytes > 0 )
+            {
+                opus_custom_encoder_ctl ( pCurOpusRedEncoder,
+                                          OPUS_SET_BITRATE ( CalcBitRateBitsPerSecFromCodedBytes ( iRedNumCodedBytes, iClientFrameSizeSamples ) ) );
+            }
             //### TODO: END ###//
 
             for ( int iB = 0; iB < vecNumFrameSizeConvBlocks[iChanCnt]; iB++ )
             {
-                const int iOffset = iB * SYSTEM_FRAME_SIZE_SAMPLES * vecNumAudioChannels[iChanCnt];
+                const int iOffset = iB * SYSTEM_FRAME_SIZE_SAMPLES * vecNumMixAudioChannels[iChanCnt];
 
                 iUnused = opus_custom_encode ( pCurOpusEncoder,
                                                &vecsSendData[iOffset],
@@ -1174,8 +1482,21 @@ void CServer::MixEncodeTransmitData ( const int iChanCnt, const int iNumClients
                                                &vecvecbyCodedData[iChanCnt][0],
                                                iCeltNumCodedBytes );
 
+                // the redundant copy is sent with the next packet (for lost packet recovery)
+                if ( iRedNumCodedBytes > 0 )
+                {
+                    iUnused = opus_custom_encode ( pCurOpusRedEncoder,
+                                                   &vecsSendData[iOffset],
+                                                   iClientFrameSizeSamples,
+                                                   &vecvecbyRedCodedData[iChanCnt][0],
+                                                   iRedNumCodedBytes );
+                }
+
                 // send separate mix to current clients
-                vecChannels[iCurChanID].PrepAndSendPacket ( &Socket, vecvecbyCodedData[iChanCnt], iCeltNumCodedBytes );
+                vecChannels[iCurChanID].PrepAndSendPacket ( &Socket,
+                                                            vecvecbyCodedData[iChanCnt],
+                                                            iCeltNumCodedBytes,
+                                                            vecvecbyRedCodedData[iChanCnt] );
             }
         }
     }
@@ -1190,7 +1511,7 @@ CVector<CChannelInfo> CServer::CreateChannelList()
     // look for free channels
     for ( int i = 0; i < iMaxNumChannels; i++ )
     {
-        if ( vecChannels[i].IsConnected() )
+        if ( vecChannels[i].IsConnected() || IsRightInputChannel ( i ) )
         {
             vecChanInfo.Add ( CChannelInfo ( i, // ID
                                              vecChannels[i].GetChanInfo() ) );
@@ -1202,6 +1523,9 @@ CVector<CChannelInfo> CServer::CreateChannelList()
 
 void CServer::CreateAndSendChanListForAllConChannels()
 {
+    // the cached connected clients list message is outdated now
+    iChanListVersion++;
+
     // create channel list
     CVector<CChannelInfo> vecChanInfo ( CreateChannelList() );
 
@@ -1282,9 +1606,10 @@ void CServer::CreateOtherMuteStateChanged ( const int iCurChanID, const int iOth
 
 int CServer::GetNumberOfConnectedClients()
 {
-    QMutexLocker locker ( &MutexChanOrder );
-
-    return iCurNumChannels;
+    // no lock needed, this is also called in the socket thread for answering pings
+    // (the two counters are not changed together, so the difference may be off for
+    // a moment but must not become negative)
+    return std::max ( 0, iCurNumChannels.load ( std::memory_order_relaxed ) - iNumRightInputChannels.load ( std::memory_order_relaxed ) );
 }
 
 // CServer::FindChannel() is called for every received audio packet or connected protocol
@@ -1330,10 +1655,19 @@ int CServer::FindChannel ( const CHostAddress& CheckAddr, const bool bAllowNew )
         return INVALID_CHANNEL_ID;
     }
 
-    // allocate a new channel
+    // the audio codecs of the free channel must have been created before (the
+    // caller checks this with IsFreeChannelReady())
+    if ( OpusMode[vecChannelOrder[iCurNumChannels]] == nullptr )
+    {
+        RequestFreeChannelCodecs();
+        return INVALID_CHANNEL_ID;
+    }
+
+    // allocate a new channel and prepare the next free channels
     i          = iCurNumChannels++; // save index of free channel and increment count
     iNewChanID = vecChannelOrder[i];
     InitChannel ( iNewChanID, CheckAddr );
+    RequestFreeChannelCodecs();
 
     // now l == r == position in vecChannelOrder to insert iNewChanID
     // move channel IDs up by one starting at the top and working down
@@ -1350,6 +1684,112 @@ int CServer::FindChannel ( const CHostAddress& CheckAddr, const bool bAllowNew )
     return iNewChanID;
 }
 
+int CServer::AllocRightInputChannel()
+{
+    QMutexLocker locker ( &MutexChanOrder );
+
+    if ( iCurNumChannels >= iMaxNumChannels )
+    {
+        return INVALID_CHANNEL_ID;
+    }
+
+    // this is called in the audio processing, so the audio codecs must not be
+    // created here, if they are not ready yet the allocation is tried again in
+    // one of the next frames
+    if ( OpusMode[vecChannelOrder[iCurNumChannels]] == nullptr )
+    {
+        RequestFreeChannelCodecs();
+        return INVALID_CHANNEL_ID;
+    }
+
+    // allocate a new channel and prepare the next free channels
+    int       i          = iCurNumChannels++; // save index of free channel and increment count
+    const int iNewChanID = vecChannelOrder[i];
+    iNumRightInputChannels++;
+    InitChannel ( iNewChanID, CHostAddress() );
+    RequestFreeChannelCodecs();
+
+    // the empty address of the right input channel is sorted before all client
+    // addresses (port 0), so it is inserted at the start of the ordered IDs
+    while ( i > 0 )
+    {
+        int j              = i--;
+        vecChannelOrder[j] = vecChannelOrder[i];
+    }
+    vecChannelOrder[0] = iNewChanID;
+
+    return iNewChanID;
+}
+
+void CServer::UpdateRightInputChannels()
+{
+    // called in BeginFrame() with the mutex locked
+    for ( int i = 0; i < iMaxNumChannels; i++ )
+    {
+        const bool bSeparateInputs = vecChannels[i].IsConnected() && vecChannels[i].GetSeparateChannels();
+        const int  iRightChanID    = vecRightInputChanID[i];
+
+        if ( bSeparateInputs && ( iRightChanID == INVALID_CHANNEL_ID ) )
+        {
+            const int iNewChanID = AllocRightInputChannel();
+
+            // if the server is full, only the left input is used
+            if ( iNewChanID != INVALID_CHANNEL_ID )
+            {
+                vecRightInputChanID[i]           = iNewChanID;
+                vecRightInputOwnerID[iNewChanID] = i;
+                UpdateRightInputChanInfo ( i );
+
+                // the conversion buffers of both inputs must run in lockstep
+                DoubleFrameSizeConvBufIn[i].Reset();
+                DoubleFrameSizeConvBufIn[iNewChanID].Reset();
+
+                // the channel list is sent again in EndDecode()
+                bChannelIsNowDisconnected = true;
+            }
+        }
+        else if ( !bSeparateInputs && ( iRightChanID != INVALID_CHANNEL_ID ) )
+        {
+            if ( JamController.GetRecordingEnabled() )
+            {
+                emit ClientDisconnected ( iRightChanID );
+            }
+
+            FreeChannel ( iRightChanID );
+            iNumRightInputChannels--;
+
+            vecRightInputOwnerID[iRightChanID] = INVALID_CHANNEL_ID;
+            vecRightInputChanID[i]             = INVALID_CHANNEL_ID;
+            bChannelIsNowDisconnected          = true;
+        }
+    }
+}
+
+void CServer::UpdateRightInputChanInfo ( const int iChID )
+{
+    const int iRightChanID = vecRightInputChanID[iChID];
+
+    if ( iRightChanID != INVALID_CHANNEL_ID )
+    {
+        // the right input channel shows the info of its client with a marked name
+        CChannelCoreInfo ChanInfo = vecChannels[iChID].GetChanInfo();
+        ChanInfo.strName          = ChanInfo.strName.left ( MAX_LEN_FADER_TAG - 4 ) + " (R)";
+
+        vecChannels[iRightChanID].GetChanInfo() = ChanInfo;
+    }
+}
+
+float CServer::GetFadeInGain ( const int iChID )
+{
+    // the right input channel fades in together with its client
+    if ( IsRightInputChannel ( iChID ) )
+    {
+        return vecChannels[vecRightInputOwnerID[iChID]].GetFadeInGain();
+    }
+
+    return vecChannels[iChID].GetFadeInGain();
+}
+
 void CServer::InitChannel ( const int iNewChanID, const CHostAddress& InetAddr )
 {
     // initialize new channel by storing the calling host address
@@ -1358,18 +1798,156 @@ void CServer::InitChannel ( const int iNewChanID, const CHostAddress& InetAddr )
     // reset channel info
     vecChannels[iNewChanID].ResetInfo();
 
-    // reset the channel gains/pans of current channel, at the same
-    // time reset gains/pans of this channel ID for all other channels
+    // a new client must opt in to listener mix recording again
+    vecbListenerMixRecording[iNewChanID] = false;
+
+    // reset the channel gains/pans of current channel
+    vecChannels[iNewChanID].ResetGainsPans();
+
+    // reset gains/pans of this channel ID for all other connected channels (a
+    // channel which is not connected resets all its gains/pans when it is
+    // initialized itself)
     for ( int i = 0; i < iMaxNumChannels; i++ )
     {
-        vecChannels[iNewChanID].SetGain ( i, 1.0 );
-        vecChannels[iNewChanID].SetPan ( i, 0.5 );
+        if ( ( i != iNewChanID ) && vecChannels[i].IsConnected() )
+        {
+            vecChannels[i].SetGain ( iNewChanID, 1.0 );
+            vecChannels[i].SetPan ( iNewChanID, 0.5 );
+        }
+    }
+}
 
-        // other channels (we do not distinguish the case if
-        // i == iCurChanID for simplicity)
-        vecChannels[i].SetGain ( iNewChanID, 1.0 );
-        vecChannels[i].SetPan ( iNewChanID, 0.5 );
+bool CServer::IsFreeChannelReady()
+{
+    // called with the mutex locked, so no channel is allocated in the meantime
+    QMutexLocker locker ( &MutexChanOrder );
+
+    // if the server is full, FindChannel() reports it
+    if ( ( iCurNumChannels >= iMaxNumChannels ) || ( OpusMode[vecChannelOrder[iCurNumChannels]] != nullptr ) )
+    {
+        return true;
     }
+
+    locker.unlock();
+    RequestFreeChannelCodecs();
+
+    return false;
+}
+
+void CServer::RequestFreeChannelCodecs()
+{
+    // the codecs are created in the connection less worker thread, so that neither
+    // the mutex nor the thread of the audio processing is held up by it
+    if ( !bFreeChanCodecsRequested.exchange ( true ) )
+    {
+        QMetaObject::invokeMethod ( &ConnLessProtocol, [this]() { PrepareFreeChannels(); }, Qt::QueuedConnection );
+    }
+}
+
+void CServer::PrepareFreeChannels()
+{
+    // requests which arrive from now on are handled by another call
+    bFreeChanCodecsRequested = false;
+
+    for ( int i = 0; i < NUM_PREPARED_FREE_CHANNELS; i++ )
+    {
+        QMutexLocker locker ( &MutexChanOrder );
+
+        if ( iCurNumChannels + i >= iMaxNumChannels )
+        {
+            return;
+        }
+
+        const int iFreeChanID = vecChannelOrder[iCurNumChannels + i];
+
+        locker.unlock();
+        CreateChannelCodecs ( iFreeChanID );
+    }
+}
+
+void CServer::CreateChannelCodecs ( const int iChanID )
+{
+    // the codecs are created without MutexChanOrder since this takes a while, only
+    // one thread at a time creates codecs and a channel can only be allocated after
+    // its OpusMode is set at the end (see IsFreeChannelReady())
+    QMutexLocker locker ( &MutexCreateCodecs );
+
+    if ( OpusMode[iChanID] != nullptr )
+    {
+        return;
+    }
+
+    int iOpusError;
+
+    // create OPUS encoder/decoder for the channel (must be done before
+    // the channel is used), create a mono and stereo encoder/decoder
+    OpusCustomMode* pNewOpusMode = opus_custom_mode_create ( SYSTEM_SAMPLE_RATE_HZ, DOUBLE_SYSTEM_FRAME_SIZE_SAMPLES, &iOpusError );
+
+    Opus64Mode[iChanID] = opus_custom_mode_create ( SYSTEM_SAMPLE_RATE_HZ, SYSTEM_FRAME_SIZE_SAMPLES, &iOpusError );
+
+    // init audio encoders and decoders
+    OpusEncoderMono[iChanID]     = opus_custom_encoder_create ( pNewOpusMode, 1, &iOpusError );   // mono encoder legacy
+    OpusDecoderMono[iChanID]     = opus_custom_decoder_create ( pNewOpusMode, 1, &iOpusError );   // mono decoder legacy
+    OpusEncoderStereo[iChanID]   = opus_custom_encoder_create ( pNewOpusMode, 2, &iOpusError );   // stereo encoder legacy
+    OpusDecoderStereo[iChanID]   = opus_custom_decoder_create ( pNewOpusMode, 2, &iOpusError );   // stereo decoder legacy
+    Opus64EncoderMono[iChanID]   = opus_custom_encoder_create ( Opus64Mode[iChanID], 1, &iOpusError ); // mono encoder OPUS64
+    Opus64DecoderMono[iChanID]   = opus_custom_decoder_create ( Opus64Mode[iChanID], 1, &iOpusError ); // mono decoder OPUS64
+    Opus64EncoderStereo[iChanID] = opus_custom_encoder_create ( Opus64Mode[iChanID], 2, &iOpusError ); // stereo encoder OPUS64
+    Opus64DecoderStereo[iChanID] = opus_custom_decoder_create ( Opus64Mode[iChanID], 2, &iOpusError ); // stereo decoder OPUS64
+
+    // init audio encoders for the redundant frames
+    OpusRedEncoderMono[iChanID]     = opus_custom_encoder_create ( pNewOpusMode, 1, &iOpusError );
+    OpusRedEncoderStereo[iChanID]   = opus_custom_encoder_create ( pNewOpusMode, 2, &iOpusError );
+    Opus64RedEncoderMono[iChanID]   = opus_custom_encoder_create ( Opus64Mode[iChanID], 1, &iOpusError );
+    Opus64RedEncoderStereo[iChanID] = opus_custom_encoder_create ( Opus64Mode[iChanID], 2, &iOpusError );
+
+    // we require a constant bit rate
+    opus_custom_encoder_ctl ( OpusEncoderMono[iChanID], OPUS_SET_VBR ( 0 ) );
+    opus_custom_encoder_ctl ( OpusEncoderStereo[iChanID], OPUS_SET_VBR ( 0 ) );
+    opus_custom_encoder_ctl ( Opus64EncoderMono[iChanID], OPUS_SET_VBR ( 0 ) );
+    opus_custom_encoder_ctl ( Opus64EncoderStereo[iChanID], OPUS_SET_VBR ( 0 ) );
+    opus_custom_encoder_ctl ( OpusRedEncoderMono[iChanID], OPUS_SET_VBR ( 0 ) );
+    opus_custom_encoder_ctl ( OpusRedEncoderStereo[iChanID], OPUS_SET_VBR ( 0 ) );
+    opus_custom_encoder_ctl ( Opus64RedEncoderMono[iChanID], OPUS_SET_VBR ( 0 ) );
+    opus_custom_encoder_ctl ( Opus64RedEncoderStereo[iChanID], OPUS_SET_VBR ( 0 ) );
+
+    // for 64 samples frame size we have to adjust the PLC behavior to avoid loud artifacts
+    opus_custom_encoder_ctl ( Opus64EncoderMono[iChanID], OPUS_SET_PACKET_LOSS_PERC ( 35 ) );
+    opus_custom_encoder_ctl ( Opus64EncoderStereo[iChanID], OPUS_SET_PACKET_LOSS_PERC ( 35 ) );
+
+    // we want as low delay as possible
+    opus_custom_encoder_ctl ( OpusEncoderMono[iChanID], OPUS_SET_APPLICATION ( OPUS_APPLICATION_RESTRICTED_LOWDELAY ) );
+    opus_custom_encoder_ctl ( OpusEncoderStereo[iChanID], OPUS_SET_APPLICATION ( OPUS_APPLICATION_RESTRICTED_LOWDELAY ) );
+    opus_custom_encoder_ctl ( Opus64EncoderMono[iChanID], OPUS_SET_APPLICATION ( OPUS_APPLICATION_RESTRICTED_LOWDELAY ) );
+    opus_custom_encoder_ctl ( Opus64EncoderStereo[iChanID], OPUS_SET_APPLICATION ( OPUS_APPLICATION_RESTRICTED_LOWDELAY ) );
+    opus_custom_encoder_ctl ( OpusRedEncoderMono[iChanID], OPUS_SET_APPLICATION ( OPUS_APPLICATION_RESTRICTED_LOWDELAY ) );
+    opus_custom_encoder_ctl ( OpusRedEncoderStereo[iChanID], OPUS_SET_APPLICATION ( OPUS_APPLICATION_RESTRICTED_LOWDELAY ) );
+    opus_custom_encoder_ctl ( Opus64RedEncoderMono[iChanID], OPUS_SET_APPLICATION ( OPUS_APPLICATION_RESTRICTED_LOWDELAY ) );
+    opus_custom_encoder_ctl ( Opus64RedEncoderStereo[iChanID], OPUS_SET_APPLICATION ( OPUS_APPLICATION_RESTRICTED_LOWDELAY ) );
+
+    // the redundant frames replace a lost frame, so they must not depend on the
+    // previous frame of the redundant stream which is not decoded by the receiver
+    opus_custom_encoder_ctl ( OpusRedEncoderMono[iChanID], CELT_SET_PREDICTION_REQUEST, 0 );
+    opus_custom_encoder_ctl ( OpusRedEncoderStereo[iChanID], CELT_SET_PREDICTION_REQUEST, 0 );
+    opus_custom_encoder_ctl ( Opus64RedEncoderMono[iChanID], CELT_SET_PREDICTION_REQUEST, 0 );
+    opus_custom_encoder_ctl ( Opus64RedEncoderStereo[iChanID], CELT_SET_PREDICTION_REQUEST, 0 );
+
+    // set encoder low complexity for legacy 128 samples frame size
+    opus_custom_encoder_ctl ( OpusEncoderMono[iChanID], OPUS_SET_COMPLEXITY ( 1 ) );
+    opus_custom_encoder_ctl ( OpusEncoderStereo[iChanID], OPUS_SET_COMPLEXITY ( 1 ) );
+    opus_custom_encoder_ctl ( OpusRedEncoderMono[iChanID], OPUS_SET_COMPLEXITY ( 1 ) );
+    opus_custom_encoder_ctl ( OpusRedEncoderStereo[iChanID], OPUS_SET_COMPLEXITY ( 1 ) );
+
+    // init double-to-normal frame size conversion buffers -----------------
+    // use worst case memory initialization to avoid allocating memory in
+    // the time-critical thread
+    DoubleFrameSizeConvBufIn[iChanID].Init ( 2 /* stereo */ * DOUBLE_SYSTEM_FRAME_SIZE_SAMPLES /* worst case buffer size */ );
+    DoubleFrameSizeConvBufOut[iChanID].Init ( 2 /* stereo */ * DOUBLE_SYSTEM_FRAME_SIZE_SAMPLES /* worst case buffer size */ );
+
+    // the channel can be allocated from now on
+    QMutexLocker chanOrderLocker ( &MutexChanOrder );
+
+    OpusMode[iChanID] = pNewOpusMode;
 }
 
 // CServer::FreeChannel() is called to remove a channel from the list of active channels.
@@ -1424,10 +2002,15 @@ void CServer::DumpChannels ( const QString& title )
 
 void CServer::OnProtocolCLMessageReceived ( int iRecID, CVector<uint8_t> vecbyMesBodyData, CHostAddress RecHostAddr )
 {
-    QMutexLocker locker ( &Mutex );
-
-    // connection less messages are always processed
-    ConnLessProtocol.ParseConnectionLessMessageBody ( vecbyMesBodyData, iRecID, RecHostAddr );
+    // connection less messages are always processed, this is done in the
+    // connection less worker thread so that neither the thread of the socket
+    // nor the server mutex is held up by directory traffic
+    QMetaObject::invokeMethod (
+        &ConnLessProtocol,
+        [this, iRecID, vecbyMesBodyData, RecHostAddr]() {
+            ConnLessProtocol.ParseConnectionLessMessageBody ( vecbyMesBodyData, iRecID, RecHostAddr );
+        },
+        Qt::QueuedConnection );
 }
 
 void CServer::OnProtocolMessageReceived ( int iRecCounter, int iRecID, CVector<uint8_t> vecbyMesBodyData, CHostAddress RecHostAddr )
@@ -1444,15 +2027,33 @@ void CServer::OnProtocolMessageReceived ( int iRecCounter, int iRecID, CVector<u
     }
 }
 
-bool CServer::PutAudioData ( const CVector<uint8_t>& vecbyRecBuf, const int iNumBytesRead, const CHostAddress& HostAdr, int& iCurChanID )
+bool CServer::PutAudioData ( const CVector<uint8_t>& vecbyRecBuf,
+                             const int               iNumBytesRead,
+                             const CHostAddress&     HostAdr,
+                             CAdmissionControl&      AdmissionControl,
+                             int&                    iCurChanID )
 {
     QMutexLocker locker ( &Mutex );
 
     bool bNewConnection = false; // init return value
 
     // Get channel ID ------------------------------------------------------
-    // check address
-    iCurChanID = FindChannel ( HostAdr, true /* allow new */ );
+    // check address, a new channel is only allocated if the admission control
+    // accepts a new connection from this source
+    iCurChanID = FindChannel ( HostAdr );
+
+    if ( iCurChanID == INVALID_CHANNEL_ID )
+    {
+        // until the audio codecs of the free channel are ready, the packets are
+        // dropped without using up the admission of the source
+        if ( !IsFreeChannelReady() || !AdmissionControl.AdmitNewConnection ( HostAdr ) )
+        {
+            iCurChanID = NOT_ADMITTED_CHANNEL_ID;
+            return false;
+        }
+
+        iCurChanID = FindChannel ( HostAdr, true /* allow new */ );
+    }
 
     // If channel is valid or new, put received audio data in jitter buffer ----------------------------
     if ( iCurChanID != INVALID_CHANNEL_ID )
@@ -1508,6 +2109,24 @@ void CServer::SetEnableRecording ( bool bNewEnableRecording )
     CreateAndSendRecorderStateForAllConChannels();
 }
 
+bool CServer::SetListenerMixRecording ( const int iChanNum, const bool bEnable )
+{
+    QMutexLocker locker ( &Mutex );
+
+    if ( ( iChanNum < 0 ) || ( iChanNum >= iMaxNumChannels ) || !vecChannels[iChanNum].IsConnected() )
+    {
+        return false;
+    }
+
+    vecbListenerMixRecording[iChanNum] = bEnable;
+
+    // the recorder finishes the listener file of this client (if any) on disable
+    // and drops the frames which were mixed before but arrive afterwards
+    emit ListenerMixRecordingChanged ( iChanNum, bEnable );
+
+    return true;
+}
+
 void CServer::SetWelcomeMessage ( const QString& strNWelcMess )
 {
     // we need a mutex to secure access
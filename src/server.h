@@ -28,7 +28,10 @@
 #include <QDateTime>
 #include <QHostAddress>
 #include <QFileInfo>
+#include <QSet>
+#include <QTimer>
 #include <algorithm>
+#include <atomic>
 #ifdef USE_OPUS_SHARED_LIB
 #    include "opus/opus_custom.h"
 #else
@@ -50,37 +53,19 @@
 // no valid channel number
 #define INVALID_CHANNEL_ID ( MAX_NUM_CHANNELS + 1 )
 
-/* Classes ********************************************************************/
-template<unsigned int slotId>
-class CServerSlots : public CServerSlots<slotId - 1>
-{
-public:
-    void OnSendProtMessCh ( CVector<uint8_t> mess ) { SendProtMessage ( slotId - 1, mess ); }
-    void OnReqConnClientsListCh() { CreateAndSendChanListForThisChan ( slotId - 1 ); }
-
-    void OnChatTextReceivedCh ( QString strChatText ) { CreateAndSendChatTextForAllConChannels ( slotId - 1, strChatText ); }
-
-    void OnMuteStateHasChangedCh ( int iChanID, bool bIsMuted ) { CreateOtherMuteStateChanged ( slotId - 1, iChanID, bIsMuted ); }
-
-    void OnServerAutoSockBufSizeChangeCh ( int iNNumFra ) { CreateAndSendJitBufMessage ( slotId - 1, iNNumFra ); }
-
-protected:
-    virtual void SendProtMessage ( int iChID, CVector<uint8_t> vecMessage ) = 0;
-
-    virtual void CreateAndSendChanListForThisChan ( const int iCurChanID ) = 0;
-
-    virtual void CreateAndSendChatTextForAllConChannels ( const int iCurChanID, const QString& strChatText ) = 0;
+// a new connection was not admitted by the admission control of the socket
+#define NOT_ADMITTED_CHANNEL_ID ( MAX_NUM_CHANNELS + 2 )
 
-    virtual void CreateOtherMuteStateChanged ( const int iCurChanID, const int iOtherChanID, const bool bIsMuted ) = 0;
+// requests for the connected clients list which arrive within this time are
+// answered together
+#define CONN_CLIENTS_LIST_COALESCE_TIME_MS 20 // ms
 
-    virtual void CreateAndSendJitBufMessage ( const int iCurChanID, const int iNNumFra ) = 0;
-};
-
-template<>
-class CServerSlots<0>
-{};
+// the audio codecs of this number of free channels are created in advance, so
+// that new channels can be allocated without creating codecs
+#define NUM_PREPARED_FREE_CHANNELS 4
 
-class CServer : public QObject, public CServerSlots<MAX_NUM_CHANNELS>
+/* Classes ********************************************************************/
+class CServer : public QObject
 {
     Q_OBJECT
 
@@ -110,9 +95,24 @@ public:
 
     void Start();
     void Stop();
-    bool IsRunning() { return HighPrecisionTimer.isActive(); }
+    bool IsRunning() { return bRoomMode ? bRoomIsRunning : HighPrecisionTimer.isActive(); }
+
+    // room mode: the frames are clocked and scheduled by a CRoomManager instead of our own timer
+    void SetRoomMode();
+
+    // frame processing phases (see OnTimer())
+    int         BeginFrame();
+    void        ScheduleDecodeBlocks ( const int iNumClients, CThreadPool* pPool, const int iNumThreads, CVector<std::future<void>>& vecFutures );
+    void        EndDecode ( const int iNumClients );
+    void        ScheduleMixEncodeBlocks ( const int iNumClients, CThreadPool* pPool, const int iNumThreads, CVector<std::future<void>>& vecFutures );
+    void        EndFrame ( const int iNumClients );
+    static void WaitForBlocks ( CVector<std::future<void>>& vecFutures );
 
-    bool PutAudioData ( const CVector<uint8_t>& vecbyRecBuf, const int iNumBytesRead, const CHostAddress& HostAdr, int& iCurChanID );
+    bool PutAudioData ( const CVector<uint8_t>& vecbyRecBuf,
+                        const int               iNumBytesRead,
+                        const CHostAddress&     HostAdr,
+                        CAdmissionControl&      AdmissionControl,
+                        int&                    iCurChanID );
 
     int GetNumberOfConnectedClients();
 
@@ -127,6 +127,8 @@ public:
     // IPv6 Enabled
     bool IsIPv6Enabled() { return bEnableIPv6; }
 
+    const CAdmissionControl& GetAdmissionControl() const { return Socket.GetAdmissionControl(); }
+
     // GUI settings ------------------------------------------------------------
     int GetClientNumAudioChannels ( const int iChanNum ) { return vecChannels[iChanNum].GetNumAudioChannels(); }
 
@@ -153,6 +155,7 @@ public:
         JamController.SetRecordingDir ( newRecordingDir, iServerFrameSizeSamples, bDisableRecording );
     }
     QString GetRecordingDir() { return JamController.GetRecordingDir(); }
+    QString GetRecordingSessionDir() { return JamController.GetRecordingSessionDir(); }
 
     void    SetWelcomeMessage ( const QString& strNWelcMess );
     QString GetWelcomeMessage() { return strWelcomeMessage; }
@@ -166,6 +169,9 @@ public:
     void SetAutoRunMinimized ( const bool NAuRuMin ) { bAutoRunMinimized = NAuRuMin; }
     bool GetAutoRunMinimized() { return bAutoRunMinimized; }
 
+    bool SetListenerMixRecording ( const int iChanNum, const bool bEnable );
+    bool GetListenerMixRecording ( const int iChanNum ) { return vecbListenerMixRecording[iChanNum]; }
+
     void SetEnableDelayPanning ( bool bDelayPanningOn ) { bDelayPan = bDelayPanningOn; }
     bool IsDelayPanningEnabled() { return bDelayPan; }
 
@@ -179,6 +185,14 @@ protected:
     void                  DumpChannels ( const QString& title );
     CVector<CChannelInfo> CreateChannelList();
 
+    // the right input of a client with separately coded inputs is mixed in an
+    // additional channel which has no address and is not connected itself
+    int   AllocRightInputChannel();
+    void  UpdateRightInputChannels();
+    void  UpdateRightInputChanInfo ( const int iChID );
+    bool  IsRightInputChannel ( const int iChID ) const { return vecRightInputOwnerID[iChID] != INVALID_CHANNEL_ID; }
+    float GetFadeInGain ( const int iChID );
+
     virtual void CreateAndSendChanListForAllConChannels();
     virtual void CreateAndSendChanListForThisChan ( const int iCurChanID );
 
@@ -190,19 +204,37 @@ protected:
 
     virtual void SendProtMessage ( int iChID, CVector<uint8_t> vecMessage );
 
-    template<unsigned int slotId>
-    inline void connectChannelSignalsToServerSlots();
+    void ConnectChannelSignals ( const int iChID );
+
+    void CreateChannelCodecs ( const int iChanID );
+    void RequestFreeChannelCodecs();
+    void PrepareFreeChannels();
+    bool IsFreeChannelReady();
 
     void WriteHTMLChannelList();
     void WriteHTMLServerQuit();
 
-    static void DecodeReceiveDataBlocks ( CServer* pServer, const int iStartChanCnt, const int iStopChanCnt, const int iNumClients );
+    static void DecodeReceiveDataBlocks ( CServer*  pServer,
+                                          const int iBlockCnt,
+                                          const int iStartChanCnt,
+                                          const int iStopChanCnt,
+                                          const int iNumClients );
+
+    static void MixEncodeTransmitDataBlocks ( CServer*  pServer,
+                                              const int iBlockCnt,
+                                              const int iStartChanCnt,
+                                              const int iStopChanCnt,
+                                              const int iNumClients );
 
-    static void MixEncodeTransmitDataBlocks ( CServer* pServer, const int iStartChanCnt, const int iStopChanCnt, const int iNumClients );
+    void ScheduleBlocks ( void ( *pBlockFunc ) ( CServer*, const int, const int, const int, const int ),
+                          const int                   iNumClients,
+                          CThreadPool*                pPool,
+                          const int                   iNumThreads,
+                          CVector<std::future<void>>& vecFutures );
 
     void DecodeReceiveData ( const int iChanCnt, const int iNumClients );
 
-    void MixEncodeTransmitData ( const int iChanCnt, const int iNumClients );
+    void MixEncodeTransmitData ( const int iChanCnt, const int iNumClients, const int iMixRow );
 
     virtual void customEvent ( QEvent* pEvent );
 
@@ -223,47 +255,80 @@ protected:
                                          CVector<uint16_t>&              vecLevelsOut );
 
     // do not use the vector class since CChannel does not have appropriate
-    // copy constructor/operator
-    CChannel vecChannels[MAX_NUM_CHANNELS];
-    int      iMaxNumChannels;
-
-    int    iCurNumChannels;
-    int    vecChannelOrder[MAX_NUM_CHANNELS];
-    QMutex MutexChanOrder;
-
+    // copy constructor/operator (the table is sized by the configured number
+    // of channels rather than MAX_NUM_CHANNELS)
+    std::unique_ptr<CChannel[]> vecChannels;
+    int                         iMaxNumChannels;
+
+    // the number of channels is only changed with MutexChanOrder set, but it is
+    // read without the lock to answer pings in the socket thread (it includes the
+    // right input channels, which are no clients of their own and counted separately)
+    std::atomic<int>  iCurNumChannels;
+    std::atomic<int>  iNumRightInputChannels;
+    CVector<int>      vecChannelOrder;
+    QMutex            MutexChanOrder;
+    QMutex            MutexCreateCodecs;
+    std::atomic<bool> bFreeChanCodecsRequested; // see RequestFreeChannelCodecs()
+
+    // the connection less protocol and the server list manager live in their own
+    // thread so that directory traffic does not hold the server mutex
     CProtocol ConnLessProtocol;
+    QThread   ConnLessWorkerThread;
     QMutex    Mutex;
     QMutex    MutexWelcomeMessage;
     bool      bChannelIsNowDisconnected;
 
-    // audio encoder/decoder
-    OpusCustomMode*    Opus64Mode[MAX_NUM_CHANNELS];
-    OpusCustomEncoder* Opus64EncoderMono[MAX_NUM_CHANNELS];
-    OpusCustomDecoder* Opus64DecoderMono[MAX_NUM_CHANNELS];
-    OpusCustomEncoder* Opus64EncoderStereo[MAX_NUM_CHANNELS];
-    OpusCustomDecoder* Opus64DecoderStereo[MAX_NUM_CHANNELS];
-    OpusCustomMode*    OpusMode[MAX_NUM_CHANNELS];
-    OpusCustomEncoder* OpusEncoderMono[MAX_NUM_CHANNELS];
-    OpusCustomDecoder* OpusDecoderMono[MAX_NUM_CHANNELS];
-    OpusCustomEncoder* OpusEncoderStereo[MAX_NUM_CHANNELS];
-    OpusCustomDecoder* OpusDecoderStereo[MAX_NUM_CHANNELS];
-    CConvBuf<int16_t>  DoubleFrameSizeConvBufIn[MAX_NUM_CHANNELS];
-    CConvBuf<int16_t>  DoubleFrameSizeConvBufOut[MAX_NUM_CHANNELS];
+    // the connected clients list message for connection less requests is only
+    // generated again if the channel list has changed (the version is bumped in
+    // the main thread, the other members are only used in the worker thread)
+    std::atomic<int>   iChanListVersion;
+    int                iConnClientsListMesVersion;
+    CVector<uint8_t>   vecConnClientsListMes;
+    QSet<CHostAddress> setConnClientsListReqAddr;
+    QTimer             TimerConnClientsListReq;
+
+    // audio encoder/decoder (created in advance of the use of a channel, see PrepareFreeChannels(),
+    // OpusMode is only changed with MutexCreateCodecs and MutexChanOrder set)
+    CVector<OpusCustomMode*>    Opus64Mode;
+    CVector<OpusCustomEncoder*> Opus64EncoderMono;
+    CVector<OpusCustomDecoder*> Opus64DecoderMono;
+    CVector<OpusCustomEncoder*> Opus64EncoderStereo;
+    CVector<OpusCustomDecoder*> Opus64DecoderStereo;
+    CVector<OpusCustomMode*>    OpusMode;
+    CVector<OpusCustomEncoder*> OpusEncoderMono;
+    CVector<OpusCustomDecoder*> OpusDecoderMono;
+    CVector<OpusCustomEncoder*> OpusEncoderStereo;
+    CVector<OpusCustomDecoder*> OpusDecoderStereo;
+    CVector<OpusCustomEncoder*> Opus64RedEncoderMono; // intra frame encoders for the redundant frames
+    CVector<OpusCustomEncoder*> Opus64RedEncoderStereo;
+    CVector<OpusCustomEncoder*> OpusRedEncoderMono;
+    CVector<OpusCustomEncoder*> OpusRedEncoderStereo;
+    CVector<CConvBuf<int16_t>>  DoubleFrameSizeConvBufIn;
+    CVector<CConvBuf<int16_t>>  DoubleFrameSizeConvBufOut;
 
     CVector<QString> vstrChatColors;
     CVector<int>     vecChanIDsCurConChan;
 
+    // right input channels of separately coded inputs (indexed by channel ID)
+    CVector<int> vecRightInputChanID;
+    CVector<int> vecRightInputOwnerID;
+
+    // gains and pans of the mix which is currently processed by a block (the
+    // first index is the block, the second index is the connected channel)
     CVector<CVector<float>>   vecvecfGains;
     CVector<CVector<float>>   vecvecfPannings;
     CVector<CVector<int16_t>> vecvecsData;
     CVector<CVector<int16_t>> vecvecsData2;
     CVector<int>              vecNumAudioChannels;
+    CVector<int>              vecNumMixAudioChannels;
+    CVector<int>              vecRightInputChanCnt;
     CVector<int>              vecNumFrameSizeConvBlocks;
     CVector<int>              vecUseDoubleSysFraSizeConvBuf;
     CVector<EAudComprType>    vecAudioComprType;
     CVector<CVector<int16_t>> vecvecsSendData;
     CVector<CVector<float>>   vecvecfIntermediateProcBuf;
     CVector<CVector<uint8_t>> vecvecbyCodedData;
+    CVector<CVector<uint8_t>> vecvecbyRedCodedData;
 
     // Channel levels
     CVector<uint16_t> vecChannelLevels;
@@ -282,6 +347,8 @@ protected:
     QString strServerHTMLFileListName;
 
     CHighPrecisionTimer HighPrecisionTimer;
+    bool                bRoomMode;
+    bool                bRoomIsRunning;
 
     // server list
     CServerListManager ServerListManager;
@@ -290,6 +357,10 @@ protected:
     recorder::CJamController JamController;
     bool                     bDisableRecording;
 
+    // channels for which the mix sent to the client is recorded as well (the flags
+    // are set under the server mutex but read by the mixer threads without it)
+    std::unique_ptr<std::atomic<bool>[]> vecbListenerMixRecording;
+
     // GUI settings
     bool bAutoRunMinimized;
 
@@ -318,6 +389,12 @@ signals:
                       const CHostAddress     RecHostAddr,
                       const int              iNumAudChan,
                       const CVector<int16_t> vecsData );
+    void ListenerAudioFrame ( const int              iChID,
+                              const QString          stChName,
+                              const CHostAddress     RecHostAddr,
+                              const int              iNumAudChan,
+                              const CVector<int16_t> vecsData );
+    void ListenerMixRecordingChanged ( int iChID, bool bEnable );
 
     void CLVersionAndOSReceived ( CHostAddress InetAddr, COSUtil::EOpSystemType eOSType, QString strVersion );
 
@@ -340,13 +417,6 @@ public slots:
 
     void OnProtocolMessageReceived ( int iRecCounter, int iRecID, CVector<uint8_t> vecbyMesBodyData, CHostAddress RecHostAddr );
 
-    void OnCLPingReceived ( CHostAddress InetAddr, int iMs ) { ConnLessProtocol.CreateCLPingMes ( InetAddr, iMs ); }
-
-    void OnCLPingWithNumClientsReceived ( CHostAddress InetAddr, int iMs, int )
-    {
-        ConnLessProtocol.CreateCLPingWithNumClientsMes ( InetAddr, iMs, GetNumberOfConnectedClients() );
-    }
-
     void OnCLSendEmptyMes ( CHostAddress TargetInetAddr )
     {
         // only send empty message if not a directory
@@ -356,11 +426,33 @@ public slots:
         }
     }
 
+    void OnCLSendEmptyMesMulti ( CHostAddress InetAddr, CVector<CHostAddress> vecTargetInetAddr )
+    {
+        // one request makes us send a datagram to each target, so only accept
+        // it from the directory we are registered with (no reflection via spoofed requests)
+        if ( !ServerListManager.IsDirectory() && ServerListManager.IsRegisteredDirectory ( InetAddr ) )
+        {
+            for ( int i = 0; i < vecTargetInetAddr.Size(); i++ )
+            {
+                ConnLessProtocol.CreateCLEmptyMes ( vecTargetInetAddr[i] );
+            }
+        }
+    }
+
     void OnCLReqServerList ( CHostAddress InetAddr ) { ServerListManager.RetrieveAll ( InetAddr ); }
 
+    void OnCLReqServerListPage ( CHostAddress InetAddr, int iVersion, int iPage ) { ServerListManager.RetrievePage ( InetAddr, iVersion, iPage ); }
+
+    void OnCLSubscribeServerList ( CHostAddress InetAddr, int iVersion, int iToken, bool bSubscribe )
+    {
+        ServerListManager.Subscribe ( InetAddr, iVersion, iToken, bSubscribe );
+    }
+
     void OnCLReqVersionAndOS ( CHostAddress InetAddr ) { ConnLessProtocol.CreateCLVersionAndOSMes ( InetAddr ); }
 
-    void OnCLReqConnClientsList ( CHostAddress InetAddr ) { ConnLessProtocol.CreateCLConnClientsListMes ( InetAddr, CreateChannelList() ); }
+    void OnCLReqConnClientsList ( CHostAddress InetAddr );
+
+    void OnTimerConnClientsListReq();
 
     void OnCLRegisterServerReceived ( CHostAddress InetAddr, CHostAddress LInetAddr, CServerCoreInfo ServerInfo )
     {
@@ -378,8 +470,12 @@ public slots:
 
     void OnCLRegisterServerResp ( CHostAddress /* unused */, ESvrRegResult eResult ) { ServerListManager.StoreRegistrationResult ( eResult ); }
 
+    void OnCLServerFeaturesReceived ( CHostAddress InetAddr, int iFeatures ) { ServerListManager.SetServerFeatures ( InetAddr, iFeatures ); }
+
     void OnCLUnregisterServerReceived ( CHostAddress InetAddr ) { ServerListManager.Remove ( InetAddr ); }
 
+    void OnRegisteredDirectoryChanged ( CHostAddress InetAddr ) { Socket.SetAdmissionExemptAddress ( InetAddr ); }
+
     void OnCLDisconnection ( CHostAddress InetAddr );
 
     void OnAboutToQuit();
@@ -132,6 +132,11 @@ CServerListManager::CServerListManager ( const quint16  iNPortNum,
     DirectoryType ( AT_NONE ),
     bEnableIPv6 ( bNEnableIPv6 ),
     ServerListFileName ( strServerListFileName ),
+    iNumJournalRecords ( 0 ),
+    iExpiryWheelPos ( 0 ),
+    iServerListVersion ( 0 ),
+    iServerListCacheVersion ( -1 ),
+    iServerListChangesBase ( 0 ),
     strDirectoryAddress ( "" ),
     bIsDirectory ( false ),
     eSvrRegStatus ( SRS_NOT_REGISTERED ),
@@ -241,6 +246,17 @@ CServerListManager::CServerListManager ( const quint16  iNPortNum,
     // per definition, the first entry in the server list is the own server
     ServerList.append ( ThisServerListEntry );
 
+    // one slot per poll interval of the time-out plus the slot currently filled
+    vecExpiryWheel.Init ( SERVLIST_TIME_OUT_MINUTES / SERVLIST_POLL_TIME_MINUTES + 1 );
+
+    // the subscription tokens must not be predictable, so the key is random
+    for ( int i = 0; i < 4; i++ )
+    {
+        const quint32 iRandom = QRandomGenerator::system()->generate();
+
+        baSubscriptionKey.append ( reinterpret_cast<const char*> ( &iRandom ), sizeof ( iRandom ) );
+    }
+
     // set the directory address - not the type, that gets done by app start up
     SetDirectoryAddress ( sNDirectoryAddress );
 
@@ -292,6 +308,18 @@ CServerListManager::CServerListManager ( const quint16  iNPortNum,
     TimerCLRegisterServerResp.setSingleShot ( true );
     TimerCLRegisterServerResp.setInterval ( REGISTER_SERVER_TIME_OUT_MS );
 
+    // prepare the timer for sending the collected hole punch requests
+    TimerHolePunch.setInterval ( SERVLIST_HOLE_PUNCH_INTERVAL_MS );
+
+    // prepare the timer for sending the changes of the server list to the subscribers
+    TimerServerListSubscribers.setInterval ( SERVLIST_SUBSCRIPTION_PUSH_INTERVAL_MS );
+
+    // the version of the server list starts at a different value on each start, so
+    // that subscribers cannot take the version of a list of a previous run of the
+    // directory for a version of the current list
+    iServerListVersion     = static_cast<int> ( QDateTime::currentSecsSinceEpoch() & 0x3FFFFFFF );
+    iServerListChangesBase = iServerListVersion;
+
     // Connections -------------------------------------------------------------
     QObject::connect ( &TimerPollList, &QTimer::timeout, this, &CServerListManager::OnTimerPollList );
 
@@ -305,7 +333,31 @@ CServerListManager::CServerListManager ( const quint16  iNPortNum,
 
     QObject::connect ( &TimerIsPermanent, &QTimer::timeout, this, &CServerListManager::OnTimerIsPermanent );
 
-    QObject::connect ( QCoreApplication::instance(), &QCoreApplication::aboutToQuit, this, &CServerListManager::OnAboutToQuit );
+    QObject::connect ( &TimerHolePunch, &QTimer::timeout, this, &CServerListManager::OnTimerHolePunch );
+
+    QObject::connect ( &TimerServerListSubscribers, &QTimer::timeout, this, &CServerListManager::OnTimerServerListSubscribers );
+
+    // note that this object may live in another thread than the application (see
+    // OnAboutToQuit())
+    QObject::connect ( QCoreApplication::instance(),
+                       &QCoreApplication::aboutToQuit,
+                       this,
+                       &CServerListManager::OnAboutToQuit,
+                       Qt::DirectConnection );
+}
+
+void CServerListManager::MoveToThread ( QThread* pThread )
+{
+    // the timers are no children of this object, so they have to be moved, too
+    moveToThread ( pThread );
+    TimerPollList.moveToThread ( pThread );
+    TimerPingServerInList.moveToThread ( pThread );
+    TimerPingServers.moveToThread ( pThread );
+    TimerRefreshRegistration.moveToThread ( pThread );
+    TimerCLRegisterServerResp.moveToThread ( pThread );
+    TimerIsPermanent.moveToThread ( pThread );
+    TimerHolePunch.moveToThread ( pThread );
+    TimerServerListSubscribers.moveToThread ( pThread );
 }
 
 // set server infos -> per definition the server info of this server is
@@ -314,33 +366,91 @@ CServerListManager::CServerListManager ( const quint16  iNPortNum,
 // and, if registered, refresh the server list entry
 void CServerListManager::SetServerName ( const QString& strNewName )
 {
+    // the server list is only changed in the thread of this object
+    if ( QThread::currentThread() != thread() )
+    {
+        QMetaObject::invokeMethod ( this, [this, strNewName]() { SetServerName ( strNewName ); }, Qt::BlockingQueuedConnection );
+        return;
+    }
+
+    QMutexLocker locker ( &Mutex );
+
     if ( ServerList[0].strName != strNewName )
     {
         ServerList[0].strName = strNewName;
-        SetRegistered ( eSvrRegStatus != SRS_NOT_REGISTERED );
+        InvalidateServerListCache();
+
+        const bool bIsRegistered = ( eSvrRegStatus != SRS_NOT_REGISTERED );
+
+        locker.unlock();
+
+        // sets the lock
+        SetRegistered ( bIsRegistered );
     }
 }
 
 void CServerListManager::SetServerCity ( const QString& strNewCity )
 {
+    // the server list is only changed in the thread of this object
+    if ( QThread::currentThread() != thread() )
+    {
+        QMetaObject::invokeMethod ( this, [this, strNewCity]() { SetServerCity ( strNewCity ); }, Qt::BlockingQueuedConnection );
+        return;
+    }
+
+    QMutexLocker locker ( &Mutex );
+
     if ( ServerList[0].strCity != strNewCity )
     {
         ServerList[0].strCity = strNewCity;
-        SetRegistered ( eSvrRegStatus != SRS_NOT_REGISTERED );
+        InvalidateServerListCache();
+
+        const bool bIsRegistered = ( eSvrRegStatus != SRS_NOT_REGISTERED );
+
+        locker.unlock();
+
+        // sets the lock
+        SetRegistered ( bIsRegistered );
     }
 }
 
 void CServerListManager::SetServerCountry ( const QLocale::Country eNewCountry )
 {
+    // the server list is only changed in the thread of this object
+    if ( QThread::currentThread() != thread() )
+    {
+        QMetaObject::invokeMethod ( this, [this, eNewCountry]() { SetServerCountry ( eNewCountry ); }, Qt::BlockingQueuedConnection );
+        return;
+    }
+
+    QMutexLocker locker ( &Mutex );
+
     if ( ServerList[0].eCountry != eNewCountry )
     {
         ServerList[0].eCountry = eNewCountry;
-        SetRegistered ( eSvrRegStatus != SRS_NOT_REGISTERED );
+        InvalidateServerListCache();
+
+        const bool bIsRegistered = ( eSvrRegStatus != SRS_NOT_REGISTERED );
+
+        locker.unlock();
+
+        // sets the lock
+        SetRegistered ( bIsRegistered );
     }
 }
 
 void CServerListManager::SetDirectoryAddress ( const QString sNDirectoryAddress )
 {
+    // the timers can only be started and stopped in the thread of this object
+    if ( QThread::currentThread() != thread() )
+    {
+        QMetaObject::invokeMethod (
+            this,
+            [this, sNDirectoryAddress]() { SetDirectoryAddress ( sNDirectoryAddress ); },
+            Qt::BlockingQueuedConnection );
+        return;
+    }
+
     // if the address has not actually changed, do nothing
     if ( sNDirectoryAddress == strDirectoryAddress )
     {
@@ -372,6 +482,13 @@ void CServerListManager::SetDirectoryAddress ( const QString sNDirectoryAddress
 
 void CServerListManager::SetDirectoryType ( const EDirectoryType eNCSAT )
 {
+    // the timers can only be started and stopped in the thread of this object
+    if ( QThread::currentThread() != thread() )
+    {
+        QMetaObject::invokeMethod ( this, [this, eNCSAT]() { SetDirectoryType ( eNCSAT ); }, Qt::BlockingQueuedConnection );
+        return;
+    }
+
     // if the directory type is not changing, do nothing
     if ( eNCSAT == DirectoryType )
     {
@@ -451,6 +568,7 @@ void CServerListManager::Unregister()
         TimerIsPermanent.stop();
     }
     ServerList[0].bPermanentOnline = false;
+    InvalidateServerListCache();
 }
 
 // When we register, set the status and start timers
@@ -481,6 +599,7 @@ void CServerListManager::Register()
 
         // directory is permanent
         ServerList[0].bPermanentOnline = true;
+        InvalidateServerListCache();
     }
     else
     {
@@ -527,25 +646,36 @@ void CServerListManager::OnTimerPingServerInList()
 
 void CServerListManager::OnTimerPollList()
 {
-    CVector<CHostAddress> vecRemovedHostAddr;
-
     QMutexLocker locker ( &Mutex );
 
-    // Check all list entries are still valid (omitting the directory itself)
-    for ( int iIdx = ServerList.size() - 1; iIdx > 0; iIdx-- )
+    // move the wheel on by one poll interval: the servers in the new slot registered
+    // one full turn ago and have not refreshed their registration since (omitting the
+    // directory itself, which is not in the wheel)
+    iExpiryWheelPos = ( iExpiryWheelPos + 1 ) % vecExpiryWheel.Size();
+
+    const QSet<CHostAddress> setExpiredHostAddr = vecExpiryWheel[iExpiryWheelPos];
+    vecExpiryWheel[iExpiryWheelPos].clear();
+
+    foreach ( const CHostAddress& HostAddr, setExpiredHostAddr )
     {
-        // 1 minute = 60 * 1000 ms
-        if ( ServerList[iIdx].RegisterTime.elapsed() > ( SERVLIST_TIME_OUT_MINUTES * 60000 ) )
+        const int iIdx = IndexOf ( HostAddr );
+
+        if ( iIdx > 0 )
         {
-            // remove this list entry
-            vecRemovedHostAddr.Add ( ServerList[iIdx].HostAddr );
-            ServerList.removeAt ( iIdx );
+            RemoveAt ( iIdx );
         }
     }
 
+    // compact the journal of the persistent server list if it got too long
+    if ( iNumJournalRecords >= SERVLIST_JOURNAL_MAX_RECORDS )
+    {
+        qInfo() << qUtf8Printable ( QString ( "Compacting persistent server list journal (%1 records)" ).arg ( iNumJournalRecords ) );
+        Save ( false );
+    }
+
     locker.unlock();
 
-    foreach ( const CHostAddress HostAddr, vecRemovedHostAddr )
+    foreach ( const CHostAddress& HostAddr, setExpiredHostAddr )
     {
         qInfo() << qUtf8Printable ( QString ( "Expired entry for %1" ).arg ( HostAddr.toString() ) );
     }
@@ -610,10 +740,29 @@ void CServerListManager::Append ( const CHostAddress&    InetAddr,
                 // create a new server list entry and init with received data
                 ServerList.append ( CServerListEntry ( InetAddr, LInetAddr, ServerInfo ) );
                 iSelIdx = iCurServerListSize;
+                mapServerListIndex.insert ( InetAddr, iSelIdx );
+                ScheduleExpiry ( iSelIdx );
+                LogServerListChange ( ServerList[iSelIdx], false );
+                WriteJournalRecord ( JR_REGISTER, ServerList[iSelIdx] );
             }
         }
         else
         {
+            // registrations are refreshed regularly, usually without any change,
+            // so only invalidate the server list messages (and write the journal)
+            // if the entry really changed
+            const bool bEntryChanged =
+                !( ServerList[iSelIdx].LHostAddr == LInetAddr ) || ServerList[iSelIdx].strName != ServerInfo.strName ||
+                ServerList[iSelIdx].eCountry != ServerInfo.eCountry || ServerList[iSelIdx].strCity != ServerInfo.strCity ||
+                ServerList[iSelIdx].iMaxNumClients != ServerInfo.iMaxNumClients ||
+                ServerList[iSelIdx].bPermanentOnline != ServerInfo.bPermanentOnline;
+
+            // if the local address changes, the entry may be listed with another address
+            if ( !( ServerList[iSelIdx].LHostAddr == LInetAddr ) )
+            {
+                LogServerListChange ( ServerList[iSelIdx], true );
+            }
+
             // update all data and call update registration function
             ServerList[iSelIdx].LHostAddr        = LInetAddr;
             ServerList[iSelIdx].strName          = ServerInfo.strName;
@@ -623,6 +772,13 @@ void CServerListManager::Append ( const CHostAddress&    InetAddr,
             ServerList[iSelIdx].bPermanentOnline = ServerInfo.bPermanentOnline;
 
             ServerList[iSelIdx].UpdateRegistration();
+            ScheduleExpiry ( iSelIdx );
+
+            if ( bEntryChanged )
+            {
+                LogServerListChange ( ServerList[iSelIdx], false );
+                WriteJournalRecord ( JR_REGISTER, ServerList[iSelIdx] );
+            }
         }
 
         pConnLessProtocol->CreateCLRegisterServerResp ( InetAddr,
@@ -645,7 +801,7 @@ void CServerListManager::Remove ( const CHostAddress& InetAddr )
         int iIdx = IndexOf ( InetAddr );
         if ( iIdx > 0 )
         {
-            ServerList.removeAt ( iIdx );
+            RemoveAt ( iIdx );
         }
     }
 }
@@ -669,62 +825,421 @@ void CServerListManager::RetrieveAll ( const CHostAddress& InetAddr )
 
     if ( bIsDirectory )
     {
-        // if the client IP address is a private one, it's on the same LAN as the directory
-        bool clientIsInternal = NetworkUtil::IsPrivateNetworkIP ( InetAddr.InetAddr );
+        const CHostAddress clientPublicAddr = GetClientPublicAddr ( InetAddr );
+
+        // make sure the server list messages reflect the current list
+        UpdateServerListCache();
 
-        CHostAddress clientPublicAddr = InetAddr;
-        if ( clientIsInternal && CHostAddress().InetAddr != ServerList[0].LHostAddr.InetAddr &&
-             !NetworkUtil::IsPrivateNetworkIP ( ServerList[0].LHostAddr.InetAddr ) )
+        // only servers not local to the directory need a "ping"
+        for ( int iIdx = 0; iIdx < vecExtServerAddr.Size(); iIdx++ )
         {
-            // client and directory on same LAN, directory has public IP set, that should be suitable for the
-            // client, too (i.e. same router with same public IP will be used for both), so use it for client public IP
-            clientPublicAddr.InetAddr = ServerList[0].LHostAddr.InetAddr;
+            // queue "send empty message" for all other registered servers
+            // this causes the server (vecExtServerAddr[iIdx])
+            // to send a "reply" to the client (InetAddr or best guess public IP address if internal to directory)
+            // - with the intent of opening the server firewall for the client
+            QueueHolePunch ( vecExtServerAddr[iIdx], clientPublicAddr );
         }
 
-        const ushort iCurServerListSize = static_cast<ushort> ( ServerList.size() );
+        SServerListMes        ClientServerListMes;
+        const SServerListMes& ServerListMes = GetClientServerListMes ( InetAddr, ClientServerListMes );
 
-        // allocate memory for the entire list
-        CVector<CServerInfo> vecServerInfo ( iCurServerListSize );
-
-        // copy list item for the directory and just let the protocol sort out the actual details
-        vecServerInfo[0]          = ServerList[0];
-        vecServerInfo[0].HostAddr = CHostAddress();
+        // send the server list to the client, since we do not know that the client
+        // has a UDP fragmentation issue, we send both lists, the reduced and the
+        // normal list after each other
+        pConnLessProtocol->SendCLPreparedMes ( InetAddr, ServerListMes.vecRedMes );
+        pConnLessProtocol->SendCLPreparedMes ( InetAddr, ServerListMes.vecMes );
 
-        // copy the list (we have to copy it since the message requires a vector but the list is actually stored in a QList object
-        // and not in a vector object)
-        for ( int iIdx = 1; iIdx < iCurServerListSize; iIdx++ )
+        // these lists only contain the beginning of a long server list, clients which
+        // support paged server lists request the other pages after the first one
+        if ( ServerList.size() > MAX_NUM_SERVERS_IN_LEGACY_SERVER_LIST )
         {
-            // copy list item
-            CServerInfo& siCurListEntry = vecServerInfo[iIdx] = ServerList[iIdx];
+            pConnLessProtocol->SendCLPreparedMes ( InetAddr, ServerListMes.vecPageMes[0] );
+        }
 
-            bool serverIsInternal = NetworkUtil::IsPrivateNetworkIP ( siCurListEntry.HostAddr.InetAddr );
+        SendServerListVersion ( InetAddr );
+    }
+}
+
+void CServerListManager::RetrievePage ( const CHostAddress& InetAddr, const int iVersion, const int iPage )
+{
+    QMutexLocker locker ( &Mutex );
 
-            bool wantHostAddr = clientIsInternal /* HostAddr is local IP if local server else external IP, so do not replace */ ||
-                                ( !serverIsInternal &&
-                                  InetAddr.InetAddr != siCurListEntry.HostAddr.InetAddr /* external server and client have different public IPs */ );
+    if ( bIsDirectory )
+    {
+        // only the current version of the list is available, if the list has changed since
+        // iVersion, the client recognises this from the version of the page it receives
+        Q_UNUSED ( iVersion );
+
+        UpdateServerListCache();
+
+        SServerListMes        ClientServerListMes;
+        const SServerListMes& ServerListMes = GetClientServerListMes ( InetAddr, ClientServerListMes );
+
+        if ( ( iPage >= 0 ) && ( iPage < ServerListMes.vecPageMes.Size() ) )
+        {
+            pConnLessProtocol->SendCLPreparedMes ( InetAddr, ServerListMes.vecPageMes[iPage] );
 
-            if ( !wantHostAddr )
+            // the token may have got lost with the first page of the list
+            if ( iPage == 0 )
             {
-                vecServerInfo[iIdx].HostAddr = siCurListEntry.LHostAddr;
+                SendServerListVersion ( InetAddr );
             }
+        }
+    }
+}
+
+const CServerListManager::SServerListMes& CServerListManager::GetClientServerListMes ( const CHostAddress& InetAddr,
+                                                                                        SServerListMes&     ClientServerListMes )
+{
+    // Called with lock set and the server list messages up to date.
+
+    // if the client IP address is a private one, it's on the same LAN as the directory
+    if ( NetworkUtil::IsPrivateNetworkIP ( InetAddr.InetAddr ) )
+    {
+        return IntClientServerListMes;
+    }
+
+    if ( !setExtServerIP.contains ( InetAddr.InetAddr ) )
+    {
+        return ExtClientServerListMes;
+    }
+
+    // the client shares its public IP with a registered server, which therefore has to
+    // be listed with its local address - these messages are specific to the client
+    GetServerListMes ( ClientServerListMes, false, InetAddr.InetAddr );
+
+    return ClientServerListMes;
+}
 
-            // do not send a "ping" to a server local to the directory (no need)
-            if ( !serverIsInternal )
+void CServerListManager::GetServerListMes ( SServerListMes& ServerListMes, const bool bClientIsInternal, const QHostAddress& ClientInetAddr )
+{
+    // Called with lock set.
+
+    CVector<CServerInfo> vecServerInfo;
+
+    GetServerInfoList ( vecServerInfo, bClientIsInternal, ClientInetAddr );
+
+    // the complete list is available in pages
+    pConnLessProtocol->GenCLServerListPageMes ( ServerListMes.vecPageMes, vecServerInfo, iServerListVersion );
+
+    // only the beginning of the list fits into the (reduced) server list messages
+    if ( vecServerInfo.Size() > MAX_NUM_SERVERS_IN_LEGACY_SERVER_LIST )
+    {
+        vecServerInfo.resize ( MAX_NUM_SERVERS_IN_LEGACY_SERVER_LIST );
+    }
+
+    pConnLessProtocol->GenCLRedServerListMes ( ServerListMes.vecRedMes, vecServerInfo );
+    pConnLessProtocol->GenCLServerListMes ( ServerListMes.vecMes, vecServerInfo );
+}
+
+void CServerListManager::GetServerInfoList ( CVector<CServerInfo>& vecServerInfo, const bool bClientIsInternal, const QHostAddress& ClientInetAddr )
+{
+    // Called with lock set.
+
+    const int iCurServerListSize = ServerList.size();
+
+    // allocate memory for the entire list
+    vecServerInfo.Init ( iCurServerListSize );
+
+    // copy list item for the directory and just let the protocol sort out the actual details
+    vecServerInfo[0]          = ServerList[0];
+    vecServerInfo[0].HostAddr = CHostAddress();
+
+    // copy the list (we have to copy it since the message requires a vector but the list is actually stored in a QList object
+    // and not in a vector object)
+    for ( int iIdx = 1; iIdx < iCurServerListSize; iIdx++ )
+    {
+        // copy list item
+        vecServerInfo[iIdx] = ServerList[iIdx];
+
+        SelectListedHostAddr ( vecServerInfo[iIdx], bClientIsInternal, ClientInetAddr );
+    }
+}
+
+void CServerListManager::SelectListedHostAddr ( CServerInfo& ServerInfo, const bool bClientIsInternal, const QHostAddress& ClientInetAddr )
+{
+    bool serverIsInternal = NetworkUtil::IsPrivateNetworkIP ( ServerInfo.HostAddr.InetAddr );
+
+    bool wantHostAddr = bClientIsInternal /* HostAddr is local IP if local server else external IP, so do not replace */ ||
+                        ( !serverIsInternal &&
+                          ClientInetAddr != ServerInfo.HostAddr.InetAddr /* external server and client have different public IPs */ );
+
+    if ( !wantHostAddr )
+    {
+        ServerInfo.HostAddr = ServerInfo.LHostAddr;
+    }
+}
+
+CHostAddress CServerListManager::GetClientPublicAddr ( const CHostAddress& InetAddr )
+{
+    // Called with lock set.
+
+    // if the client IP address is a private one, it's on the same LAN as the directory
+    bool clientIsInternal = NetworkUtil::IsPrivateNetworkIP ( InetAddr.InetAddr );
+
+    CHostAddress clientPublicAddr = InetAddr;
+    if ( clientIsInternal && CHostAddress().InetAddr != ServerList[0].LHostAddr.InetAddr &&
+         !NetworkUtil::IsPrivateNetworkIP ( ServerList[0].LHostAddr.InetAddr ) )
+    {
+        // client and directory on same LAN, directory has public IP set, that should be suitable for the
+        // client, too (i.e. same router with same public IP will be used for both), so use it for client public IP
+        clientPublicAddr.InetAddr = ServerList[0].LHostAddr.InetAddr;
+    }
+
+    return clientPublicAddr;
+}
+
+void CServerListManager::InvalidateServerListCache()
+{
+    // A change which is not logged (e.g., of the entry of the directory itself or
+    // of the complete list) cannot be sent as a diff, so the subscribers have to
+    // request the complete list again.
+    iServerListVersion++;
+
+    lstServerListChanges.clear();
+    iServerListChangesBase = iServerListVersion;
+}
+
+void CServerListManager::LogServerListChange ( const CServerInfo& ServerInfo, const bool bRemoved )
+{
+    // Called with lock set.
+
+    iServerListVersion++;
+
+    SServerListChange Change;
+    Change.iVersion   = iServerListVersion;
+    Change.bRemoved   = bRemoved;
+    Change.ServerInfo = ServerInfo;
+
+    lstServerListChanges.append ( Change );
+
+    // the oldest changes are dropped, subscribers with an older version of the list
+    // have to request the complete list again
+    while ( lstServerListChanges.size() > SERVLIST_MAX_NUM_CHANGES )
+    {
+        iServerListChangesBase = lstServerListChanges.takeFirst().iVersion;
+    }
+}
+
+void CServerListManager::Subscribe ( const CHostAddress& InetAddr, const int iVersion, const int iToken, const bool bSubscribe )
+{
+    QMutexLocker locker ( &Mutex );
+
+    // only a client which has received the token at its address can (un)subscribe it,
+    // otherwise the diffs could be directed to any address
+    if ( !bIsDirectory || ( iToken != GetSubscriptionToken ( InetAddr ) ) )
+    {
+        return;
+    }
+
+    if ( !bSubscribe )
+    {
+        mapServerListSubscribers.remove ( InetAddr );
+        return;
+    }
+
+    // limit the number of subscribers, the other clients have to open the connect
+    // dialog again to get an updated list as before
+    if ( !mapServerListSubscribers.contains ( InetAddr ) && ( mapServerListSubscribers.size() >= SERVLIST_MAX_NUM_SUBSCRIBERS ) )
+    {
+        return;
+    }
+
+    // a renewal also tells which version the client has, so lost diffs are sent again
+    SServerListSubscriber& Subscriber = mapServerListSubscribers[InetAddr];
+
+    Subscriber.iVersion = iVersion;
+    Subscriber.RenewTime.start();
+
+    if ( !TimerServerListSubscribers.isActive() )
+    {
+        TimerServerListSubscribers.start();
+    }
+}
+
+void CServerListManager::OnTimerServerListSubscribers()
+{
+    QMutexLocker locker ( &Mutex );
+
+    QHash<CHostAddress, SServerListSubscriber>::iterator it = mapServerListSubscribers.begin();
+
+    while ( it != mapServerListSubscribers.end() )
+    {
+        if ( !bIsDirectory || it.value().RenewTime.hasExpired ( SERVLIST_SUBSCRIPTION_TIME_OUT_MS ) )
+        {
+            it = mapServerListSubscribers.erase ( it );
+            continue;
+        }
+
+        if ( it.value().iVersion != iServerListVersion )
+        {
+            SendServerListDiff ( it.key(), it.value() );
+        }
+
+        ++it;
+    }
+
+    if ( mapServerListSubscribers.isEmpty() )
+    {
+        TimerServerListSubscribers.stop();
+    }
+}
+
+void CServerListManager::SendServerListDiff ( const CHostAddress& InetAddr, SServerListSubscriber& Subscriber )
+{
+    // Called with lock set.
+
+    // the entries are listed for the subscriber as in its server list
+    const bool         bClientIsInternal = NetworkUtil::IsPrivateNetworkIP ( InetAddr.InetAddr );
+    const CHostAddress ClientPublicAddr  = GetClientPublicAddr ( InetAddr );
+
+    CVector<CHostAddress> vecRemovedInetAddr ( 0 );
+    CVector<CServerInfo>  vecServerInfo ( 0 );
+    CVector<CHostAddress> vecHolePunchServerAddr ( 0 );
+    CVector<uint8_t>      vecDiffMes;
+    QSet<CHostAddress>    setChangedHostAddr;
+    bool                  bResync = ( Subscriber.iVersion < iServerListChangesBase ) || ( Subscriber.iVersion > iServerListVersion );
+
+    if ( !bResync )
+    {
+        // the changes are sorted by version, find the first one the subscriber does not have
+        QList<SServerListChange>::const_iterator itChange =
+            std::upper_bound ( lstServerListChanges.constBegin(),
+                               lstServerListChanges.constEnd(),
+                               Subscriber.iVersion,
+                               [] ( const int iVersion, const SServerListChange& Change ) { return iVersion < Change.iVersion; } );
+
+        for ( ; itChange != lstServerListChanges.constEnd(); ++itChange )
+        {
+            if ( itChange->bRemoved )
+            {
+                CServerInfo RemovedServerInfo = itChange->ServerInfo;
+
+                SelectListedHostAddr ( RemovedServerInfo, bClientIsInternal, InetAddr.InetAddr );
+                vecRemovedInetAddr.Add ( RemovedServerInfo.HostAddr );
+            }
+            else if ( !setChangedHostAddr.contains ( itChange->ServerInfo.HostAddr ) )
             {
-                // create "send empty message" for all other registered servers
-                // this causes the server (vecServerInfo[iIdx].HostAddr)
-                // to send a "reply" to the client (InetAddr or best guess public IP address if internal to directory)
-                // - with the intent of opening the server firewall for the client
-                pConnLessProtocol->CreateCLSendEmptyMesMes ( siCurListEntry.HostAddr, clientPublicAddr );
+                // the entry is sent as it is listed now (if it was removed in the
+                // meantime, this is a later change)
+                const int iIdx = IndexOf ( itChange->ServerInfo.HostAddr );
+
+                setChangedHostAddr.insert ( itChange->ServerInfo.HostAddr );
+
+                if ( iIdx > 0 )
+                {
+                    CServerInfo ChangedServerInfo = ServerList[iIdx];
+
+                    SelectListedHostAddr ( ChangedServerInfo, bClientIsInternal, InetAddr.InetAddr );
+                    vecServerInfo.Add ( ChangedServerInfo );
+
+                    if ( !NetworkUtil::IsPrivateNetworkIP ( ServerList[iIdx].HostAddr.InetAddr ) )
+                    {
+                        vecHolePunchServerAddr.Add ( ServerList[iIdx].HostAddr );
+                    }
+                }
             }
         }
 
-        // send the server list to the client, since we do not know that the client
-        // has a UDP fragmentation issue, we send both lists, the reduced and the
-        // normal list after each other
-        pConnLessProtocol->CreateCLRedServerListMes ( InetAddr, vecServerInfo );
-        pConnLessProtocol->CreateCLServerListMes ( InetAddr, vecServerInfo );
+        pConnLessProtocol->GenCLServerListDiffMes ( vecDiffMes,
+                                                    Subscriber.iVersion,
+                                                    iServerListVersion,
+                                                    GetSubscriptionToken ( InetAddr ),
+                                                    false,
+                                                    vecRemovedInetAddr,
+                                                    vecServerInfo );
+
+        // a diff which does not fit into one datagram is not worth it
+        bResync = vecDiffMes.Size() > MESS_LEN_WITHOUT_DATA_BYTE + MAX_SIZE_BYTES_SERVER_LIST_PAGE;
+    }
+
+    if ( bResync )
+    {
+        vecRemovedInetAddr.Init ( 0 );
+        vecServerInfo.Init ( 0 );
+
+        pConnLessProtocol->GenCLServerListDiffMes ( vecDiffMes,
+                                                    Subscriber.iVersion,
+                                                    iServerListVersion,
+                                                    GetSubscriptionToken ( InetAddr ),
+                                                    true,
+                                                    vecRemovedInetAddr,
+                                                    vecServerInfo );
+    }
+    else
+    {
+        // new servers which are not local to the directory need a "ping" as in RetrieveAll()
+        for ( int iIdx = 0; iIdx < vecHolePunchServerAddr.Size(); iIdx++ )
+        {
+            QueueHolePunch ( vecHolePunchServerAddr[iIdx], ClientPublicAddr );
+        }
+    }
+
+    pConnLessProtocol->SendCLPreparedMes ( InetAddr, vecDiffMes );
+
+    // the subscriber is assumed to have the list now, if the diff gets lost, the
+    // renewal of the subscription tells the actual version of the client
+    Subscriber.iVersion = iServerListVersion;
+}
+
+void CServerListManager::SendServerListVersion ( const CHostAddress& InetAddr )
+{
+    // Called with lock set.
+
+    // a diff without changes tells the clients which support subscriptions the
+    // version of the list and the token they need to subscribe
+    CVector<uint8_t> vecDiffMes;
+
+    pConnLessProtocol->GenCLServerListDiffMes ( vecDiffMes,
+                                                iServerListVersion,
+                                                iServerListVersion,
+                                                GetSubscriptionToken ( InetAddr ),
+                                                false,
+                                                CVector<CHostAddress> ( 0 ),
+                                                CVector<CServerInfo> ( 0 ) );
+
+    pConnLessProtocol->SendCLPreparedMes ( InetAddr, vecDiffMes );
+}
+
+int CServerListManager::GetSubscriptionToken ( const CHostAddress& InetAddr ) const
+{
+    // the token is the beginning of a keyed hash of the address, only the
+    // directory can generate it
+    const QByteArray baHash =
+        QMessageAuthenticationCode::hash ( InetAddr.toString().toUtf8(), baSubscriptionKey, QCryptographicHash::Sha256 );
+
+    return static_cast<int> ( qFromBigEndian<quint32> ( baHash.constData() ) );
+}
+
+void CServerListManager::UpdateServerListCache()
+{
+    // Called with lock set.
+
+    if ( iServerListCacheVersion == iServerListVersion )
+    {
+        return;
+    }
+
+    // clients on the LAN of the directory get the addresses as registered
+    GetServerListMes ( IntClientServerListMes, true, QHostAddress() );
+
+    // external clients get the local address of servers on the LAN of the directory (the
+    // null address never matches the IP of a server, see setExtServerIP for that case)
+    GetServerListMes ( ExtClientServerListMes, false, QHostAddress() );
+
+    vecExtServerAddr.Init ( 0 );
+    setExtServerIP.clear();
+
+    for ( int iIdx = 1; iIdx < ServerList.size(); iIdx++ )
+    {
+        if ( !NetworkUtil::IsPrivateNetworkIP ( ServerList[iIdx].HostAddr.InetAddr ) )
+        {
+            vecExtServerAddr.Add ( ServerList[iIdx].HostAddr );
+            setExtServerIP.insert ( ServerList[iIdx].HostAddr.InetAddr );
+        }
     }
+
+    iServerListCacheVersion = iServerListVersion;
 }
 
 int CServerListManager::IndexOf ( const CHostAddress& haSearchTerm )
@@ -732,16 +1247,131 @@ int CServerListManager::IndexOf ( const CHostAddress& haSearchTerm )
     // Called with lock set.
 
     // Find the server in the list. The very first list entry
-    // per definition is the directory
-    // (i.e., this server).
-    for ( int iIdx = ServerList.size() - 1; iIdx > 0; iIdx-- )
+    // per definition is the directory (i.e., this server) and
+    // is not in the index.
+    return mapServerListIndex.value ( haSearchTerm, INVALID_INDEX );
+}
+
+void CServerListManager::RemoveAt ( const int iIdx )
+{
+    // Called with lock set.
+
+    const CHostAddress HostAddr          = ServerList[iIdx].HostAddr;
+    const CServerInfo  RemovedServerInfo = ServerList[iIdx];
+    const int          iLastIdx          = ServerList.size() - 1;
+
+    WriteJournalRecord ( JR_REMOVE, ServerList[iIdx] );
+
+    vecExpiryWheel[ServerList[iIdx].iExpirySlot].remove ( HostAddr );
+    mapServerListIndex.remove ( HostAddr );
+
+    // the last entry takes the place of the removed one, so no other index changes
+    if ( iIdx != iLastIdx )
     {
-        if ( ServerList[iIdx].HostAddr == haSearchTerm )
+        ServerList[iIdx] = ServerList[iLastIdx];
+        mapServerListIndex.insert ( ServerList[iIdx].HostAddr, iIdx );
+    }
+
+    ServerList.removeLast();
+    LogServerListChange ( RemovedServerInfo, true );
+}
+
+void CServerListManager::QueueHolePunch ( const CHostAddress& ServerAddr, const CHostAddress& ClientAddr )
+{
+    // Called with lock set.
+
+    QSet<CHostAddress>& setTargets = mapHolePunchTargets[ServerAddr];
+
+    if ( setTargets.isEmpty() )
+    {
+        lstHolePunchServers.append ( ServerAddr );
+    }
+
+    // a client requesting the list several times within the window only needs one
+    setTargets.insert ( ClientAddr );
+
+    if ( !TimerHolePunch.isActive() )
+    {
+        TimerHolePunch.start();
+    }
+}
+
+void CServerListManager::OnTimerHolePunch()
+{
+    QMutexLocker locker ( &Mutex );
+
+    int iNumMes = 0;
+
+    while ( !lstHolePunchServers.isEmpty() && ( iNumMes < SERVLIST_HOLE_PUNCH_MAX_MES_PER_INTERVAL ) )
+    {
+        const CHostAddress  ServerAddr = lstHolePunchServers.takeFirst();
+        const int           iIdx       = IndexOf ( ServerAddr );
+        QSet<CHostAddress>& setTargets = mapHolePunchTargets[ServerAddr];
+
+        if ( iIdx == INVALID_INDEX )
+        {
+            // the server has gone meanwhile
+            mapHolePunchTargets.remove ( ServerAddr );
+            continue;
+        }
+
+        QSet<CHostAddress>::iterator it = setTargets.begin();
+
+        if ( ServerList[iIdx].bSendEmptyMesMulti )
         {
-            return iIdx;
+            // one message for all (or at least many) targets
+            CVector<CHostAddress> vecTargets;
+
+            while ( ( it != setTargets.end() ) && ( vecTargets.Size() < MAX_NUM_TARGETS_SEND_EMPTY_MES_MULTI ) )
+            {
+                vecTargets.Add ( *it );
+                it = setTargets.erase ( it );
+            }
+
+            pConnLessProtocol->CreateCLSendEmptyMesMultiMes ( ServerAddr, vecTargets );
+            iNumMes++;
         }
+        else
+        {
+            // older servers need one message per target
+            while ( ( it != setTargets.end() ) && ( iNumMes < SERVLIST_HOLE_PUNCH_MAX_MES_PER_INTERVAL ) )
+            {
+                pConnLessProtocol->CreateCLSendEmptyMesMes ( ServerAddr, *it );
+                it = setTargets.erase ( it );
+                iNumMes++;
+            }
+        }
+
+        if ( setTargets.isEmpty() )
+        {
+            mapHolePunchTargets.remove ( ServerAddr );
+        }
+        else
+        {
+            // the remaining targets are served after the other servers
+            lstHolePunchServers.append ( ServerAddr );
+        }
+    }
+
+    if ( lstHolePunchServers.isEmpty() )
+    {
+        TimerHolePunch.stop();
     }
-    return INVALID_INDEX;
+}
+
+void CServerListManager::ScheduleExpiry ( const int iIdx )
+{
+    // Called with lock set.
+
+    CServerListEntry& ServerListEntry = ServerList[iIdx];
+
+    if ( ServerListEntry.iExpirySlot != INVALID_INDEX )
+    {
+        vecExpiryWheel[ServerListEntry.iExpirySlot].remove ( ServerListEntry.HostAddr );
+    }
+
+    ServerListEntry.iExpirySlot = iExpiryWheelPos;
+    vecExpiryWheel[iExpiryWheelPos].insert ( ServerListEntry.HostAddr );
 }
 
 bool CServerListManager::SetServerListFileName ( QString strFilename )
@@ -759,6 +1389,8 @@ bool CServerListManager::SetServerListFileName ( QString strFilename )
         Save();
     }
 
+    JournalFile.close();
+
     ServerListFileName = strFilename;
     return Load();
 }
@@ -790,6 +1422,12 @@ bool CServerListManager::Load()
     CServerListEntry serverListEntry = ServerList[0];
     ServerList.clear();
     ServerList.append ( serverListEntry );
+    mapServerListIndex.clear();
+    for ( int iSlot = 0; iSlot < vecExpiryWheel.Size(); iSlot++ )
+    {
+        vecExpiryWheel[iSlot].clear();
+    }
+    InvalidateServerListCache();
 
     // use entire file content for the persistent server list
     CHostAddress haServerHostAddr;
@@ -828,12 +1466,32 @@ bool CServerListManager::Load()
                                         .arg ( serverListEntry.LHostAddr.toString() )
                                         .arg ( serverListEntry.strName ) );
         ServerList.append ( serverListEntry );
+        mapServerListIndex.insert ( serverListEntry.HostAddr, ServerList.size() - 1 );
+        ScheduleExpiry ( ServerList.size() - 1 );
+    }
+
+    file.close();
+
+    // apply the changes since the server list file was written (e.g., if the
+    // directory was not shut down regularly) and fold them into the file
+    JournalFile.close();
+
+    const int iNumReplayed = ReplayJournal();
+
+    if ( iNumReplayed > 0 )
+    {
+        qInfo() << qUtf8Printable ( QString ( "Replayed %1 records of the persistent server list journal" ).arg ( iNumReplayed ) );
+        Save ( false );
+    }
+    else
+    {
+        OpenJournal ( true );
     }
 
     return true;
 }
 
-void CServerListManager::Save()
+void CServerListManager::Save ( const bool bLogEntries )
 {
     // this is called with the lock set
 
@@ -842,12 +1500,21 @@ void CServerListManager::Save()
         return;
     }
 
-    QFile file ( ServerListFileName );
+    // the file is replaced as a whole, so an interrupted write does not lose the list
+    QSaveFile file ( ServerListFileName );
+    file.setDirectWriteFallback ( true );
 
-    if ( !file.open ( QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Text ) )
+    if ( !file.open ( QIODevice::WriteOnly | QIODevice::Text ) )
     {
         // Not a useable file
         qWarning() << qUtf8Printable ( QString ( tr ( "Could not write to '%1'" ) ).arg ( ServerListFileName ) );
+
+        // the changes are kept in the journal (e.g., if Load() closed it for the replay)
+        if ( !JournalFile.isOpen() )
+        {
+            OpenJournal ( false );
+        }
+
         ServerListFileName.clear();
 
         return;
@@ -858,12 +1525,170 @@ void CServerListManager::Save()
     // (that's this server, which is added automatically on start up, not read)
     for ( int iIdx = ServerList.size() - 1; iIdx > 0; iIdx-- )
     {
-        qInfo() << qUtf8Printable ( QString ( tr ( "Saving registration for %1 (%2): %3" ) )
-                                        .arg ( ServerList[iIdx].HostAddr.toString() )
-                                        .arg ( ServerList[iIdx].LHostAddr.toString() )
-                                        .arg ( ServerList[iIdx].strName ) );
+        if ( bLogEntries )
+        {
+            qInfo() << qUtf8Printable ( QString ( tr ( "Saving registration for %1 (%2): %3" ) )
+                                            .arg ( ServerList[iIdx].HostAddr.toString() )
+                                            .arg ( ServerList[iIdx].LHostAddr.toString() )
+                                            .arg ( ServerList[iIdx].strName ) );
+        }
         out << ServerList[iIdx].toCSV() << '\n';
     }
+
+    out.flush();
+
+    if ( !file.commit() )
+    {
+        qWarning() << qUtf8Printable ( QString ( tr ( "Could not write to '%1'" ) ).arg ( ServerListFileName ) );
+
+        // the file does not contain the changes, so the journal must keep them
+        if ( !JournalFile.isOpen() )
+        {
+            OpenJournal ( false );
+        }
+
+        return;
+    }
+
+    // the file contains all changes now, so the journal starts anew
+    OpenJournal ( true );
+}
+
+void CServerListManager::OpenJournal ( const bool bTruncate )
+{
+    // this is called with the lock set
+
+    JournalFile.close();
+    iNumJournalRecords = 0;
+
+    if ( !bIsDirectory || ServerListFileName.isEmpty() )
+    {
+        return;
+    }
+
+    JournalFile.setFileName ( GetJournalFileName() );
+
+    if ( !JournalFile.open ( QIODevice::WriteOnly | ( bTruncate ? QIODevice::Truncate : QIODevice::Append ) ) )
+    {
+        qWarning() << qUtf8Printable ( QString ( tr ( "Could not write to '%1'" ) ).arg ( GetJournalFileName() ) );
+    }
+}
+
+void CServerListManager::WriteJournalRecord ( const EJournalRecordType eType, const CServerListEntry& Entry )
+{
+    // this is called with the lock set
+
+    if ( !JournalFile.isOpen() )
+    {
+        return;
+    }
+
+    QByteArray  baRecord;
+    QDataStream Record ( &baRecord, QIODevice::WriteOnly );
+    Record.setVersion ( QDataStream::Qt_5_12 );
+
+    Record << static_cast<quint8> ( eType ) << Entry.HostAddr.InetAddr << Entry.HostAddr.iPort;
+
+    if ( eType == JR_REGISTER )
+    {
+        Record << Entry.LHostAddr.InetAddr << Entry.LHostAddr.iPort << Entry.strName << Entry.strCity << static_cast<qint32> ( Entry.eCountry )
+               << static_cast<qint32> ( Entry.iMaxNumClients ) << Entry.bPermanentOnline << Entry.bSendEmptyMesMulti;
+    }
+
+    // the records are stored with their size so that a record which was not
+    // completely written can be detected on replay
+    QDataStream Journal ( &JournalFile );
+    Journal.setVersion ( QDataStream::Qt_5_12 );
+    Journal << baRecord;
+
+    // hand the record over to the operating system immediately
+    JournalFile.flush();
+    iNumJournalRecords++;
+}
+
+int CServerListManager::ReplayJournal()
+{
+    // this is called with the lock set and the journal closed
+
+    QFile file ( GetJournalFileName() );
+
+    if ( !file.open ( QIODevice::ReadOnly ) )
+    {
+        return 0; // no journal
+    }
+
+    QDataStream Journal ( &file );
+    Journal.setVersion ( QDataStream::Qt_5_12 );
+
+    int iNumReplayed = 0;
+
+    while ( !Journal.atEnd() )
+    {
+        QByteArray baRecord;
+        Journal >> baRecord;
+
+        if ( Journal.status() != QDataStream::Ok )
+        {
+            qWarning() << qUtf8Printable ( QString ( "Ignoring incomplete record at the end of '%1'" ).arg ( GetJournalFileName() ) );
+            break;
+        }
+
+        QDataStream Record ( baRecord );
+        Record.setVersion ( QDataStream::Qt_5_12 );
+
+        quint8           iType;
+        CServerListEntry Entry;
+
+        Record >> iType >> Entry.HostAddr.InetAddr >> Entry.HostAddr.iPort;
+
+        const int iIdx = IndexOf ( Entry.HostAddr );
+
+        if ( iType == JR_REGISTER )
+        {
+            qint32 iCountry;
+            qint32 iMaxNumClients;
+
+            Record >> Entry.LHostAddr.InetAddr >> Entry.LHostAddr.iPort >> Entry.strName >> Entry.strCity >> iCountry >> iMaxNumClients >>
+                Entry.bPermanentOnline >> Entry.bSendEmptyMesMulti;
+
+            if ( ( Record.status() != QDataStream::Ok ) || ( CHostAddress() == Entry.HostAddr ) )
+            {
+                continue; // invalid record
+            }
+
+            Entry.eCountry = QLocale::AnyCountry;
+
+            if ( iCountry >= 0 && iCountry <= QLocale::LastCountry )
+            {
+                Entry.eCountry = static_cast<QLocale::Country> ( iCountry );
+            }
+
+            Entry.iMaxNumClients = iMaxNumClients;
+
+            if ( iIdx > 0 )
+            {
+                // keep the position in the expiry wheel
+                Entry.iExpirySlot = ServerList[iIdx].iExpirySlot;
+                ServerList[iIdx]  = Entry;
+            }
+            else if ( iIdx == INVALID_INDEX && ServerList.size() < MAX_NUM_SERVERS_IN_SERVER_LIST )
+            {
+                ServerList.append ( Entry );
+                mapServerListIndex.insert ( Entry.HostAddr, ServerList.size() - 1 );
+                ScheduleExpiry ( ServerList.size() - 1 );
+            }
+        }
+        else if ( iType == JR_REMOVE && iIdx > 0 )
+        {
+            RemoveAt ( iIdx );
+        }
+
+        iNumReplayed++;
+    }
+
+    InvalidateServerListCache();
+
+    return iNumReplayed;
 }
 
 /* Registered server functionality *************************************************/
@@ -880,6 +1705,10 @@ void CServerListManager::StoreRegistrationResult ( ESvrRegResult eResult )
     {
     case ESvrRegResult::SRR_REGISTERED:
         SetSvrRegStatus ( ESvrRegStatus::SRS_REGISTERED );
+
+        // tell the directory about our optional features (a directory which
+        // does not know the message ignores it)
+        pConnLessProtocol->CreateCLServerFeaturesMes ( DirectoryAddress, SF_SEND_EMPTY_MES_MULTI );
         break;
 
     case ESvrRegResult::SRR_SERVER_LIST_FULL:
@@ -900,6 +1729,30 @@ void CServerListManager::StoreRegistrationResult ( ESvrRegResult eResult )
     }
 }
 
+void CServerListManager::SetServerFeatures ( const CHostAddress& InetAddr, const int iFeatures )
+{
+    // only the directory keeps the features of the registered servers
+    if ( !bIsDirectory )
+    {
+        return;
+    }
+
+    QMutexLocker locker ( &Mutex );
+
+    const int iIdx = IndexOf ( InetAddr );
+
+    if ( iIdx > 0 )
+    {
+        const bool bSendEmptyMesMulti = ( iFeatures & SF_SEND_EMPTY_MES_MULTI ) != 0;
+
+        if ( ServerList[iIdx].bSendEmptyMesMulti != bSendEmptyMesMulti )
+        {
+            ServerList[iIdx].bSendEmptyMesMulti = bSendEmptyMesMulti;
+            WriteJournalRecord ( JR_REGISTER, ServerList[iIdx] );
+        }
+    }
+}
+
 void CServerListManager::OnTimerPingServers()
 {
     QMutexLocker locker ( &Mutex );
@@ -941,6 +1794,13 @@ void CServerListManager::OnTimerCLRegisterServerResp()
 
 void CServerListManager::OnAboutToQuit()
 {
+    // the timers can only be stopped in the thread of this object
+    if ( QThread::currentThread() != thread() )
+    {
+        QMetaObject::invokeMethod ( this, [this]() { OnAboutToQuit(); }, Qt::BlockingQueuedConnection );
+        return;
+    }
+
     {
         QMutexLocker locker ( &Mutex );
         Save();
@@ -950,6 +1810,13 @@ void CServerListManager::OnAboutToQuit()
     Unregister();
 }
 
+bool CServerListManager::IsRegisteredDirectory ( const CHostAddress& InetAddr )
+{
+    QMutexLocker locker ( &Mutex );
+
+    return ( eSvrRegStatus == SRS_REGISTERED ) && ( InetAddr == DirectoryAddress );
+}
+
 void CServerListManager::SetRegistered ( const bool bIsRegister )
 {
     // we need the lock since the user might change the server properties at
@@ -1022,4 +1889,7 @@ void CServerListManager::SetSvrRegStatus ( ESvrRegStatus eNSvrRegStatus )
     // store the state and inform the GUI about the new status
     eSvrRegStatus = eNSvrRegStatus;
     emit SvrRegStatusChanged();
+
+    // the server does not throttle the directory it is registered with
+    emit RegisteredDirectoryChanged ( ( !bIsDirectory && ( eSvrRegStatus == SRS_REGISTERED ) ) ? DirectoryAddress : CHostAddress() );
 }
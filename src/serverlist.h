@@ -68,6 +68,16 @@ Note: this mechanism will not work in a private network.
 #include <QList>
 #include <QElapsedTimer>
 #include <QMutex>
+#include <QSet>
+#include <QHash>
+#include <QThread>
+#include <QFile>
+#include <QSaveFile>
+#include <QDataStream>
+#include <QDateTime>
+#include <QRandomGenerator>
+#include <QMessageAuthenticationCode>
+#include <QtEndian>
 #if QT_VERSION >= QT_VERSION_CHECK( 5, 6, 0 )
 #    include <QVersionNumber>
 #endif
@@ -79,7 +89,13 @@ Note: this mechanism will not work in a private network.
 class CServerListEntry : public CServerInfo
 {
 public:
-    CServerListEntry() : CServerInfo ( CHostAddress(), CHostAddress(), "", QLocale::AnyCountry, "", 0, false ) { UpdateRegistration(); }
+    CServerListEntry() :
+        CServerInfo ( CHostAddress(), CHostAddress(), "", QLocale::AnyCountry, "", 0, false ),
+        iExpirySlot ( INVALID_INDEX ),
+        bSendEmptyMesMulti ( false )
+    {
+        UpdateRegistration();
+    }
 
     CServerListEntry ( const CHostAddress&     NHAddr,
                        const CHostAddress&     NLHAddr,
@@ -88,7 +104,9 @@ public:
                        const QString&          NsCity,
                        const int               NiMaxNumClients,
                        const bool              NbPermOnline ) :
-        CServerInfo ( NHAddr, NLHAddr, NsName, NeCountry, NsCity, NiMaxNumClients, NbPermOnline )
+        CServerInfo ( NHAddr, NLHAddr, NsName, NeCountry, NsCity, NiMaxNumClients, NbPermOnline ),
+        iExpirySlot ( INVALID_INDEX ),
+        bSendEmptyMesMulti ( false )
     {
         UpdateRegistration();
     }
@@ -100,7 +118,9 @@ public:
                       NewCoreServerInfo.eCountry,
                       NewCoreServerInfo.strCity,
                       NewCoreServerInfo.iMaxNumClients,
-                      NewCoreServerInfo.bPermanentOnline )
+                      NewCoreServerInfo.bPermanentOnline ),
+        iExpirySlot ( INVALID_INDEX ),
+        bSendEmptyMesMulti ( false )
     {
         UpdateRegistration();
     }
@@ -120,6 +140,12 @@ public:
     // time on which the entry was registered
     QElapsedTimer RegisterTime;
 
+    // slot of the expiry wheel of the server list manager the entry is in
+    int iExpirySlot;
+
+    // the server understands PROTMESSID_CLM_SEND_EMPTY_MES_MULTI
+    bool bSendEmptyMesMulti;
+
 protected:
     // Taken from src/settings.h - the same comment applies
     static QString    ToBase64 ( const QByteArray strIn ) { return QString::fromLatin1 ( strIn.toBase64() ); }
@@ -144,13 +170,25 @@ public:
                          CProtocol*     pNConLProt );
 
     void    SetServerName ( const QString& strNewName );
-    QString GetServerName() { return ServerList[0].strName; }
+    QString GetServerName()
+    {
+        QMutexLocker locker ( &Mutex );
+        return ServerList[0].strName;
+    }
 
     void    SetServerCity ( const QString& strNewCity );
-    QString GetServerCity() { return ServerList[0].strCity; }
+    QString GetServerCity()
+    {
+        QMutexLocker locker ( &Mutex );
+        return ServerList[0].strCity;
+    }
 
     void             SetServerCountry ( const QLocale::Country eNewCountry );
-    QLocale::Country GetServerCountry() { return ServerList[0].eCountry; }
+    QLocale::Country GetServerCountry()
+    {
+        QMutexLocker locker ( &Mutex );
+        return ServerList[0].eCountry;
+    }
 
     void    SetDirectoryAddress ( const QString sNDirectoryAddress );
     QString GetDirectoryAddress() { return strDirectoryAddress; }
@@ -162,6 +200,8 @@ public:
 
     ESvrRegStatus GetSvrRegStatus() { return eSvrRegStatus; }
 
+    bool IsRegisteredDirectory ( const CHostAddress& InetAddr );
+
     // the update has to be called if any change to the server list
     // properties was done
     void Update();
@@ -169,21 +209,53 @@ public:
     void Append ( const CHostAddress& InetAddr, const CHostAddress& LInetAddr, const CServerCoreInfo& ServerInfo, const QString strVersion = "" );
     void Remove ( const CHostAddress& InetAddr );
     void RetrieveAll ( const CHostAddress& InetAddr );
+    void RetrievePage ( const CHostAddress& InetAddr, const int iVersion, const int iPage );
+    void Subscribe ( const CHostAddress& InetAddr, const int iVersion, const int iToken, const bool bSubscribe );
 
     void StoreRegistrationResult ( ESvrRegResult eStatus );
+    void SetServerFeatures ( const CHostAddress& InetAddr, const int iFeatures );
 
     QString GetServerListFileName() { return ServerListFileName; }
     bool    SetServerListFileName ( QString strFilename );
 
+    // moves this object together with its timers to the given thread (must be
+    // called in the thread the object currently lives in)
+    void MoveToThread ( QThread* pThread );
+
 protected:
     void SetIsDirectory();
     void Unregister();
     void Register();
     void SetRegistered ( bool bIsRegister );
 
-    int  IndexOf ( const CHostAddress& haSearchTerm );
-    bool Load();
-    void Save();
+    int          IndexOf ( const CHostAddress& haSearchTerm );
+    void         RemoveAt ( const int iIdx );
+    void         QueueHolePunch ( const CHostAddress& ServerAddr, const CHostAddress& ClientAddr );
+    void         ScheduleExpiry ( const int iIdx );
+    void         GetServerInfoList ( CVector<CServerInfo>& vecServerInfo, const bool bClientIsInternal, const QHostAddress& ClientInetAddr );
+    void         SelectListedHostAddr ( CServerInfo& ServerInfo, const bool bClientIsInternal, const QHostAddress& ClientInetAddr );
+    CHostAddress GetClientPublicAddr ( const CHostAddress& InetAddr );
+    void         InvalidateServerListCache();
+    void         LogServerListChange ( const CServerInfo& ServerInfo, const bool bRemoved );
+    void         UpdateServerListCache();
+    bool         Load();
+    void         Save ( const bool bLogEntries = true );
+
+    // Changes of the persistent server list are appended to a journal next to the
+    // server list file, so that they are not lost if the directory is not shut
+    // down regularly. The journal is replayed on loading and emptied whenever the
+    // server list file is written.
+    enum EJournalRecordType
+    {
+        JR_REGISTER = 1, // new or changed entry
+        JR_REMOVE   = 2  // unregistered or expired entry
+    };
+
+    QString GetJournalFileName() const { return ServerListFileName + ".journal"; }
+    void    OpenJournal ( const bool bTruncate );
+    int     ReplayJournal();
+    void    WriteJournalRecord ( const EJournalRecordType eType, const CServerListEntry& Entry );
+
     void SetSvrRegStatus ( ESvrRegStatus eNSvrRegStatus );
 
     QMutex Mutex;
@@ -197,9 +269,77 @@ protected:
     CHostAddress ServerPublicIP6;
 
     QString ServerListFileName;
+    QFile   JournalFile;
+    int     iNumJournalRecords;
 
     QList<CServerListEntry> ServerList;
 
+    // index of the registered servers in ServerList (i.e., without this server)
+    QHash<CHostAddress, int> mapServerListIndex;
+
+    // registered servers by the poll interval of their last registration, the
+    // servers in the slot the wheel moves to next have timed out
+    CVector<QSet<CHostAddress>> vecExpiryWheel;
+    int                         iExpiryWheelPos;
+
+    // pre-encoded reduced and full server list messages for one view of the list,
+    // the full list is also available in pages
+    struct SServerListMes
+    {
+        CVector<uint8_t>          vecRedMes;
+        CVector<uint8_t>          vecMes;
+        CVector<CVector<uint8_t>> vecPageMes;
+    };
+
+    void                  GetServerListMes ( SServerListMes& ServerListMes, const bool bClientIsInternal, const QHostAddress& ClientInetAddr );
+    const SServerListMes& GetClientServerListMes ( const CHostAddress& InetAddr, SServerListMes& ClientServerListMes );
+
+    // NAT hole punch requests per registered server (the clients it shall send an empty
+    // message to), collected for a short time so they can be combined and sent at a
+    // limited rate, the servers are served round robin
+    QHash<CHostAddress, QSet<CHostAddress>> mapHolePunchTargets;
+    QList<CHostAddress>                     lstHolePunchServers;
+
+    // the server list messages only depend on whether the client is on the LAN of
+    // the directory, so they are encoded once per version of the list
+    int                   iServerListVersion;
+    int                   iServerListCacheVersion;
+    SServerListMes        IntClientServerListMes;
+    SServerListMes        ExtClientServerListMes;
+    CVector<CHostAddress> vecExtServerAddr; // servers which get asked to open their firewall
+    QSet<QHostAddress>    setExtServerIP;   // clients with one of these IPs get an individual list
+
+    // changes of the server list after version iServerListChangesBase, a removed
+    // entry is kept as it was listed, for any other change only the address is
+    // used since the subscribers get the entry as it is listed at that time
+    struct SServerListChange
+    {
+        int         iVersion;
+        bool        bRemoved;
+        CServerInfo ServerInfo;
+    };
+
+    QList<SServerListChange> lstServerListChanges;
+    int                      iServerListChangesBase;
+
+    // clients which get the changes of the server list pushed, with the version of
+    // the list they have
+    struct SServerListSubscriber
+    {
+        int           iVersion;
+        QElapsedTimer RenewTime;
+    };
+
+    void SendServerListDiff ( const CHostAddress& InetAddr, SServerListSubscriber& Subscriber );
+    void SendServerListVersion ( const CHostAddress& InetAddr );
+    int  GetSubscriptionToken ( const CHostAddress& InetAddr ) const;
+
+    // key of the subscription tokens, a client can only subscribe with the token
+    // it has received at its address
+    QByteArray baSubscriptionKey;
+
+    QHash<CHostAddress, SServerListSubscriber> mapServerListSubscribers;
+
     QString strDirectoryAddress;
     bool    bIsDirectory;
 
@@ -220,6 +360,8 @@ protected:
     QTimer TimerRefreshRegistration;
     QTimer TimerCLRegisterServerResp;
     QTimer TimerIsPermanent;
+    QTimer TimerHolePunch;
+    QTimer TimerServerListSubscribers;
 
 public slots:
     void OnTimerPollList();
@@ -227,10 +369,17 @@ public slots:
     void OnTimerPingServers();
     void OnTimerRefreshRegistration() { SetRegistered ( true ); }
     void OnTimerCLRegisterServerResp();
-    void OnTimerIsPermanent() { ServerList[0].bPermanentOnline = true; }
+    void OnTimerHolePunch();
+    void OnTimerServerListSubscribers();
+    void OnTimerIsPermanent()
+    {
+        ServerList[0].bPermanentOnline = true;
+        InvalidateServerListCache();
+    }
 
     void OnAboutToQuit();
 
 signals:
     void SvrRegStatusChanged();
+    void RegisteredDirectoryChanged ( CHostAddress InetAddr ); // invalid address if not registered
 };
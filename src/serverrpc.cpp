@@ -25,7 +25,7 @@
 
 #include "serverrpc.h"
 
-CServerRpc::CServerRpc ( CServer* pServer, CRpcServer* pRpcServer, QObject* parent ) : QObject ( parent )
+CServerRpc::CServerRpc ( CServer* pServer, CRoomManager* pRoomManager, CRpcServer* pRpcServer, QObject* parent ) : QObject ( parent )
 {
     // API doc already part of CClientRpc
     pRpcServer->HandleMethod ( "jamulus/getMode", [=] ( const QJsonObject& params, QJsonObject& response ) {
@@ -41,12 +41,59 @@ CServerRpc::CServerRpc ( CServer* pServer, CRpcServer* pRpcServer, QObject* pare
     /// @result {string} result.errorMessage - The recorder error message, if any.
     /// @result {boolean} result.enabled - True if the recorder is enabled.
     /// @result {string} result.recordingDirectory - The recorder recording directory.
+    /// @result {string} result.sessionDirectory - The directory of the current (or last) recording session, if any.
     pRpcServer->HandleMethod ( "jamulusserver/getRecorderStatus", [=] ( const QJsonObject& params, QJsonObject& response ) {
         QJsonObject result{
             { "initialised", pServer->GetRecorderInitialised() },
             { "errorMessage", pServer->GetRecorderErrMsg() },
             { "enabled", pServer->GetRecordingEnabled() },
             { "recordingDirectory", pServer->GetRecordingDir() },
+            { "sessionDirectory", pServer->GetRecordingSessionDir() },
+        };
+
+        response["result"] = result;
+        Q_UNUSED ( params );
+    } );
+
+    /// @rpc_method jamulusserver/getRecordingSession
+    /// @brief Returns the files of the current (or last) recording session, read from the session index.
+    /// @param {object} params - No parameters (empty object).
+    /// @result {string} result.sessionDirectory - The session directory.
+    /// @result {array}  result.items - One item per recorded file, in order of connection.
+    /// @result {string} result.items[*].trackName - The (latest) client name of the track.
+    /// @result {string} result.items[*].fileName - The absolute file name.
+    /// @result {number} result.items[*].numAudioChannels - The number of audio channels of the file.
+    /// @result {number} result.items[*].startSeconds - Where the file starts in the session.
+    /// @result {number} result.items[*].lengthSeconds - The length of the file.
+    /// @result {boolean} result.items[*].open - True if the file is still being recorded.
+    pRpcServer->HandleMethod ( "jamulusserver/getRecordingSession", [=] ( const QJsonObject& params, QJsonObject& response ) {
+        const QString                      strSessionDir = pServer->GetRecordingSessionDir();
+        QList<recorder::SSessionIndexItem> items;
+        int                                iServerFrameSizeSamples;
+
+        if ( strSessionDir.isEmpty() || !recorder::CSessionIndex::ReadItems ( strSessionDir, items, iServerFrameSizeSamples ) )
+        {
+            response["error"] = CRpcServer::CreateJsonRpcError ( 1, "No recording session index available" );
+            return;
+        }
+
+        QJsonArray jsonItems;
+        foreach ( const recorder::SSessionIndexItem& item, items )
+        {
+            QJsonObject jsonItem{
+                { "trackName", item.trackName },
+                { "fileName", item.trackItem.fileName },
+                { "numAudioChannels", item.trackItem.numAudioChannels },
+                { "startSeconds", static_cast<double> ( item.trackItem.startFrame * iServerFrameSizeSamples ) / SYSTEM_SAMPLE_RATE_HZ },
+                { "lengthSeconds", static_cast<double> ( item.trackItem.frameCount * iServerFrameSizeSamples ) / SYSTEM_SAMPLE_RATE_HZ },
+                { "open", item.open },
+            };
+            jsonItems.append ( jsonItem );
+        }
+
+        QJsonObject result{
+            { "sessionDirectory", strSessionDir },
+            { "items", jsonItems },
         };
 
         response["result"] = result;
@@ -67,6 +114,7 @@ CServerRpc::CServerRpc ( CServer* pServer, CRpcServer* pRpcServer, QObject* pare
     /// @result {string} result.clients[*].city - The city name provided by the user for this channel.
     /// @result {number} result.clients[*].countryName - The text name of the country specified by the user for this channel (see QLocale::Country).
     /// @result {number} result.clients[*].skillLevelCode - The skill level id provided by the user for this channel.
+    /// @result {boolean} result.clients[*].listenerMixRecording - True if the mix sent to this client is recorded.
     pRpcServer->HandleMethod ( "jamulusserver/getClients", [=] ( const QJsonObject& params, QJsonObject& response ) {
         QJsonArray                clients;
         CVector<CHostAddress>     vecHostAddresses;
@@ -100,6 +148,7 @@ CServerRpc::CServerRpc ( CServer* pServer, CRpcServer* pRpcServer, QObject* pare
                 { "city", vecChanInfo[i].strCity },
                 { "countryName", QLocale::countryToString ( vecChanInfo[i].eCountry ) },
                 { "skillLevelCode", vecChanInfo[i].eSkillLevel },
+                { "listenerMixRecording", pServer->GetListenerMixRecording ( i ) },
             };
             clients.append ( client );
 
@@ -146,6 +195,28 @@ CServerRpc::CServerRpc ( CServer* pServer, CRpcServer* pRpcServer, QObject* pare
         Q_UNUSED ( params );
     } );
 
+    /// @rpc_method jamulusserver/getAdmissionStats
+    /// @brief Returns the counters of the admission control which limits the connectionless messages and new connections per source.
+    /// @param {object} params - No parameters (empty object).
+    /// @result {number} result.connectionLessAdmitted - The number of connectionless messages passed on for processing.
+    /// @result {number} result.connectionLessDropped - The number of connectionless messages dropped because the source exceeded its rate.
+    /// @result {number} result.newConnectionsAdmitted - The number of packets from unknown sources which were allowed to open a channel.
+    /// @result {number} result.newConnectionsDropped - The number of packets from unknown sources dropped because the source exceeded its rate.
+    /// @result {number} result.entriesReplaced - The number of times a source replaced another one in the admission table.
+    pRpcServer->HandleMethod ( "jamulusserver/getAdmissionStats", [=] ( const QJsonObject& params, QJsonObject& response ) {
+        const CAdmissionControl& AdmissionControl = pServer->GetAdmissionControl();
+
+        QJsonObject result{
+            { "connectionLessAdmitted", static_cast<qint64> ( AdmissionControl.GetNumCLMesAdmitted() ) },
+            { "connectionLessDropped", static_cast<qint64> ( AdmissionControl.GetNumCLMesDropped() ) },
+            { "newConnectionsAdmitted", static_cast<qint64> ( AdmissionControl.GetNumNewConnectionsAdmitted() ) },
+            { "newConnectionsDropped", static_cast<qint64> ( AdmissionControl.GetNumNewConnectionsDropped() ) },
+            { "entriesReplaced", static_cast<qint64> ( AdmissionControl.GetNumEntriesReplaced() ) },
+        };
+        response["result"] = result;
+        Q_UNUSED ( params );
+    } );
+
     /// @rpc_method jamulusserver/setDirectory
     /// @brief Set the directory type and, for custom, the directory address.
     /// @param {string} params.directoryType - The directory type as a string (see EDirectoryType and DeserializeDirectoryType).
@@ -238,6 +309,36 @@ CServerRpc::CServerRpc ( CServer* pServer, CRpcServer* pRpcServer, QObject* pare
         response["result"] = "acknowledged";
     } );
 
+    /// @rpc_method jamulusserver/setListenerMixRecording
+    /// @brief Selects whether the mix the server sends to a client is recorded as well.
+    ///  Listener mixes are written to the "listeners" subdirectory of the recording session.
+    /// @param {number} params.id - The client’s channel id.
+    /// @param {boolean} params.enabled - True to record the mix sent to this client.
+    /// @result {string} result - Always "ok".
+    pRpcServer->HandleMethod ( "jamulusserver/setListenerMixRecording", [=] ( const QJsonObject& params, QJsonObject& response ) {
+        auto jsonId      = params["id"];
+        auto jsonEnabled = params["enabled"];
+        if ( !jsonId.isDouble() )
+        {
+            response["error"] = CRpcServer::CreateJsonRpcError ( CRpcServer::iErrInvalidParams, "Invalid params: id is not a number" );
+            return;
+        }
+
+        if ( !jsonEnabled.isBool() )
+        {
+            response["error"] = CRpcServer::CreateJsonRpcError ( CRpcServer::iErrInvalidParams, "Invalid params: enabled is not a boolean" );
+            return;
+        }
+
+        if ( !pServer->SetListenerMixRecording ( jsonId.toInt(), jsonEnabled.toBool() ) )
+        {
+            response["error"] = CRpcServer::CreateJsonRpcError ( CRpcServer::iErrInvalidParams, "Invalid params: id is not a connected client" );
+            return;
+        }
+
+        response["result"] = "ok";
+    } );
+
     /// @rpc_method jamulusserver/startRecording
     /// @brief Starts the server recording.
     /// @param {object} params - No parameters (empty object).
@@ -270,6 +371,121 @@ CServerRpc::CServerRpc ( CServer* pServer, CRpcServer* pRpcServer, QObject* pare
         response["result"] = "acknowledged";
         Q_UNUSED ( params );
     } );
+
+    // the room methods are only available in multi-room mode
+    if ( pRoomManager == nullptr )
+    {
+        return;
+    }
+
+    /// @rpc_method jamulusserver/getRooms
+    /// @brief Returns the rooms hosted by this process (multi-room mode only).
+    /// @param {object} params - No parameters (empty object).
+    /// @result {array}  result.rooms - The list of rooms, the first one is the server itself.
+    /// @result {number} result.rooms[*].id - The room id.
+    /// @result {number} result.rooms[*].port - The port clients connect to.
+    /// @result {string} result.rooms[*].name - The room name.
+    /// @result {number} result.rooms[*].connections - The number of connected clients.
+    /// @result {boolean} result.rooms[*].running - True if the room is processing audio.
+    pRpcServer->HandleMethod ( "jamulusserver/getRooms", [=] ( const QJsonObject& params, QJsonObject& response ) {
+        QJsonArray rooms;
+
+        foreach ( const int iRoomID, pRoomManager->GetRoomIDs() )
+        {
+            CServer*    pRoom = pRoomManager->GetRoom ( iRoomID );
+            QJsonObject room{
+                { "id", iRoomID },
+                { "port", pRoomManager->GetRoomPort ( iRoomID ) },
+                { "name", pRoom->GetServerName() },
+                { "connections", pRoom->GetNumberOfConnectedClients() },
+                { "running", pRoom->IsRunning() },
+            };
+            rooms.append ( room );
+        }
+
+        QJsonObject result{
+            { "rooms", rooms },
+        };
+        response["result"] = result;
+        Q_UNUSED ( params );
+    } );
+
+    /// @rpc_method jamulusserver/createRoom
+    /// @brief Creates a new room on its own port (multi-room mode only).
+    /// @param {number} params.port - The port clients connect to.
+    /// @param {string} params.name - The room name.
+    /// @param {number} [params.maxClients] - (optional) The maximum number of clients, defaults to 10.
+    /// @param {string} [params.welcomeMessage] - (optional) The welcome message of the room.
+    /// @result {number} result.id - The id of the new room.
+    pRpcServer->HandleMethod ( "jamulusserver/createRoom", [=] ( const QJsonObject& params, QJsonObject& response ) {
+        auto jsonPort           = params["port"];
+        auto jsonName           = params["name"];
+        auto jsonMaxClients     = params["maxClients"];
+        auto jsonWelcomeMessage = params["welcomeMessage"];
+
+        if ( !jsonPort.isDouble() || jsonPort.toInt() <= 0 || jsonPort.toInt() > 65535 )
+        {
+            response["error"] = CRpcServer::CreateJsonRpcError ( CRpcServer::iErrInvalidParams, "Invalid params: port is not a valid port number" );
+            return;
+        }
+
+        if ( !jsonName.isString() )
+        {
+            response["error"] = CRpcServer::CreateJsonRpcError ( CRpcServer::iErrInvalidParams, "Invalid params: name is not a string" );
+            return;
+        }
+
+        if ( !jsonMaxClients.isUndefined() &&
+             ( !jsonMaxClients.isDouble() || jsonMaxClients.toInt() < 1 || jsonMaxClients.toInt() > MAX_NUM_CHANNELS ) )
+        {
+            response["error"] = CRpcServer::CreateJsonRpcError ( CRpcServer::iErrInvalidParams, "Invalid params: maxClients is out of range" );
+            return;
+        }
+
+        if ( !jsonWelcomeMessage.isUndefined() && !jsonWelcomeMessage.isString() )
+        {
+            response["error"] = CRpcServer::CreateJsonRpcError ( CRpcServer::iErrInvalidParams, "Invalid params: welcomeMessage is not a string" );
+            return;
+        }
+
+        try
+        {
+            const int iRoomID = pRoomManager->CreateRoom ( static_cast<quint16> ( jsonPort.toInt() ),
+                                                           jsonMaxClients.toInt ( DEFAULT_USED_NUM_CHANNELS ),
+                                                           jsonName.toString(),
+                                                           jsonWelcomeMessage.toString() );
+
+            QJsonObject result{
+                { "id", iRoomID },
+            };
+            response["result"] = result;
+        }
+        catch ( const CGenErr& generr )
+        {
+            response["error"] = CRpcServer::CreateJsonRpcError ( 1, generr.GetErrorText() );
+        }
+    } );
+
+    /// @rpc_method jamulusserver/destroyRoom
+    /// @brief Disconnects all clients of a room and removes it (multi-room mode only).
+    /// @param {number} params.id - The room id. The first room (the server itself) cannot be destroyed.
+    /// @result {string} result - Always "ok".
+    pRpcServer->HandleMethod ( "jamulusserver/destroyRoom", [=] ( const QJsonObject& params, QJsonObject& response ) {
+        auto jsonId = params["id"];
+        if ( !jsonId.isDouble() )
+        {
+            response["error"] = CRpcServer::CreateJsonRpcError ( CRpcServer::iErrInvalidParams, "Invalid params: id is not a number" );
+            return;
+        }
+
+        if ( !pRoomManager->DestroyRoom ( jsonId.toInt() ) )
+        {
+            response["error"] = CRpcServer::CreateJsonRpcError ( CRpcServer::iErrInvalidParams, "Invalid params: id is not a room that can be destroyed" );
+            return;
+        }
+
+        response["result"] = "ok";
+    } );
 }
 
 #if defined( Q_OS_MACOS ) && QT_VERSION < QT_VERSION_CHECK( 6, 0, 0 )
@@ -27,6 +27,7 @@
 
 #include <unordered_map>
 #include "server.h"
+#include "roommanager.h"
 #include "rpcserver.h"
 
 // hash functor for enum classes (only needed on legacy macOS Qt5)
@@ -40,7 +41,7 @@ class CServerRpc : public QObject
     Q_OBJECT
 
 public:
-    CServerRpc ( CServer* pServer, CRpcServer* pRpcServer, QObject* parent = nullptr );
+    CServerRpc ( CServer* pServer, CRoomManager* pRoomManager, CRpcServer* pRpcServer, QObject* parent = nullptr );
 
 private:
     const static std::unordered_map<std::string, EDirectoryType> sumStringToDirectoryType;
@@ -33,6 +33,133 @@
 #endif
 
 /* Implementation *************************************************************/
+CAdmissionControl::CAdmissionControl() :
+    iNumCLMesAdmitted ( 0 ),
+    iNumCLMesDropped ( 0 ),
+    iNumNewConnectionsAdmitted ( 0 ),
+    iNumNewConnectionsDropped ( 0 ),
+    iNumEntriesReplaced ( 0 )
+{
+    // all entries are unused initially
+    vecBuckets.Init ( ADMISSION_TABLE_SIZE );
+    std::fill ( vecBuckets.begin(), vecBuckets.end(), SBucket{ 0, 0, 0, 0 } );
+
+    Clock.start();
+}
+
+CAdmissionControl::SBucket& CAdmissionControl::GetBucket ( const CHostAddress& HostAddr )
+{
+    // get the prefix of the source address (the IPv6 prefixes are marked so that
+    // they differ from the IPv4 ones)
+    uint64_t iPrefix;
+
+    if ( HostAddr.InetAddr.protocol() == QAbstractSocket::IPv4Protocol )
+    {
+        iPrefix = static_cast<uint64_t> ( HostAddr.InetAddr.toIPv4Address() ) >> ( 32 - ADMISSION_PREFIX_LEN_IPV4 );
+    }
+    else
+    {
+        const Q_IPV6ADDR Addr6 = HostAddr.InetAddr.toIPv6Address();
+
+        iPrefix = 0;
+
+        for ( int i = 0; i < 8; i++ )
+        {
+            iPrefix = ( iPrefix << 8 ) | Addr6[i];
+        }
+
+        iPrefix = ( iPrefix >> ( 64 - ADMISSION_PREFIX_LEN_IPV6 ) ) ^ Q_UINT64_C ( 0x8000000000000000 );
+    }
+
+    // the upper bits of the (multiplicative) hash select the entry, the lower
+    // bits identify the prefix in the entry
+    const uint64_t iHash  = iPrefix * Q_UINT64_C ( 0x9E3779B97F4A7C15 );
+    const uint32_t iTag   = static_cast<uint32_t> ( iHash ) | 1;
+    const uint32_t iNow   = static_cast<uint32_t> ( Clock.elapsed() );
+    SBucket&       Bucket = vecBuckets[static_cast<int> ( iHash >> 32 ) & ( ADMISSION_TABLE_SIZE - 1 )];
+
+    if ( Bucket.iTag != iTag )
+    {
+        if ( Bucket.iTag != 0 )
+        {
+            iNumEntriesReplaced.fetch_add ( 1, std::memory_order_relaxed );
+        }
+
+        // a new source starts with full buckets
+        Bucket.iTag                 = iTag;
+        Bucket.iLastUpdateMs        = iNow;
+        Bucket.iCLMesTokens         = ADMISSION_CL_MES_BURST * 1000;
+        Bucket.iNewConnectionTokens = ADMISSION_NEW_CONNECTION_BURST * 1000;
+    }
+    else
+    {
+        // note that the time difference is correct even if the millisecond
+        // counter wrapped around
+        const int64_t iElapsedMs = static_cast<uint32_t> ( iNow - Bucket.iLastUpdateMs );
+
+        Refill ( Bucket.iCLMesTokens, iElapsedMs, ADMISSION_CL_MES_RATE, ADMISSION_CL_MES_BURST );
+        Refill ( Bucket.iNewConnectionTokens, iElapsedMs, ADMISSION_NEW_CONNECTION_RATE, ADMISSION_NEW_CONNECTION_BURST );
+
+        Bucket.iLastUpdateMs = iNow;
+    }
+
+    return Bucket;
+}
+
+void CAdmissionControl::Refill ( int32_t& iTokens, const int64_t iElapsedMs, const int iRate, const int iBurst )
+{
+    // the rate is per second, so the number of thousandths of a token per millisecond
+    iTokens = static_cast<int32_t> ( std::min<int64_t> ( iTokens + iElapsedMs * iRate, iBurst * 1000 ) );
+}
+
+bool CAdmissionControl::AdmitConnectionLessMes ( const CHostAddress& HostAddr )
+{
+    SBucket& Bucket = GetBucket ( HostAddr );
+
+    if ( Bucket.iCLMesTokens < 1000 )
+    {
+        // the directory sends the hole punch requests of all connecting clients,
+        // so it may exceed the rate of a single source (the exempt address is
+        // only checked if the bucket is empty to keep the common case lock free)
+        QMutexLocker locker ( &MutexExemptAddr );
+
+        if ( HostAddr == ExemptAddr )
+        {
+            iNumCLMesAdmitted.fetch_add ( 1, std::memory_order_relaxed );
+            return true;
+        }
+
+        iNumCLMesDropped.fetch_add ( 1, std::memory_order_relaxed );
+        return false;
+    }
+
+    Bucket.iCLMesTokens -= 1000;
+    iNumCLMesAdmitted.fetch_add ( 1, std::memory_order_relaxed );
+    return true;
+}
+
+void CAdmissionControl::SetExemptAddress ( const CHostAddress& HostAddr )
+{
+    QMutexLocker locker ( &MutexExemptAddr );
+
+    ExemptAddr = HostAddr;
+}
+
+bool CAdmissionControl::AdmitNewConnection ( const CHostAddress& HostAddr )
+{
+    SBucket& Bucket = GetBucket ( HostAddr );
+
+    if ( Bucket.iNewConnectionTokens < 1000 )
+    {
+        iNumNewConnectionsDropped.fetch_add ( 1, std::memory_order_relaxed );
+        return false;
+    }
+
+    Bucket.iNewConnectionTokens -= 1000;
+    iNumNewConnectionsAdmitted.fetch_add ( 1, std::memory_order_relaxed );
+    return true;
+}
+
 
 // Connections -------------------------------------------------------------
 // it is important to do the following connections in this class since we
@@ -67,7 +194,8 @@ CSocket::CSocket ( CServer* pNServP, const quint16 iPortNumber, const quint16 iQ
     // server connections:
     QObject::connect ( this, &CSocket::ProtocolMessageReceived, pServer, &CServer::OnProtocolMessageReceived );
 
-    QObject::connect ( this, &CSocket::ProtocolCLMessageReceived, pServer, &CServer::OnProtocolCLMessageReceived );
+    // the server passes the connection less messages on to its own worker thread
+    QObject::connect ( this, &CSocket::ProtocolCLMessageReceived, pServer, &CServer::OnProtocolCLMessageReceived, Qt::DirectConnection );
 
     QObject::connect ( this,
                        static_cast<void ( CSocket::* ) ( int, int, CHostAddress )> ( &CSocket::NewConnection ),
@@ -413,6 +541,27 @@ void CSocket::OnDataReceived()
         // this is a protocol message, check the type of the message
         if ( CProtocol::IsConnectionLessMessageID ( iRecID ) )
         {
+            // the server limits the rate of connection less messages per source
+            // before they are passed on for parsing
+            if ( !bIsClient && !AdmissionControl.AdmitConnectionLessMes ( RecHostAddr ) )
+            {
+                return;
+            }
+
+            // the server answers pings right away in this thread, so that the measured
+            // ping time does not include the time the message waits for being parsed
+            if ( !bIsClient && ( ( iRecID == PROTMESSID_CLM_PING_MS ) || ( iRecID == PROTMESSID_CLM_PING_MS_WITHNUMCLIENTS ) ) )
+            {
+                CVector<uint8_t> vecbyPingAnswer;
+
+                if ( !CProtocol::GenCLPingAnswerMes ( vecbyPingAnswer, iRecID, vecbyMesBodyData, pServer->GetNumberOfConnectedClients() ) )
+                {
+                    SendPacket ( vecbyPingAnswer, RecHostAddr );
+                }
+
+                return;
+            }
+
             //### TODO: BEGIN ###//
             // a copy of the vector is used -> avoid malloc in real-time routine
             emit ProtocolCLMessageReceived ( iRecID, vecbyMesBodyData, RecHostAddr );
@@ -461,7 +610,7 @@ void CSocket::OnDataReceived()
 
             int iCurChanID;
 
-            if ( pServer->PutAudioData ( vecbyRecBuf, iNumBytesRead, RecHostAddr, iCurChanID ) )
+            if ( pServer->PutAudioData ( vecbyRecBuf, iNumBytesRead, RecHostAddr, AdmissionControl, iCurChanID ) )
             {
                 // we have a new connection, emit a signal
                 emit NewConnection ( iCurChanID, pServer->GetNumberOfConnectedClients(), RecHostAddr );
@@ -474,7 +623,8 @@ void CSocket::OnDataReceived()
                 }
             }
 
-            // check if no channel is available
+            // check if no channel is available (note that sources which are not
+            // admitted do not get a reply)
             if ( iCurChanID == INVALID_CHANNEL_ID )
             {
                 // fire message for the state that no free channel is available
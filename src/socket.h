@@ -27,7 +27,9 @@
 #include <QObject>
 #include <QThread>
 #include <QMutex>
+#include <QElapsedTimer>
 #include <vector>
+#include <atomic>
 #include "global.h"
 #include "protocol.h"
 #include "util.h"
@@ -46,7 +48,67 @@ class CChannel; // forward declaration of CChannel
 // number of ports we try to bind until we give up
 #define NUM_SOCKET_PORTS_TO_TRY 100
 
+// admission control of the server: token buckets per source address prefix for
+// connection less messages and new connections (rates are per second)
+#define ADMISSION_TABLE_SIZE           4096 // must be a power of two
+#define ADMISSION_PREFIX_LEN_IPV4      32   // bits
+#define ADMISSION_PREFIX_LEN_IPV6      64   // bits
+#define ADMISSION_CL_MES_RATE          30
+#define ADMISSION_CL_MES_BURST         300 // a client requests all pages of a long server list at once
+#define ADMISSION_NEW_CONNECTION_RATE  2
+#define ADMISSION_NEW_CONNECTION_BURST 10
+
 /* Classes ********************************************************************/
+/* Admission control -------------------------------------------------------- */
+// Limits the rate of connection less messages and new connections the server
+// accepts per source address prefix. The table is only accessed by the socket
+// receive thread and therefore needs no lock, the counters can be read from any
+// thread. Prefixes which map to the same table entry replace each other.
+// Connection less messages of the exempt address (the directory the server is
+// registered with) are never dropped.
+class CAdmissionControl
+{
+public:
+    CAdmissionControl();
+
+    bool AdmitConnectionLessMes ( const CHostAddress& HostAddr );
+    bool AdmitNewConnection ( const CHostAddress& HostAddr );
+
+    void SetExemptAddress ( const CHostAddress& HostAddr );
+
+    uint64_t GetNumCLMesAdmitted() const { return iNumCLMesAdmitted.load ( std::memory_order_relaxed ); }
+    uint64_t GetNumCLMesDropped() const { return iNumCLMesDropped.load ( std::memory_order_relaxed ); }
+    uint64_t GetNumNewConnectionsAdmitted() const { return iNumNewConnectionsAdmitted.load ( std::memory_order_relaxed ); }
+    uint64_t GetNumNewConnectionsDropped() const { return iNumNewConnectionsDropped.load ( std::memory_order_relaxed ); }
+    uint64_t GetNumEntriesReplaced() const { return iNumEntriesReplaced.load ( std::memory_order_relaxed ); }
+
+protected:
+    // the tokens are stored in thousandths of a token
+    struct SBucket
+    {
+        uint32_t iTag; // zero for an unused entry
+        uint32_t iLastUpdateMs;
+        int32_t  iCLMesTokens;
+        int32_t  iNewConnectionTokens;
+    };
+
+    SBucket&    GetBucket ( const CHostAddress& HostAddr );
+    static void Refill ( int32_t& iTokens, const int64_t iElapsedMs, const int iRate, const int iBurst );
+
+    CVector<SBucket> vecBuckets;
+    QElapsedTimer    Clock;
+
+    // the exempt address is set by another thread
+    QMutex       MutexExemptAddr;
+    CHostAddress ExemptAddr;
+
+    std::atomic<uint64_t> iNumCLMesAdmitted;
+    std::atomic<uint64_t> iNumCLMesDropped;
+    std::atomic<uint64_t> iNumNewConnectionsAdmitted;
+    std::atomic<uint64_t> iNumNewConnectionsDropped;
+    std::atomic<uint64_t> iNumEntriesReplaced;
+};
+
 /* Base socket class -------------------------------------------------------- */
 class CSocket : public QObject
 {
@@ -63,6 +125,10 @@ public:
     bool GetAndResetbJitterBufferOKFlag();
     void Close();
 
+    const CAdmissionControl& GetAdmissionControl() const { return AdmissionControl; }
+
+    void SetAdmissionExemptAddress ( const CHostAddress& HostAddr ) { AdmissionControl.SetExemptAddress ( HostAddr ); }
+
 protected:
     void    Init ( const quint16 iPortNumber, const quint16 iQosNumber, const QString& strServerBindIP );
     quint16 iPortNumber;
@@ -88,6 +154,9 @@ protected:
 
     bool bEnableIPv6;
 
+    // only used by the server
+    CAdmissionControl AdmissionControl;
+
 public:
     void OnDataReceived();
 
@@ -147,6 +216,10 @@ public:
 
     bool GetAndResetbJitterBufferOKFlag() { return Socket.GetAndResetbJitterBufferOKFlag(); }
 
+    const CAdmissionControl& GetAdmissionControl() const { return Socket.GetAdmissionControl(); }
+
+    void SetAdmissionExemptAddress ( const CHostAddress& HostAddr ) { Socket.SetAdmissionExemptAddress ( HostAddr ); }
+
 protected:
     class CSocketThread : public QThread
     {
@@ -515,7 +515,7 @@ void CSound::Stop()
     }
 }
 
-CSound::CSound ( void ( *fpNewCallback ) ( CVector<int16_t>& psData, void* arg ),
+CSound::CSound ( void ( *fpNewCallback ) ( CVector<float>& vecfData, void* arg ),
                  void*          arg,
                  const QString& strMIDISetup,
                  const bool,
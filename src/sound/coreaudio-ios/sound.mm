@@ -28,7 +28,7 @@
 #define kInputBus  1
 
 /* Implementation *************************************************************/
-CSound::CSound ( void ( *fpNewProcessCallback ) ( CVector<short>& psData, void* arg ),
+CSound::CSound ( void ( *fpNewProcessCallback ) ( CVector<float>& vecfData, void* arg ),
                  void*          arg,
                  const QString& strMIDISetup,
                  const bool,
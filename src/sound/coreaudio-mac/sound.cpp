@@ -25,7 +25,7 @@
 #include "sound.h"
 
 /* Implementation *************************************************************/
-CSound::CSound ( void ( *fpNewProcessCallback ) ( CVector<short>& psData, void* arg ),
+CSound::CSound ( void ( *fpNewProcessCallback ) ( CVector<float>& vecfData, void* arg ),
                  void*          arg,
                  const QString& strMIDISetup,
                  const bool,
@@ -38,7 +38,7 @@ class CSound : public CSoundBase
     Q_OBJECT
 
 public:
-    CSound ( void ( *fpNewProcessCallback ) ( CVector<short>& psData, void* arg ),
+    CSound ( void ( *fpNewProcessCallback ) ( CVector<float>& vecfData, void* arg ),
              void*          arg,
              const QString& strMIDISetup,
              const bool,
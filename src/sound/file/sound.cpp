@@ -0,0 +1,411 @@
+/******************************************************************************\
+ * Copyright (c) 2004-2025
+ *
+ * Author(s):
+ *  Volker Fischer
+ *
+ ******************************************************************************
+ *
+ * This program is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation; either version 2 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ *
+\******************************************************************************/
+
+#include "sound.h"
+#include <QElapsedTimer>
+#include <QtEndian>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <thread>
+
+/* Implementation *************************************************************/
+CSound::CSound ( void ( *fpNewProcessCallback ) ( CVector<float>& vecfData, void* arg ),
+                 void*          arg,
+                 const QString& strMIDISetup,
+                 const bool,
+                 const QString& ) :
+    CSoundBase ( "File", fpNewProcessCallback, arg, strMIDISetup ),
+    eSource ( SO_SILENCE ),
+    eSink ( SI_NULL ),
+    iFixedMonoBufferSize ( 0 ),
+    iMonoBufferSize ( 0 ),
+    iInputPos ( 0 ),
+    iGeneratorPos ( 0 ),
+    iStatNumBlocks ( 0 ),
+    iStatNumLateBlocks ( 0 ),
+    iStatSumCallbackTimeNs ( 0 ),
+    iStatMaxCallbackTimeNs ( 0 ),
+    iStatNumBlocksPerInterval ( 1 )
+{
+    setObjectName ( "CSoundFileThread" );
+}
+
+CSound::~CSound()
+{
+    if ( IsRunning() )
+    {
+        Stop();
+    }
+
+    OutputFile.close();
+}
+
+void CSound::SetFileSetup ( const QString& strSetup )
+{
+    const QStringList slParams = strSetup.split ( ";" );
+
+    for ( const QString& strParam : slParams )
+    {
+        const QString strKey   = strParam.section ( '=', 0, 0 ).trimmed();
+        const QString strValue = strParam.section ( '=', 1 ).trimmed();
+
+        if ( strKey == "in" )
+        {
+            if ( strValue == "silence" )
+            {
+                eSource = SO_SILENCE;
+            }
+            else if ( strValue == "sine" )
+            {
+                eSource = SO_SINE;
+            }
+            else if ( strValue == "impulse" )
+            {
+                eSource = SO_IMPULSE;
+            }
+            else
+            {
+                LoadWaveFile ( strValue );
+                eSource = SO_FILE;
+            }
+        }
+        else if ( strKey == "out" )
+        {
+            pOutputWaveStream.reset();
+            OutputFile.close();
+
+            if ( strValue == "null" )
+            {
+                eSink = SI_NULL;
+            }
+            else if ( strValue == "-" )
+            {
+                if ( !OutputFile.open ( stdout, QIODevice::WriteOnly ) )
+                {
+                    throw CGenErr ( tr ( "The audio output could not be written to stdout." ) );
+                }
+
+                eSink = SI_STDOUT;
+            }
+            else
+            {
+                OutputFile.setFileName ( strValue );
+
+                if ( !OutputFile.open ( QIODevice::WriteOnly | QIODevice::Truncate ) )
+                {
+                    throw CGenErr ( tr ( "The audio output file %1 could not be opened." ).arg ( strValue ) );
+                }
+
+                pOutputWaveStream.reset ( new recorder::CWaveStream ( &OutputFile, 2 ) );
+                eSink = SI_FILE;
+            }
+        }
+        else if ( strKey == "frames" )
+        {
+            bool      bOk;
+            const int iFrames = strValue.toInt ( &bOk );
+
+            if ( !bOk || ( iFrames < SYSTEM_FRAME_SIZE_SAMPLES / 2 ) || ( iFrames > 8 * DOUBLE_SYSTEM_FRAME_SIZE_SAMPLES ) )
+            {
+                throw CGenErr ( tr ( "The audio block size %1 is not supported." ).arg ( strValue ) );
+            }
+
+            iFixedMonoBufferSize = iFrames;
+        }
+        else if ( !strKey.isEmpty() )
+        {
+            throw CGenErr ( tr ( "Unknown sound file setup parameter: %1" ).arg ( strParam ) );
+        }
+    }
+}
+
+void CSound::LoadWaveFile ( const QString& strFileName )
+{
+    QFile InputFile ( strFileName );
+
+    if ( !InputFile.open ( QIODevice::ReadOnly ) )
+    {
+        throw CGenErr ( tr ( "The audio input file %1 could not be opened." ).arg ( strFileName ) );
+    }
+
+    // the whole file is read at once so that the audio thread never reads from disk
+    const QByteArray baFile = InputFile.readAll();
+    const char*      pData  = baFile.constData();
+    const int        iSize  = baFile.size();
+
+    if ( ( iSize < 12 ) || ( qstrncmp ( pData, "RIFF", 4 ) != 0 ) || ( qstrncmp ( pData + 8, "WAVE", 4 ) != 0 ) )
+    {
+        throw CGenErr ( tr ( "The audio input file %1 is not a WAV file." ).arg ( strFileName ) );
+    }
+
+    // walk through the chunks to find the format and the audio data
+    int iNumChannels = 0;
+    int iPos         = 12;
+
+    while ( iPos + 8 <= iSize )
+    {
+        const int iChunkSize = static_cast<int> ( qFromLittleEndian<quint32> ( pData + iPos + 4 ) );
+        const int iChunkData = iPos + 8;
+
+        if ( ( iChunkSize < 0 ) || ( iChunkSize > iSize - iChunkData ) )
+        {
+            break;
+        }
+
+        if ( ( qstrncmp ( pData + iPos, "fmt ", 4 ) == 0 ) && ( iChunkSize >= 16 ) )
+        {
+            const int iFormat        = qFromLittleEndian<quint16> ( pData + iChunkData );
+            const int iSampleRate    = static_cast<int> ( qFromLittleEndian<quint32> ( pData + iChunkData + 4 ) );
+            const int iBitsPerSample = qFromLittleEndian<quint16> ( pData + iChunkData + 14 );
+
+            iNumChannels = qFromLittleEndian<quint16> ( pData + iChunkData + 2 );
+
+            if ( ( iFormat != 1 ) || ( iBitsPerSample != 16 ) || ( iSampleRate != SYSTEM_SAMPLE_RATE_HZ ) || ( iNumChannels < 1 ) ||
+                 ( iNumChannels > 2 ) )
+            {
+                throw CGenErr ( tr ( "The audio input file %1 must be a 16 bit PCM mono or stereo WAV file with %2 Hz." )
+                                    .arg ( strFileName )
+                                    .arg ( SYSTEM_SAMPLE_RATE_HZ ) );
+            }
+        }
+        else if ( ( qstrncmp ( pData + iPos, "data", 4 ) == 0 ) && ( iNumChannels > 0 ) )
+        {
+            const int iNumFrames = iChunkSize / ( 2 * iNumChannels );
+
+            if ( iNumFrames == 0 )
+            {
+                break;
+            }
+
+            // store the samples as interleaved stereo (mono is put on both channels)
+            vecsInputFile.Init ( 2 * iNumFrames );
+
+            for ( int i = 0; i < iNumFrames; i++ )
+            {
+                const char* pFrame = pData + iChunkData + 2 * iNumChannels * i;
+
+                vecsInputFile[2 * i]     = qFromLittleEndian<qint16> ( pFrame );
+                vecsInputFile[2 * i + 1] = qFromLittleEndian<qint16> ( pFrame + 2 * ( iNumChannels - 1 ) );
+            }
+
+            iInputPos = 0;
+            return;
+        }
+
+        // chunks are padded to an even size
+        iPos = iChunkData + iChunkSize + ( iChunkSize & 1 );
+    }
+
+    throw CGenErr ( tr ( "The audio input file %1 contains no audio data." ).arg ( strFileName ) );
+}
+
+int CSound::Init ( const int iNewPrefMonoBufferSize )
+{
+    // a fixed block size from the setup overrides the preferred block size
+    iMonoBufferSize = ( iFixedMonoBufferSize > 0 ) ? iFixedMonoBufferSize : iNewPrefMonoBufferSize;
+
+    vecfAudio.Init ( 2 * iMonoBufferSize );
+    vecsOutput.Init ( 2 * iMonoBufferSize );
+
+    iStatNumBlocksPerInterval = std::max ( 1, SOUND_FILE_STAT_INTERVAL_S * SYSTEM_SAMPLE_RATE_HZ / iMonoBufferSize );
+
+    CSoundBase::Init ( iMonoBufferSize );
+    return iMonoBufferSize;
+}
+
+void CSound::Start()
+{
+    // reset the statistic
+    iStatNumBlocks         = 0;
+    iStatNumLateBlocks     = 0;
+    iStatSumCallbackTimeNs = 0;
+    iStatMaxCallbackTimeNs = 0;
+
+    // call base class
+    CSoundBase::Start();
+
+    // start the timer thread
+    QThread::start ( QThread::TimeCriticalPriority );
+}
+
+void CSound::Stop()
+{
+    // call base class (waits until a running callback is finished)
+    CSoundBase::Stop();
+
+    // give thread some time to terminate
+    wait ( 5000 );
+
+    if ( pOutputWaveStream )
+    {
+        // make the WAV file valid up to here (the file is continued if we are started again)
+        pOutputWaveStream->finalise();
+        pOutputWaveStream->setByteOrder ( QDataStream::LittleEndian );
+        OutputFile.flush();
+    }
+}
+
+void CSound::run()
+{
+    // the blocks are timed against an absolute clock so that the timing
+    // errors of the single sleeps do not add up
+    const std::chrono::nanoseconds BlockDuration ( static_cast<qint64> ( iMonoBufferSize ) * 1000000000 / SYSTEM_SAMPLE_RATE_HZ );
+    auto                           NextBlockTime = std::chrono::steady_clock::now() + BlockDuration;
+    QElapsedTimer                  CallbackTimer;
+
+    while ( IsRunning() )
+    {
+        std::this_thread::sleep_until ( NextBlockTime );
+
+        QMutexLocker locker ( &MutexAudioProcessCallback );
+
+        if ( !IsRunning() )
+        {
+            break;
+        }
+
+        GetInput();
+
+        // measure the processing time of the client for the statistic
+        CallbackTimer.start();
+        ProcessCallback ( vecfAudio );
+        const qint64 iCallbackTimeNs = CallbackTimer.nsecsElapsed();
+
+        PutOutput();
+
+        // the block is late if the next block is due already
+        NextBlockTime += BlockDuration;
+        UpdateStatistic ( iCallbackTimeNs, std::chrono::steady_clock::now() > NextBlockTime );
+    }
+}
+
+void CSound::GetInput()
+{
+    const int iStereoBufferSize = 2 * iMonoBufferSize;
+
+    switch ( eSource )
+    {
+    case SO_SILENCE:
+        vecfAudio.Reset ( 0 );
+        break;
+
+    case SO_SINE:
+        for ( int i = 0; i < iMonoBufferSize; i++ )
+        {
+            const float fPhase  = 2.0f * static_cast<float> ( M_PI ) * SOUND_FILE_SINE_FREQ_HZ * ( iGeneratorPos + i ) / SYSTEM_SAMPLE_RATE_HZ;
+            const float fSample = SOUND_FILE_GENERATOR_AMPLITUDE * sinf ( fPhase );
+
+            vecfAudio[2 * i] = vecfAudio[2 * i + 1] = fSample;
+        }
+
+        // the sine frequency is an integer, so the phase repeats every second
+        iGeneratorPos = ( iGeneratorPos + iMonoBufferSize ) % SYSTEM_SAMPLE_RATE_HZ;
+        break;
+
+    case SO_IMPULSE:
+    {
+        const int iImpulseInterval = SYSTEM_SAMPLE_RATE_HZ * SOUND_FILE_IMPULSE_INTERVAL_MS / 1000;
+
+        for ( int i = 0; i < iMonoBufferSize; i++ )
+        {
+            const float fSample = ( ( iGeneratorPos + i ) % iImpulseInterval == 0 ) ? SOUND_FILE_GENERATOR_AMPLITUDE : 0.0f;
+
+            vecfAudio[2 * i] = vecfAudio[2 * i + 1] = fSample;
+        }
+
+        iGeneratorPos = ( iGeneratorPos + iMonoBufferSize ) % iImpulseInterval;
+        break;
+    }
+
+    case SO_FILE:
+        // the input file is looped
+        for ( int i = 0; i < iStereoBufferSize; i++ )
+        {
+            vecfAudio[i] = static_cast<float> ( vecsInputFile[iInputPos] ) / _MAXSHORT;
+
+            if ( ++iInputPos == vecsInputFile.Size() )
+            {
+                iInputPos = 0;
+            }
+        }
+        break;
+    }
+}
+
+void CSound::PutOutput()
+{
+    if ( eSink == SI_NULL )
+    {
+        return;
+    }
+
+    const int iStereoBufferSize = 2 * iMonoBufferSize;
+
+    for ( int i = 0; i < iStereoBufferSize; i++ )
+    {
+        vecsOutput[i] = Float2Short ( vecfAudio[i] * _MAXSHORT );
+    }
+
+    if ( eSink == SI_FILE )
+    {
+        for ( int i = 0; i < iStereoBufferSize; i++ )
+        {
+            *pOutputWaveStream << vecsOutput[i];
+        }
+    }
+    else
+    {
+        // raw samples for a pipe (we assume a little endian machine here)
+        OutputFile.write ( reinterpret_cast<const char*> ( &vecsOutput[0] ), iStereoBufferSize * sizeof ( int16_t ) );
+        OutputFile.flush();
+    }
+}
+
+void CSound::UpdateStatistic ( const qint64 iCallbackTimeNs, const bool bIsLate )
+{
+    iStatNumBlocks++;
+    iStatSumCallbackTimeNs += iCallbackTimeNs;
+    iStatMaxCallbackTimeNs = std::max ( iStatMaxCallbackTimeNs, iCallbackTimeNs );
+
+    if ( bIsLate )
+    {
+        iStatNumLateBlocks++;
+    }
+
+    if ( iStatNumBlocks >= iStatNumBlocksPerInterval )
+    {
+        qInfo() << qUtf8Printable ( QString ( "- sound file: %1 blocks of %2 samples, processing time mean %3 us, max %4 us, %5 late blocks" )
+                                        .arg ( iStatNumBlocks )
+                                        .arg ( iMonoBufferSize )
+                                        .arg ( iStatSumCallbackTimeNs / iStatNumBlocks / 1000 )
+                                        .arg ( iStatMaxCallbackTimeNs / 1000 )
+                                        .arg ( iStatNumLateBlocks ) );
+
+        iStatNumBlocks         = 0;
+        iStatNumLateBlocks     = 0;
+        iStatSumCallbackTimeNs = 0;
+        iStatMaxCallbackTimeNs = 0;
+    }
+}
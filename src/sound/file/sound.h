@@ -0,0 +1,118 @@
+/******************************************************************************\
+ * Copyright (c) 2004-2025
+ *
+ * Author(s):
+ *  Volker Fischer
+ *
+ ******************************************************************************
+ *
+ * This program is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation; either version 2 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ *
+\******************************************************************************/
+
+#pragma once
+
+#include <QFile>
+#include <QString>
+#include <memory>
+#include "../../util.h"
+#include "../soundbase.h"
+#include "../../global.h"
+#include "../../recorder/cwavestream.h"
+
+/* Definitions ****************************************************************/
+// frequency of the sine generator and interval of the impulse generator
+#define SOUND_FILE_SINE_FREQ_HZ        440
+#define SOUND_FILE_IMPULSE_INTERVAL_MS 1000 // ms
+#define SOUND_FILE_GENERATOR_AMPLITUDE 0.5f
+
+// interval at which the block timing statistic is logged
+#define SOUND_FILE_STAT_INTERVAL_S 10 // s
+
+/* Classes ********************************************************************/
+// Sound interface without audio hardware: the audio callback is clocked by a
+// timer at the real-time rate of the current block size, the input is read from
+// a WAV file (looped) or a generator and the output is written to a WAV file,
+// to stdout (raw 16 bit little endian stereo samples) or discarded. This allows
+// headless clients for load tests and reproducible latency measurements.
+//
+// The setup string has the form "in=<source>;out=<sink>;frames=<n>", all parts
+// are optional:
+// - source: path of a 16 bit PCM WAV file with 48 kHz (mono or stereo), "sine",
+//   "impulse" or "silence" (default)
+// - sink: path of a WAV file, "-" for stdout or "null" (default)
+// - frames: fixed mono block size in samples (default: the preferred block size)
+class CSound : public CSoundBase
+{
+    Q_OBJECT
+
+public:
+    CSound ( void ( *fpNewProcessCallback ) ( CVector<float>& vecfData, void* arg ),
+             void*          arg,
+             const QString& strMIDISetup,
+             const bool,
+             const QString& );
+
+    virtual ~CSound();
+
+    void SetFileSetup ( const QString& strSetup );
+
+    virtual int  Init ( const int iNewPrefMonoBufferSize );
+    virtual void Start();
+    virtual void Stop();
+
+protected:
+    enum ESource
+    {
+        SO_SILENCE,
+        SO_SINE,
+        SO_IMPULSE,
+        SO_FILE
+    };
+
+    enum ESink
+    {
+        SI_NULL,
+        SI_STDOUT,
+        SI_FILE
+    };
+
+    virtual void run();
+
+    void LoadWaveFile ( const QString& strFileName );
+    void GetInput();
+    void PutOutput();
+    void UpdateStatistic ( const qint64 iCallbackTimeNs, const bool bIsLate );
+
+    ESource          eSource;
+    ESink            eSink;
+    int              iFixedMonoBufferSize; // zero if not set
+    int              iMonoBufferSize;
+    CVector<float>   vecfAudio;
+    CVector<int16_t> vecsInputFile; // interleaved stereo
+    int              iInputPos;
+    qint64           iGeneratorPos;
+
+    QFile                                  OutputFile;
+    std::unique_ptr<recorder::CWaveStream> pOutputWaveStream;
+    CVector<int16_t>                       vecsOutput;
+
+    // block timing statistic
+    qint64 iStatNumBlocks;
+    qint64 iStatNumLateBlocks;
+    qint64 iStatSumCallbackTimeNs;
+    qint64 iStatMaxCallbackTimeNs;
+    qint64 iStatNumBlocksPerInterval;
+};
@@ -60,7 +60,7 @@ class CSound : public CSoundBase
     Q_OBJECT
 
 public:
-    CSound ( void ( *fpNewProcessCallback ) ( CVector<short>& psData, void* arg ),
+    CSound ( void ( *fpNewProcessCallback ) ( CVector<float>& vecfData, void* arg ),
              void*          arg,
              const QString& strMIDISetup,
              const bool     bNoAutoJackConnect,
@@ -90,7 +90,7 @@ public:
 
     // these variables should be protected but cannot since we want
     // to access them from the callback function
-    CVector<short> vecsTmpAudioSndCrdStereo;
+    CVector<float> vecfTmpAudioSndCrdStereo;
     int            iJACKBufferSizeMono;
     int            iJACKBufferSizeStero;
     bool           bJackWasShutDown;
@@ -121,7 +121,7 @@ class CSound : public CSoundBase
     Q_OBJECT
 
 public:
-    CSound ( void ( *fpNewProcessCallback ) ( CVector<short>& psData, void* pParg ),
+    CSound ( void ( *fpNewProcessCallback ) ( CVector<float>& vecfData, void* pParg ),
              void*          pParg,
              const QString& strMIDISetup,
              const bool,
@@ -136,19 +136,19 @@ public:
     virtual int Init ( const int iNewPrefMonoBufferSize )
     {
         CSoundBase::Init ( iNewPrefMonoBufferSize );
-        vecsTemp.Init ( 2 * iNewPrefMonoBufferSize );
+        vecfTemp.Init ( 2 * iNewPrefMonoBufferSize );
         return iNewPrefMonoBufferSize;
     }
     CHighPrecisionTimer HighPrecisionTimer;
-    CVector<short>      vecsTemp;
+    CVector<float>      vecfTemp;
 
 public slots:
     void OnTimer()
     {
-        vecsTemp.Reset ( 0 );
+        vecfTemp.Reset ( 0 );
         if ( IsRunning() )
         {
-            ProcessCallback ( vecsTemp );
+            ProcessCallback ( vecfTemp );
         }
     }
 };
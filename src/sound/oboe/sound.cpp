@@ -29,7 +29,7 @@
 
 const uint8_t CSound::RING_FACTOR = 20;
 
-CSound::CSound ( void ( *fpNewProcessCallback ) ( CVector<short>& psData, void* arg ),
+CSound::CSound ( void ( *fpNewProcessCallback ) ( CVector<float>& vecfData, void* arg ),
                  void*          arg,
                  const QString& strMIDISetup,
                  const bool,
@@ -39,7 +39,7 @@ class CSound : public CSoundBase, public oboe::AudioStreamCallback
 
 public:
     static const uint8_t RING_FACTOR;
-    CSound ( void ( *fpNewProcessCallback ) ( CVector<short>& psData, void* arg ),
+    CSound ( void ( *fpNewProcessCallback ) ( CVector<float>& vecfData, void* arg ),
              void*          arg,
              const QString& strMIDISetup,
              const bool,
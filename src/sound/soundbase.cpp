@@ -38,7 +38,7 @@ char const sMidiCtlChar[] = {
 
 /* Implementation *************************************************************/
 CSoundBase::CSoundBase ( const QString& strNewSystemDriverTechniqueName,
-                         void ( *fpNewProcessCallback ) ( CVector<int16_t>& psData, void* pParg ),
+                         void ( *fpNewProcessCallback ) ( CVector<float>& vecfData, void* pParg ),
                          void*          pParg,
                          const QString& strMIDISetup ) :
     fpProcessCallback ( fpNewProcessCallback ),
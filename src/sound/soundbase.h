@@ -68,7 +68,7 @@ class CSoundBase : public QThread
 
 public:
     CSoundBase ( const QString& strNewSystemDriverTechniqueName,
-                 void ( *fpNewProcessCallback ) ( CVector<int16_t>& psData, void* pParg ),
+                 void ( *fpNewProcessCallback ) ( CVector<float>& vecfData, void* pParg ),
                  void*          pParg,
                  const QString& strMIDISetup );
 
@@ -147,14 +147,40 @@ protected:
     }
 
     // function pointer to callback function
-    void ( *fpProcessCallback ) ( CVector<int16_t>& psData, void* arg );
-    void* pProcessCallbackArg;
+    void ( *fpProcessCallback ) ( CVector<float>& vecfData, void* arg );
+    void*          pProcessCallbackArg;
+    CVector<float> vecfProcessCallbackData;
 
-    // callback function call for derived classes
-    void ProcessCallback ( CVector<int16_t>& psData )
+    // callback function call for derived classes (the samples are normalized
+    // to the range -1 to 1, drivers which deliver float samples use them as they are)
+    void ProcessCallback ( CVector<float>& vecfData )
     {
         bCallbackEntered = true;
-        ( *fpProcessCallback ) ( psData, pProcessCallbackArg );
+        ( *fpProcessCallback ) ( vecfData, pProcessCallbackArg );
+    }
+
+    // callback function call for derived classes which use 16 bit samples
+    void ProcessCallback ( CVector<int16_t>& vecsData )
+    {
+        const int iSize = vecsData.Size();
+
+        // the temporary buffer is only allocated again if the block size changes
+        if ( vecfProcessCallbackData.Size() != iSize )
+        {
+            vecfProcessCallbackData.Init ( iSize );
+        }
+
+        for ( int i = 0; i < iSize; i++ )
+        {
+            vecfProcessCallbackData[i] = static_cast<float> ( vecsData[i] ) / _MAXSHORT;
+        }
+
+        ProcessCallback ( vecfProcessCallbackData );
+
+        for ( int i = 0; i < iSize; i++ )
+        {
+            vecsData[i] = Float2Short ( vecfProcessCallbackData[i] * _MAXSHORT );
+        }
     }
 
     bool   bRun;
@@ -29,10 +29,12 @@
 #include <QDateTime>
 #include <QUdpSocket>
 #include <QHostAddress>
+#include <QElapsedTimer>
 #include "global.h"
 #include "socket.h"
 #include "protocol.h"
 #include "util.h"
+#include "plugins/audioreverb.h"
 
 /* Classes ********************************************************************/
 class CTestbench : public QObject
@@ -118,7 +120,7 @@ public slots:
         ESvrRegResult          eSvrRegResult;
 
         // generate random protocol message
-        switch ( GenRandomIntInRange ( 0, 34 ) )
+        switch ( GenRandomIntInRange ( 0, 35 ) )
         {
         case 0: // PROTMESSID_JITT_BUF_SIZE
             Protocol.CreateJitBufMes ( GenRandomIntInRange ( 0, 10 ) );
@@ -174,7 +176,7 @@ public slots:
             NetTrProps.iBlockSizeFact         = GenRandomIntInRange ( -2, 100 );
             NetTrProps.iNumAudioChannels      = GenRandomIntInRange ( -2, 10 );
             NetTrProps.iSampleRate            = GenRandomIntInRange ( -2, 10000 );
-            NetTrProps.eFlags                 = static_cast<ENetwFlags> ( GenRandomIntInRange ( 0, 1 ) );
+            NetTrProps.eFlags                 = static_cast<ENetwFlags> ( GenRandomIntInRange ( 0, 3 ) );
 
             Protocol.CreateNetwTranspPropsMes ( NetTrProps );
             break;
@@ -291,6 +293,10 @@ public slots:
         case 34: // PROTMESSID_CLIENT_ID
             Protocol.CreateClientIDMes ( GenRandomIntInRange ( -2, 20 ) );
             break;
+
+        case 35: // PROTMESSID_AUDIO_LOSS_RATE
+            Protocol.CreateAudioLossRateMes ( GenRandomIntInRange ( -2, 1100 ) );
+            break;
         }
     }
 
@@ -305,3 +311,292 @@ public slots:
 
     void OnSendCLMessage ( CHostAddress, CVector<uint8_t> vecMessage ) { OnSendProtMessage ( vecMessage ); }
 };
+
+// Reference for the benchmark of the reverberation: the previous implementation
+// of CAudioReverb which processes sample by sample, kept verbatim.
+class CAudioReverbReference
+{
+public:
+    CAudioReverbReference() {}
+
+    void Init ( const EAudChanConf eNAudioChannelConf, const int iNStereoBlockSizeSam, const int iSampleRate, const float fT60 = 1.1f );
+
+    void Clear();
+    void Process ( CVector<float>& vecfStereoInOut, const bool bReverbOnLeftChan, const float fAttenuation );
+
+protected:
+    void setT60 ( const float fT60, const int iSampleRate );
+    bool isPrime ( const int number );
+
+    class COnePole
+    {
+    public:
+        COnePole() : fA ( 0 ), fB ( 0 ) { Reset(); }
+        void  setPole ( const float fPole );
+        float Calc ( const float fIn );
+        void  Reset() { fLastSample = 0; }
+
+    protected:
+        float fA;
+        float fB;
+        float fLastSample;
+    };
+
+    EAudChanConf eAudioChannelConf;
+    int          iStereoBlockSizeSam;
+    CFIFO<float> allpassDelays[3];
+    CFIFO<float> combDelays[4];
+    COnePole     combFilters[4];
+    CFIFO<float> outLeftDelay;
+    CFIFO<float> outRightDelay;
+    float        allpassCoefficient;
+    float        combCoefficient[4];
+};
+
+inline void CAudioReverbReference::Init ( const EAudChanConf eNAudioChannelConf,
+                                          const int          iNStereoBlockSizeSam,
+                                          const int          iSampleRate,
+                                          const float        fT60 )
+{
+    // store parameters
+    eAudioChannelConf   = eNAudioChannelConf;
+    iStereoBlockSizeSam = iNStereoBlockSizeSam;
+
+    // delay lengths for 44100 Hz sample rate
+    int         lengths[9] = { 1116, 1356, 1422, 1617, 225, 341, 441, 211, 179 };
+    const float scaler     = static_cast<float> ( iSampleRate ) / 44100.0f;
+
+    if ( scaler != 1.0f )
+    {
+        for ( int i = 0; i < 9; i++ )
+        {
+            int delay = static_cast<int> ( floorf ( scaler * lengths[i] ) );
+
+            if ( ( delay & 1 ) == 0 )
+            {
+                delay++;
+            }
+
+            while ( !isPrime ( delay ) )
+            {
+                delay += 2;
+            }
+
+            lengths[i] = delay;
+        }
+    }
+
+    for ( int i = 0; i < 3; i++ )
+    {
+        allpassDelays[i].Init ( lengths[i + 4] );
+    }
+
+    for ( int i = 0; i < 4; i++ )
+    {
+        combDelays[i].Init ( lengths[i] );
+        combFilters[i].setPole ( 0.2f );
+    }
+
+    setT60 ( fT60, iSampleRate );
+    outLeftDelay.Init ( lengths[7] );
+    outRightDelay.Init ( lengths[8] );
+    allpassCoefficient = 0.7f;
+    Clear();
+}
+
+inline bool CAudioReverbReference::isPrime ( const int number )
+{
+    /*
+        Returns true if argument value is prime. Taken from "class Effect" in
+        "STK abstract effects parent class".
+    */
+    if ( number == 2 )
+    {
+        return true;
+    }
+
+    if ( number & 1 )
+    {
+        for ( int i = 3; i < static_cast<int> ( sqrtf ( static_cast<float> ( number ) ) ) + 1; i += 2 )
+        {
+            if ( ( number % i ) == 0 )
+            {
+                return false;
+            }
+        }
+
+        return true; // prime
+    }
+    else
+    {
+        return false; // even
+    }
+}
+
+inline void CAudioReverbReference::Clear()
+{
+    // reset and clear all internal state
+    allpassDelays[0].Reset ( 0 );
+    allpassDelays[1].Reset ( 0 );
+    allpassDelays[2].Reset ( 0 );
+    combDelays[0].Reset ( 0 );
+    combDelays[1].Reset ( 0 );
+    combDelays[2].Reset ( 0 );
+    combDelays[3].Reset ( 0 );
+    combFilters[0].Reset();
+    combFilters[1].Reset();
+    combFilters[2].Reset();
+    combFilters[3].Reset();
+    outRightDelay.Reset ( 0 );
+    outLeftDelay.Reset ( 0 );
+}
+
+inline void CAudioReverbReference::setT60 ( const float fT60, const int iSampleRate )
+{
+    // set the reverberation T60 decay time
+    for ( int i = 0; i < 4; i++ )
+    {
+        combCoefficient[i] = powf ( 10.0f, static_cast<float> ( -3.0f * combDelays[i].Size() / ( fT60 * iSampleRate ) ) );
+    }
+}
+
+inline void CAudioReverbReference::COnePole::setPole ( const float fPole )
+{
+    // calculate IIR filter coefficients based on the pole value
+    fA = -fPole;
+    fB = 1.0f - fPole;
+}
+
+inline float CAudioReverbReference::COnePole::Calc ( const float fIn )
+{
+    // calculate IIR filter
+    fLastSample = fB * fIn - fA * fLastSample;
+
+    return fLastSample;
+}
+
+inline void CAudioReverbReference::Process ( CVector<float>& vecfStereoInOut, const bool bReverbOnLeftChan, const float fAttenuation )
+{
+    float fMixedInput, temp, temp0, temp1, temp2;
+
+    for ( int i = 0; i < iStereoBlockSizeSam; i += 2 )
+    {
+        // we sum up the stereo input channels (in case mono input is used, a zero
+        // shall be input for the right channel)
+        if ( eAudioChannelConf == CC_STEREO )
+        {
+            fMixedInput = 0.5f * ( vecfStereoInOut[i] + vecfStereoInOut[i + 1] );
+        }
+        else
+        {
+            if ( bReverbOnLeftChan )
+            {
+                fMixedInput = vecfStereoInOut[i];
+            }
+            else
+            {
+                fMixedInput = vecfStereoInOut[i + 1];
+            }
+        }
+
+        temp  = allpassDelays[0].Get();
+        temp0 = allpassCoefficient * temp;
+        temp0 += fMixedInput;
+        allpassDelays[0].Add ( temp0 );
+        temp0 = -( allpassCoefficient * temp0 ) + temp;
+
+        temp  = allpassDelays[1].Get();
+        temp1 = allpassCoefficient * temp;
+        temp1 += temp0;
+        allpassDelays[1].Add ( temp1 );
+        temp1 = -( allpassCoefficient * temp1 ) + temp;
+
+        temp  = allpassDelays[2].Get();
+        temp2 = allpassCoefficient * temp;
+        temp2 += temp1;
+        allpassDelays[2].Add ( temp2 );
+        temp2 = -( allpassCoefficient * temp2 ) + temp;
+
+        const float temp3 = temp2 + combFilters[0].Calc ( combCoefficient[0] * combDelays[0].Get() );
+        const float temp4 = temp2 + combFilters[1].Calc ( combCoefficient[1] * combDelays[1].Get() );
+        const float temp5 = temp2 + combFilters[2].Calc ( combCoefficient[2] * combDelays[2].Get() );
+        const float temp6 = temp2 + combFilters[3].Calc ( combCoefficient[3] * combDelays[3].Get() );
+
+        combDelays[0].Add ( temp3 );
+        combDelays[1].Add ( temp4 );
+        combDelays[2].Add ( temp5 );
+        combDelays[3].Add ( temp6 );
+
+        const float filtout = temp3 + temp4 + temp5 + temp6;
+
+        outLeftDelay.Add ( filtout );
+        outRightDelay.Add ( filtout );
+
+        // inplace apply the attenuated reverb signal (for stereo always apply
+        // reverberation effect on both channels)
+        if ( ( eAudioChannelConf == CC_STEREO ) || bReverbOnLeftChan )
+        {
+            vecfStereoInOut[i] = ( 1.0f - fAttenuation ) * vecfStereoInOut[i] + 0.5f * fAttenuation * outLeftDelay.Get();
+        }
+
+        if ( ( eAudioChannelConf == CC_STEREO ) || !bReverbOnLeftChan )
+        {
+            vecfStereoInOut[i + 1] = ( 1.0f - fAttenuation ) * vecfStereoInOut[i + 1] + 0.5f * fAttenuation * outRightDelay.Get();
+        }
+    }
+}
+
+// Benchmark of the block processing of the reverberation compared with the
+// previous processing sample by sample. The CPU time per block and the maximum
+// difference of the output are printed for the block sizes of the client.
+class CAudioReverbBenchmark
+{
+public:
+    static void Run()
+    {
+        const int iNumBlocks = 20000;
+
+        for ( const int iMonoBlockSizeSam : { 64, 128, 256, 512 } )
+        {
+            CAudioReverb          BlockReverb;
+            CAudioReverbReference SampleReverb;
+            CVector<float>        vecfBlockData ( 2 * iMonoBlockSizeSam );
+            CVector<float>        vecfSampleData ( 2 * iMonoBlockSizeSam );
+            qint64                iBlockTimeNs  = 0;
+            qint64                iSampleTimeNs = 0;
+            float                 fMaxDiff      = 0;
+            QElapsedTimer         Timer;
+
+            BlockReverb.Init ( CC_STEREO, 2 * iMonoBlockSizeSam, SYSTEM_SAMPLE_RATE_HZ );
+            SampleReverb.Init ( CC_STEREO, 2 * iMonoBlockSizeSam, SYSTEM_SAMPLE_RATE_HZ );
+
+            for ( int iBlock = 0; iBlock < iNumBlocks; iBlock++ )
+            {
+                for ( int i = 0; i < 2 * iMonoBlockSizeSam; i++ )
+                {
+                    vecfBlockData[i]  = static_cast<float> ( rand() ) / RAND_MAX - 0.5f;
+                    vecfSampleData[i] = vecfBlockData[i];
+                }
+
+                Timer.start();
+                BlockReverb.Process ( vecfBlockData, false, 0.5f );
+                iBlockTimeNs += Timer.nsecsElapsed();
+
+                Timer.start();
+                SampleReverb.Process ( vecfSampleData, false, 0.5f );
+                iSampleTimeNs += Timer.nsecsElapsed();
+
+                for ( int i = 0; i < 2 * iMonoBlockSizeSam; i++ )
+                {
+                    fMaxDiff = std::max ( fMaxDiff, std::abs ( vecfBlockData[i] - vecfSampleData[i] ) );
+                }
+            }
+
+            qInfo() << qUtf8Printable ( QString ( "reverb, %1 samples: per sample %2 ns/block, block %3 ns/block, max. difference %4" )
+                                            .arg ( iMonoBlockSizeSam )
+                                            .arg ( iSampleTimeNs / iNumBlocks )
+                                            .arg ( iBlockTimeNs / iNumBlocks )
+                                            .arg ( fMaxDiff ) );
+        }
+    }
+};
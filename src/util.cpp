@@ -75,6 +75,47 @@ void CStereoSignalLevelMeter::Update ( const CVector<short>& vecsAudio, const in
     }
 }
 
+void CStereoSignalLevelMeter::Update ( const CVector<float>& vecfAudio, const int iMonoBlockSizeSam, const bool bIsStereoIn )
+{
+    // same as the 16 bit version above but for normalized float samples (the
+    // level is scaled to the 16 bit range for the meter calculation)
+    float fMinLOrMono = 0.0f;
+    float fMinR       = 0.0f;
+
+    if ( bIsStereoIn )
+    {
+        // stereo in
+        for ( int i = 0; i < 2 * iMonoBlockSizeSam; i += 6 ) // 2 * 3 = 6 -> stereo
+        {
+            // left (or mono) and right channel
+            fMinLOrMono = std::min ( fMinLOrMono, vecfAudio[i] );
+            fMinR       = std::min ( fMinR, vecfAudio[i + 1] );
+        }
+
+        // in case of mono out use minimum of both channels
+        if ( !bIsStereoOut )
+        {
+            fMinLOrMono = std::min ( fMinLOrMono, fMinR );
+        }
+    }
+    else
+    {
+        // mono in
+        for ( int i = 0; i < iMonoBlockSizeSam; i += 3 )
+        {
+            fMinLOrMono = std::min ( fMinLOrMono, vecfAudio[i] );
+        }
+    }
+
+    // apply smoothing, if in stereo out mode, do this for two channels
+    dCurLevelLOrMono = UpdateCurLevel ( dCurLevelLOrMono, -fMinLOrMono * _MAXSHORT );
+
+    if ( bIsStereoOut )
+    {
+        dCurLevelR = UpdateCurLevel ( dCurLevelR, -fMinR * _MAXSHORT );
+    }
+}
+
 double CStereoSignalLevelMeter::UpdateCurLevel ( double dCurLevel, const double dMax )
 {
     // decrease max with time
@@ -98,6 +139,151 @@ double CStereoSignalLevelMeter::UpdateCurLevel ( double dCurLevel, const double
     }
 }
 
+// In-band latency probe implementation ----------------------------------------
+CLatencyProbe::CLatencyProbe() :
+    vecfProbe ( LATENCY_PROBE_LENGTH_SAM ),
+    fProbeEnergy ( 0.0f ),
+    vecfHistory ( 2 * LATENCY_PROBE_LENGTH_SAM ),
+    iDelaySam ( -1 )
+{
+    // linear chirp from 300 Hz to 6 kHz with a Hann window, a chirp has a sharp
+    // autocorrelation peak and survives the audio codec well
+    const float fPi       = 3.14159265f;
+    const float fDuration = static_cast<float> ( LATENCY_PROBE_LENGTH_SAM ) / SYSTEM_SAMPLE_RATE_HZ;
+    const float fStartHz  = 300.0f;
+    const float fStopHz   = 6000.0f;
+
+    for ( int i = 0; i < LATENCY_PROBE_LENGTH_SAM; i++ )
+    {
+        const float fTime   = static_cast<float> ( i ) / SYSTEM_SAMPLE_RATE_HZ;
+        const float fPhase  = 2 * fPi * ( fStartHz * fTime + ( fStopHz - fStartHz ) * fTime * fTime / ( 2 * fDuration ) );
+        const float fWindow = 0.5f - 0.5f * cosf ( 2 * fPi * i / ( LATENCY_PROBE_LENGTH_SAM - 1 ) );
+
+        vecfProbe[i] = LATENCY_PROBE_AMPLITUDE * fWindow * sinf ( fPhase );
+
+        fProbeEnergy += vecfProbe[i] * vecfProbe[i];
+    }
+
+    Reset();
+}
+
+void CLatencyProbe::Reset()
+{
+    // note that the last result is kept
+    vecfHistory.Reset ( 0 );
+    iHistoryPos     = 0;
+    eState          = PS_IDLE;
+    iSampleCnt      = 0;
+    iProbeStartSam  = 0;
+    iSamToNextProbe = LATENCY_PROBE_INTERVAL_MS * SYSTEM_SAMPLE_RATE_HZ / 1000;
+    fMaxCorr        = 0.0f;
+    iMaxCorrSam     = 0;
+    iNumFails       = 0;
+}
+
+void CLatencyProbe::Inject ( CVector<float>& vecfAudio, const int iMonoBlockSizeSam, const int iNumChannels )
+{
+    if ( ( eState == PS_IDLE ) && ( iSamToNextProbe <= 0 ) )
+    {
+        // start a new probe at the beginning of this block
+        eState         = PS_DETECTING;
+        iProbeStartSam = iSampleCnt;
+        fMaxCorr       = 0.0f;
+    }
+
+    if ( eState == PS_DETECTING )
+    {
+        // the probe may span several blocks
+        const int iProbePos = static_cast<int> ( iSampleCnt - iProbeStartSam );
+
+        for ( int i = 0; ( i < iMonoBlockSizeSam ) && ( iProbePos + i < LATENCY_PROBE_LENGTH_SAM ); i++ )
+        {
+            for ( int j = 0; j < iNumChannels; j++ )
+            {
+                vecfAudio[iNumChannels * i + j] += vecfProbe[iProbePos + i];
+            }
+        }
+    }
+}
+
+void CLatencyProbe::Detect ( const CVector<float>& vecfAudio, const int iMonoBlockSizeSam, const int iNumChannels )
+{
+    const qint64 iMaxDelaySam = static_cast<qint64> ( LATENCY_PROBE_MAX_DELAY_MS ) * SYSTEM_SAMPLE_RATE_HZ / 1000;
+
+    for ( int i = 0; i < iMonoBlockSizeSam; i++ )
+    {
+        // store the received mono signal twice so that the last probe length
+        // samples are always available in a linear order
+        float fMono = 0.0f;
+
+        for ( int j = 0; j < iNumChannels; j++ )
+        {
+            fMono += vecfAudio[iNumChannels * i + j];
+        }
+
+        vecfHistory[iHistoryPos] = vecfHistory[iHistoryPos + LATENCY_PROBE_LENGTH_SAM] = fMono / iNumChannels;
+
+        if ( ++iHistoryPos == LATENCY_PROBE_LENGTH_SAM )
+        {
+            iHistoryPos = 0;
+        }
+
+        if ( eState != PS_DETECTING )
+        {
+            continue;
+        }
+
+        // normalized cross-correlation of the last probe length samples with the probe
+        const float* pfWindow = &vecfHistory[iHistoryPos];
+        float        fCorr    = 0.0f;
+        float        fEnergy  = 0.0f;
+
+        for ( int k = 0; k < LATENCY_PROBE_LENGTH_SAM; k++ )
+        {
+            fCorr   += pfWindow[k] * vecfProbe[k];
+            fEnergy += pfWindow[k] * pfWindow[k];
+        }
+
+        const qint64 iCurSam = iSampleCnt + i;
+
+        if ( fEnergy > 0.0f )
+        {
+            const float fNormCorr = fCorr / sqrtf ( fEnergy * fProbeEnergy );
+
+            if ( fNormCorr > fMaxCorr )
+            {
+                fMaxCorr    = fNormCorr;
+                iMaxCorrSam = iCurSam;
+            }
+        }
+
+        if ( iCurSam - iProbeStartSam >= iMaxDelaySam + LATENCY_PROBE_LENGTH_SAM )
+        {
+            // evaluate the probe, the delay is counted from the probe start
+            if ( fMaxCorr >= LATENCY_PROBE_THRESHOLD )
+            {
+                iDelaySam = static_cast<int> ( iMaxCorrSam - ( LATENCY_PROBE_LENGTH_SAM - 1 ) - iProbeStartSam );
+                iNumFails = 0;
+            }
+            else if ( ++iNumFails >= LATENCY_PROBE_MAX_NUM_FAILS )
+            {
+                // our own signal is probably not in the mix anymore
+                iDelaySam = -1;
+            }
+
+            eState          = PS_IDLE;
+            iSamToNextProbe = LATENCY_PROBE_INTERVAL_MS * SYSTEM_SAMPLE_RATE_HZ / 1000;
+        }
+    }
+
+    iSampleCnt += iMonoBlockSizeSam;
+
+    if ( eState == PS_IDLE )
+    {
+        iSamToNextProbe -= iMonoBlockSizeSam;
+    }
+}
+
 double CStereoSignalLevelMeter::CalcLogResultForMeter ( const double& dLinearLevel )
 {
     const double dNormLevel = dLinearLevel / _MAXSHORT;
@@ -25,6 +25,7 @@
 #pragma once
 #include <vector>
 #include <algorithm>
+#include <atomic>
 #ifdef _WIN32
 #    include <winsock2.h>
 #    include <ws2tcpip.h>
@@ -86,6 +87,18 @@ class CClient; // forward declaration of CClient
 #define INVALID_MIDI_CH            -1 // invalid MIDI channel definition
 #define DNS_SRV_RESOLVE_TIMEOUT_MS 500
 
+// in-band latency probe (chirp length, interval between probes, maximum
+// detectable delay, level and minimum normalized correlation for a detection)
+#define LATENCY_PROBE_LENGTH_SAM    512
+#define LATENCY_PROBE_INTERVAL_MS   5000
+#define LATENCY_PROBE_MAX_DELAY_MS  1000
+#define LATENCY_PROBE_AMPLITUDE     0.1f
+#define LATENCY_PROBE_THRESHOLD     0.5f
+#define LATENCY_PROBE_MAX_NUM_FAILS 3 // failed probes until the last result is dropped
+
+// a smoothed gain is set to its target if it is closer than this threshold
+#define SMOOTHED_GAIN_THRESHOLD 1e-4f
+
 /* Global functions ***********************************************************/
 // converting float to short
 inline short Float2Short ( const float fInput )
@@ -105,6 +118,24 @@ inline short Float2Short ( const float fInput )
     return static_cast<short> ( fInput );
 }
 
+// limit a normalized float sample to the range -1 to 1
+inline float ClipFloat ( const float fInput )
+{
+    // lower bound
+    if ( fInput < -1.0f )
+    {
+        return -1.0f;
+    }
+
+    // upper bound
+    if ( fInput > 1.0f )
+    {
+        return 1.0f;
+    }
+
+    return fInput;
+}
+
 // calculate the bit rate in bits per second from the number of coded bytes
 inline int CalcBitRateBitsPerSecFromCodedBytes ( const int iCeltNumCodedBytes, const int iFrameSize )
 {
@@ -494,8 +525,19 @@ enum EAudComprType
 enum ENetwFlags
 {
     // used for protocol -> enum values must be fixed!
-    NF_NONE         = 0,
-    NF_WITH_COUNTER = 1 // using a network counter to correctly order UDP packets in jitter buffer
+    NF_NONE                               = 0,
+    NF_WITH_COUNTER                       = 1, // using a network counter to correctly order UDP packets in jitter buffer
+    NF_WITH_COUNTER_AND_REDUNDANCY        = 2, // like NF_WITH_COUNTER, a frame may carry a redundant copy of the previous frame
+    NF_WITH_COUNTER_AND_SEPARATE_CHANNELS = 3  // like NF_WITH_COUNTER, the client codes each audio channel separately (mono)
+};
+
+// Optional network transport features of the server (bit flags) ---------------
+enum ENetwTranspFeatures
+{
+    // used for protocol -> enum values must be fixed!
+    NTF_NONE              = 0,
+    NTF_REDUNDANCY        = 1, // understands NF_WITH_COUNTER_AND_REDUNDANCY
+    NTF_SEPARATE_CHANNELS = 2  // understands NF_WITH_COUNTER_AND_SEPARATE_CHANNELS
 };
 
 // Audio quality enum ----------------------------------------------------------
@@ -511,6 +553,7 @@ enum EAudioQuality
 enum EGetDataStat
 {
     GS_BUFFER_OK,
+    GS_BUFFER_REDUNDANT, // the lost frame was reconstructed from the redundant copy in the following frame
     GS_BUFFER_UNDERRUN,
     GS_CHAN_NOW_DISCONNECTED,
     GS_CHAN_NOT_CONNECTED
@@ -673,6 +716,14 @@ enum ESvrRegResult
     SRR_NOT_FULFILL_REQIREMENTS = 3
 };
 
+// Optional features of a registered server (bit flags) ------------------------
+enum EServerFeatures
+{
+    // used for protocol -> enum values must be fixed!
+    SF_NONE                 = 0,
+    SF_SEND_EMPTY_MES_MULTI = 1 // understands PROTMESSID_CLM_SEND_EMPTY_MES_MULTI
+};
+
 // Skill level enum ------------------------------------------------------------
 enum ESkillLevel
 {
@@ -715,6 +766,7 @@ public:
     }
 
     void Update ( const CVector<short>& vecsAudio, const int iInSize, const bool bIsStereoIn );
+    void Update ( const CVector<float>& vecfAudio, const int iInSize, const bool bIsStereoIn );
 
     double        GetLevelForMeterdBLeftOrMono() { return CalcLogResultForMeter ( dCurLevelLOrMono ); }
     double        GetLevelForMeterdBRight() { return CalcLogResultForMeter ( dCurLevelR ); }
@@ -735,6 +787,94 @@ protected:
     bool   bIsStereoOut;
 };
 
+// Smoothed gain ---------------------------------------------------------------
+// Avoids clicks if a gain is changed while audio is processed: the gain follows
+// its target value with an exponential approach from block to block and changes
+// linearly within a block. The current gain of a sample is GetStart() plus its
+// index (starting with one) times GetStep(). The first update after Init() sets
+// the gain to the target without smoothing.
+class CSmoothedGain
+{
+public:
+    CSmoothedGain() : fPrevGain ( 1.0f ), fGain ( 1.0f ), fSmoothingFactor ( 1.0f ), bIsInitialized ( false ) {}
+
+    void Init ( const int iMonoBlockSizeSam, const int iSampleRate, const int iTimeConstMs )
+    {
+        fSmoothingFactor = std::min ( 1.0f, static_cast<float> ( iMonoBlockSizeSam ) * 1000 / ( iSampleRate * iTimeConstMs ) );
+        bIsInitialized   = false;
+    }
+
+    // call once per block with the current target gain
+    void Update ( const float fTarget )
+    {
+        if ( !bIsInitialized )
+        {
+            fPrevGain      = fTarget;
+            fGain          = fTarget;
+            bIsInitialized = true;
+            return;
+        }
+
+        fPrevGain = fGain;
+        fGain += ( fTarget - fGain ) * fSmoothingFactor;
+
+        // reach the target exactly, so that a constant gain of zero or one is detected
+        if ( ( fGain - fTarget < SMOOTHED_GAIN_THRESHOLD ) && ( fTarget - fGain < SMOOTHED_GAIN_THRESHOLD ) )
+        {
+            fGain = fTarget;
+        }
+    }
+
+    float GetStart() const { return fPrevGain; }
+    float GetEnd() const { return fGain; }
+    float GetStep ( const int iNumSamples ) const { return ( fGain - fPrevGain ) / iNumSamples; }
+    bool  IsConstant ( const float fValue ) const { return ( fPrevGain == fValue ) && ( fGain == fValue ); }
+
+protected:
+    float fPrevGain;
+    float fGain;
+    float fSmoothingFactor;
+    bool  bIsInitialized;
+};
+
+// In-band latency probe -------------------------------------------------------
+// A short chirp is added to the transmitted signal and its return in the mix of
+// the server is detected by a normalized cross-correlation. The result is the
+// delay from the audio encoder input to the audio decoder output which includes
+// the network, the jitter buffers, the server processing and the audio codec.
+class CLatencyProbe
+{
+public:
+    CLatencyProbe();
+
+    void Reset();
+    void Inject ( CVector<float>& vecfAudio, const int iMonoBlockSizeSam, const int iNumChannels );
+    void Detect ( const CVector<float>& vecfAudio, const int iMonoBlockSizeSam, const int iNumChannels );
+
+    // -1 if no valid measurement is available
+    int GetDelaySamples() const { return iDelaySam.load ( std::memory_order_relaxed ); }
+
+protected:
+    enum EState
+    {
+        PS_IDLE,
+        PS_DETECTING
+    };
+
+    CVector<float>   vecfProbe;
+    float            fProbeEnergy;
+    CVector<float>   vecfHistory; // received mono signal, stored twice to get a linear correlation window
+    int              iHistoryPos;
+    EState           eState;
+    qint64           iSampleCnt;
+    qint64           iProbeStartSam;
+    int              iSamToNextProbe;
+    float            fMaxCorr;
+    qint64           iMaxCorrSam;
+    int              iNumFails;
+    std::atomic<int> iDelaySam;
+};
+
 // Host address ----------------------------------------------------------------
 class CHostAddress
 {
@@ -771,6 +911,9 @@ public:
     quint16      iPort;
 };
 
+// hash function to use host addresses as keys of QHash and QSet
+inline uint qHash ( const CHostAddress& HostAddr, uint iSeed = 0 ) { return qHash ( HostAddr.InetAddr, iSeed ) ^ HostAddr.iPort; }
+
 // Instrument picture data base ------------------------------------------------
 // this is a pure static class
 class CInstPictures